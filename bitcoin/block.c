@@ -11,7 +11,7 @@ struct bitcoin_block *bitcoin_block_from_hex(const tal_t *ctx,
 	struct bitcoin_block *b;
 	u8 *linear_tx;
 	const u8 *p;
-	size_t len, i, num;
+	size_t len;
 
 	if (hexlen && hex[hexlen-1] == '\n')
 		hexlen--;
@@ -21,21 +21,23 @@ struct bitcoin_block *bitcoin_block_from_hex(const tal_t *ctx,
 
 	/* De-hex the array. */
 	len = hex_data_size(hexlen);
-	p = linear_tx = tal_arr(ctx, u8, len);
+	p = linear_tx = tal_arr(b, u8, len);
 	if (!hex_decode(hex, hexlen, linear_tx, len))
 		return tal_free(b);
 
 	pull(&p, &len, &b->hdr, sizeof(b->hdr));
-	num = pull_varint(&p, &len);
-	b->tx = tal_arr(b, struct bitcoin_tx *, num);
-	for (i = 0; i < num; i++)
-		b->tx[i] = pull_bitcoin_tx(b->tx, &p, &len);
+	b->num_txs = pull_varint(&p, &len);
+	b->raw_txs = p;
+	b->raw_txs_len = len;
+
+	/* Make sure the txs are well-formed, so users needn't check. */
+	for (u64 i = 0; i < b->num_txs && p; i++)
+		bitcoin_tx_skim(&p, &len, NULL, NULL, NULL, NULL);
 
 	/* We should end up not overrunning, nor have extra */
 	if (!p || len)
 		return tal_free(b);
 
-	tal_free(linear_tx);
 	return b;
 }
 
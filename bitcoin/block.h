@@ -22,8 +22,11 @@ struct bitcoin_block_hdr {
 
 struct bitcoin_block {
 	struct bitcoin_block_hdr hdr;
-	/* tal_count shows now many */
-	struct bitcoin_tx **tx;
+	/* The serialized transactions, left as they are: walk them with
+	 * bitcoin_tx_skim() and pull_bitcoin_tx() the ones you want. */
+	u64 num_txs;
+	const u8 *raw_txs;
+	size_t raw_txs_len;
 };
 
 struct bitcoin_block *bitcoin_block_from_hex(const tal_t *ctx,
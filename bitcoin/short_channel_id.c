@@ -21,6 +21,12 @@ bool short_channel_id_from_str(const char *str, size_t strlen,
 	return matches == 3;
 }
 
+u64 short_channel_id_to_uint(const struct short_channel_id *scid)
+{
+	return ((u64)scid->blocknum << 40) | ((u64)scid->txnum << 16)
+		| scid->outnum;
+}
+
 char *short_channel_id_to_str(const tal_t *ctx, const struct short_channel_id *scid)
 {
 	return tal_fmt(ctx, "%d:%d:%d", scid->blocknum, scid->txnum, scid->outnum);
@@ -0,0 +1,88 @@
+#include <assert.h>
+#include <bitcoin/pullpush.c>
+#include <bitcoin/shadouble.c>
+#include <bitcoin/tx.c>
+#include <bitcoin/varint.c>
+#include <ccan/err/err.h>
+#include <ccan/opt/opt.h>
+#include <ccan/structeq/structeq.h>
+#include <ccan/time/time.h>
+#include <common/utils.c>
+#include <inttypes.h>
+#include <stdio.h>
+
+/* A p2sh-p2wpkh spend, as found in a block. */
+static const char extended_tx[] = "02000000000101b5bef485c41d0d1f58d1e8a561924ece5c476d86cff063ea10c8df06136eb31d00000000171600144aa38e396e1394fb45cbf83f48d1464fbc9f498fffffffff0140330f000000000017a9140580ba016669d3efaf09a0b2ec3954469ea2bf038702483045022100f2abf9e9cf238c66533af93f23937eae8ac01fb6f105a00ab71dbefb9637dc9502205c1ac745829b3f6889607961f5d817dfa0c8f52bdda12e837c4f7b162f6db8a701210204096eb817f7efb414ef4d3d8be39dd04374256d3b054a322d4a6ee22736d03b00000000";
+
+/* Like chaintopology's filter path: pull each interesting tx out of the
+ * block, then the watches for it each ask for its txid.  DEVELOPER builds
+ * recheck cached txids, so only time this with DEVELOPER=0. */
+static u64 time_filter(struct bitcoin_tx **txs, const u8 *lin,
+		       size_t num_lookups, bool cached,
+		       const struct bitcoin_txid *expect)
+{
+	struct timemono start, end;
+	struct bitcoin_txid txid;
+
+	start = time_mono();
+	for (size_t i = 0; i < tal_count(txs); i++) {
+		const u8 *p = lin;
+		size_t len = tal_len(lin);
+
+		txs[i] = pull_bitcoin_tx(txs, &p, &len);
+		/* What we did before we remembered the txid. */
+		if (!cached)
+			txs[i]->have_txid = false;
+		for (size_t j = 0; j < num_lookups; j++) {
+			bitcoin_txid(txs[i], &txid);
+			assert(structeq(&txid, expect));
+		}
+	}
+	end = time_mono();
+
+	return time_to_nsec(time_divide(timemono_between(end, start),
+					tal_count(txs)));
+}
+
+int main(int argc, char *argv[])
+{
+	const tal_t *ctx = tal_tmpctx(NULL);
+	struct bitcoin_tx *tx, **txs;
+	struct bitcoin_txid expect;
+	size_t num_txs = 1000, num_lookups = 3;
+	bool uncached = false;
+	u8 *lin;
+
+	opt_register_noarg("--uncached", opt_set_bool, &uncached,
+			   "Also time rebuilding the txid every time");
+	opt_parse(&argc, argv, opt_log_stderr_exit);
+
+	if (argc > 1)
+		num_txs = atoi(argv[1]);
+	if (argc > 2)
+		num_lookups = atoi(argv[2]);
+	if (argc > 3 || num_txs == 0)
+		opt_usage_and_exit("[num_txs [num_lookups]]");
+
+	tx = bitcoin_tx_from_hex(ctx, extended_tx, strlen(extended_tx));
+	assert(tx);
+	lin = linearize_tx(ctx, tx);
+	bitcoin_txid(tx, &expect);
+
+	txs = tal_arr(ctx, struct bitcoin_tx *, num_txs);
+	printf("%zu txs pulled, %zu txid lookups each: %"PRIu64" nanoseconds per tx\n",
+	       num_txs, num_lookups,
+	       time_filter(txs, lin, num_lookups, true, &expect));
+
+	if (uncached) {
+		for (size_t i = 0; i < num_txs; i++)
+			tal_free(txs[i]);
+		printf("%zu txs pulled, %zu uncached txid lookups each: %"PRIu64" nanoseconds per tx\n",
+		       num_txs, num_lookups,
+		       time_filter(txs, lin, num_lookups, false, &expect));
+	}
+
+	tal_free(ctx);
+	opt_free_table();
+	return 0;
+}
@@ -3,7 +3,9 @@
 #include <bitcoin/shadouble.c>
 #include <bitcoin/tx.c>
 #include <bitcoin/varint.c>
+#include <ccan/mem/mem.h>
 #include <ccan/str/hex/hex.h>
+#include <ccan/structeq/structeq.h>
 #include <common/utils.c>
 
 const char extended_tx[] = "02000000000101b5bef485c41d0d1f58d1e8a561924ece5c476d86cff063ea10c8df06136eb31d00000000171600144aa38e396e1394fb45cbf83f48d1464fbc9f498fffffffff0140330f000000000017a9140580ba016669d3efaf09a0b2ec3954469ea2bf038702483045022100f2abf9e9cf238c66533af93f23937eae8ac01fb6f105a00ab71dbefb9637dc9502205c1ac745829b3f6889607961f5d817dfa0c8f52bdda12e837c4f7b162f6db8a701210204096eb817f7efb414ef4d3d8be39dd04374256d3b054a322d4a6ee22736d03b00000000";
@@ -24,9 +26,58 @@ static void tal_hexeq(const u8 *p, const char *hex)
 	hexeq(p, tal_count(p),hex);
 }
 
+static size_t skimmed_inputs, skimmed_outputs;
+
+static void skim_input(const struct bitcoin_txid *txid, u32 index, void *arg)
+{
+	const struct bitcoin_tx *tx = arg;
+
+	assert(structeq(txid, &tx->input[skimmed_inputs].txid));
+	assert(index == tx->input[skimmed_inputs].index);
+	skimmed_inputs++;
+}
+
+static void skim_output(const u8 *script, size_t script_len, void *arg)
+{
+	const struct bitcoin_tx *tx = arg;
+
+	assert(memeq(script, script_len,
+		     tx->output[skimmed_outputs].script,
+		     tal_len(tx->output[skimmed_outputs].script)));
+	skimmed_outputs++;
+}
+
+/* bitcoin_tx_skim() should see just what pull_bitcoin_tx() does. */
+static void check_skim(const struct bitcoin_tx *tx)
+{
+	u8 *lin = linearize_tx(NULL, tx);
+	const u8 *p = lin;
+	size_t len = tal_len(lin);
+	struct bitcoin_txid txid, skimmed_txid;
+
+	skimmed_inputs = skimmed_outputs = 0;
+	bitcoin_tx_skim(&p, &len, &skimmed_txid, skim_input, skim_output,
+			(void *)tx);
+	assert(p == lin + tal_len(lin));
+	assert(len == 0);
+	assert(skimmed_inputs == tal_count(tx->input));
+	assert(skimmed_outputs == tal_count(tx->output));
+
+	bitcoin_txid(tx, &txid);
+	assert(structeq(&txid, &skimmed_txid));
+
+	/* Truncated, it fails. */
+	p = lin;
+	len = tal_len(lin) - 1;
+	bitcoin_tx_skim(&p, &len, &skimmed_txid, NULL, NULL, NULL);
+	assert(!p);
+	tal_free(lin);
+}
+
 int main(void)
 {
-	struct bitcoin_tx *tx;
+	struct bitcoin_tx *tx, rebuilt;
+	struct bitcoin_txid txid, rebuilt_txid, in_txid;
 
 	tx = bitcoin_tx_from_hex(NULL, extended_tx, strlen(extended_tx));
 	assert(tx);
@@ -38,9 +89,9 @@ int main(void)
 	assert(tal_count(tx->input) == 1);
 	assert(tal_count(tx->output) == 1);
 
-	reverse_bytes(tx->input[0].txid.shad.sha.u.u8,
-		      sizeof(tx->input[0].txid));
-	hexeq(&tx->input[0].txid, sizeof(tx->input[0].txid),
+	in_txid = tx->input[0].txid;
+	reverse_bytes(in_txid.shad.sha.u.u8, sizeof(in_txid));
+	hexeq(&in_txid, sizeof(in_txid),
 	      "1db36e1306dfc810ea63f0cf866d475cce4e9261a5e8d1581f0d1dc485f4beb5");
 	assert(tx->input[0].index == 0);
 
@@ -58,6 +109,16 @@ int main(void)
 	tal_hexeq(tx->input[0].witness[1],
 		  "0204096eb817f7efb414ef4d3d8be39dd04374256d3b054a322d4a6ee22736d03b");
 
+	check_skim(tx);
+
+	/* The txid we remembered while parsing is the one we'd build. */
+	assert(tx->have_txid);
+	bitcoin_txid(tx, &txid);
+	rebuilt = *tx;
+	rebuilt.have_txid = false;
+	bitcoin_txid(&rebuilt, &rebuilt_txid);
+	assert(structeq(&txid, &rebuilt_txid));
+
 	tal_free(tx);
 	return 0;
 }
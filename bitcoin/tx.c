@@ -8,6 +8,7 @@
 #include <ccan/mem/mem.h>
 #include <ccan/read_write_all/read_write_all.h>
 #include <ccan/str/hex/hex.h>
+#include <ccan/structeq/structeq.h>
 #include <common/type_to_string.h>
 #include <stdio.h>
 
@@ -281,6 +282,17 @@ void bitcoin_txid(const struct bitcoin_tx *tx, struct bitcoin_txid *txid)
 	struct sha256_ctx ctx = SHA256_INIT;
 
 	/* For TXID, we never use extended form. */
+	if (tx->have_txid) {
+#if DEVELOPER
+		/* Catch anyone changing a tx after we parsed it. */
+		push_tx(tx, push_sha, &ctx, false);
+		sha256_double_done(&ctx, &txid->shad);
+		assert(structeq(txid, &tx->txid));
+#endif
+		*txid = tx->txid;
+		return;
+	}
+
 	push_tx(tx, push_sha, &ctx, false);
 	sha256_double_done(&ctx, &txid->shad);
 }
@@ -302,6 +314,7 @@ struct bitcoin_tx *bitcoin_tx(const tal_t *ctx, varint_t input_count,
 	}
 	tx->lock_time = 0;
 	tx->version = 2;
+	tx->have_txid = false;
 	return tx;
 }
 
@@ -383,20 +396,37 @@ static void pull_witness(struct bitcoin_tx_input *inputs, size_t i,
 	}
 }
 
+/* For TXID, we never use extended form: that's the version, then
+ * everything up to the witnesses, then the lock_time. */
+static void txid_from_parts(const u8 *start, const u8 *body,
+			    const u8 *body_end, const u8 *lock_time,
+			    struct bitcoin_txid *txid)
+{
+	struct sha256_ctx ctx = SHA256_INIT;
+
+	sha256_update(&ctx, start, sizeof(u32));
+	sha256_update(&ctx, body, body_end - body);
+	sha256_update(&ctx, lock_time, sizeof(u32));
+	sha256_double_done(&ctx, &txid->shad);
+}
+
 struct bitcoin_tx *pull_bitcoin_tx_onto(const tal_t *ctx, const u8 **cursor,
 					size_t *max, struct bitcoin_tx *tx)
 {
+	const u8 *start = *cursor, *body, *body_end, *lock_time;
 	size_t i;
 	u64 count;
 	u8 flag = 0;
 
 	tx->version = pull_le32(cursor, max);
+	body = *cursor;
 	count = pull_length(cursor, max);
 	/* BIP 144 marker is 0 (impossible to have tx with 0 inputs) */
 	if (count == 0) {
 		pull(cursor, max, &flag, 1);
 		if (flag != SEGREGATED_WITNESS_FLAG)
 			return tal_free(tx);
+		body = *cursor;
 		count = pull_length(cursor, max);
 	}
 
@@ -408,6 +438,7 @@ struct bitcoin_tx *pull_bitcoin_tx_onto(const tal_t *ctx, const u8 **cursor,
 	tx->output = tal_arr(tx, struct bitcoin_tx_output, count);
 	for (i = 0; i < tal_count(tx->output); i++)
 		pull_output(tx, cursor, max, tx->output + i);
+	body_end = *cursor;
 
 	if (flag & SEGREGATED_WITNESS_FLAG) {
 		for (i = 0; i < tal_count(tx->input); i++)
@@ -416,14 +447,84 @@ struct bitcoin_tx *pull_bitcoin_tx_onto(const tal_t *ctx, const u8 **cursor,
 		for (i = 0; i < tal_count(tx->input); i++)
 			tx->input[i].witness = NULL;
 	}
+	lock_time = *cursor;
 	tx->lock_time = pull_le32(cursor, max);
 
 	/* If we ran short, fail. */
 	if (!*cursor)
-		tx = tal_free(tx);
+		return tal_free(tx);
+
+	/* We have the serialization right here: no need to rebuild it. */
+	txid_from_parts(start, body, body_end, lock_time, &tx->txid);
+	tx->have_txid = true;
 	return tx;
 }
 
+void bitcoin_tx_skim(const u8 **cursor, size_t *max, struct bitcoin_txid *txid,
+		     void (*input)(const struct bitcoin_txid *txid, u32 index,
+				   void *arg),
+		     void (*output)(const u8 *script, size_t script_len,
+				    void *arg),
+		     void *arg)
+{
+	const u8 *start = *cursor, *body, *body_end, *lock_time;
+	u64 i, j, count, num_inputs;
+	u8 flag = 0;
+
+	pull_le32(cursor, max);
+	body = *cursor;
+	num_inputs = pull_length(cursor, max);
+	/* BIP 144 marker is 0 (impossible to have tx with 0 inputs) */
+	if (num_inputs == 0) {
+		pull(cursor, max, &flag, 1);
+		if (flag != SEGREGATED_WITNESS_FLAG) {
+			*cursor = NULL;
+			*max = 0;
+			return;
+		}
+		body = *cursor;
+		num_inputs = pull_length(cursor, max);
+	}
+
+	for (i = 0; i < num_inputs && *cursor; i++) {
+		struct bitcoin_txid in_txid;
+		u32 index;
+
+		pull_sha256_double(cursor, max, &in_txid.shad);
+		index = pull_le32(cursor, max);
+		pull(cursor, max, NULL, pull_length(cursor, max));
+		pull_le32(cursor, max);
+		if (*cursor && input)
+			input(&in_txid, index, arg);
+	}
+
+	count = pull_length(cursor, max);
+	for (i = 0; i < count && *cursor; i++) {
+		const u8 *script;
+		u64 script_len;
+
+		pull_value(cursor, max);
+		script_len = pull_length(cursor, max);
+		script = pull(cursor, max, NULL, script_len);
+		if (*cursor && output)
+			output(script, script_len, arg);
+	}
+	body_end = *cursor;
+
+	if (flag & SEGREGATED_WITNESS_FLAG) {
+		for (i = 0; i < num_inputs && *cursor; i++) {
+			count = pull_length(cursor, max);
+			for (j = 0; j < count && *cursor; j++)
+				pull(cursor, max, NULL,
+				     pull_length(cursor, max));
+		}
+	}
+	lock_time = pull(cursor, max, NULL, sizeof(u32));
+
+	if (*cursor && txid)
+		txid_from_parts(start, body, body_end, lock_time, txid);
+}
+
 struct bitcoin_tx *pull_bitcoin_tx(const tal_t *ctx,
 				   const u8 **cursor, size_t *max)
 {
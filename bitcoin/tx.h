@@ -16,6 +16,14 @@ struct bitcoin_tx {
 	struct bitcoin_tx_input *input;
 	struct bitcoin_tx_output *output;
 	u32 lock_time;
+
+	/* We hash parsed txs once as we pull them, and bitcoin_txid()
+	 * trusts that from then on: so once parsed, a tx's version,
+	 * lock_time, inputs and outputs must not change.  Adding
+	 * witnesses or input amounts is fine, since they're not part of
+	 * the txid.  Txs we build ourselves don't have this set. */
+	bool have_txid;
+	struct bitcoin_txid txid;
 };
 
 struct bitcoin_tx_output {
@@ -37,7 +45,8 @@ struct bitcoin_tx_input {
 };
 
 
-/* SHA256^2 the tx: simpler than sha256_tx */
+/* SHA256^2 the tx: simpler than sha256_tx (free if we parsed it, and
+ * DEVELOPER builds check the parsed txid is still right). */
 void bitcoin_txid(const struct bitcoin_tx *tx, struct bitcoin_txid *txid);
 
 /* Useful for signature code. */
@@ -55,7 +64,8 @@ size_t measure_tx_cost(const struct bitcoin_tx *tx);
 struct bitcoin_tx *bitcoin_tx(const tal_t *ctx, varint_t input_count,
 			      varint_t output_count);
 
-/* This takes a raw bitcoin tx in hex. */
+/* This takes a raw bitcoin tx in hex.  Don't change the result's inputs
+ * or outputs: see have_txid. */
 struct bitcoin_tx *bitcoin_tx_from_hex(const tal_t *ctx, const char *hex,
 				       size_t hexlen);
 
@@ -67,7 +77,8 @@ bool bitcoin_txid_from_hex(const char *hexstr, size_t hexstr_len,
 bool bitcoin_txid_to_hex(const struct bitcoin_txid *txid,
 			 char *hexstr, size_t hexstr_len);
 
-/* Internal de-linearization functions. */
+/* Internal de-linearization functions.  As with bitcoin_tx_from_hex(),
+ * the tx they return must not be changed afterwards. */
 struct bitcoin_tx *pull_bitcoin_tx(const tal_t *ctx,
 				   const u8 **cursor, size_t *max);
 
@@ -85,4 +96,25 @@ struct bitcoin_tx *pull_bitcoin_tx(const tal_t *ctx,
  */
 struct bitcoin_tx *pull_bitcoin_tx_onto(const tal_t *ctx, const u8 **cursor,
 					size_t *max, struct bitcoin_tx *tx);
+
+/**
+ * bitcoin_tx_skim - Walk a serialized bitcoin tx in place
+ *
+ * For when most txs (eg. in a block) aren't worth a pull_bitcoin_tx():
+ * nothing is allocated or copied.  Sets *cursor to NULL if the tx is
+ * malformed (@input and @output may have been called by then).
+ *
+ * @cursor: buffer to read from
+ * @max: Buffer size left to read
+ * @txid (out): the txid, or NULL if you don't need it
+ * @input: called with each input's outpoint, or NULL
+ * @output: called with each output's script, or NULL
+ * @arg: handed to @input and @output
+ */
+void bitcoin_tx_skim(const u8 **cursor, size_t *max, struct bitcoin_txid *txid,
+		     void (*input)(const struct bitcoin_txid *txid, u32 index,
+				   void *arg),
+		     void (*output)(const u8 *script, size_t script_len,
+				    void *arg),
+		     void *arg);
 #endif /* LIGHTNING_BITCOIN_TX_H */
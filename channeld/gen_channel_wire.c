@@ -0,0 +1,1057 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#include <channeld/gen_channel_wire.h>
+#include <ccan/mem/mem.h>
+#include <ccan/tal/str/str.h>
+#include <stdio.h>
+
+const char *channel_wire_type_name(int e)
+{
+	static char invalidbuf[sizeof("INVALID ") + STR_MAX_CHARS(e)];
+
+	switch ((enum channel_wire_type)e) {
+	case WIRE_CHANNEL_NORMAL_OPERATION: return "WIRE_CHANNEL_NORMAL_OPERATION";
+	case WIRE_CHANNEL_INIT: return "WIRE_CHANNEL_INIT";
+	case WIRE_CHANNEL_FUNDING_LOCKED: return "WIRE_CHANNEL_FUNDING_LOCKED";
+	case WIRE_CHANNEL_FUNDING_ANNOUNCE_DEPTH: return "WIRE_CHANNEL_FUNDING_ANNOUNCE_DEPTH";
+	case WIRE_CHANNEL_OFFER_HTLC: return "WIRE_CHANNEL_OFFER_HTLC";
+	case WIRE_CHANNEL_OFFER_HTLC_REPLY: return "WIRE_CHANNEL_OFFER_HTLC_REPLY";
+	case WIRE_CHANNEL_FULFILL_HTLC: return "WIRE_CHANNEL_FULFILL_HTLC";
+	case WIRE_CHANNEL_FAIL_HTLC: return "WIRE_CHANNEL_FAIL_HTLC";
+	case WIRE_CHANNEL_PING: return "WIRE_CHANNEL_PING";
+	case WIRE_CHANNEL_PING_REPLY: return "WIRE_CHANNEL_PING_REPLY";
+	case WIRE_CHANNEL_GOT_FUNDING_LOCKED: return "WIRE_CHANNEL_GOT_FUNDING_LOCKED";
+	case WIRE_CHANNEL_SENDING_COMMITSIG: return "WIRE_CHANNEL_SENDING_COMMITSIG";
+	case WIRE_CHANNEL_SENDING_COMMITSIG_REPLY: return "WIRE_CHANNEL_SENDING_COMMITSIG_REPLY";
+	case WIRE_CHANNEL_GOT_COMMITSIG: return "WIRE_CHANNEL_GOT_COMMITSIG";
+	case WIRE_CHANNEL_GOT_COMMITSIG_REPLY: return "WIRE_CHANNEL_GOT_COMMITSIG_REPLY";
+	case WIRE_CHANNEL_GOT_REVOKE: return "WIRE_CHANNEL_GOT_REVOKE";
+	case WIRE_CHANNEL_GOT_REVOKE_REPLY: return "WIRE_CHANNEL_GOT_REVOKE_REPLY";
+	case WIRE_CHANNEL_SEND_SHUTDOWN: return "WIRE_CHANNEL_SEND_SHUTDOWN";
+	case WIRE_CHANNEL_GOT_SHUTDOWN: return "WIRE_CHANNEL_GOT_SHUTDOWN";
+	case WIRE_CHANNEL_SHUTDOWN_COMPLETE: return "WIRE_CHANNEL_SHUTDOWN_COMPLETE";
+	case WIRE_CHANNEL_DEV_REENABLE_COMMIT: return "WIRE_CHANNEL_DEV_REENABLE_COMMIT";
+	case WIRE_CHANNEL_DEV_REENABLE_COMMIT_REPLY: return "WIRE_CHANNEL_DEV_REENABLE_COMMIT_REPLY";
+	case WIRE_CHANNEL_FEERATES: return "WIRE_CHANNEL_FEERATES";
+	}
+
+	sprintf(invalidbuf, "INVALID %i", e);
+	return invalidbuf;
+}
+
+bool fromwire_channel_normal_operation(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_NORMAL_OPERATION)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_channel_init(const tal_t *ctx, const void *p, size_t *plen, struct bitcoin_blkid *chain_hash, struct bitcoin_txid *funding_txid, u16 *funding_txout, u64 *funding_satoshi, struct channel_config *our_config, struct channel_config *their_config, u32 feerate_per_kw[2], u32 *feerate_min, u32 *feerate_max, secp256k1_ecdsa_signature *first_commit_sig, struct crypto_state *crypto_state, u64 *gossip_index, struct pubkey *remote_fundingkey, struct pubkey *remote_revocation_basepoint, struct pubkey *remote_payment_basepoint, struct pubkey *remote_htlc_basepoint, struct pubkey *remote_delayed_payment_basepoint, struct pubkey *remote_per_commit, struct pubkey *old_remote_per_commit, enum side *funder, u32 *fee_base, u32 *fee_proportional, u64 *local_msatoshi, struct privkey *seed, struct pubkey *local_node_id, struct pubkey *remote_node_id, u32 *commit_msec, u16 *cltv_delta, bool *last_was_revoke, struct changed_htlc **last_sent_commit, u64 *next_index_local, u64 *next_index_remote, u64 *revocations_received, u64 *next_htlc_id, struct added_htlc **htlcs, enum htlc_state **htlc_states, struct fulfilled_htlc **fulfilled, enum side **fulfilled_sides, struct failed_htlc **failed, enum side **failed_sides, bool *local_funding_locked, bool *remote_funding_locked, struct short_channel_id *funding_short_id, bool *reestablish, u8 **shutdown_scriptpubkey, bool *remote_shutdown_received, u8 *flags, u8 **init_peer_pkt)
+{
+	u16 num_last_sent_commit;
+	u16 num_htlcs;
+	u16 num_fulfilled;
+	u16 num_failed;
+	u16 shutdown_scriptpubkey_len;
+	u16 init_peer_pkt_len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_INIT)
+		return false;
+	//4th case chain_hash
+	fromwire_bitcoin_blkid(&cursor, plen, chain_hash);
+	//4th case funding_txid
+	fromwire_bitcoin_txid(&cursor, plen, funding_txid);
+	//3th case funding_txout
+	*funding_txout = fromwire_u16(&cursor, plen);
+	//3th case funding_satoshi
+	*funding_satoshi = fromwire_u64(&cursor, plen);
+	//4th case our_config
+	fromwire_channel_config(&cursor, plen, our_config);
+	//4th case their_config
+	fromwire_channel_config(&cursor, plen, their_config);
+	/* FIXME: Fix generate-wire.py to allow NUM_SIDES*u32 here. */
+	for (size_t i = 0; i < 2; i++)
+		(feerate_per_kw)[i] = fromwire_u32(&cursor, plen);
+	//3th case feerate_min
+	*feerate_min = fromwire_u32(&cursor, plen);
+	//3th case feerate_max
+	*feerate_max = fromwire_u32(&cursor, plen);
+	//4th case first_commit_sig
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, first_commit_sig);
+	//4th case crypto_state
+	fromwire_crypto_state(&cursor, plen, crypto_state);
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	//4th case remote_fundingkey
+	fromwire_pubkey(&cursor, plen, remote_fundingkey);
+	//4th case remote_revocation_basepoint
+	fromwire_pubkey(&cursor, plen, remote_revocation_basepoint);
+	//4th case remote_payment_basepoint
+	fromwire_pubkey(&cursor, plen, remote_payment_basepoint);
+	//4th case remote_htlc_basepoint
+	fromwire_pubkey(&cursor, plen, remote_htlc_basepoint);
+	//4th case remote_delayed_payment_basepoint
+	fromwire_pubkey(&cursor, plen, remote_delayed_payment_basepoint);
+	//4th case remote_per_commit
+	fromwire_pubkey(&cursor, plen, remote_per_commit);
+	//4th case old_remote_per_commit
+	fromwire_pubkey(&cursor, plen, old_remote_per_commit);
+	//3th case funder
+	*funder = fromwire_side(&cursor, plen);
+	//3th case fee_base
+	*fee_base = fromwire_u32(&cursor, plen);
+	//3th case fee_proportional
+	*fee_proportional = fromwire_u32(&cursor, plen);
+	//3th case local_msatoshi
+	*local_msatoshi = fromwire_u64(&cursor, plen);
+	//4th case seed
+	fromwire_privkey(&cursor, plen, seed);
+	//4th case local_node_id
+	fromwire_pubkey(&cursor, plen, local_node_id);
+	//4th case remote_node_id
+	fromwire_pubkey(&cursor, plen, remote_node_id);
+	//3th case commit_msec
+	*commit_msec = fromwire_u32(&cursor, plen);
+	//3th case cltv_delta
+	*cltv_delta = fromwire_u16(&cursor, plen);
+	//3th case last_was_revoke
+	*last_was_revoke = fromwire_bool(&cursor, plen);
+	//3th case num_last_sent_commit
+	num_last_sent_commit = fromwire_u16(&cursor, plen);
+	//2nd case last_sent_commit
+	*last_sent_commit = num_last_sent_commit ? tal_arr(ctx, struct changed_htlc, num_last_sent_commit) : NULL;
+	for (size_t i = 0; i < num_last_sent_commit; i++)
+		fromwire_changed_htlc(&cursor, plen, *last_sent_commit + i);
+	//3th case next_index_local
+	*next_index_local = fromwire_u64(&cursor, plen);
+	//3th case next_index_remote
+	*next_index_remote = fromwire_u64(&cursor, plen);
+	//3th case revocations_received
+	*revocations_received = fromwire_u64(&cursor, plen);
+	//3th case next_htlc_id
+	*next_htlc_id = fromwire_u64(&cursor, plen);
+	//3th case num_htlcs
+	num_htlcs = fromwire_u16(&cursor, plen);
+	//2nd case htlcs
+	*htlcs = num_htlcs ? tal_arr(ctx, struct added_htlc, num_htlcs) : NULL;
+	for (size_t i = 0; i < num_htlcs; i++)
+		fromwire_added_htlc(&cursor, plen, *htlcs + i);
+	//2nd case htlc_states
+	*htlc_states = num_htlcs ? tal_arr(ctx, enum htlc_state, num_htlcs) : NULL;
+	for (size_t i = 0; i < num_htlcs; i++)
+		(*htlc_states)[i] = fromwire_htlc_state(&cursor, plen);
+	//3th case num_fulfilled
+	num_fulfilled = fromwire_u16(&cursor, plen);
+	//2nd case fulfilled
+	*fulfilled = num_fulfilled ? tal_arr(ctx, struct fulfilled_htlc, num_fulfilled) : NULL;
+	for (size_t i = 0; i < num_fulfilled; i++)
+		fromwire_fulfilled_htlc(&cursor, plen, *fulfilled + i);
+	//2nd case fulfilled_sides
+	*fulfilled_sides = num_fulfilled ? tal_arr(ctx, enum side, num_fulfilled) : NULL;
+	for (size_t i = 0; i < num_fulfilled; i++)
+		(*fulfilled_sides)[i] = fromwire_side(&cursor, plen);
+	//3th case num_failed
+	num_failed = fromwire_u16(&cursor, plen);
+	//2nd case failed
+	*failed = num_failed ? tal_arr(ctx, struct failed_htlc, num_failed) : NULL;
+	for (size_t i = 0; i < num_failed; i++)
+		fromwire_failed_htlc(ctx, &cursor, plen, *failed + i);
+	//2nd case failed_sides
+	*failed_sides = num_failed ? tal_arr(ctx, enum side, num_failed) : NULL;
+	for (size_t i = 0; i < num_failed; i++)
+		(*failed_sides)[i] = fromwire_side(&cursor, plen);
+	//3th case local_funding_locked
+	*local_funding_locked = fromwire_bool(&cursor, plen);
+	//3th case remote_funding_locked
+	*remote_funding_locked = fromwire_bool(&cursor, plen);
+	//4th case funding_short_id
+	fromwire_short_channel_id(&cursor, plen, funding_short_id);
+	//3th case reestablish
+	*reestablish = fromwire_bool(&cursor, plen);
+	//3th case shutdown_scriptpubkey_len
+	shutdown_scriptpubkey_len = fromwire_u16(&cursor, plen);
+	//2nd case shutdown_scriptpubkey
+	*shutdown_scriptpubkey = shutdown_scriptpubkey_len ? tal_arr(ctx, u8, shutdown_scriptpubkey_len) : NULL;
+	fromwire_u8_array(&cursor, plen, *shutdown_scriptpubkey, shutdown_scriptpubkey_len);
+	//3th case remote_shutdown_received
+	*remote_shutdown_received = fromwire_bool(&cursor, plen);
+	//3th case flags
+	*flags = fromwire_u8(&cursor, plen);
+	//3th case init_peer_pkt_len
+	init_peer_pkt_len = fromwire_u16(&cursor, plen);
+	//2nd case init_peer_pkt
+	*init_peer_pkt = init_peer_pkt_len ? tal_arr(ctx, u8, init_peer_pkt_len) : NULL;
+	fromwire_u8_array(&cursor, plen, *init_peer_pkt, init_peer_pkt_len);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_funding_locked(const void *p, size_t *plen, struct short_channel_id *short_channel_id)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_FUNDING_LOCKED)
+		return false;
+	//4th case short_channel_id
+	fromwire_short_channel_id(&cursor, plen, short_channel_id);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_funding_announce_depth(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_FUNDING_ANNOUNCE_DEPTH)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_channel_offer_htlc(const void *p, size_t *plen, u64 *amount_msat, u32 *cltv_expiry, struct sha256 *payment_hash, u8 onion_routing_packet[1366])
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_OFFER_HTLC)
+		return false;
+	//3th case amount_msat
+	*amount_msat = fromwire_u64(&cursor, plen);
+	//3th case cltv_expiry
+	*cltv_expiry = fromwire_u32(&cursor, plen);
+	//4th case payment_hash
+	fromwire_sha256(&cursor, plen, payment_hash);
+	fromwire_u8_array(&cursor, plen, onion_routing_packet, 1366);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_offer_htlc_reply(const tal_t *ctx, const void *p, size_t *plen, u64 *id, u16 *failure_code, u8 **failurestr)
+{
+	u16 failurestrlen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_OFFER_HTLC_REPLY)
+		return false;
+	//3th case id
+	*id = fromwire_u64(&cursor, plen);
+	/* Zero failure code means success. */
+	//3th case failure_code
+	*failure_code = fromwire_u16(&cursor, plen);
+	//3th case failurestrlen
+	failurestrlen = fromwire_u16(&cursor, plen);
+	//2nd case failurestr
+	*failurestr = failurestrlen ? tal_arr(ctx, u8, failurestrlen) : NULL;
+	fromwire_u8_array(&cursor, plen, *failurestr, failurestrlen);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_fulfill_htlc(const void *p, size_t *plen, u64 *id, struct preimage *payment_preimage)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_FULFILL_HTLC)
+		return false;
+	//3th case id
+	*id = fromwire_u64(&cursor, plen);
+	//4th case payment_preimage
+	fromwire_preimage(&cursor, plen, payment_preimage);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_fail_htlc(const tal_t *ctx, const void *p, size_t *plen, u64 *id, u8 **error_pkt, u16 *errcode, struct short_channel_id *which_channel)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_FAIL_HTLC)
+		return false;
+	//3th case id
+	*id = fromwire_u64(&cursor, plen);
+	/* If this is non-zero length, you need to wrap this and pass it on. */
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case error_pkt
+	*error_pkt = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *error_pkt, len);
+	/* If it errcode is != 0, it's a local error, otherwise we're passing thru. */
+	//3th case errcode
+	*errcode = fromwire_u16(&cursor, plen);
+	/* If errcode & UPDATE, this says which outgoing channel failed. */
+	//4th case which_channel
+	fromwire_short_channel_id(&cursor, plen, which_channel);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_ping(const void *p, size_t *plen, u16 *num_pong_bytes, u16 *len)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_PING)
+		return false;
+	//3th case num_pong_bytes
+	*num_pong_bytes = fromwire_u16(&cursor, plen);
+	//3th case len
+	*len = fromwire_u16(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_ping_reply(const void *p, size_t *plen, u16 *totlen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_PING_REPLY)
+		return false;
+	//3th case totlen
+	*totlen = fromwire_u16(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_got_funding_locked(const void *p, size_t *plen, struct pubkey *next_per_commit_point)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_GOT_FUNDING_LOCKED)
+		return false;
+	//4th case next_per_commit_point
+	fromwire_pubkey(&cursor, plen, next_per_commit_point);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_sending_commitsig(const tal_t *ctx, const void *p, size_t *plen, u64 *commitnum, u32 *feerate, struct changed_htlc **changed, secp256k1_ecdsa_signature *commit_sig, secp256k1_ecdsa_signature **htlc_sigs)
+{
+	u16 num_changed;
+	u16 num_htlc_sigs;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_SENDING_COMMITSIG)
+		return false;
+	//3th case commitnum
+	*commitnum = fromwire_u64(&cursor, plen);
+	//3th case feerate
+	*feerate = fromwire_u32(&cursor, plen);
+	/* SENT_ADD_COMMIT, SENT_REMOVE_ACK_COMMIT, SENT_ADD_ACK_COMMIT, SENT_REMOVE_COMMIT */
+	//3th case num_changed
+	num_changed = fromwire_u16(&cursor, plen);
+	//2nd case changed
+	*changed = num_changed ? tal_arr(ctx, struct changed_htlc, num_changed) : NULL;
+	for (size_t i = 0; i < num_changed; i++)
+		fromwire_changed_htlc(&cursor, plen, *changed + i);
+	//4th case commit_sig
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, commit_sig);
+	//3th case num_htlc_sigs
+	num_htlc_sigs = fromwire_u16(&cursor, plen);
+	//2nd case htlc_sigs
+	*htlc_sigs = num_htlc_sigs ? tal_arr(ctx, secp256k1_ecdsa_signature, num_htlc_sigs) : NULL;
+	for (size_t i = 0; i < num_htlc_sigs; i++)
+		fromwire_secp256k1_ecdsa_signature(&cursor, plen, *htlc_sigs + i);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_sending_commitsig_reply(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_SENDING_COMMITSIG_REPLY)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_channel_got_commitsig(const tal_t *ctx, const void *p, size_t *plen, u64 *commitnum, u32 *feerate, secp256k1_ecdsa_signature *signature, secp256k1_ecdsa_signature **htlc_signature, struct added_htlc **added, struct secret **shared_secret, struct fulfilled_htlc **fulfilled, struct failed_htlc **failed, struct changed_htlc **changed, struct bitcoin_tx *tx)
+{
+	u16 num_htlcs;
+	u16 num_added;
+	u16 num_fulfilled;
+	u16 num_failed;
+	u16 num_changed;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_GOT_COMMITSIG)
+		return false;
+	//3th case commitnum
+	*commitnum = fromwire_u64(&cursor, plen);
+	//3th case feerate
+	*feerate = fromwire_u32(&cursor, plen);
+	//4th case signature
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, signature);
+	//3th case num_htlcs
+	num_htlcs = fromwire_u16(&cursor, plen);
+	//2nd case htlc_signature
+	*htlc_signature = num_htlcs ? tal_arr(ctx, secp256k1_ecdsa_signature, num_htlcs) : NULL;
+	for (size_t i = 0; i < num_htlcs; i++)
+		fromwire_secp256k1_ecdsa_signature(&cursor, plen, *htlc_signature + i);
+	/* RCVD_ADD_COMMIT: we're now committed to their new offered HTLCs. */
+	//3th case num_added
+	num_added = fromwire_u16(&cursor, plen);
+	//2nd case added
+	*added = num_added ? tal_arr(ctx, struct added_htlc, num_added) : NULL;
+	for (size_t i = 0; i < num_added; i++)
+		fromwire_added_htlc(&cursor, plen, *added + i);
+	//2nd case shared_secret
+	*shared_secret = num_added ? tal_arr(ctx, struct secret, num_added) : NULL;
+	for (size_t i = 0; i < num_added; i++)
+		fromwire_secret(&cursor, plen, *shared_secret + i);
+	/* RCVD_REMOVE_COMMIT: we're now no longer committed to these HTLCs. */
+	//3th case num_fulfilled
+	num_fulfilled = fromwire_u16(&cursor, plen);
+	//2nd case fulfilled
+	*fulfilled = num_fulfilled ? tal_arr(ctx, struct fulfilled_htlc, num_fulfilled) : NULL;
+	for (size_t i = 0; i < num_fulfilled; i++)
+		fromwire_fulfilled_htlc(&cursor, plen, *fulfilled + i);
+	//3th case num_failed
+	num_failed = fromwire_u16(&cursor, plen);
+	//2nd case failed
+	*failed = num_failed ? tal_arr(ctx, struct failed_htlc, num_failed) : NULL;
+	for (size_t i = 0; i < num_failed; i++)
+		fromwire_failed_htlc(ctx, &cursor, plen, *failed + i);
+	/* RCVD_ADD_ACK_COMMIT, RCVD_REMOVE_ACK_COMMIT */
+	//3th case num_changed
+	num_changed = fromwire_u16(&cursor, plen);
+	//2nd case changed
+	*changed = num_changed ? tal_arr(ctx, struct changed_htlc, num_changed) : NULL;
+	for (size_t i = 0; i < num_changed; i++)
+		fromwire_changed_htlc(&cursor, plen, *changed + i);
+	//4th case tx
+	fromwire_bitcoin_tx(&cursor, plen, tx);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_got_commitsig_reply(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_GOT_COMMITSIG_REPLY)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_channel_got_revoke(const tal_t *ctx, const void *p, size_t *plen, u64 *revokenum, struct sha256 *per_commitment_secret, struct pubkey *next_per_commit_point, struct changed_htlc **changed)
+{
+	u16 num_changed;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_GOT_REVOKE)
+		return false;
+	//3th case revokenum
+	*revokenum = fromwire_u64(&cursor, plen);
+	//4th case per_commitment_secret
+	fromwire_sha256(&cursor, plen, per_commitment_secret);
+	//4th case next_per_commit_point
+	fromwire_pubkey(&cursor, plen, next_per_commit_point);
+	/* RCVD_ADD_ACK_REVOCATION, RCVD_REMOVE_ACK_REVOCATION, RCVD_ADD_REVOCATION, RCVD_REMOVE_REVOCATION */
+	//3th case num_changed
+	num_changed = fromwire_u16(&cursor, plen);
+	//2nd case changed
+	*changed = num_changed ? tal_arr(ctx, struct changed_htlc, num_changed) : NULL;
+	for (size_t i = 0; i < num_changed; i++)
+		fromwire_changed_htlc(&cursor, plen, *changed + i);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_got_revoke_reply(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_GOT_REVOKE_REPLY)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_channel_send_shutdown(const tal_t *ctx, const void *p, size_t *plen, u8 **scriptpubkey)
+{
+	u16 scriptpubkey_len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_SEND_SHUTDOWN)
+		return false;
+	//3th case scriptpubkey_len
+	scriptpubkey_len = fromwire_u16(&cursor, plen);
+	//2nd case scriptpubkey
+	*scriptpubkey = scriptpubkey_len ? tal_arr(ctx, u8, scriptpubkey_len) : NULL;
+	fromwire_u8_array(&cursor, plen, *scriptpubkey, scriptpubkey_len);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_got_shutdown(const tal_t *ctx, const void *p, size_t *plen, u8 **scriptpubkey)
+{
+	u16 scriptpubkey_len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_GOT_SHUTDOWN)
+		return false;
+	//3th case scriptpubkey_len
+	scriptpubkey_len = fromwire_u16(&cursor, plen);
+	//2nd case scriptpubkey
+	*scriptpubkey = scriptpubkey_len ? tal_arr(ctx, u8, scriptpubkey_len) : NULL;
+	fromwire_u8_array(&cursor, plen, *scriptpubkey, scriptpubkey_len);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_shutdown_complete(const void *p, size_t *plen, struct crypto_state *crypto_state, u64 *gossip_index)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_SHUTDOWN_COMPLETE)
+		return false;
+	//4th case crypto_state
+	fromwire_crypto_state(&cursor, plen, crypto_state);
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_dev_reenable_commit(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_DEV_REENABLE_COMMIT)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_channel_dev_reenable_commit_reply(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_DEV_REENABLE_COMMIT_REPLY)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_channel_feerates(const void *p, size_t *plen, u32 *feerate, u32 *min_feerate, u32 *max_feerate)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_FEERATES)
+		return false;
+	//3th case feerate
+	*feerate = fromwire_u32(&cursor, plen);
+	//3th case min_feerate
+	*min_feerate = fromwire_u32(&cursor, plen);
+	//3th case max_feerate
+	*max_feerate = fromwire_u32(&cursor, plen);
+	return cursor != NULL;
+}
+
+u8 *towire_channel_normal_operation(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_NORMAL_OPERATION);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_init(const tal_t *ctx, const struct bitcoin_blkid *chain_hash, const struct bitcoin_txid *funding_txid, u16 funding_txout, u64 funding_satoshi, const struct channel_config *our_config, const struct channel_config *their_config, const u32 feerate_per_kw[2], u32 feerate_min, u32 feerate_max, const secp256k1_ecdsa_signature *first_commit_sig, const struct crypto_state *crypto_state, u64 gossip_index, const struct pubkey *remote_fundingkey, const struct pubkey *remote_revocation_basepoint, const struct pubkey *remote_payment_basepoint, const struct pubkey *remote_htlc_basepoint, const struct pubkey *remote_delayed_payment_basepoint, const struct pubkey *remote_per_commit, const struct pubkey *old_remote_per_commit, enum side funder, u32 fee_base, u32 fee_proportional, u64 local_msatoshi, const struct privkey *seed, const struct pubkey *local_node_id, const struct pubkey *remote_node_id, u32 commit_msec, u16 cltv_delta, bool last_was_revoke, const struct changed_htlc *last_sent_commit, u64 next_index_local, u64 next_index_remote, u64 revocations_received, u64 next_htlc_id, const struct added_htlc *htlcs, const enum htlc_state *htlc_states, const struct fulfilled_htlc *fulfilled, const enum side *fulfilled_sides, const struct failed_htlc *failed, const enum side *failed_sides, bool local_funding_locked, bool remote_funding_locked, const struct short_channel_id *funding_short_id, bool reestablish, const u8 *shutdown_scriptpubkey, bool remote_shutdown_received, u8 flags, const u8 *init_peer_pkt)
+{
+	u16 num_last_sent_commit = tal_count(last_sent_commit);
+	u16 num_htlcs = tal_count(htlc_states);
+	u16 num_fulfilled = tal_count(fulfilled_sides);
+	u16 num_failed = tal_count(failed_sides);
+	u16 shutdown_scriptpubkey_len = tal_count(shutdown_scriptpubkey);
+	u16 init_peer_pkt_len = tal_count(init_peer_pkt);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_INIT);
+	towire_bitcoin_blkid(&p, chain_hash);
+	towire_bitcoin_txid(&p, funding_txid);
+	towire_u16(&p, funding_txout);
+	towire_u64(&p, funding_satoshi);
+	towire_channel_config(&p, our_config);
+	towire_channel_config(&p, their_config);
+	/* FIXME: Fix generate-wire.py to allow NUM_SIDES*u32 here. */
+	for (size_t i = 0; i < 2; i++)
+
+		towire_u32(&p, feerate_per_kw[i]);
+	towire_u32(&p, feerate_min);
+	towire_u32(&p, feerate_max);
+	towire_secp256k1_ecdsa_signature(&p, first_commit_sig);
+	towire_crypto_state(&p, crypto_state);
+	towire_u64(&p, gossip_index);
+	towire_pubkey(&p, remote_fundingkey);
+	towire_pubkey(&p, remote_revocation_basepoint);
+	towire_pubkey(&p, remote_payment_basepoint);
+	towire_pubkey(&p, remote_htlc_basepoint);
+	towire_pubkey(&p, remote_delayed_payment_basepoint);
+	towire_pubkey(&p, remote_per_commit);
+	towire_pubkey(&p, old_remote_per_commit);
+	towire_side(&p, funder);
+	towire_u32(&p, fee_base);
+	towire_u32(&p, fee_proportional);
+	towire_u64(&p, local_msatoshi);
+	towire_privkey(&p, seed);
+	towire_pubkey(&p, local_node_id);
+	towire_pubkey(&p, remote_node_id);
+	towire_u32(&p, commit_msec);
+	towire_u16(&p, cltv_delta);
+	towire_bool(&p, last_was_revoke);
+	towire_u16(&p, num_last_sent_commit);
+	for (size_t i = 0; i < num_last_sent_commit; i++)
+
+		towire_changed_htlc(&p, last_sent_commit + i);
+	towire_u64(&p, next_index_local);
+	towire_u64(&p, next_index_remote);
+	towire_u64(&p, revocations_received);
+	towire_u64(&p, next_htlc_id);
+	towire_u16(&p, num_htlcs);
+	for (size_t i = 0; i < num_htlcs; i++)
+
+		towire_added_htlc(&p, htlcs + i);
+	for (size_t i = 0; i < num_htlcs; i++)
+
+		towire_htlc_state(&p, htlc_states[i]);
+	towire_u16(&p, num_fulfilled);
+	for (size_t i = 0; i < num_fulfilled; i++)
+
+		towire_fulfilled_htlc(&p, fulfilled + i);
+	for (size_t i = 0; i < num_fulfilled; i++)
+
+		towire_side(&p, fulfilled_sides[i]);
+	towire_u16(&p, num_failed);
+	for (size_t i = 0; i < num_failed; i++)
+
+		towire_failed_htlc(&p, failed + i);
+	for (size_t i = 0; i < num_failed; i++)
+
+		towire_side(&p, failed_sides[i]);
+	towire_bool(&p, local_funding_locked);
+	towire_bool(&p, remote_funding_locked);
+	towire_short_channel_id(&p, funding_short_id);
+	towire_bool(&p, reestablish);
+	towire_u16(&p, shutdown_scriptpubkey_len);
+	towire_u8_array(&p, shutdown_scriptpubkey, shutdown_scriptpubkey_len);
+	towire_bool(&p, remote_shutdown_received);
+	towire_u8(&p, flags);
+	towire_u16(&p, init_peer_pkt_len);
+	towire_u8_array(&p, init_peer_pkt, init_peer_pkt_len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_funding_locked(const tal_t *ctx, const struct short_channel_id *short_channel_id)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_FUNDING_LOCKED);
+	towire_short_channel_id(&p, short_channel_id);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_funding_announce_depth(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_FUNDING_ANNOUNCE_DEPTH);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_offer_htlc(const tal_t *ctx, u64 amount_msat, u32 cltv_expiry, const struct sha256 *payment_hash, const u8 onion_routing_packet[1366])
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_OFFER_HTLC);
+	towire_u64(&p, amount_msat);
+	towire_u32(&p, cltv_expiry);
+	towire_sha256(&p, payment_hash);
+	towire_u8_array(&p, onion_routing_packet, 1366);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_offer_htlc_reply(const tal_t *ctx, u64 id, u16 failure_code, const u8 *failurestr)
+{
+	u16 failurestrlen = tal_count(failurestr);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_OFFER_HTLC_REPLY);
+	towire_u64(&p, id);
+	/* Zero failure code means success. */
+	towire_u16(&p, failure_code);
+	towire_u16(&p, failurestrlen);
+	towire_u8_array(&p, failurestr, failurestrlen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_fulfill_htlc(const tal_t *ctx, u64 id, const struct preimage *payment_preimage)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_FULFILL_HTLC);
+	towire_u64(&p, id);
+	towire_preimage(&p, payment_preimage);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_fail_htlc(const tal_t *ctx, u64 id, const u8 *error_pkt, u16 errcode, const struct short_channel_id *which_channel)
+{
+	u16 len = tal_count(error_pkt);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_FAIL_HTLC);
+	towire_u64(&p, id);
+	/* If this is non-zero length, you need to wrap this and pass it on. */
+	towire_u16(&p, len);
+	towire_u8_array(&p, error_pkt, len);
+	/* If it errcode is != 0, it's a local error, otherwise we're passing thru. */
+	towire_u16(&p, errcode);
+	/* If errcode & UPDATE, this says which outgoing channel failed. */
+	towire_short_channel_id(&p, which_channel);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_ping(const tal_t *ctx, u16 num_pong_bytes, u16 len)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_PING);
+	towire_u16(&p, num_pong_bytes);
+	towire_u16(&p, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_ping_reply(const tal_t *ctx, u16 totlen)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_PING_REPLY);
+	towire_u16(&p, totlen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_got_funding_locked(const tal_t *ctx, const struct pubkey *next_per_commit_point)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_GOT_FUNDING_LOCKED);
+	towire_pubkey(&p, next_per_commit_point);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_sending_commitsig(const tal_t *ctx, u64 commitnum, u32 feerate, const struct changed_htlc *changed, const secp256k1_ecdsa_signature *commit_sig, const secp256k1_ecdsa_signature *htlc_sigs)
+{
+	u16 num_changed = tal_count(changed);
+	u16 num_htlc_sigs = tal_count(htlc_sigs);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_SENDING_COMMITSIG);
+	towire_u64(&p, commitnum);
+	towire_u32(&p, feerate);
+	/* SENT_ADD_COMMIT, SENT_REMOVE_ACK_COMMIT, SENT_ADD_ACK_COMMIT, SENT_REMOVE_COMMIT */
+	towire_u16(&p, num_changed);
+	for (size_t i = 0; i < num_changed; i++)
+
+		towire_changed_htlc(&p, changed + i);
+	towire_secp256k1_ecdsa_signature(&p, commit_sig);
+	towire_u16(&p, num_htlc_sigs);
+	for (size_t i = 0; i < num_htlc_sigs; i++)
+
+		towire_secp256k1_ecdsa_signature(&p, htlc_sigs + i);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_sending_commitsig_reply(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_SENDING_COMMITSIG_REPLY);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_got_commitsig(const tal_t *ctx, u64 commitnum, u32 feerate, const secp256k1_ecdsa_signature *signature, const secp256k1_ecdsa_signature *htlc_signature, const struct added_htlc *added, const struct secret *shared_secret, const struct fulfilled_htlc *fulfilled, const struct failed_htlc *failed, const struct changed_htlc *changed, const struct bitcoin_tx *tx)
+{
+	u16 num_htlcs = tal_count(htlc_signature);
+	u16 num_added = tal_count(shared_secret);
+	u16 num_fulfilled = tal_count(fulfilled);
+	u16 num_failed = tal_count(failed);
+	u16 num_changed = tal_count(changed);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_GOT_COMMITSIG);
+	towire_u64(&p, commitnum);
+	towire_u32(&p, feerate);
+	towire_secp256k1_ecdsa_signature(&p, signature);
+	towire_u16(&p, num_htlcs);
+	for (size_t i = 0; i < num_htlcs; i++)
+
+		towire_secp256k1_ecdsa_signature(&p, htlc_signature + i);
+	/* RCVD_ADD_COMMIT: we're now committed to their new offered HTLCs. */
+	towire_u16(&p, num_added);
+	for (size_t i = 0; i < num_added; i++)
+
+		towire_added_htlc(&p, added + i);
+	for (size_t i = 0; i < num_added; i++)
+
+		towire_secret(&p, shared_secret + i);
+	/* RCVD_REMOVE_COMMIT: we're now no longer committed to these HTLCs. */
+	towire_u16(&p, num_fulfilled);
+	for (size_t i = 0; i < num_fulfilled; i++)
+
+		towire_fulfilled_htlc(&p, fulfilled + i);
+	towire_u16(&p, num_failed);
+	for (size_t i = 0; i < num_failed; i++)
+
+		towire_failed_htlc(&p, failed + i);
+	/* RCVD_ADD_ACK_COMMIT, RCVD_REMOVE_ACK_COMMIT */
+	towire_u16(&p, num_changed);
+	for (size_t i = 0; i < num_changed; i++)
+
+		towire_changed_htlc(&p, changed + i);
+	towire_bitcoin_tx(&p, tx);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_got_commitsig_reply(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_GOT_COMMITSIG_REPLY);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_got_revoke(const tal_t *ctx, u64 revokenum, const struct sha256 *per_commitment_secret, const struct pubkey *next_per_commit_point, const struct changed_htlc *changed)
+{
+	u16 num_changed = tal_count(changed);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_GOT_REVOKE);
+	towire_u64(&p, revokenum);
+	towire_sha256(&p, per_commitment_secret);
+	towire_pubkey(&p, next_per_commit_point);
+	/* RCVD_ADD_ACK_REVOCATION, RCVD_REMOVE_ACK_REVOCATION, RCVD_ADD_REVOCATION, RCVD_REMOVE_REVOCATION */
+	towire_u16(&p, num_changed);
+	for (size_t i = 0; i < num_changed; i++)
+
+		towire_changed_htlc(&p, changed + i);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_got_revoke_reply(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_GOT_REVOKE_REPLY);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_send_shutdown(const tal_t *ctx, const u8 *scriptpubkey)
+{
+	u16 scriptpubkey_len = tal_count(scriptpubkey);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_SEND_SHUTDOWN);
+	towire_u16(&p, scriptpubkey_len);
+	towire_u8_array(&p, scriptpubkey, scriptpubkey_len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_got_shutdown(const tal_t *ctx, const u8 *scriptpubkey)
+{
+	u16 scriptpubkey_len = tal_count(scriptpubkey);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_GOT_SHUTDOWN);
+	towire_u16(&p, scriptpubkey_len);
+	towire_u8_array(&p, scriptpubkey, scriptpubkey_len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_shutdown_complete(const tal_t *ctx, const struct crypto_state *crypto_state, u64 gossip_index)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_SHUTDOWN_COMPLETE);
+	towire_crypto_state(&p, crypto_state);
+	towire_u64(&p, gossip_index);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_dev_reenable_commit(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_DEV_REENABLE_COMMIT);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_dev_reenable_commit_reply(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_DEV_REENABLE_COMMIT_REPLY);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_feerates(const tal_t *ctx, u32 feerate, u32 min_feerate, u32 max_feerate)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_FEERATES);
+	towire_u32(&p, feerate);
+	towire_u32(&p, min_feerate);
+	towire_u32(&p, max_feerate);
+
+	return memcheck(p, tal_count(p));
+}
+
+
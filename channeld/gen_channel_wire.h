@@ -0,0 +1,155 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#ifndef LIGHTNING_CHANNELD_GEN_CHANNEL_WIRE_H
+#define LIGHTNING_CHANNELD_GEN_CHANNEL_WIRE_H
+#include <ccan/tal/tal.h>
+#include <wire/wire.h>
+#include <common/cryptomsg.h>
+
+#include <common/channel_config.h>
+
+#include <bitcoin/preimage.h>
+
+#include <common/htlc_wire.h>
+
+enum channel_wire_type {
+	/* Received and sent funding_locked */
+	WIRE_CHANNEL_NORMAL_OPERATION = 11001,
+	/* Begin!  (passes gossipd-client fd) */
+	WIRE_CHANNEL_INIT = 1000,
+	/* Tx is deep enough, go! */
+	WIRE_CHANNEL_FUNDING_LOCKED = 1002,
+	/* Tell the channel that we may announce the channel's existence */
+	WIRE_CHANNEL_FUNDING_ANNOUNCE_DEPTH = 1003,
+	/* Tell channel to offer this htlc */
+	WIRE_CHANNEL_OFFER_HTLC = 1004,
+	/* Reply; synchronous since IDs have to increment. */
+	WIRE_CHANNEL_OFFER_HTLC_REPLY = 1104,
+	/* Main daemon found out the preimage for an htlc */
+	WIRE_CHANNEL_FULFILL_HTLC = 1005,
+	/* Main daemon says HTLC failed */
+	WIRE_CHANNEL_FAIL_HTLC = 1006,
+	/* Ping/pong test. */
+	WIRE_CHANNEL_PING = 1011,
+	WIRE_CHANNEL_PING_REPLY = 1111,
+	/* When we receive funding_locked. */
+	WIRE_CHANNEL_GOT_FUNDING_LOCKED = 1019,
+	/* When we send a commitment_signed message, tell master. */
+	WIRE_CHANNEL_SENDING_COMMITSIG = 1020,
+	/* Wait for reply, to make sure it's on disk before we send commit. */
+	WIRE_CHANNEL_SENDING_COMMITSIG_REPLY = 1120,
+	/* When we have a commitment_signed message, tell master to remember. */
+	WIRE_CHANNEL_GOT_COMMITSIG = 1021,
+	/* Wait for reply, to make sure it's on disk before we send revocation. */
+	WIRE_CHANNEL_GOT_COMMITSIG_REPLY = 1121,
+	WIRE_CHANNEL_GOT_REVOKE = 1022,
+	/* Wait for reply, to make sure it's on disk before we continue */
+	/* (eg. if we sent another commitment_signed, that would implicitly ack). */
+	WIRE_CHANNEL_GOT_REVOKE_REPLY = 1122,
+	/* Tell peer that channel is shutting down */
+	WIRE_CHANNEL_SEND_SHUTDOWN = 1023,
+	/* Peer told us that channel is shutting down */
+	WIRE_CHANNEL_GOT_SHUTDOWN = 1024,
+	/* Shutdown is complete, ready for closing negotiation. + peer_fd & gossip_fd. */
+	WIRE_CHANNEL_SHUTDOWN_COMPLETE = 1025,
+	/* Re-enable commit timer. */
+	WIRE_CHANNEL_DEV_REENABLE_COMMIT = 1026,
+	WIRE_CHANNEL_DEV_REENABLE_COMMIT_REPLY = 1126,
+	WIRE_CHANNEL_FEERATES = 1027,
+};
+const char *channel_wire_type_name(int e);
+
+bool fromwire_channel_normal_operation(const void *p, size_t *plen);
+
+bool fromwire_channel_init(const tal_t *ctx, const void *p, size_t *plen, struct bitcoin_blkid *chain_hash, struct bitcoin_txid *funding_txid, u16 *funding_txout, u64 *funding_satoshi, struct channel_config *our_config, struct channel_config *their_config, u32 feerate_per_kw[2], u32 *feerate_min, u32 *feerate_max, secp256k1_ecdsa_signature *first_commit_sig, struct crypto_state *crypto_state, u64 *gossip_index, struct pubkey *remote_fundingkey, struct pubkey *remote_revocation_basepoint, struct pubkey *remote_payment_basepoint, struct pubkey *remote_htlc_basepoint, struct pubkey *remote_delayed_payment_basepoint, struct pubkey *remote_per_commit, struct pubkey *old_remote_per_commit, enum side *funder, u32 *fee_base, u32 *fee_proportional, u64 *local_msatoshi, struct privkey *seed, struct pubkey *local_node_id, struct pubkey *remote_node_id, u32 *commit_msec, u16 *cltv_delta, bool *last_was_revoke, struct changed_htlc **last_sent_commit, u64 *next_index_local, u64 *next_index_remote, u64 *revocations_received, u64 *next_htlc_id, struct added_htlc **htlcs, enum htlc_state **htlc_states, struct fulfilled_htlc **fulfilled, enum side **fulfilled_sides, struct failed_htlc **failed, enum side **failed_sides, bool *local_funding_locked, bool *remote_funding_locked, struct short_channel_id *funding_short_id, bool *reestablish, u8 **shutdown_scriptpubkey, bool *remote_shutdown_received, u8 *flags, u8 **init_peer_pkt);
+
+bool fromwire_channel_funding_locked(const void *p, size_t *plen, struct short_channel_id *short_channel_id);
+
+bool fromwire_channel_funding_announce_depth(const void *p, size_t *plen);
+
+bool fromwire_channel_offer_htlc(const void *p, size_t *plen, u64 *amount_msat, u32 *cltv_expiry, struct sha256 *payment_hash, u8 onion_routing_packet[1366]);
+
+bool fromwire_channel_offer_htlc_reply(const tal_t *ctx, const void *p, size_t *plen, u64 *id, u16 *failure_code, u8 **failurestr);
+
+bool fromwire_channel_fulfill_htlc(const void *p, size_t *plen, u64 *id, struct preimage *payment_preimage);
+
+bool fromwire_channel_fail_htlc(const tal_t *ctx, const void *p, size_t *plen, u64 *id, u8 **error_pkt, u16 *errcode, struct short_channel_id *which_channel);
+
+bool fromwire_channel_ping(const void *p, size_t *plen, u16 *num_pong_bytes, u16 *len);
+
+bool fromwire_channel_ping_reply(const void *p, size_t *plen, u16 *totlen);
+
+bool fromwire_channel_got_funding_locked(const void *p, size_t *plen, struct pubkey *next_per_commit_point);
+
+bool fromwire_channel_sending_commitsig(const tal_t *ctx, const void *p, size_t *plen, u64 *commitnum, u32 *feerate, struct changed_htlc **changed, secp256k1_ecdsa_signature *commit_sig, secp256k1_ecdsa_signature **htlc_sigs);
+
+bool fromwire_channel_sending_commitsig_reply(const void *p, size_t *plen);
+
+bool fromwire_channel_got_commitsig(const tal_t *ctx, const void *p, size_t *plen, u64 *commitnum, u32 *feerate, secp256k1_ecdsa_signature *signature, secp256k1_ecdsa_signature **htlc_signature, struct added_htlc **added, struct secret **shared_secret, struct fulfilled_htlc **fulfilled, struct failed_htlc **failed, struct changed_htlc **changed, struct bitcoin_tx *tx);
+
+bool fromwire_channel_got_commitsig_reply(const void *p, size_t *plen);
+
+bool fromwire_channel_got_revoke(const tal_t *ctx, const void *p, size_t *plen, u64 *revokenum, struct sha256 *per_commitment_secret, struct pubkey *next_per_commit_point, struct changed_htlc **changed);
+
+bool fromwire_channel_got_revoke_reply(const void *p, size_t *plen);
+
+bool fromwire_channel_send_shutdown(const tal_t *ctx, const void *p, size_t *plen, u8 **scriptpubkey);
+
+bool fromwire_channel_got_shutdown(const tal_t *ctx, const void *p, size_t *plen, u8 **scriptpubkey);
+
+bool fromwire_channel_shutdown_complete(const void *p, size_t *plen, struct crypto_state *crypto_state, u64 *gossip_index);
+
+bool fromwire_channel_dev_reenable_commit(const void *p, size_t *plen);
+
+bool fromwire_channel_dev_reenable_commit_reply(const void *p, size_t *plen);
+
+bool fromwire_channel_feerates(const void *p, size_t *plen, u32 *feerate, u32 *min_feerate, u32 *max_feerate);
+
+u8 *towire_channel_normal_operation(const tal_t *ctx);
+
+u8 *towire_channel_init(const tal_t *ctx, const struct bitcoin_blkid *chain_hash, const struct bitcoin_txid *funding_txid, u16 funding_txout, u64 funding_satoshi, const struct channel_config *our_config, const struct channel_config *their_config, const u32 feerate_per_kw[2], u32 feerate_min, u32 feerate_max, const secp256k1_ecdsa_signature *first_commit_sig, const struct crypto_state *crypto_state, u64 gossip_index, const struct pubkey *remote_fundingkey, const struct pubkey *remote_revocation_basepoint, const struct pubkey *remote_payment_basepoint, const struct pubkey *remote_htlc_basepoint, const struct pubkey *remote_delayed_payment_basepoint, const struct pubkey *remote_per_commit, const struct pubkey *old_remote_per_commit, enum side funder, u32 fee_base, u32 fee_proportional, u64 local_msatoshi, const struct privkey *seed, const struct pubkey *local_node_id, const struct pubkey *remote_node_id, u32 commit_msec, u16 cltv_delta, bool last_was_revoke, const struct changed_htlc *last_sent_commit, u64 next_index_local, u64 next_index_remote, u64 revocations_received, u64 next_htlc_id, const struct added_htlc *htlcs, const enum htlc_state *htlc_states, const struct fulfilled_htlc *fulfilled, const enum side *fulfilled_sides, const struct failed_htlc *failed, const enum side *failed_sides, bool local_funding_locked, bool remote_funding_locked, const struct short_channel_id *funding_short_id, bool reestablish, const u8 *shutdown_scriptpubkey, bool remote_shutdown_received, u8 flags, const u8 *init_peer_pkt);
+
+u8 *towire_channel_funding_locked(const tal_t *ctx, const struct short_channel_id *short_channel_id);
+
+u8 *towire_channel_funding_announce_depth(const tal_t *ctx);
+
+u8 *towire_channel_offer_htlc(const tal_t *ctx, u64 amount_msat, u32 cltv_expiry, const struct sha256 *payment_hash, const u8 onion_routing_packet[1366]);
+
+u8 *towire_channel_offer_htlc_reply(const tal_t *ctx, u64 id, u16 failure_code, const u8 *failurestr);
+
+u8 *towire_channel_fulfill_htlc(const tal_t *ctx, u64 id, const struct preimage *payment_preimage);
+
+u8 *towire_channel_fail_htlc(const tal_t *ctx, u64 id, const u8 *error_pkt, u16 errcode, const struct short_channel_id *which_channel);
+
+u8 *towire_channel_ping(const tal_t *ctx, u16 num_pong_bytes, u16 len);
+
+u8 *towire_channel_ping_reply(const tal_t *ctx, u16 totlen);
+
+u8 *towire_channel_got_funding_locked(const tal_t *ctx, const struct pubkey *next_per_commit_point);
+
+u8 *towire_channel_sending_commitsig(const tal_t *ctx, u64 commitnum, u32 feerate, const struct changed_htlc *changed, const secp256k1_ecdsa_signature *commit_sig, const secp256k1_ecdsa_signature *htlc_sigs);
+
+u8 *towire_channel_sending_commitsig_reply(const tal_t *ctx);
+
+u8 *towire_channel_got_commitsig(const tal_t *ctx, u64 commitnum, u32 feerate, const secp256k1_ecdsa_signature *signature, const secp256k1_ecdsa_signature *htlc_signature, const struct added_htlc *added, const struct secret *shared_secret, const struct fulfilled_htlc *fulfilled, const struct failed_htlc *failed, const struct changed_htlc *changed, const struct bitcoin_tx *tx);
+
+u8 *towire_channel_got_commitsig_reply(const tal_t *ctx);
+
+u8 *towire_channel_got_revoke(const tal_t *ctx, u64 revokenum, const struct sha256 *per_commitment_secret, const struct pubkey *next_per_commit_point, const struct changed_htlc *changed);
+
+u8 *towire_channel_got_revoke_reply(const tal_t *ctx);
+
+u8 *towire_channel_send_shutdown(const tal_t *ctx, const u8 *scriptpubkey);
+
+u8 *towire_channel_got_shutdown(const tal_t *ctx, const u8 *scriptpubkey);
+
+u8 *towire_channel_shutdown_complete(const tal_t *ctx, const struct crypto_state *crypto_state, u64 gossip_index);
+
+u8 *towire_channel_dev_reenable_commit(const tal_t *ctx);
+
+u8 *towire_channel_dev_reenable_commit_reply(const tal_t *ctx);
+
+u8 *towire_channel_feerates(const tal_t *ctx, u32 feerate, u32 min_feerate, u32 max_feerate);
+
+#endif /* LIGHTNING_CHANNELD_GEN_CHANNEL_WIRE_H */
+
@@ -0,0 +1,201 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#include <closingd/gen_closing_wire.h>
+#include <ccan/mem/mem.h>
+#include <ccan/tal/str/str.h>
+#include <stdio.h>
+
+const char *closing_wire_type_name(int e)
+{
+	static char invalidbuf[sizeof("INVALID ") + STR_MAX_CHARS(e)];
+
+	switch ((enum closing_wire_type)e) {
+	case WIRE_CLOSING_INIT: return "WIRE_CLOSING_INIT";
+	case WIRE_CLOSING_RECEIVED_SIGNATURE: return "WIRE_CLOSING_RECEIVED_SIGNATURE";
+	case WIRE_CLOSING_RECEIVED_SIGNATURE_REPLY: return "WIRE_CLOSING_RECEIVED_SIGNATURE_REPLY";
+	case WIRE_CLOSING_COMPLETE: return "WIRE_CLOSING_COMPLETE";
+	}
+
+	sprintf(invalidbuf, "INVALID %i", e);
+	return invalidbuf;
+}
+
+bool fromwire_closing_init(const tal_t *ctx, const void *p, size_t *plen, struct crypto_state *crypto_state, u64 *gossip_index, struct privkey *seed, struct bitcoin_txid *funding_txid, u16 *funding_txout, u64 *funding_satoshi, struct pubkey *remote_fundingkey, enum side *funder, u64 *local_msatoshi, u64 *remote_msatoshi, u64 *our_dust_limit, u64 *min_fee_satoshi, u64 *max_fee_satoshi, u64 *initial_fee_satoshi, u8 **local_scriptpubkey, u8 **remote_scriptpubkey, bool *reconnected, u64 *next_index_local, u64 *next_index_remote, u64 *revocations_received)
+{
+	u16 local_scriptpubkey_len;
+	u16 remote_scriptpubkey_len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CLOSING_INIT)
+		return false;
+	//4th case crypto_state
+	fromwire_crypto_state(&cursor, plen, crypto_state);
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	//4th case seed
+	fromwire_privkey(&cursor, plen, seed);
+	//4th case funding_txid
+	fromwire_bitcoin_txid(&cursor, plen, funding_txid);
+	//3th case funding_txout
+	*funding_txout = fromwire_u16(&cursor, plen);
+	//3th case funding_satoshi
+	*funding_satoshi = fromwire_u64(&cursor, plen);
+	//4th case remote_fundingkey
+	fromwire_pubkey(&cursor, plen, remote_fundingkey);
+	//3th case funder
+	*funder = fromwire_side(&cursor, plen);
+	//3th case local_msatoshi
+	*local_msatoshi = fromwire_u64(&cursor, plen);
+	//3th case remote_msatoshi
+	*remote_msatoshi = fromwire_u64(&cursor, plen);
+	//3th case our_dust_limit
+	*our_dust_limit = fromwire_u64(&cursor, plen);
+	//3th case min_fee_satoshi
+	*min_fee_satoshi = fromwire_u64(&cursor, plen);
+	//3th case max_fee_satoshi
+	*max_fee_satoshi = fromwire_u64(&cursor, plen);
+	//3th case initial_fee_satoshi
+	*initial_fee_satoshi = fromwire_u64(&cursor, plen);
+	//3th case local_scriptpubkey_len
+	local_scriptpubkey_len = fromwire_u16(&cursor, plen);
+	//2nd case local_scriptpubkey
+	*local_scriptpubkey = local_scriptpubkey_len ? tal_arr(ctx, u8, local_scriptpubkey_len) : NULL;
+	fromwire_u8_array(&cursor, plen, *local_scriptpubkey, local_scriptpubkey_len);
+	//3th case remote_scriptpubkey_len
+	remote_scriptpubkey_len = fromwire_u16(&cursor, plen);
+	//2nd case remote_scriptpubkey
+	*remote_scriptpubkey = remote_scriptpubkey_len ? tal_arr(ctx, u8, remote_scriptpubkey_len) : NULL;
+	fromwire_u8_array(&cursor, plen, *remote_scriptpubkey, remote_scriptpubkey_len);
+	//3th case reconnected
+	*reconnected = fromwire_bool(&cursor, plen);
+	//3th case next_index_local
+	*next_index_local = fromwire_u64(&cursor, plen);
+	//3th case next_index_remote
+	*next_index_remote = fromwire_u64(&cursor, plen);
+	//3th case revocations_received
+	*revocations_received = fromwire_u64(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_closing_received_signature(const void *p, size_t *plen, secp256k1_ecdsa_signature *signature, struct bitcoin_tx *tx)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CLOSING_RECEIVED_SIGNATURE)
+		return false;
+	//4th case signature
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, signature);
+	//4th case tx
+	fromwire_bitcoin_tx(&cursor, plen, tx);
+	return cursor != NULL;
+}
+
+bool fromwire_closing_received_signature_reply(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CLOSING_RECEIVED_SIGNATURE_REPLY)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_closing_complete(const void *p, size_t *plen, u64 *gossip_index)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CLOSING_COMPLETE)
+		return false;
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	return cursor != NULL;
+}
+
+u8 *towire_closing_init(const tal_t *ctx, const struct crypto_state *crypto_state, u64 gossip_index, const struct privkey *seed, const struct bitcoin_txid *funding_txid, u16 funding_txout, u64 funding_satoshi, const struct pubkey *remote_fundingkey, enum side funder, u64 local_msatoshi, u64 remote_msatoshi, u64 our_dust_limit, u64 min_fee_satoshi, u64 max_fee_satoshi, u64 initial_fee_satoshi, const u8 *local_scriptpubkey, const u8 *remote_scriptpubkey, bool reconnected, u64 next_index_local, u64 next_index_remote, u64 revocations_received)
+{
+	u16 local_scriptpubkey_len = tal_count(local_scriptpubkey);
+	u16 remote_scriptpubkey_len = tal_count(remote_scriptpubkey);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CLOSING_INIT);
+	towire_crypto_state(&p, crypto_state);
+	towire_u64(&p, gossip_index);
+	towire_privkey(&p, seed);
+	towire_bitcoin_txid(&p, funding_txid);
+	towire_u16(&p, funding_txout);
+	towire_u64(&p, funding_satoshi);
+	towire_pubkey(&p, remote_fundingkey);
+	towire_side(&p, funder);
+	towire_u64(&p, local_msatoshi);
+	towire_u64(&p, remote_msatoshi);
+	towire_u64(&p, our_dust_limit);
+	towire_u64(&p, min_fee_satoshi);
+	towire_u64(&p, max_fee_satoshi);
+	towire_u64(&p, initial_fee_satoshi);
+	towire_u16(&p, local_scriptpubkey_len);
+	towire_u8_array(&p, local_scriptpubkey, local_scriptpubkey_len);
+	towire_u16(&p, remote_scriptpubkey_len);
+	towire_u8_array(&p, remote_scriptpubkey, remote_scriptpubkey_len);
+	towire_bool(&p, reconnected);
+	towire_u64(&p, next_index_local);
+	towire_u64(&p, next_index_remote);
+	towire_u64(&p, revocations_received);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_closing_received_signature(const tal_t *ctx, const secp256k1_ecdsa_signature *signature, const struct bitcoin_tx *tx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CLOSING_RECEIVED_SIGNATURE);
+	towire_secp256k1_ecdsa_signature(&p, signature);
+	towire_bitcoin_tx(&p, tx);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_closing_received_signature_reply(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CLOSING_RECEIVED_SIGNATURE_REPLY);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_closing_complete(const tal_t *ctx, u64 gossip_index)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CLOSING_COMPLETE);
+	towire_u64(&p, gossip_index);
+
+	return memcheck(p, tal_count(p));
+}
+
+
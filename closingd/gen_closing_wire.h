@@ -0,0 +1,39 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#ifndef LIGHTNING_CLOSINGD_GEN_CLOSING_WIRE_H
+#define LIGHTNING_CLOSINGD_GEN_CLOSING_WIRE_H
+#include <ccan/tal/tal.h>
+#include <wire/wire.h>
+#include <common/cryptomsg.h>
+
+#include <common/htlc_wire.h>
+
+enum closing_wire_type {
+	/* Begin!  (passes peer fd, gossipd-client fd) */
+	WIRE_CLOSING_INIT = 2001,
+	/* We received an offer, save signature. */
+	WIRE_CLOSING_RECEIVED_SIGNATURE = 2002,
+	WIRE_CLOSING_RECEIVED_SIGNATURE_REPLY = 2102,
+	/* Negotiations complete, we're exiting. */
+	WIRE_CLOSING_COMPLETE = 2004,
+};
+const char *closing_wire_type_name(int e);
+
+bool fromwire_closing_init(const tal_t *ctx, const void *p, size_t *plen, struct crypto_state *crypto_state, u64 *gossip_index, struct privkey *seed, struct bitcoin_txid *funding_txid, u16 *funding_txout, u64 *funding_satoshi, struct pubkey *remote_fundingkey, enum side *funder, u64 *local_msatoshi, u64 *remote_msatoshi, u64 *our_dust_limit, u64 *min_fee_satoshi, u64 *max_fee_satoshi, u64 *initial_fee_satoshi, u8 **local_scriptpubkey, u8 **remote_scriptpubkey, bool *reconnected, u64 *next_index_local, u64 *next_index_remote, u64 *revocations_received);
+
+bool fromwire_closing_received_signature(const void *p, size_t *plen, secp256k1_ecdsa_signature *signature, struct bitcoin_tx *tx);
+
+bool fromwire_closing_received_signature_reply(const void *p, size_t *plen);
+
+bool fromwire_closing_complete(const void *p, size_t *plen, u64 *gossip_index);
+
+u8 *towire_closing_init(const tal_t *ctx, const struct crypto_state *crypto_state, u64 gossip_index, const struct privkey *seed, const struct bitcoin_txid *funding_txid, u16 funding_txout, u64 funding_satoshi, const struct pubkey *remote_fundingkey, enum side funder, u64 local_msatoshi, u64 remote_msatoshi, u64 our_dust_limit, u64 min_fee_satoshi, u64 max_fee_satoshi, u64 initial_fee_satoshi, const u8 *local_scriptpubkey, const u8 *remote_scriptpubkey, bool reconnected, u64 next_index_local, u64 next_index_remote, u64 revocations_received);
+
+u8 *towire_closing_received_signature(const tal_t *ctx, const secp256k1_ecdsa_signature *signature, const struct bitcoin_tx *tx);
+
+u8 *towire_closing_received_signature_reply(const tal_t *ctx);
+
+u8 *towire_closing_complete(const tal_t *ctx, u64 gossip_index);
+
+#endif /* LIGHTNING_CLOSINGD_GEN_CLOSING_WIRE_H */
+
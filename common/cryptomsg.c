@@ -241,17 +241,19 @@ static struct io_plan *peer_write_done(struct io_conn *conn,
 	return pcs->next_out(conn, pcs->peer);
 }
 
-u8 *cryptomsg_encrypt_msg(const tal_t *ctx,
-			  struct crypto_state *cs,
-			  const u8 *msg TAKES)
+/* How many bytes does msg take once encrypted? */
+static size_t encrypted_len(const u8 *msg)
+{
+	return sizeof(be16) + 16 + tal_count(msg) + 16;
+}
+
+/* Encrypt msg into out, which has room for encrypted_len(msg) bytes. */
+static void encrypt_msg_into(struct crypto_state *cs, const u8 *msg, u8 *out)
 {
 	unsigned char npub[crypto_aead_chacha20poly1305_ietf_NPUBBYTES];
 	unsigned long long clen, mlen = tal_count(msg);
 	be16 l;
 	int ret;
-	u8 *out;
-
-	out = tal_arr(ctx, u8, sizeof(l) + 16 + mlen + 16);
 
 	/* BOLT #8:
 	 *
@@ -320,6 +322,15 @@ u8 *cryptomsg_encrypt_msg(const tal_t *ctx,
 #endif
 
 	maybe_rotate_key(&cs->sn, &cs->sk, &cs->s_ck);
+}
+
+u8 *cryptomsg_encrypt_msg(const tal_t *ctx,
+			  struct crypto_state *cs,
+			  const u8 *msg TAKES)
+{
+	u8 *out = tal_arr(ctx, u8, encrypted_len(msg));
+
+	encrypt_msg_into(cs, msg, out);
 
 	if (taken(msg))
 		tal_free(msg);
@@ -378,6 +389,61 @@ struct io_plan *peer_write_message(struct io_conn *conn,
 	return io_write(conn, pcs->out, tal_count(pcs->out), post, pcs);
 }
 
+struct io_plan *peer_write_messages(struct io_conn *conn,
+				    struct peer_crypto_state *pcs,
+				    const u8 **msgs,
+				    struct io_plan *(*next)(struct io_conn *,
+							    struct peer *))
+{
+	struct io_plan *(*post)(struct io_conn *, struct peer_crypto_state *);
+	size_t i, num = tal_count(msgs), len = 0;
+
+	assert(!pcs->out);
+
+	post = peer_write_done;
+
+#if DEVELOPER
+	/* A dev_disconnect cuts the batch short at the message it hits. */
+	for (i = 0; i < num; i++) {
+		switch (dev_disconnect(fromwire_peektype(msgs[i]))) {
+		case DEV_DISCONNECT_NORMAL:
+			continue;
+		case DEV_DISCONNECT_BEFORE:
+			dev_sabotage_fd(io_conn_fd(conn));
+			num = i + 1;
+			break;
+		case DEV_DISCONNECT_DROPPKT:
+			post = peer_write_postclose;
+			num = i;
+			break;
+		case DEV_DISCONNECT_AFTER:
+			post = peer_write_postclose;
+			num = i + 1;
+			break;
+		case DEV_DISCONNECT_BLACKHOLE:
+			dev_blackhole_fd(io_conn_fd(conn));
+			num = i + 1;
+			break;
+		}
+		break;
+	}
+#endif /* DEVELOPER */
+
+	for (i = 0; i < num; i++)
+		len += encrypted_len(msgs[i]);
+
+	/* Encrypt them all back-to-back, so they go out in one write. */
+	pcs->out = tal_arr(conn, u8, len);
+	pcs->next_out = next;
+	len = 0;
+	for (i = 0; i < num; i++) {
+		encrypt_msg_into(&pcs->cs, msgs[i], pcs->out + len);
+		len += encrypted_len(msgs[i]);
+	}
+
+	return io_write(conn, pcs->out, tal_count(pcs->out), post, pcs);
+}
+
 /* We write in one op, so it's all or nothing. */
 bool peer_out_started(const struct io_conn *conn,
 		      const struct peer_crypto_state *cs)
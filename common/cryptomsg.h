@@ -46,6 +46,14 @@ struct io_plan *peer_write_message(struct io_conn *conn,
 				   struct io_plan *(*next)(struct io_conn *,
 							   struct peer *));
 
+/* Sends several messages, encrypted back-to-back into a single write:
+ * does not take msgs or their elements. */
+struct io_plan *peer_write_messages(struct io_conn *conn,
+				    struct peer_crypto_state *cs,
+				    const u8 **msgs,
+				    struct io_plan *(*next)(struct io_conn *,
+							    struct peer *));
+
 /* Low-level functions for sync comms: doesn't discard unknowns! */
 u8 *cryptomsg_encrypt_msg(const tal_t *ctx,
 			  struct crypto_state *cs,
@@ -0,0 +1,3 @@
+#define VERSION "3c9cf46-dirty"
+#define VERSION_NAME "Bitcoin Savings & Trust Daily Interest II"
+#define BUILD_FEATURES ""
@@ -1,10 +1,43 @@
+#include <ccan/crypto/siphash24/siphash24.h>
 #include <ccan/mem/mem.h>
+#include <common/pseudorand.h>
 #include <gossipd/broadcast.h>
 
+const struct queued_message *broadcast_map_keyof_msg(const struct queued_message *msg)
+{
+	return msg;
+}
+
+size_t broadcast_map_hash_key(const struct queued_message *key)
+{
+	struct siphash24_ctx ctx;
+
+	siphash24_init(&ctx, siphash_seed());
+	siphash24_u32(&ctx, key->type);
+	siphash24_update(&ctx, key->tag, tal_len(key->tag));
+	return siphash24_done(&ctx);
+}
+
+bool broadcast_map_msg_eq(const struct queued_message *msg,
+		      const struct queued_message *key)
+{
+	return msg->type == key->type
+		&& memeq(msg->tag, tal_len(msg->tag),
+			 key->tag, tal_len(key->tag));
+}
+
+static void destroy_broadcast_state(struct broadcast_state *bstate)
+{
+	broadcast_map_clear(bstate->by_tag);
+}
+
 struct broadcast_state *new_broadcast_state(tal_t *ctx)
 {
 	struct broadcast_state *bstate = tal(ctx, struct broadcast_state);
 	uintmap_init(&bstate->broadcasts);
+	bstate->by_tag = tal(bstate, struct broadcast_map);
+	broadcast_map_init(bstate->by_tag);
+	tal_add_destructor(bstate, destroy_broadcast_state);
 	/* Skip 0 because we initialize peers with 0 */
 	bstate->next_index = 1;
 	return bstate;
@@ -27,27 +60,27 @@ bool queue_broadcast(struct broadcast_state *bstate,
 		     const u8 *tag,
 		     const u8 *payload)
 {
-	struct queued_message *msg;
-	u64 index;
+	struct queued_message *msg, key;
 	bool evicted = false;
 
 	memcheck(tag, tal_len(tag));
 
 	/* Remove any tag&type collisions */
-	for (msg = uintmap_first(&bstate->broadcasts, &index);
-	     msg;
-	     msg = uintmap_after(&bstate->broadcasts, &index)) {
-		if (msg->type == type && memcmp(msg->tag, tag, tal_len(tag)) == 0) {
-			uintmap_del(&bstate->broadcasts, index);
-			tal_free(msg);
-			evicted = true;
-			break;
-		}
+	key.type = type;
+	key.tag = (void *)tag;
+	msg = broadcast_map_get(bstate->by_tag, &key);
+	if (msg) {
+		broadcast_map_del(bstate->by_tag, msg);
+		uintmap_del(&bstate->broadcasts, msg->index);
+		tal_free(msg);
+		evicted = true;
 	}
 
 	/* Now add the message to the queue */
 	msg = new_queued_message(bstate, type, tag, payload);
-	uintmap_add(&bstate->broadcasts, bstate->next_index, msg);
+	msg->index = bstate->next_index;
+	uintmap_add(&bstate->broadcasts, msg->index, msg);
+	broadcast_map_add(bstate->by_tag, msg);
 	bstate->next_index += 1;
 	return evicted;
 }
@@ -2,6 +2,7 @@
 #define LIGHTNING_LIGHTNINGD_GOSSIP_BROADCAST_H
 #include "config.h"
 
+#include <ccan/htable/htable_type.h>
 #include <ccan/intmap/intmap.h>
 #include <ccan/list/list.h>
 #include <ccan/short_types/short_types.h>
@@ -17,11 +18,24 @@ struct queued_message {
 
 	/* Serialized payload */
 	u8 *payload;
+
+	/* Where we are in bstate->broadcasts */
+	u64 index;
 };
 
+/* (type, tag) is the key, so we can find what a new message replaces. */
+const struct queued_message *broadcast_map_keyof_msg(const struct queued_message *msg);
+size_t broadcast_map_hash_key(const struct queued_message *key);
+bool broadcast_map_msg_eq(const struct queued_message *msg,
+		      const struct queued_message *key);
+HTABLE_DEFINE_TYPE(struct queued_message, broadcast_map_keyof_msg, broadcast_map_hash_key, broadcast_map_msg_eq, broadcast_map);
+
 struct broadcast_state {
-u32 next_index;
-UINTMAP(struct queued_message *) broadcasts;
+	u32 next_index;
+	UINTMAP(struct queued_message *) broadcasts;
+
+	/* The same messages, by type and tag. */
+	struct broadcast_map *by_tag;
 };
 
 struct broadcast_state *new_broadcast_state(tal_t *ctx);
@@ -0,0 +1,1124 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#include <gossipd/gen_gossip_wire.h>
+#include <ccan/mem/mem.h>
+#include <ccan/tal/str/str.h>
+#include <stdio.h>
+
+const char *gossip_wire_type_name(int e)
+{
+	static char invalidbuf[sizeof("INVALID ") + STR_MAX_CHARS(e)];
+
+	switch ((enum gossip_wire_type)e) {
+	case WIRE_GOSSIPCTL_INIT: return "WIRE_GOSSIPCTL_INIT";
+	case WIRE_GOSSIPCTL_PEER_ADDRHINT: return "WIRE_GOSSIPCTL_PEER_ADDRHINT";
+	case WIRE_GOSSIPCTL_REACH_PEER: return "WIRE_GOSSIPCTL_REACH_PEER";
+	case WIRE_GOSSIP_PEER_CONNECTED: return "WIRE_GOSSIP_PEER_CONNECTED";
+	case WIRE_GOSSIP_PEER_ALREADY_CONNECTED: return "WIRE_GOSSIP_PEER_ALREADY_CONNECTED";
+	case WIRE_GOSSIP_PEER_NONGOSSIP: return "WIRE_GOSSIP_PEER_NONGOSSIP";
+	case WIRE_GOSSIPCTL_RELEASE_PEER: return "WIRE_GOSSIPCTL_RELEASE_PEER";
+	case WIRE_GOSSIPCTL_RELEASE_PEER_REPLY: return "WIRE_GOSSIPCTL_RELEASE_PEER_REPLY";
+	case WIRE_GOSSIPCTL_RELEASE_PEER_REPLYFAIL: return "WIRE_GOSSIPCTL_RELEASE_PEER_REPLYFAIL";
+	case WIRE_GOSSIPCTL_HAND_BACK_PEER: return "WIRE_GOSSIPCTL_HAND_BACK_PEER";
+	case WIRE_GOSSIP_GETNODES_REQUEST: return "WIRE_GOSSIP_GETNODES_REQUEST";
+	case WIRE_GOSSIP_GETNODES_REPLY: return "WIRE_GOSSIP_GETNODES_REPLY";
+	case WIRE_GOSSIP_GETROUTE_REQUEST: return "WIRE_GOSSIP_GETROUTE_REQUEST";
+	case WIRE_GOSSIP_GETROUTE_REPLY: return "WIRE_GOSSIP_GETROUTE_REPLY";
+	case WIRE_GOSSIP_GETCHANNELS_REQUEST: return "WIRE_GOSSIP_GETCHANNELS_REQUEST";
+	case WIRE_GOSSIP_GETCHANNELS_REPLY: return "WIRE_GOSSIP_GETCHANNELS_REPLY";
+	case WIRE_GOSSIP_PING: return "WIRE_GOSSIP_PING";
+	case WIRE_GOSSIP_PING_REPLY: return "WIRE_GOSSIP_PING_REPLY";
+	case WIRE_GOSSIP_RESOLVE_CHANNEL_REQUEST: return "WIRE_GOSSIP_RESOLVE_CHANNEL_REQUEST";
+	case WIRE_GOSSIP_RESOLVE_CHANNEL_REPLY: return "WIRE_GOSSIP_RESOLVE_CHANNEL_REPLY";
+	case WIRE_GOSSIP_GETPEERS_REQUEST: return "WIRE_GOSSIP_GETPEERS_REQUEST";
+	case WIRE_GOSSIP_GETPEERS_REPLY: return "WIRE_GOSSIP_GETPEERS_REPLY";
+	case WIRE_GOSSIP_GET_UPDATE: return "WIRE_GOSSIP_GET_UPDATE";
+	case WIRE_GOSSIP_GET_UPDATE_REPLY: return "WIRE_GOSSIP_GET_UPDATE_REPLY";
+	case WIRE_GOSSIP_SEND_GOSSIP: return "WIRE_GOSSIP_SEND_GOSSIP";
+	case WIRE_GOSSIP_LOCAL_ADD_CHANNEL: return "WIRE_GOSSIP_LOCAL_ADD_CHANNEL";
+	case WIRE_GOSSIP_GET_TXOUT: return "WIRE_GOSSIP_GET_TXOUT";
+	case WIRE_GOSSIP_GET_TXOUT_REPLY: return "WIRE_GOSSIP_GET_TXOUT_REPLY";
+	}
+
+	sprintf(invalidbuf, "INVALID %i", e);
+	return invalidbuf;
+}
+
+bool fromwire_gossipctl_init(const tal_t *ctx, const void *p, size_t *plen, u32 *broadcast_interval, struct bitcoin_blkid *chain_hash, struct pubkey *id, u16 *port, u8 **gfeatures, u8 **lfeatures, struct wireaddr **wireaddrs, u8 rgb[3], u8 alias[32], u32 *update_channel_interval)
+{
+	u16 gflen;
+	u16 lflen;
+	u16 num_wireaddrs;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIPCTL_INIT)
+		return false;
+	//3th case broadcast_interval
+	*broadcast_interval = fromwire_u32(&cursor, plen);
+	//4th case chain_hash
+	fromwire_bitcoin_blkid(&cursor, plen, chain_hash);
+	//4th case id
+	fromwire_pubkey(&cursor, plen, id);
+	/* If non-zero, port to listen on. */
+	//3th case port
+	*port = fromwire_u16(&cursor, plen);
+	//3th case gflen
+	gflen = fromwire_u16(&cursor, plen);
+	//2nd case gfeatures
+	*gfeatures = gflen ? tal_arr(ctx, u8, gflen) : NULL;
+	fromwire_u8_array(&cursor, plen, *gfeatures, gflen);
+	//3th case lflen
+	lflen = fromwire_u16(&cursor, plen);
+	//2nd case lfeatures
+	*lfeatures = lflen ? tal_arr(ctx, u8, lflen) : NULL;
+	fromwire_u8_array(&cursor, plen, *lfeatures, lflen);
+	//3th case num_wireaddrs
+	num_wireaddrs = fromwire_u16(&cursor, plen);
+	//2nd case wireaddrs
+	*wireaddrs = num_wireaddrs ? tal_arr(ctx, struct wireaddr, num_wireaddrs) : NULL;
+	for (size_t i = 0; i < num_wireaddrs; i++)
+		fromwire_wireaddr(&cursor, plen, *wireaddrs + i);
+	fromwire_u8_array(&cursor, plen, rgb, 3);
+	fromwire_u8_array(&cursor, plen, alias, 32);
+	//3th case update_channel_interval
+	*update_channel_interval = fromwire_u32(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_gossipctl_peer_addrhint(const void *p, size_t *plen, struct pubkey *id, struct wireaddr *addr)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIPCTL_PEER_ADDRHINT)
+		return false;
+	//4th case id
+	fromwire_pubkey(&cursor, plen, id);
+	//4th case addr
+	fromwire_wireaddr(&cursor, plen, addr);
+	return cursor != NULL;
+}
+
+bool fromwire_gossipctl_reach_peer(const void *p, size_t *plen, struct pubkey *id)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIPCTL_REACH_PEER)
+		return false;
+	//4th case id
+	fromwire_pubkey(&cursor, plen, id);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_peer_connected(const tal_t *ctx, const void *p, size_t *plen, struct pubkey *id, struct wireaddr *addr, struct crypto_state *crypto_state, u64 *gossip_index, u8 **gfeatures, u8 **lfeatures)
+{
+	u16 gflen;
+	u16 lflen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_PEER_CONNECTED)
+		return false;
+	//4th case id
+	fromwire_pubkey(&cursor, plen, id);
+	//4th case addr
+	fromwire_wireaddr(&cursor, plen, addr);
+	//4th case crypto_state
+	fromwire_crypto_state(&cursor, plen, crypto_state);
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	//3th case gflen
+	gflen = fromwire_u16(&cursor, plen);
+	//2nd case gfeatures
+	*gfeatures = gflen ? tal_arr(ctx, u8, gflen) : NULL;
+	fromwire_u8_array(&cursor, plen, *gfeatures, gflen);
+	//3th case lflen
+	lflen = fromwire_u16(&cursor, plen);
+	//2nd case lfeatures
+	*lfeatures = lflen ? tal_arr(ctx, u8, lflen) : NULL;
+	fromwire_u8_array(&cursor, plen, *lfeatures, lflen);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_peer_already_connected(const void *p, size_t *plen, struct pubkey *id)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_PEER_ALREADY_CONNECTED)
+		return false;
+	//4th case id
+	fromwire_pubkey(&cursor, plen, id);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_peer_nongossip(const tal_t *ctx, const void *p, size_t *plen, struct pubkey *id, struct wireaddr *addr, struct crypto_state *crypto_state, u64 *gossip_index, u8 **gfeatures, u8 **lfeatures, u8 **msg)
+{
+	u16 gflen;
+	u16 lflen;
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_PEER_NONGOSSIP)
+		return false;
+	//4th case id
+	fromwire_pubkey(&cursor, plen, id);
+	//4th case addr
+	fromwire_wireaddr(&cursor, plen, addr);
+	//4th case crypto_state
+	fromwire_crypto_state(&cursor, plen, crypto_state);
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	//3th case gflen
+	gflen = fromwire_u16(&cursor, plen);
+	//2nd case gfeatures
+	*gfeatures = gflen ? tal_arr(ctx, u8, gflen) : NULL;
+	fromwire_u8_array(&cursor, plen, *gfeatures, gflen);
+	//3th case lflen
+	lflen = fromwire_u16(&cursor, plen);
+	//2nd case lfeatures
+	*lfeatures = lflen ? tal_arr(ctx, u8, lflen) : NULL;
+	fromwire_u8_array(&cursor, plen, *lfeatures, lflen);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case msg
+	*msg = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *msg, len);
+	return cursor != NULL;
+}
+
+bool fromwire_gossipctl_release_peer(const void *p, size_t *plen, struct pubkey *id)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIPCTL_RELEASE_PEER)
+		return false;
+	//4th case id
+	fromwire_pubkey(&cursor, plen, id);
+	return cursor != NULL;
+}
+
+bool fromwire_gossipctl_release_peer_reply(const tal_t *ctx, const void *p, size_t *plen, struct wireaddr *addr, struct crypto_state *crypto_state, u64 *gossip_index, u8 **gfeatures, u8 **lfeatures)
+{
+	u16 gflen;
+	u16 lflen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIPCTL_RELEASE_PEER_REPLY)
+		return false;
+	//4th case addr
+	fromwire_wireaddr(&cursor, plen, addr);
+	//4th case crypto_state
+	fromwire_crypto_state(&cursor, plen, crypto_state);
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	//3th case gflen
+	gflen = fromwire_u16(&cursor, plen);
+	//2nd case gfeatures
+	*gfeatures = gflen ? tal_arr(ctx, u8, gflen) : NULL;
+	fromwire_u8_array(&cursor, plen, *gfeatures, gflen);
+	//3th case lflen
+	lflen = fromwire_u16(&cursor, plen);
+	//2nd case lfeatures
+	*lfeatures = lflen ? tal_arr(ctx, u8, lflen) : NULL;
+	fromwire_u8_array(&cursor, plen, *lfeatures, lflen);
+	return cursor != NULL;
+}
+
+bool fromwire_gossipctl_release_peer_replyfail(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIPCTL_RELEASE_PEER_REPLYFAIL)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_gossipctl_hand_back_peer(const tal_t *ctx, const void *p, size_t *plen, struct pubkey *id, struct crypto_state *crypto_state, u64 *gossip_index, u8 **msg)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIPCTL_HAND_BACK_PEER)
+		return false;
+	//4th case id
+	fromwire_pubkey(&cursor, plen, id);
+	//4th case crypto_state
+	fromwire_crypto_state(&cursor, plen, crypto_state);
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case msg
+	*msg = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *msg, len);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_getnodes_request(const tal_t *ctx, const void *p, size_t *plen, struct pubkey **ids, struct pubkey **firsts, u16 *limit)
+{
+	u16 num_ids;
+	u16 num_firsts;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_GETNODES_REQUEST)
+		return false;
+	//3th case num_ids
+	num_ids = fromwire_u16(&cursor, plen);
+	//2nd case ids
+	*ids = num_ids ? tal_arr(ctx, struct pubkey, num_ids) : NULL;
+	for (size_t i = 0; i < num_ids; i++)
+		fromwire_pubkey(&cursor, plen, *ids + i);
+	//3th case num_firsts
+	num_firsts = fromwire_u16(&cursor, plen);
+	//2nd case firsts
+	*firsts = num_firsts ? tal_arr(ctx, struct pubkey, num_firsts) : NULL;
+	for (size_t i = 0; i < num_firsts; i++)
+		fromwire_pubkey(&cursor, plen, *firsts + i);
+	//3th case limit
+	*limit = fromwire_u16(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_getnodes_reply(const tal_t *ctx, const void *p, size_t *plen, struct pubkey **nexts, struct gossip_getnodes_entry **nodes)
+{
+	u16 num_nexts;
+	u16 num_nodes;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_GETNODES_REPLY)
+		return false;
+	//3th case num_nexts
+	num_nexts = fromwire_u16(&cursor, plen);
+	//2nd case nexts
+	*nexts = num_nexts ? tal_arr(ctx, struct pubkey, num_nexts) : NULL;
+	for (size_t i = 0; i < num_nexts; i++)
+		fromwire_pubkey(&cursor, plen, *nexts + i);
+	//3th case num_nodes
+	num_nodes = fromwire_u16(&cursor, plen);
+	//2nd case nodes
+	*nodes = num_nodes ? tal_arr(ctx, struct gossip_getnodes_entry, num_nodes) : NULL;
+	for (size_t i = 0; i < num_nodes; i++)
+		fromwire_gossip_getnodes_entry(ctx, &cursor, plen, *nodes + i);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_getroute_request(const void *p, size_t *plen, struct pubkey *source, struct pubkey *destination, u32 *msatoshi, u16 *riskfactor, u32 *final_cltv)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_GETROUTE_REQUEST)
+		return false;
+	//4th case source
+	fromwire_pubkey(&cursor, plen, source);
+	//4th case destination
+	fromwire_pubkey(&cursor, plen, destination);
+	//3th case msatoshi
+	*msatoshi = fromwire_u32(&cursor, plen);
+	//3th case riskfactor
+	*riskfactor = fromwire_u16(&cursor, plen);
+	//3th case final_cltv
+	*final_cltv = fromwire_u32(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_getroute_reply(const tal_t *ctx, const void *p, size_t *plen, struct route_hop **hops)
+{
+	u16 num_hops;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_GETROUTE_REPLY)
+		return false;
+	//3th case num_hops
+	num_hops = fromwire_u16(&cursor, plen);
+	//2nd case hops
+	*hops = num_hops ? tal_arr(ctx, struct route_hop, num_hops) : NULL;
+	for (size_t i = 0; i < num_hops; i++)
+		fromwire_route_hop(&cursor, plen, *hops + i);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_getchannels_request(const tal_t *ctx, const void *p, size_t *plen, struct pubkey **sources, bool *active_only, struct short_channel_id *first, struct short_channel_id *last, u16 *limit)
+{
+	u16 num_sources;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_GETCHANNELS_REQUEST)
+		return false;
+	//3th case num_sources
+	num_sources = fromwire_u16(&cursor, plen);
+	//2nd case sources
+	*sources = num_sources ? tal_arr(ctx, struct pubkey, num_sources) : NULL;
+	for (size_t i = 0; i < num_sources; i++)
+		fromwire_pubkey(&cursor, plen, *sources + i);
+	//3th case active_only
+	*active_only = fromwire_bool(&cursor, plen);
+	//4th case first
+	fromwire_short_channel_id(&cursor, plen, first);
+	//4th case last
+	fromwire_short_channel_id(&cursor, plen, last);
+	//3th case limit
+	*limit = fromwire_u16(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_getchannels_reply(const tal_t *ctx, const void *p, size_t *plen, bool *more, struct short_channel_id *next, struct gossip_getchannels_entry **nodes)
+{
+	u16 num_channels;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_GETCHANNELS_REPLY)
+		return false;
+	//3th case more
+	*more = fromwire_bool(&cursor, plen);
+	//4th case next
+	fromwire_short_channel_id(&cursor, plen, next);
+	//3th case num_channels
+	num_channels = fromwire_u16(&cursor, plen);
+	//2nd case nodes
+	*nodes = num_channels ? tal_arr(ctx, struct gossip_getchannels_entry, num_channels) : NULL;
+	for (size_t i = 0; i < num_channels; i++)
+		fromwire_gossip_getchannels_entry(&cursor, plen, *nodes + i);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_ping(const void *p, size_t *plen, struct pubkey *id, u16 *num_pong_bytes, u16 *len)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_PING)
+		return false;
+	//4th case id
+	fromwire_pubkey(&cursor, plen, id);
+	//3th case num_pong_bytes
+	*num_pong_bytes = fromwire_u16(&cursor, plen);
+	//3th case len
+	*len = fromwire_u16(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_ping_reply(const void *p, size_t *plen, bool *sent, u16 *totlen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_PING_REPLY)
+		return false;
+	/* False if id in gossip_ping was unknown. */
+	//3th case sent
+	*sent = fromwire_bool(&cursor, plen);
+	/* 0 == no pong expected */
+	//3th case totlen
+	*totlen = fromwire_u16(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_resolve_channel_request(const void *p, size_t *plen, struct short_channel_id *channel_id)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_RESOLVE_CHANNEL_REQUEST)
+		return false;
+	//4th case channel_id
+	fromwire_short_channel_id(&cursor, plen, channel_id);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_resolve_channel_reply(const tal_t *ctx, const void *p, size_t *plen, struct pubkey **keys)
+{
+	u16 num_keys;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_RESOLVE_CHANNEL_REPLY)
+		return false;
+	//3th case num_keys
+	num_keys = fromwire_u16(&cursor, plen);
+	//2nd case keys
+	*keys = num_keys ? tal_arr(ctx, struct pubkey, num_keys) : NULL;
+	for (size_t i = 0; i < num_keys; i++)
+		fromwire_pubkey(&cursor, plen, *keys + i);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_getpeers_request(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_GETPEERS_REQUEST)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_getpeers_reply(const tal_t *ctx, const void *p, size_t *plen, struct pubkey **id, struct wireaddr **addr)
+{
+	u16 num;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_GETPEERS_REPLY)
+		return false;
+	//3th case num
+	num = fromwire_u16(&cursor, plen);
+	//2nd case id
+	*id = num ? tal_arr(ctx, struct pubkey, num) : NULL;
+	for (size_t i = 0; i < num; i++)
+		fromwire_pubkey(&cursor, plen, *id + i);
+	//2nd case addr
+	*addr = num ? tal_arr(ctx, struct wireaddr, num) : NULL;
+	for (size_t i = 0; i < num; i++)
+		fromwire_wireaddr(&cursor, plen, *addr + i);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_get_update(const void *p, size_t *plen, struct short_channel_id *short_channel_id)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_GET_UPDATE)
+		return false;
+	//4th case short_channel_id
+	fromwire_short_channel_id(&cursor, plen, short_channel_id);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_get_update_reply(const tal_t *ctx, const void *p, size_t *plen, u8 **update)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_GET_UPDATE_REPLY)
+		return false;
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case update
+	*update = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *update, len);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_send_gossip(const tal_t *ctx, const void *p, size_t *plen, u64 *gossip_index, u8 **gossip)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_SEND_GOSSIP)
+		return false;
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case gossip
+	*gossip = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *gossip, len);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_local_add_channel(const void *p, size_t *plen, struct short_channel_id *short_channel_id, struct bitcoin_blkid *chain_hash, struct pubkey *remote_node_id, u16 *flags, u16 *cltv_expiry_delta, u64 *htlc_minimum_msat, u32 *fee_base_msat, u32 *fee_proportional_millionths)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_LOCAL_ADD_CHANNEL)
+		return false;
+	//4th case short_channel_id
+	fromwire_short_channel_id(&cursor, plen, short_channel_id);
+	//4th case chain_hash
+	fromwire_bitcoin_blkid(&cursor, plen, chain_hash);
+	//4th case remote_node_id
+	fromwire_pubkey(&cursor, plen, remote_node_id);
+	//3th case flags
+	*flags = fromwire_u16(&cursor, plen);
+	//3th case cltv_expiry_delta
+	*cltv_expiry_delta = fromwire_u16(&cursor, plen);
+	//3th case htlc_minimum_msat
+	*htlc_minimum_msat = fromwire_u64(&cursor, plen);
+	//3th case fee_base_msat
+	*fee_base_msat = fromwire_u32(&cursor, plen);
+	//3th case fee_proportional_millionths
+	*fee_proportional_millionths = fromwire_u32(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_get_txout(const void *p, size_t *plen, struct short_channel_id *short_channel_id)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_GET_TXOUT)
+		return false;
+	//4th case short_channel_id
+	fromwire_short_channel_id(&cursor, plen, short_channel_id);
+	return cursor != NULL;
+}
+
+bool fromwire_gossip_get_txout_reply(const tal_t *ctx, const void *p, size_t *plen, struct short_channel_id *short_channel_id, u8 **outscript)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_GOSSIP_GET_TXOUT_REPLY)
+		return false;
+	//4th case short_channel_id
+	fromwire_short_channel_id(&cursor, plen, short_channel_id);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case outscript
+	*outscript = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *outscript, len);
+	return cursor != NULL;
+}
+
+u8 *towire_gossipctl_init(const tal_t *ctx, u32 broadcast_interval, const struct bitcoin_blkid *chain_hash, const struct pubkey *id, u16 port, const u8 *gfeatures, const u8 *lfeatures, const struct wireaddr *wireaddrs, const u8 rgb[3], const u8 alias[32], u32 update_channel_interval)
+{
+	u16 gflen = tal_count(gfeatures);
+	u16 lflen = tal_count(lfeatures);
+	u16 num_wireaddrs = tal_count(wireaddrs);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIPCTL_INIT);
+	towire_u32(&p, broadcast_interval);
+	towire_bitcoin_blkid(&p, chain_hash);
+	towire_pubkey(&p, id);
+	/* If non-zero, port to listen on. */
+	towire_u16(&p, port);
+	towire_u16(&p, gflen);
+	towire_u8_array(&p, gfeatures, gflen);
+	towire_u16(&p, lflen);
+	towire_u8_array(&p, lfeatures, lflen);
+	towire_u16(&p, num_wireaddrs);
+	for (size_t i = 0; i < num_wireaddrs; i++)
+
+		towire_wireaddr(&p, wireaddrs + i);
+	towire_u8_array(&p, rgb, 3);
+	towire_u8_array(&p, alias, 32);
+	towire_u32(&p, update_channel_interval);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossipctl_peer_addrhint(const tal_t *ctx, const struct pubkey *id, const struct wireaddr *addr)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIPCTL_PEER_ADDRHINT);
+	towire_pubkey(&p, id);
+	towire_wireaddr(&p, addr);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossipctl_reach_peer(const tal_t *ctx, const struct pubkey *id)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIPCTL_REACH_PEER);
+	towire_pubkey(&p, id);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_peer_connected(const tal_t *ctx, const struct pubkey *id, const struct wireaddr *addr, const struct crypto_state *crypto_state, u64 gossip_index, const u8 *gfeatures, const u8 *lfeatures)
+{
+	u16 gflen = tal_count(gfeatures);
+	u16 lflen = tal_count(lfeatures);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_PEER_CONNECTED);
+	towire_pubkey(&p, id);
+	towire_wireaddr(&p, addr);
+	towire_crypto_state(&p, crypto_state);
+	towire_u64(&p, gossip_index);
+	towire_u16(&p, gflen);
+	towire_u8_array(&p, gfeatures, gflen);
+	towire_u16(&p, lflen);
+	towire_u8_array(&p, lfeatures, lflen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_peer_already_connected(const tal_t *ctx, const struct pubkey *id)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_PEER_ALREADY_CONNECTED);
+	towire_pubkey(&p, id);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_peer_nongossip(const tal_t *ctx, const struct pubkey *id, const struct wireaddr *addr, const struct crypto_state *crypto_state, u64 gossip_index, const u8 *gfeatures, const u8 *lfeatures, const u8 *msg)
+{
+	u16 gflen = tal_count(gfeatures);
+	u16 lflen = tal_count(lfeatures);
+	u16 len = tal_count(msg);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_PEER_NONGOSSIP);
+	towire_pubkey(&p, id);
+	towire_wireaddr(&p, addr);
+	towire_crypto_state(&p, crypto_state);
+	towire_u64(&p, gossip_index);
+	towire_u16(&p, gflen);
+	towire_u8_array(&p, gfeatures, gflen);
+	towire_u16(&p, lflen);
+	towire_u8_array(&p, lfeatures, lflen);
+	towire_u16(&p, len);
+	towire_u8_array(&p, msg, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossipctl_release_peer(const tal_t *ctx, const struct pubkey *id)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIPCTL_RELEASE_PEER);
+	towire_pubkey(&p, id);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossipctl_release_peer_reply(const tal_t *ctx, const struct wireaddr *addr, const struct crypto_state *crypto_state, u64 gossip_index, const u8 *gfeatures, const u8 *lfeatures)
+{
+	u16 gflen = tal_count(gfeatures);
+	u16 lflen = tal_count(lfeatures);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIPCTL_RELEASE_PEER_REPLY);
+	towire_wireaddr(&p, addr);
+	towire_crypto_state(&p, crypto_state);
+	towire_u64(&p, gossip_index);
+	towire_u16(&p, gflen);
+	towire_u8_array(&p, gfeatures, gflen);
+	towire_u16(&p, lflen);
+	towire_u8_array(&p, lfeatures, lflen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossipctl_release_peer_replyfail(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIPCTL_RELEASE_PEER_REPLYFAIL);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossipctl_hand_back_peer(const tal_t *ctx, const struct pubkey *id, const struct crypto_state *crypto_state, u64 gossip_index, const u8 *msg)
+{
+	u16 len = tal_count(msg);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIPCTL_HAND_BACK_PEER);
+	towire_pubkey(&p, id);
+	towire_crypto_state(&p, crypto_state);
+	towire_u64(&p, gossip_index);
+	towire_u16(&p, len);
+	towire_u8_array(&p, msg, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_getnodes_request(const tal_t *ctx, const struct pubkey *ids, const struct pubkey *firsts, u16 limit)
+{
+	u16 num_ids = tal_count(ids);
+	u16 num_firsts = tal_count(firsts);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_GETNODES_REQUEST);
+	towire_u16(&p, num_ids);
+	for (size_t i = 0; i < num_ids; i++)
+
+		towire_pubkey(&p, ids + i);
+	towire_u16(&p, num_firsts);
+	for (size_t i = 0; i < num_firsts; i++)
+
+		towire_pubkey(&p, firsts + i);
+	towire_u16(&p, limit);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_getnodes_reply(const tal_t *ctx, const struct pubkey *nexts, const struct gossip_getnodes_entry *nodes)
+{
+	u16 num_nexts = tal_count(nexts);
+	u16 num_nodes = tal_count(nodes);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_GETNODES_REPLY);
+	towire_u16(&p, num_nexts);
+	for (size_t i = 0; i < num_nexts; i++)
+
+		towire_pubkey(&p, nexts + i);
+	towire_u16(&p, num_nodes);
+	for (size_t i = 0; i < num_nodes; i++)
+
+		towire_gossip_getnodes_entry(&p, nodes + i);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_getroute_request(const tal_t *ctx, const struct pubkey *source, const struct pubkey *destination, u32 msatoshi, u16 riskfactor, u32 final_cltv)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_GETROUTE_REQUEST);
+	towire_pubkey(&p, source);
+	towire_pubkey(&p, destination);
+	towire_u32(&p, msatoshi);
+	towire_u16(&p, riskfactor);
+	towire_u32(&p, final_cltv);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_getroute_reply(const tal_t *ctx, const struct route_hop *hops)
+{
+	u16 num_hops = tal_count(hops);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_GETROUTE_REPLY);
+	towire_u16(&p, num_hops);
+	for (size_t i = 0; i < num_hops; i++)
+
+		towire_route_hop(&p, hops + i);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_getchannels_request(const tal_t *ctx, const struct pubkey *sources, bool active_only, const struct short_channel_id *first, const struct short_channel_id *last, u16 limit)
+{
+	u16 num_sources = tal_count(sources);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_GETCHANNELS_REQUEST);
+	towire_u16(&p, num_sources);
+	for (size_t i = 0; i < num_sources; i++)
+
+		towire_pubkey(&p, sources + i);
+	towire_bool(&p, active_only);
+	towire_short_channel_id(&p, first);
+	towire_short_channel_id(&p, last);
+	towire_u16(&p, limit);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_getchannels_reply(const tal_t *ctx, bool more, const struct short_channel_id *next, const struct gossip_getchannels_entry *nodes)
+{
+	u16 num_channels = tal_count(nodes);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_GETCHANNELS_REPLY);
+	towire_bool(&p, more);
+	towire_short_channel_id(&p, next);
+	towire_u16(&p, num_channels);
+	for (size_t i = 0; i < num_channels; i++)
+
+		towire_gossip_getchannels_entry(&p, nodes + i);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_ping(const tal_t *ctx, const struct pubkey *id, u16 num_pong_bytes, u16 len)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_PING);
+	towire_pubkey(&p, id);
+	towire_u16(&p, num_pong_bytes);
+	towire_u16(&p, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_ping_reply(const tal_t *ctx, bool sent, u16 totlen)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_PING_REPLY);
+	/* False if id in gossip_ping was unknown. */
+	towire_bool(&p, sent);
+	/* 0 == no pong expected */
+	towire_u16(&p, totlen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_resolve_channel_request(const tal_t *ctx, const struct short_channel_id *channel_id)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_RESOLVE_CHANNEL_REQUEST);
+	towire_short_channel_id(&p, channel_id);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_resolve_channel_reply(const tal_t *ctx, const struct pubkey *keys)
+{
+	u16 num_keys = tal_count(keys);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_RESOLVE_CHANNEL_REPLY);
+	towire_u16(&p, num_keys);
+	for (size_t i = 0; i < num_keys; i++)
+
+		towire_pubkey(&p, keys + i);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_getpeers_request(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_GETPEERS_REQUEST);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_getpeers_reply(const tal_t *ctx, const struct pubkey *id, const struct wireaddr *addr)
+{
+	u16 num = tal_count(addr);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_GETPEERS_REPLY);
+	towire_u16(&p, num);
+	for (size_t i = 0; i < num; i++)
+
+		towire_pubkey(&p, id + i);
+	for (size_t i = 0; i < num; i++)
+
+		towire_wireaddr(&p, addr + i);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_get_update(const tal_t *ctx, const struct short_channel_id *short_channel_id)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_GET_UPDATE);
+	towire_short_channel_id(&p, short_channel_id);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_get_update_reply(const tal_t *ctx, const u8 *update)
+{
+	u16 len = tal_count(update);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_GET_UPDATE_REPLY);
+	towire_u16(&p, len);
+	towire_u8_array(&p, update, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_send_gossip(const tal_t *ctx, u64 gossip_index, const u8 *gossip)
+{
+	u16 len = tal_count(gossip);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_SEND_GOSSIP);
+	towire_u64(&p, gossip_index);
+	towire_u16(&p, len);
+	towire_u8_array(&p, gossip, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_local_add_channel(const tal_t *ctx, const struct short_channel_id *short_channel_id, const struct bitcoin_blkid *chain_hash, const struct pubkey *remote_node_id, u16 flags, u16 cltv_expiry_delta, u64 htlc_minimum_msat, u32 fee_base_msat, u32 fee_proportional_millionths)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_LOCAL_ADD_CHANNEL);
+	towire_short_channel_id(&p, short_channel_id);
+	towire_bitcoin_blkid(&p, chain_hash);
+	towire_pubkey(&p, remote_node_id);
+	towire_u16(&p, flags);
+	towire_u16(&p, cltv_expiry_delta);
+	towire_u64(&p, htlc_minimum_msat);
+	towire_u32(&p, fee_base_msat);
+	towire_u32(&p, fee_proportional_millionths);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_get_txout(const tal_t *ctx, const struct short_channel_id *short_channel_id)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_GET_TXOUT);
+	towire_short_channel_id(&p, short_channel_id);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_gossip_get_txout_reply(const tal_t *ctx, const struct short_channel_id *short_channel_id, const u8 *outscript)
+{
+	u16 len = tal_count(outscript);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_GOSSIP_GET_TXOUT_REPLY);
+	towire_short_channel_id(&p, short_channel_id);
+	towire_u16(&p, len);
+	towire_u8_array(&p, outscript, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+
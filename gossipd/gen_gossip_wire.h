@@ -0,0 +1,190 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#ifndef LIGHTNING_GOSSIPD_GEN_GOSSIP_WIRE_H
+#define LIGHTNING_GOSSIPD_GEN_GOSSIP_WIRE_H
+#include <ccan/tal/tal.h>
+#include <wire/wire.h>
+#include <common/cryptomsg.h>
+
+#include <common/wireaddr.h>
+
+#include <lightningd/gossip_msg.h>
+
+enum gossip_wire_type {
+	/* Initialize the gossip daemon. */
+	WIRE_GOSSIPCTL_INIT = 3000,
+	/* Master -> gossipd: Optional hint for where to find peer. */
+	WIRE_GOSSIPCTL_PEER_ADDRHINT = 3014,
+	/* Master -> gossipd: connect to a peer.  We may get a peer_connected or */
+	/* peer_already_connected */
+	WIRE_GOSSIPCTL_REACH_PEER = 3001,
+	/* Gossipd -> master: we got a peer. Two fds: peer and gossip */
+	WIRE_GOSSIP_PEER_CONNECTED = 3002,
+	/* Gossipd -> master: you asked to reach a peer, we already had. */
+	WIRE_GOSSIP_PEER_ALREADY_CONNECTED = 3015,
+	/* Gossipd -> master: peer sent non-gossip packet. Two fds: peer and gossip */
+	WIRE_GOSSIP_PEER_NONGOSSIP = 3003,
+	/* Master -> gossipd: release a peer (so we can open a channel) */
+	WIRE_GOSSIPCTL_RELEASE_PEER = 3004,
+	/* Gossipd -> master: reply to gossip_release_peer.  Two fds: peer and gossip. */
+	WIRE_GOSSIPCTL_RELEASE_PEER_REPLY = 3104,
+	/* Gossipd -> master:  reply to gossip_release_peer if we couldn't find the peer. */
+	WIRE_GOSSIPCTL_RELEASE_PEER_REPLYFAIL = 3204,
+	/* master -> gossipd: take back peer, with optional msg. (+peer fd, +gossip fd) */
+	WIRE_GOSSIPCTL_HAND_BACK_PEER = 3013,
+	/* Pass JSON-RPC getnodes call through */
+	/* Either just the node with id (if num_ids is 1), or up to limit nodes in */
+	/* id order, from first (if num_firsts is 1) or the start. */
+	WIRE_GOSSIP_GETNODES_REQUEST = 3005,
+	/* If there are more, num_nexts is 1: ask again with that as first. */
+	WIRE_GOSSIP_GETNODES_REPLY = 3105,
+	/* Pass JSON-RPC getroute call through */
+	WIRE_GOSSIP_GETROUTE_REQUEST = 3006,
+	WIRE_GOSSIP_GETROUTE_REPLY = 3106,
+	/* Channels with short_channel_id from first to last inclusive, optionally */
+	/* only those from source (if num_sources is 1) and/or active ones, up to */
+	/* limit short_channel_ids (each has up to two entries, one per direction). */
+	WIRE_GOSSIP_GETCHANNELS_REQUEST = 3007,
+	/* If more, ask again with first = next for the rest. */
+	WIRE_GOSSIP_GETCHANNELS_REPLY = 3107,
+	/* Ping/pong test.  Waits for a reply if it expects one. */
+	WIRE_GOSSIP_PING = 3008,
+	WIRE_GOSSIP_PING_REPLY = 3108,
+	/* Given a short_channel_id, return the endpoints */
+	WIRE_GOSSIP_RESOLVE_CHANNEL_REQUEST = 3009,
+	WIRE_GOSSIP_RESOLVE_CHANNEL_REPLY = 3109,
+	/* The main daemon asks for peers */
+	WIRE_GOSSIP_GETPEERS_REQUEST = 3011,
+	WIRE_GOSSIP_GETPEERS_REPLY = 3111,
+	/* Channel daemon can ask for updates for a specific channel, for sending */
+	/* errors.  Must be distinct from WIRE_CHANNEL_ANNOUNCEMENT etc. gossip msgs! */
+	WIRE_GOSSIP_GET_UPDATE = 3012,
+	/* If channel isn't known, update will be empty. */
+	WIRE_GOSSIP_GET_UPDATE_REPLY = 3112,
+	/* Gossipd can tell channeld etc about gossip to fwd. */
+	WIRE_GOSSIP_SEND_GOSSIP = 3016,
+	/* Both sides have seen the funding tx being locked, but we have not */
+	/* yet reached the announcement depth. So we add the channel locally so */
+	/* we can use it already. */
+	WIRE_GOSSIP_LOCAL_ADD_CHANNEL = 3017,
+	/* Gossipd->master get this tx output please. */
+	WIRE_GOSSIP_GET_TXOUT = 3018,
+	/* master->gossipd here is the output, or empty if none. */
+	WIRE_GOSSIP_GET_TXOUT_REPLY = 3118,
+};
+const char *gossip_wire_type_name(int e);
+
+bool fromwire_gossipctl_init(const tal_t *ctx, const void *p, size_t *plen, u32 *broadcast_interval, struct bitcoin_blkid *chain_hash, struct pubkey *id, u16 *port, u8 **gfeatures, u8 **lfeatures, struct wireaddr **wireaddrs, u8 rgb[3], u8 alias[32], u32 *update_channel_interval);
+
+bool fromwire_gossipctl_peer_addrhint(const void *p, size_t *plen, struct pubkey *id, struct wireaddr *addr);
+
+bool fromwire_gossipctl_reach_peer(const void *p, size_t *plen, struct pubkey *id);
+
+bool fromwire_gossip_peer_connected(const tal_t *ctx, const void *p, size_t *plen, struct pubkey *id, struct wireaddr *addr, struct crypto_state *crypto_state, u64 *gossip_index, u8 **gfeatures, u8 **lfeatures);
+
+bool fromwire_gossip_peer_already_connected(const void *p, size_t *plen, struct pubkey *id);
+
+bool fromwire_gossip_peer_nongossip(const tal_t *ctx, const void *p, size_t *plen, struct pubkey *id, struct wireaddr *addr, struct crypto_state *crypto_state, u64 *gossip_index, u8 **gfeatures, u8 **lfeatures, u8 **msg);
+
+bool fromwire_gossipctl_release_peer(const void *p, size_t *plen, struct pubkey *id);
+
+bool fromwire_gossipctl_release_peer_reply(const tal_t *ctx, const void *p, size_t *plen, struct wireaddr *addr, struct crypto_state *crypto_state, u64 *gossip_index, u8 **gfeatures, u8 **lfeatures);
+
+bool fromwire_gossipctl_release_peer_replyfail(const void *p, size_t *plen);
+
+bool fromwire_gossipctl_hand_back_peer(const tal_t *ctx, const void *p, size_t *plen, struct pubkey *id, struct crypto_state *crypto_state, u64 *gossip_index, u8 **msg);
+
+bool fromwire_gossip_getnodes_request(const tal_t *ctx, const void *p, size_t *plen, struct pubkey **ids, struct pubkey **firsts, u16 *limit);
+
+bool fromwire_gossip_getnodes_reply(const tal_t *ctx, const void *p, size_t *plen, struct pubkey **nexts, struct gossip_getnodes_entry **nodes);
+
+bool fromwire_gossip_getroute_request(const void *p, size_t *plen, struct pubkey *source, struct pubkey *destination, u32 *msatoshi, u16 *riskfactor, u32 *final_cltv);
+
+bool fromwire_gossip_getroute_reply(const tal_t *ctx, const void *p, size_t *plen, struct route_hop **hops);
+
+bool fromwire_gossip_getchannels_request(const tal_t *ctx, const void *p, size_t *plen, struct pubkey **sources, bool *active_only, struct short_channel_id *first, struct short_channel_id *last, u16 *limit);
+
+bool fromwire_gossip_getchannels_reply(const tal_t *ctx, const void *p, size_t *plen, bool *more, struct short_channel_id *next, struct gossip_getchannels_entry **nodes);
+
+bool fromwire_gossip_ping(const void *p, size_t *plen, struct pubkey *id, u16 *num_pong_bytes, u16 *len);
+
+bool fromwire_gossip_ping_reply(const void *p, size_t *plen, bool *sent, u16 *totlen);
+
+bool fromwire_gossip_resolve_channel_request(const void *p, size_t *plen, struct short_channel_id *channel_id);
+
+bool fromwire_gossip_resolve_channel_reply(const tal_t *ctx, const void *p, size_t *plen, struct pubkey **keys);
+
+bool fromwire_gossip_getpeers_request(const void *p, size_t *plen);
+
+bool fromwire_gossip_getpeers_reply(const tal_t *ctx, const void *p, size_t *plen, struct pubkey **id, struct wireaddr **addr);
+
+bool fromwire_gossip_get_update(const void *p, size_t *plen, struct short_channel_id *short_channel_id);
+
+bool fromwire_gossip_get_update_reply(const tal_t *ctx, const void *p, size_t *plen, u8 **update);
+
+bool fromwire_gossip_send_gossip(const tal_t *ctx, const void *p, size_t *plen, u64 *gossip_index, u8 **gossip);
+
+bool fromwire_gossip_local_add_channel(const void *p, size_t *plen, struct short_channel_id *short_channel_id, struct bitcoin_blkid *chain_hash, struct pubkey *remote_node_id, u16 *flags, u16 *cltv_expiry_delta, u64 *htlc_minimum_msat, u32 *fee_base_msat, u32 *fee_proportional_millionths);
+
+bool fromwire_gossip_get_txout(const void *p, size_t *plen, struct short_channel_id *short_channel_id);
+
+bool fromwire_gossip_get_txout_reply(const tal_t *ctx, const void *p, size_t *plen, struct short_channel_id *short_channel_id, u8 **outscript);
+
+u8 *towire_gossipctl_init(const tal_t *ctx, u32 broadcast_interval, const struct bitcoin_blkid *chain_hash, const struct pubkey *id, u16 port, const u8 *gfeatures, const u8 *lfeatures, const struct wireaddr *wireaddrs, const u8 rgb[3], const u8 alias[32], u32 update_channel_interval);
+
+u8 *towire_gossipctl_peer_addrhint(const tal_t *ctx, const struct pubkey *id, const struct wireaddr *addr);
+
+u8 *towire_gossipctl_reach_peer(const tal_t *ctx, const struct pubkey *id);
+
+u8 *towire_gossip_peer_connected(const tal_t *ctx, const struct pubkey *id, const struct wireaddr *addr, const struct crypto_state *crypto_state, u64 gossip_index, const u8 *gfeatures, const u8 *lfeatures);
+
+u8 *towire_gossip_peer_already_connected(const tal_t *ctx, const struct pubkey *id);
+
+u8 *towire_gossip_peer_nongossip(const tal_t *ctx, const struct pubkey *id, const struct wireaddr *addr, const struct crypto_state *crypto_state, u64 gossip_index, const u8 *gfeatures, const u8 *lfeatures, const u8 *msg);
+
+u8 *towire_gossipctl_release_peer(const tal_t *ctx, const struct pubkey *id);
+
+u8 *towire_gossipctl_release_peer_reply(const tal_t *ctx, const struct wireaddr *addr, const struct crypto_state *crypto_state, u64 gossip_index, const u8 *gfeatures, const u8 *lfeatures);
+
+u8 *towire_gossipctl_release_peer_replyfail(const tal_t *ctx);
+
+u8 *towire_gossipctl_hand_back_peer(const tal_t *ctx, const struct pubkey *id, const struct crypto_state *crypto_state, u64 gossip_index, const u8 *msg);
+
+u8 *towire_gossip_getnodes_request(const tal_t *ctx, const struct pubkey *ids, const struct pubkey *firsts, u16 limit);
+
+u8 *towire_gossip_getnodes_reply(const tal_t *ctx, const struct pubkey *nexts, const struct gossip_getnodes_entry *nodes);
+
+u8 *towire_gossip_getroute_request(const tal_t *ctx, const struct pubkey *source, const struct pubkey *destination, u32 msatoshi, u16 riskfactor, u32 final_cltv);
+
+u8 *towire_gossip_getroute_reply(const tal_t *ctx, const struct route_hop *hops);
+
+u8 *towire_gossip_getchannels_request(const tal_t *ctx, const struct pubkey *sources, bool active_only, const struct short_channel_id *first, const struct short_channel_id *last, u16 limit);
+
+u8 *towire_gossip_getchannels_reply(const tal_t *ctx, bool more, const struct short_channel_id *next, const struct gossip_getchannels_entry *nodes);
+
+u8 *towire_gossip_ping(const tal_t *ctx, const struct pubkey *id, u16 num_pong_bytes, u16 len);
+
+u8 *towire_gossip_ping_reply(const tal_t *ctx, bool sent, u16 totlen);
+
+u8 *towire_gossip_resolve_channel_request(const tal_t *ctx, const struct short_channel_id *channel_id);
+
+u8 *towire_gossip_resolve_channel_reply(const tal_t *ctx, const struct pubkey *keys);
+
+u8 *towire_gossip_getpeers_request(const tal_t *ctx);
+
+u8 *towire_gossip_getpeers_reply(const tal_t *ctx, const struct pubkey *id, const struct wireaddr *addr);
+
+u8 *towire_gossip_get_update(const tal_t *ctx, const struct short_channel_id *short_channel_id);
+
+u8 *towire_gossip_get_update_reply(const tal_t *ctx, const u8 *update);
+
+u8 *towire_gossip_send_gossip(const tal_t *ctx, u64 gossip_index, const u8 *gossip);
+
+u8 *towire_gossip_local_add_channel(const tal_t *ctx, const struct short_channel_id *short_channel_id, const struct bitcoin_blkid *chain_hash, const struct pubkey *remote_node_id, u16 flags, u16 cltv_expiry_delta, u64 htlc_minimum_msat, u32 fee_base_msat, u32 fee_proportional_millionths);
+
+u8 *towire_gossip_get_txout(const tal_t *ctx, const struct short_channel_id *short_channel_id);
+
+u8 *towire_gossip_get_txout_reply(const tal_t *ctx, const struct short_channel_id *short_channel_id, const u8 *outscript);
+
+#endif /* LIGHTNING_GOSSIPD_GEN_GOSSIP_WIRE_H */
+
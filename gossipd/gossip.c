@@ -1,3 +1,5 @@
+#include <ccan/array_size/array_size.h>
+#include <ccan/asort/asort.h>
 #include <ccan/build_assert/build_assert.h>
 #include <ccan/container_of/container_of.h>
 #include <ccan/crypto/hkdf_sha256/hkdf_sha256.h>
@@ -29,6 +31,7 @@
 #include <fcntl.h>
 #include <gossipd/broadcast.h>
 #include <gossipd/gen_gossip_wire.h>
+#include <gossipd/gossip_store.h>
 #include <gossipd/handshake.h>
 #include <gossipd/routing.h>
 #include <hsmd/client.h>
@@ -49,6 +52,11 @@
 
 #define HSM_FD 3
 
+/* We coalesce up to this many bytes of gossip into each write to a peer:
+ * large enough to amortize the syscalls over many messages, small enough
+ * that queued peer messages don't wait long behind a dump. */
+#define GOSSIP_BATCH_BYTES 65536
+
 struct daemon {
 	/* Who am I? */
 	struct pubkey id;
@@ -150,6 +158,9 @@ struct peer {
 	/* If we die, should we reach again? */
 	bool reach_again;
 
+	/* Batch of gossip being written to the nonlocal owner, if any. */
+	u8 *gossip_batch;
+
 	/* Only one of these is set: */
 	struct local_peer_state *local;
 	struct daemon_conn *remote;
@@ -234,6 +245,7 @@ static struct peer *new_peer(const tal_t *ctx,
 	peer->remote = NULL;
 	peer->reach_again = false;
 	peer->broadcast_index = 0;
+	peer->gossip_batch = NULL;
 
 	return peer;
 }
@@ -651,11 +663,25 @@ static void wake_pkt_out(struct peer *peer)
 /* Mutual recursion. */
 static struct io_plan *peer_pkt_out(struct io_conn *conn, struct peer *peer);
 
-static struct io_plan *local_gossip_broadcast_done(struct io_conn *conn,
-						   struct peer *peer)
+/* Gather the broadcasts after peer->broadcast_index, up to
+ * GOSSIP_BATCH_BYTES (but at least one), and advance the index past them. */
+static const u8 **next_gossip_batch(const tal_t *ctx, struct peer *peer)
 {
-	peer->broadcast_index++;
-	return peer_pkt_out(conn, peer);
+	struct broadcast_state *bstate = peer->daemon->rstate->broadcasts;
+	struct queued_message *next;
+	const u8 **batch = tal_arr(ctx, const u8 *, 0);
+	size_t n = 0, len = 0;
+
+	while ((next = next_broadcast_message(bstate, peer->broadcast_index))
+	       != NULL) {
+		if (n && len + tal_len(next->payload) > GOSSIP_BATCH_BYTES)
+			break;
+		tal_resize(&batch, n + 1);
+		batch[n++] = next->payload;
+		len += tal_len(next->payload);
+		peer->broadcast_index = next->index;
+	}
+	return batch;
 }
 
 static struct io_plan *peer_pkt_out(struct io_conn *conn, struct peer *peer)
@@ -681,15 +707,17 @@ static struct io_plan *peer_pkt_out(struct io_conn *conn, struct peer *peer)
 
 	/* If we're supposed to be sending gossip, do so now. */
 	if (peer->gossip_sync) {
-		struct queued_message *next;
+		const u8 **batch = next_gossip_batch(peer, peer);
 
-		next = next_broadcast_message(peer->daemon->rstate->broadcasts,
-					      peer->broadcast_index);
+		if (tal_count(batch)) {
+			struct io_plan *plan;
 
-		if (next)
-			return peer_write_message(conn, &peer->local->pcs,
-						  next->payload,
-						  local_gossip_broadcast_done);
+			plan = peer_write_messages(conn, &peer->local->pcs,
+						   batch, peer_pkt_out);
+			tal_free(batch);
+			return plan;
+		}
+		tal_free(batch);
 
 		/* Gossip is drained.  Wait for next timer. */
 		peer->gossip_sync = false;
@@ -786,12 +814,9 @@ static void handle_local_add_channel(struct peer *peer, u8 *msg)
 	direction = get_channel_direction(&rstate->local_id, &remote_node_id);
 	c = half_add_connection(rstate, &rstate->local_id, &remote_node_id, &scid, direction);
 
-	c->active = true;
-	c->last_timestamp = 0;
-	c->delay = cltv_expiry_delta;
-	c->htlc_minimum_msat = htlc_minimum_msat;
-	c->base_fee = fee_base_msat;
-	c->proportional_fee = fee_proportional_millionths;
+	set_connection_values(rstate, c, fee_base_msat,
+			      fee_proportional_millionths, cltv_expiry_delta,
+			      true, 0, htlc_minimum_msat);
 	status_trace("Channel %s(%d) was updated (LOCAL)",
 		     type_to_string(msg, struct short_channel_id, &scid),
 		     direction);
@@ -876,10 +901,21 @@ static struct io_plan *nonlocal_gossip_broadcast_done(struct io_conn *conn,
 	struct peer *peer = dc->ctx;
 
 	status_trace("%s", __func__);
-	peer->broadcast_index++;
+	peer->gossip_batch = tal_free(peer->gossip_batch);
 	return nonlocal_dump_gossip(conn, dc);
 }
 
+/* Append msg to *buf framed as io_write_wire would send it. */
+static void append_wire(u8 **buf, const u8 *msg)
+{
+	wire_len_t hdr = cpu_to_wirelen(tal_len(msg));
+	size_t off = tal_len(*buf);
+
+	tal_resize(buf, off + sizeof(hdr) + tal_len(msg));
+	memcpy(*buf + off, &hdr, sizeof(hdr));
+	memcpy(*buf + off + sizeof(hdr), msg, tal_len(msg));
+}
+
 /**
  * nonlocal_dump_gossip - catch the nonlocal peer up with the latest gossip.
  *
@@ -889,7 +925,7 @@ static struct io_plan *nonlocal_dump_gossip(struct io_conn *conn, struct daemon_
 {
 	struct queued_message *next;
 	struct peer *peer = dc->ctx;
-
+	u8 *batch;
 
 	/* Make sure we are not connected directly */
 	assert(!peer->local);
@@ -897,16 +933,26 @@ static struct io_plan *nonlocal_dump_gossip(struct io_conn *conn, struct daemon_
 	next = next_broadcast_message(peer->daemon->rstate->broadcasts,
 				      peer->broadcast_index);
 
-	if (!next) {
+	if (!next)
 		return msg_queue_wait(conn, &peer->remote->out,
 				      daemon_conn_write_next, dc);
-	} else {
-		u8 *msg = towire_gossip_send_gossip(conn,
-						    peer->broadcast_index,
+
+	/* Frame as many as fit in one batch, and write them in one go. */
+	batch = tal_arr(peer, u8, 0);
+	do {
+		u8 *msg = towire_gossip_send_gossip(batch, next->index,
 						    next->payload);
-		return io_write_wire(conn, take(msg),
-				     nonlocal_gossip_broadcast_done, dc);
-	}
+		append_wire(&batch, msg);
+		tal_free(msg);
+		peer->broadcast_index = next->index;
+		next = next_broadcast_message(peer->daemon->rstate->broadcasts,
+					      peer->broadcast_index);
+	} while (next && tal_len(batch) + tal_len(next->payload)
+		 <= GOSSIP_BATCH_BYTES);
+
+	peer->gossip_batch = batch;
+	return io_write(conn, batch, tal_len(batch),
+			nonlocal_gossip_broadcast_done, dc);
 }
 
 static struct io_plan *new_peer_got_fd(struct io_conn *conn, struct peer *peer)
@@ -1057,63 +1103,169 @@ static struct io_plan *getroute_req(struct io_conn *conn, struct daemon *daemon,
 	return daemon_conn_read_next(conn, &daemon->master);
 }
 
+static void fill_getchannels_entry(struct gossip_getchannels_entry *entry,
+				   const struct node_connection *nc)
+{
+	entry->source = nc->src->id;
+	entry->destination = nc->dst->id;
+	entry->active = nc->active;
+	entry->flags = nc->flags;
+	entry->public = (nc->channel_update != NULL);
+	entry->short_channel_id = nc->short_channel_id;
+	entry->last_update_timestamp = nc->last_timestamp;
+	if (entry->last_update_timestamp >= 0) {
+		entry->base_fee_msat = nc->base_fee;
+		entry->fee_per_millionth = nc->proportional_fee;
+		entry->delay = nc->delay;
+	}
+}
+
+static int nc_scid_cmp(struct node_connection *const *a,
+		       struct node_connection *const *b,
+		       void *unused)
+{
+	u64 ia = short_channel_id_to_uint(&(*a)->short_channel_id);
+	u64 ib = short_channel_id_to_uint(&(*b)->short_channel_id);
+
+	if (ia < ib)
+		return -1;
+	return ia > ib;
+}
+
 static struct io_plan *getchannels_req(struct io_conn *conn, struct daemon *daemon,
 				    u8 *msg)
 {
+	struct routing_state *rstate = daemon->rstate;
 	tal_t *tmpctx = tal_tmpctx(daemon);
 	u8 *out;
-	size_t j, num_chans = 0;
+	size_t num_chans = 0, num_entries = 0;
 	struct gossip_getchannels_entry *entries;
-	struct node *n;
-	struct node_map_iter i;
-
-	entries = tal_arr(tmpctx, struct gossip_getchannels_entry, num_chans);
-	n = node_map_first(daemon->rstate->nodes, &i);
-	while (n != NULL) {
-		for (j=0; j<tal_count(n->out); j++){
-			tal_resize(&entries, num_chans + 1);
-			entries[num_chans].source = n->out[j]->src->id;
-			entries[num_chans].destination = n->out[j]->dst->id;
-			entries[num_chans].active = n->out[j]->active;
-			entries[num_chans].flags = n->out[j]->flags;
-			entries[num_chans].public = (n->out[j]->channel_update != NULL);
-			entries[num_chans].short_channel_id = n->out[j]->short_channel_id;
-			entries[num_chans].last_update_timestamp = n->out[j]->last_timestamp;
-			if (entries[num_chans].last_update_timestamp >= 0) {
-				entries[num_chans].base_fee_msat = n->out[j]->base_fee;
-				entries[num_chans].fee_per_millionth = n->out[j]->proportional_fee;
-				entries[num_chans].delay = n->out[j]->delay;
+	struct pubkey *sources;
+	struct short_channel_id first, last, next;
+	bool active_only, more = false;
+	u16 limit;
+	u64 idx, last_idx;
+
+	if (!fromwire_gossip_getchannels_request(tmpctx, msg, NULL, &sources,
+						 &active_only,
+						 &first, &last, &limit)
+	    || tal_count(sources) > 1)
+		master_badmsg(WIRE_GOSSIP_GETCHANNELS_REQUEST, msg);
+
+	idx = short_channel_id_to_uint(&first);
+	last_idx = short_channel_id_to_uint(&last);
+	memset(&next, 0, sizeof(next));
+
+	/* limit counts channels: each can have both directions. */
+	entries = tal_arr(tmpctx, struct gossip_getchannels_entry, 2 * limit);
+
+	if (tal_count(sources)) {
+		/* Just walk its own channels, in order. */
+		struct node *n = node_map_get(rstate->nodes, &sources[0].pubkey);
+		struct node_connection **conns;
+
+		if (n)
+			conns = tal_dup_arr(tmpctx, struct node_connection *,
+					    n->out, tal_count(n->out), 0);
+		else
+			conns = tal_arr(tmpctx, struct node_connection *, 0);
+
+		asort(conns, tal_count(conns), nc_scid_cmp, NULL);
+		for (size_t i = 0; i < tal_count(conns); i++) {
+			const struct node_connection *nc = conns[i];
+			u64 scid = short_channel_id_to_uint(&nc->short_channel_id);
+
+			if (scid < idx || scid > last_idx)
+				continue;
+			if (active_only && !nc->active)
+				continue;
+			if (num_chans >= limit) {
+				more = true;
+				next = nc->short_channel_id;
+				break;
 			}
+			fill_getchannels_entry(&entries[num_entries++], nc);
 			num_chans++;
 		}
-		n = node_map_next(daemon->rstate->nodes, &i);
+	} else {
+		struct routing_channel *chan;
+
+		chan = uintmap_get(&rstate->ordered_channels, idx);
+		if (!chan)
+			chan = uintmap_after(&rstate->ordered_channels, &idx);
+		for (; chan && idx <= last_idx;
+		     chan = uintmap_after(&rstate->ordered_channels, &idx)) {
+			size_t prev_entries = num_entries;
+
+			if (num_chans >= limit) {
+				more = true;
+				next = chan->scid;
+				break;
+			}
+			for (size_t i = 0; i < ARRAY_SIZE(chan->connections); i++) {
+				const struct node_connection *nc;
+
+				nc = chan->connections[i];
+				if (!nc || (active_only && !nc->active))
+					continue;
+				fill_getchannels_entry(&entries[num_entries++],
+						       nc);
+			}
+			if (num_entries != prev_entries)
+				num_chans++;
+		}
 	}
+	tal_resize(&entries, num_entries);
 
-	out = towire_gossip_getchannels_reply(daemon, entries);
+	out = towire_gossip_getchannels_reply(daemon, more, &next, entries);
 	daemon_conn_send(&daemon->master, take(out));
 	tal_free(tmpctx);
 	return daemon_conn_read_next(conn, &daemon->master);
 }
 
-static struct io_plan *getnodes(struct io_conn *conn, struct daemon *daemon)
+static void fill_getnodes_entry(struct gossip_getnodes_entry *entry,
+				const struct node *n)
 {
+	entry->nodeid = n->id;
+	entry->addresses = n->addresses;
+}
+
+static struct io_plan *getnodes(struct io_conn *conn, struct daemon *daemon,
+				const u8 *msg)
+{
+	struct routing_state *rstate = daemon->rstate;
 	tal_t *tmpctx = tal_tmpctx(daemon);
 	u8 *out;
-	struct node *n;
-	struct node_map_iter i;
 	struct gossip_getnodes_entry *nodes;
-	size_t node_count = 0;
-
-	nodes = tal_arr(tmpctx, struct gossip_getnodes_entry, node_count);
-	n = node_map_first(daemon->rstate->nodes, &i);
-	while (n != NULL) {
-		tal_resize(&nodes, node_count + 1);
-		nodes[node_count].nodeid = n->id;
-		nodes[node_count].addresses = n->addresses;
-		node_count++;
-		n = node_map_next(daemon->rstate->nodes, &i);
+	struct pubkey *ids, *firsts, *nexts = NULL;
+	u16 limit;
+
+	if (!fromwire_gossip_getnodes_request(tmpctx, msg, NULL, &ids, &firsts,
+					      &limit)
+	    || tal_count(ids) > 1 || tal_count(firsts) > 1)
+		master_badmsg(WIRE_GOSSIP_GETNODES_REQUEST, msg);
+
+	if (tal_count(ids)) {
+		struct node *n = node_map_get(rstate->nodes, &ids[0].pubkey);
+
+		nodes = tal_arr(tmpctx, struct gossip_getnodes_entry, n ? 1 : 0);
+		if (n)
+			fill_getnodes_entry(&nodes[0], n);
+	} else {
+		/* In id order, so nodes coming and going between pages
+		 * don't make us skip or repeat any others. */
+		struct node *n = first_node_from(rstate,
+						 tal_count(firsts) ? firsts : NULL);
+		size_t num = 0;
+
+		nodes = tal_arr(tmpctx, struct gossip_getnodes_entry, limit);
+		for (; n && num < limit; n = next_node(rstate, n))
+			fill_getnodes_entry(&nodes[num++], n);
+		tal_resize(&nodes, num);
+		if (n)
+			nexts = tal_dup_arr(tmpctx, struct pubkey, &n->id, 1, 0);
 	}
-	out = towire_gossip_getnodes_reply(daemon, nodes);
+	out = towire_gossip_getnodes_reply(daemon, nexts, nodes);
 	daemon_conn_send(&daemon->master, take(out));
 	tal_free(tmpctx);
 	return daemon_conn_read_next(conn, &daemon->master);
@@ -1197,65 +1349,82 @@ fail:
 	return -1;
 }
 
-static void gossip_send_keepalive_update(struct routing_state *rstate,
-					 struct node_connection *nc)
-{
-	tal_t *tmpctx = tal_tmpctx(nc);
-	size_t plen = tal_len(nc->channel_update);
-	secp256k1_ecdsa_signature sig;
-	struct bitcoin_blkid chain_hash;
-	struct short_channel_id scid;
-	u32 timestamp, fee_base_msat, fee_proportional_millionths;
-	u64 htlc_minimum_msat;
-	u16 flags, cltv_expiry_delta;
-	u8 *update, *msg;
+/* Re-sign ncs' channel_updates with a fresh timestamp.  We write every
+ * request before reading any reply, so the HSM costs one round trip for the
+ * whole batch rather than one per channel. */
+static void gossip_send_keepalive_updates(struct routing_state *rstate,
+					  struct node_connection **ncs)
+{
+	tal_t *tmpctx = tal_tmpctx(rstate);
+	size_t num = tal_count(ncs);
+	u8 **updates = tal_arr(tmpctx, u8 *, num);
+	u32 now = time_now().ts.tv_sec;
+
+	for (size_t i = 0; i < num; i++) {
+		size_t plen = tal_len(ncs[i]->channel_update);
+		secp256k1_ecdsa_signature sig;
+		struct bitcoin_blkid chain_hash;
+		struct short_channel_id scid;
+		u32 timestamp, fee_base_msat, fee_proportional_millionths;
+		u64 htlc_minimum_msat;
+		u16 flags, cltv_expiry_delta;
+		u8 *update;
+
+		/* Parse old update */
+		if (!fromwire_channel_update(
+			ncs[i]->channel_update, &plen, &sig, &chain_hash, &scid,
+			&timestamp, &flags, &cltv_expiry_delta,
+			&htlc_minimum_msat, &fee_base_msat,
+			&fee_proportional_millionths)) {
+			status_failed(
+			    STATUS_FAIL_INTERNAL_ERROR,
+			    "Unable to parse previously accepted channel_update");
+		}
 
-	/* Parse old update */
-	if (!fromwire_channel_update(
-		nc->channel_update, &plen, &sig, &chain_hash, &scid, &timestamp,
-		&flags, &cltv_expiry_delta, &htlc_minimum_msat, &fee_base_msat,
-		&fee_proportional_millionths)) {
-		status_failed(
-		    STATUS_FAIL_INTERNAL_ERROR,
-		    "Unable to parse previously accepted channel_update");
+		/* Now generate a new update, with up to date timestamp */
+		update = towire_channel_update(tmpctx, &sig, &chain_hash, &scid,
+					       now, flags, cltv_expiry_delta,
+					       htlc_minimum_msat, fee_base_msat,
+					       fee_proportional_millionths);
+
+		if (!wire_sync_write(HSM_FD,
+				     towire_hsm_cupdate_sig_req(tmpctx, update))) {
+			status_failed(STATUS_FAIL_HSM_IO,
+				      "Writing cupdate_sig_req: %s",
+				      strerror(errno));
+		}
 	}
 
-	/* Now generate a new update, with up to date timestamp */
-	timestamp = time_now().ts.tv_sec;
-	update =
-	    towire_channel_update(tmpctx, &sig, &chain_hash, &scid, timestamp,
-				  flags, cltv_expiry_delta, htlc_minimum_msat,
-				  fee_base_msat, fee_proportional_millionths);
-
-	if (!wire_sync_write(HSM_FD,
-			     towire_hsm_cupdate_sig_req(tmpctx, update))) {
-		status_failed(STATUS_FAIL_HSM_IO, "Writing cupdate_sig_req: %s",
-			      strerror(errno));
+	/* The HSM answers in order. */
+	for (size_t i = 0; i < num; i++) {
+		u8 *msg = wire_sync_read(tmpctx, HSM_FD);
+		if (!msg
+		    || !fromwire_hsm_cupdate_sig_reply(tmpctx, msg, NULL,
+						       &updates[i])) {
+			status_failed(STATUS_FAIL_HSM_IO,
+				      "Reading cupdate_sig_req: %s",
+				      strerror(errno));
+		}
 	}
 
-	msg = wire_sync_read(tmpctx, HSM_FD);
-	if (!msg || !fromwire_hsm_cupdate_sig_reply(tmpctx, msg, NULL, &update)) {
-		status_failed(STATUS_FAIL_HSM_IO,
-			      "Reading cupdate_sig_req: %s",
-			      strerror(errno));
+	for (size_t i = 0; i < num; i++) {
+		status_trace("Sending keepalive channel_update for %s",
+			     type_to_string(tmpctx, struct short_channel_id,
+					    &ncs[i]->short_channel_id));
+		handle_channel_update(rstate, updates[i]);
 	}
-
-	status_trace("Sending keepalive channel_update for %s",
-		     type_to_string(tmpctx, struct short_channel_id, &scid));
-
-	handle_channel_update(rstate, update);
 	tal_free(tmpctx);
-
 }
 
 static void gossip_prune_network(struct daemon *daemon)
 {
 	u64 now = time_now().ts.tv_sec;
-	struct node_map_iter it;
+	struct routing_state *rstate = daemon->rstate;
 	/* Anything below this highwater mark ought to be pruned */
 	s64 highwater = now - 2*daemon->update_channel_interval;
 	struct node *n;
-	struct node **prunednodes;
+	struct node_connection *nc;
+	struct node_connection **keepalives;
 
 	/* Schedule next run now */
 	new_reltimer(&daemon->timers, daemon,
@@ -1263,13 +1432,15 @@ static void gossip_prune_network(struct daemon *daemon)
 		     gossip_prune_network, daemon);
 
 	/* Find myself in the network */
-	n = node_map_get(daemon->rstate->nodes, &daemon->id.pubkey);
+	n = node_map_get(rstate->nodes, &daemon->id.pubkey);
 	if (n) {
 		/* Iterate through all outgoing connection and check whether
 		 * it's time to re-announce */
+		keepalives = tal_arr(daemon, struct node_connection *, 0);
 		for (size_t i = 0; i < tal_count(n->out); i++) {
-			struct node_connection *nc = n->out[i];
+			size_t num = tal_count(keepalives);
 
+			nc = n->out[i];
 			if (!nc->channel_update) {
 				/* Connection is not public yet, so don't even
 				 * try to re-announce it */
@@ -1286,57 +1457,43 @@ static void gossip_prune_network(struct daemon *daemon)
 				continue;
 			}
 
-			gossip_send_keepalive_update(daemon->rstate, nc);
+			tal_resize(&keepalives, num + 1);
+			keepalives[num] = nc;
 		}
+		gossip_send_keepalive_updates(rstate, keepalives);
+		tal_free(keepalives);
 	}
 
-	/* Now iterate through all channels and see if it is still alive */
-	for (n = node_map_first(daemon->rstate->nodes, &it); n;
-	     n = node_map_next(daemon->rstate->nodes, &it)) {
-		for (size_t i = 0; i < tal_count(n->out); i++) {
-			struct node_connection *nc = n->out[i];
-
-			if (!nc->channel_update) {
-				/* Not even announced yet */
-				continue;
-			}
-
-			if (nc->last_timestamp > highwater) {
-				/* Still alive */
-				continue;
-			}
-
-			status_trace(
-			    "Pruning channel %s/%d from network view (age %"PRIu64"s)",
-			    type_to_string(trc, struct short_channel_id,
-					   &nc->short_channel_id),
-			    get_channel_direction(&nc->src->id, &nc->dst->id),
-			    now - nc->last_timestamp);
-			/* Calls remove_conn_from_array internally, removes on
-			 * both src and dst side. */
-			tal_free(nc);
-		}
+	/* Now prune the channels which have expired: the expiry heap hands
+	 * them to us oldest first, so we stop at the first live one. */
+	while ((nc = routing_first_expiry(rstate)) != NULL
+	       && nc->last_timestamp <= highwater) {
+		status_trace(
+		    "Pruning channel %s/%d from network view (age %"PRIu64"s)",
+		    type_to_string(trc, struct short_channel_id,
+				   &nc->short_channel_id),
+		    get_channel_direction(&nc->src->id, &nc->dst->id),
+		    now - nc->last_timestamp);
+
+		/* Calls remove_conn_from_array internally, removes on
+		 * both src and dst side. */
+		tal_free(nc);
 	}
 
-	/* Finally remove all nodes that do not have any edges
-	 * anymore. Accumulate into prunednodes, and delete in the
-	 * second loop. */
-	prunednodes = tal_arr(n, struct node*, 0);
-	for (n = node_map_first(daemon->rstate->nodes, &it); n;
-	     n = node_map_next(daemon->rstate->nodes, &it)) {
+	/* Finally remove any nodes which have no edges anymore, however
+	 * they lost them.  This is just a pass over the dense node_array;
+	 * we go backwards since freeing a node moves the last one into its
+	 * slot, and we've already looked at that one. */
+	for (size_t i = tal_count(rstate->node_array); i > 0; i--) {
+		n = rstate->node_array[i - 1];
 		if (tal_count(n->in) == 0 && tal_count(n->out) == 0) {
-			size_t count = tal_count(prunednodes);
-			tal_resize(&prunednodes, count + 1);
-			prunednodes[count] = n;
+			node_map_del(rstate->nodes, n);
+			tal_free(n);
 		}
 	}
 
-	for (size_t i=0; i<tal_count(prunednodes); i++) {
-		node_map_del(daemon->rstate->nodes, prunednodes[i]);
-		tal_free(prunednodes[i]);
-	}
-
-	tal_free(prunednodes);
+	/* Drop what we've pruned or superseded from the store, too. */
+	gossip_store_compact(daemon->rstate->store, daemon->rstate);
 }
 
 static struct io_plan *connection_in(struct io_conn *conn, struct daemon *daemon)
@@ -1460,6 +1617,11 @@ static struct io_plan *gossip_init(struct daemon_conn *master,
 	}
 	daemon->rstate = new_routing_state(daemon, &chain_hash, &daemon->id);
 
+	/* Pick up where we left off, rather than relearning everything. */
+	daemon->rstate->store = gossip_store_new(daemon->rstate);
+	gossip_store_load(daemon->rstate->store, daemon->rstate);
+	gossip_store_compact(daemon->rstate->store, daemon->rstate);
+
 	setup_listeners(daemon, port);
 
 	new_reltimer(&daemon->timers, daemon,
@@ -1749,7 +1911,7 @@ static struct io_plan *recv_req(struct io_conn *conn, struct daemon_conn *master
 		return release_peer(conn, daemon, master->msg_in);
 
 	case WIRE_GOSSIP_GETNODES_REQUEST:
-		return getnodes(conn, daemon);
+		return getnodes(conn, daemon, daemon->master.msg_in);
 
 	case WIRE_GOSSIP_GETROUTE_REQUEST:
 		return getroute_req(conn, daemon, daemon->master.msg_in);
@@ -0,0 +1,248 @@
+#include <assert.h>
+#include <ccan/array_size/array_size.h>
+#include <ccan/endian/endian.h>
+#include <ccan/read_write_all/read_write_all.h>
+#include <common/status.h>
+#include <common/utils.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <gossipd/gossip_store.h>
+#include <gossipd/routing.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <wire/gen_peer_wire.h>
+
+/* Bump this if the record format changes: we discard old stores. */
+#define GOSSIP_STORE_VERSION 1
+
+/* The file is a version byte, then records: a big-endian 32-bit length
+ * followed by that many bytes of wire message. */
+
+/* Peer messages have a 16-bit length, so no record can be longer. */
+#define GOSSIP_STORE_MAX_RECORD 65535
+
+struct gossip_store {
+	int fd;
+
+	/* Records in the file, current or not. */
+	size_t count;
+};
+
+static void destroy_gossip_store(struct gossip_store *gs)
+{
+	close(gs->fd);
+}
+
+static int open_store(const char *filename, int flags)
+{
+	int fd = open(filename, O_RDWR|O_APPEND|flags, 0600);
+	if (fd < 0)
+		status_failed(STATUS_FAIL_INTERNAL_ERROR,
+			      "Opening %s: %s", filename, strerror(errno));
+	return fd;
+}
+
+/* Start the file again with just a header. */
+static void reset_store(int fd, const char *filename)
+{
+	u8 version = GOSSIP_STORE_VERSION;
+
+	if (ftruncate(fd, 0) != 0 || !write_all(fd, &version, sizeof(version)))
+		status_failed(STATUS_FAIL_INTERNAL_ERROR,
+			      "Resetting %s: %s", filename, strerror(errno));
+}
+
+struct gossip_store *gossip_store_new(const tal_t *ctx)
+{
+	struct gossip_store *gs = tal(ctx, struct gossip_store);
+
+	gs->fd = open_store(GOSSIP_STORE_FILENAME, O_CREAT);
+	gs->count = 0;
+	tal_add_destructor(gs, destroy_gossip_store);
+	return gs;
+}
+
+static bool write_record(int fd, const u8 *msg)
+{
+	beint32_t belen = cpu_to_be32(tal_len(msg));
+
+	/* O_APPEND means these land together, even on a short write. */
+	return write_all(fd, &belen, sizeof(belen))
+		&& write_all(fd, msg, tal_len(msg));
+}
+
+void gossip_store_add(struct gossip_store *gs, const u8 *msg)
+{
+	if (!write_record(gs->fd, msg))
+		status_failed(STATUS_FAIL_INTERNAL_ERROR,
+			      "Writing %s: %s",
+			      GOSSIP_STORE_FILENAME, strerror(errno));
+	gs->count++;
+}
+
+static bool replay_record(struct routing_state *rstate, const u8 *msg)
+{
+	switch (fromwire_peektype(msg)) {
+	case WIRE_CHANNEL_ANNOUNCEMENT:
+		return routing_add_channel_announcement(rstate, msg);
+	case WIRE_CHANNEL_UPDATE:
+		return routing_add_channel_update(rstate, msg);
+	case WIRE_NODE_ANNOUNCEMENT:
+		return routing_add_node_announcement(rstate, msg);
+	}
+	return false;
+}
+
+void gossip_store_load(struct gossip_store *gs, struct routing_state *rstate)
+{
+	const tal_t *tmpctx = tal_tmpctx(gs);
+	beint32_t belen;
+	u8 version;
+	off_t good = sizeof(version);
+	size_t replayed = 0;
+
+	if (lseek(gs->fd, 0, SEEK_SET) != 0)
+		status_failed(STATUS_FAIL_INTERNAL_ERROR,
+			      "Seeking %s: %s",
+			      GOSSIP_STORE_FILENAME, strerror(errno));
+
+	if (!read_all(gs->fd, &version, sizeof(version))
+	    || version != GOSSIP_STORE_VERSION) {
+		status_trace("gossip_store: discarding old or empty store");
+		reset_store(gs->fd, GOSSIP_STORE_FILENAME);
+		tal_free(tmpctx);
+		return;
+	}
+
+	while (read_all(gs->fd, &belen, sizeof(belen))) {
+		u8 *msg;
+
+		/* Corrupt length?  Don't allocate it, truncate here. */
+		if (be32_to_cpu(belen) > GOSSIP_STORE_MAX_RECORD) {
+			status_trace("gossip_store: bad record length %u at %zu",
+				     be32_to_cpu(belen), (size_t)good);
+			break;
+		}
+		msg = tal_arr(tmpctx, u8, be32_to_cpu(belen));
+
+		if (!read_all(gs->fd, msg, tal_len(msg)))
+			break;
+		gs->count++;
+		replayed += replay_record(rstate, msg);
+		good += sizeof(belen) + tal_len(msg);
+		tal_free(msg);
+	}
+
+	/* Partial write from a crash?  Lose it. */
+	if (lseek(gs->fd, 0, SEEK_END) != good) {
+		status_trace("gossip_store: truncating partial record at %zu",
+			     (size_t)good);
+		if (ftruncate(gs->fd, good) != 0)
+			status_failed(STATUS_FAIL_INTERNAL_ERROR,
+				      "Truncating %s: %s",
+				      GOSSIP_STORE_FILENAME, strerror(errno));
+	}
+
+	status_trace("gossip_store: replayed %zu of %zu records",
+		     replayed, gs->count);
+	tal_free(tmpctx);
+}
+
+/* The announcement for this channel, if any (both sides share it). */
+static const u8 *channel_announcement(const struct routing_channel *chan)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(chan->connections); i++) {
+		if (chan->connections[i]
+		    && chan->connections[i]->channel_announcement)
+			return chan->connections[i]->channel_announcement;
+	}
+	return NULL;
+}
+
+/* Writes everything rstate still has to fd, and returns the number of
+ * records, or -1 on write error. */
+static ssize_t write_current(int fd, struct routing_state *rstate)
+{
+	struct routing_channel *chan;
+	struct channel_map_iter cit;
+	struct node *n;
+	struct node_map_iter nit;
+	ssize_t count = 0;
+
+	/* Announcements first: updates and node_announcements need them. */
+	for (chan = channel_map_first(rstate->channels, &cit);
+	     chan;
+	     chan = channel_map_next(rstate->channels, &cit)) {
+		const u8 *announce = channel_announcement(chan);
+
+		/* Local channels we were told about directly aren't stored */
+		if (!announce)
+			continue;
+		if (!write_record(fd, announce))
+			return -1;
+		count++;
+
+		for (size_t i = 0; i < ARRAY_SIZE(chan->connections); i++) {
+			const struct node_connection *c = chan->connections[i];
+			if (!c || !c->channel_update)
+				continue;
+			if (!write_record(fd, c->channel_update))
+				return -1;
+			count++;
+		}
+	}
+
+	for (n = node_map_first(rstate->nodes, &nit);
+	     n;
+	     n = node_map_next(rstate->nodes, &nit)) {
+		if (!n->node_announcement)
+			continue;
+		if (!write_record(fd, n->node_announcement))
+			return -1;
+		count++;
+	}
+	return count;
+}
+
+void gossip_store_compact(struct gossip_store *gs,
+			  struct routing_state *rstate)
+{
+	const char *tmpname = GOSSIP_STORE_FILENAME ".tmp";
+	ssize_t count;
+	int fd;
+
+	/* Compaction isn't free: only bother once it'll halve the file. */
+	if (gs->count <= rstate->store_live * 2)
+		return;
+
+	fd = open_store(tmpname, O_CREAT|O_TRUNC);
+	reset_store(fd, tmpname);
+	count = write_current(fd, rstate);
+	if (count < 0) {
+		status_trace("gossip_store: compacting failed: %s",
+			     strerror(errno));
+		close(fd);
+		unlink(tmpname);
+		return;
+	}
+
+	/* Make sure it's all on disk before it replaces the old one. */
+	if (fsync(fd) != 0) {
+		status_trace("gossip_store: syncing %s failed: %s",
+			     tmpname, strerror(errno));
+		close(fd);
+		unlink(tmpname);
+		return;
+	}
+
+	if (rename(tmpname, GOSSIP_STORE_FILENAME) != 0)
+		status_failed(STATUS_FAIL_INTERNAL_ERROR,
+			      "Renaming %s: %s", tmpname, strerror(errno));
+
+	status_trace("gossip_store: compacted %zu records to %zu",
+		     gs->count, (size_t)count);
+	assert(count == rstate->store_live);
+	close(gs->fd);
+	gs->fd = fd;
+	gs->count = count;
+}
@@ -0,0 +1,44 @@
+#ifndef LIGHTNING_GOSSIPD_GOSSIP_STORE_H
+#define LIGHTNING_GOSSIPD_GOSSIP_STORE_H
+#include "config.h"
+#include <ccan/short_types/short_types.h>
+#include <ccan/tal/tal.h>
+
+/* Append-only record of every gossip message we've accepted, so we don't
+ * have to relearn (and re-verify) the whole network when we restart. */
+#define GOSSIP_STORE_FILENAME "gossip_store"
+
+struct routing_state;
+
+/**
+ * gossip_store_new -- open (or create) the gossip_store.
+ *
+ * Doesn't read it: call gossip_store_load() for that.
+ */
+struct gossip_store *gossip_store_new(const tal_t *ctx);
+
+/**
+ * gossip_store_add -- append a message we've checked and accepted.
+ *
+ * @msg is a channel_announcement, channel_update or node_announcement.
+ */
+void gossip_store_add(struct gossip_store *gs, const u8 *msg);
+
+/**
+ * gossip_store_load -- replay the store into @rstate.
+ *
+ * Truncates any partial record left by a crash, or any record claiming
+ * to be longer than a wire message can be.
+ */
+void gossip_store_load(struct gossip_store *gs, struct routing_state *rstate);
+
+/**
+ * gossip_store_compact -- rewrite the store if mostly superseded.
+ *
+ * Replaces the file with just what @rstate still has, if the file holds
+ * more than twice as many records as that.
+ */
+void gossip_store_compact(struct gossip_store *gs,
+			  struct routing_state *rstate);
+
+#endif /* LIGHTNING_GOSSIPD_GOSSIP_STORE_H */
@@ -5,6 +5,7 @@
 #include <ccan/array_size/array_size.h>
 #include <ccan/crypto/siphash24/siphash24.h>
 #include <ccan/endian/endian.h>
+#include <ccan/mem/mem.h>
 #include <ccan/structeq/structeq.h>
 #include <ccan/tal/str/str.h>
 #include <common/features.h>
@@ -12,6 +13,7 @@
 #include <common/status.h>
 #include <common/type_to_string.h>
 #include <common/wireaddr.h>
+#include <gossipd/gossip_store.h>
 #include <inttypes.h>
 #include <wire/gen_peer_wire.h>
 
@@ -56,15 +58,33 @@ static struct node_map *empty_node_map(const tal_t *ctx)
 	return map;
 }
 
+static struct channel_map *empty_channel_map(const tal_t *ctx)
+{
+	struct channel_map *map = tal(ctx, struct channel_map);
+	channel_map_init(map);
+	tal_add_destructor(map, channel_map_clear);
+	return map;
+}
+
 struct routing_state *new_routing_state(const tal_t *ctx,
 					const struct bitcoin_blkid *chain_hash,
 					const struct pubkey *local_id)
 {
 	struct routing_state *rstate = tal(ctx, struct routing_state);
 	rstate->nodes = empty_node_map(rstate);
+	rstate->channels = empty_channel_map(rstate);
+	uintmap_init(&rstate->ordered_channels);
+	uintmap_init(&rstate->ordered_nodes);
 	rstate->broadcasts = new_broadcast_state(rstate);
 	rstate->chain_hash = *chain_hash;
 	rstate->local_id = *local_id;
+	rstate->node_array = tal_arr(rstate, struct node *, 0);
+	rstate->route_engine = ROUTE_ENGINE_LAYERED;
+	rstate->route_query = new_route_query(rstate);
+	rstate->route_graph = NULL;
+	rstate->store = NULL;
+	rstate->store_live = 0;
+	rstate->expiry = tal_arr(rstate, struct node_connection *, 0);
 	list_head_init(&rstate->pending_cannouncement);
 	return rstate;
 }
@@ -85,8 +105,227 @@ bool node_map_node_eq(const struct node *n, const secp256k1_pubkey *key)
 	return structeq(&n->id.pubkey, key);
 }
 
-static void destroy_node(struct node *node)
+const struct short_channel_id *channel_map_keyof_channel(const struct routing_channel *chan)
+{
+	return &chan->scid;
+}
+
+size_t channel_map_hash_key(const struct short_channel_id *scid)
+{
+	/* Bitfields, so we can't just hash the struct. */
+	u64 id = short_channel_id_to_uint(scid);
+	return siphash24(siphash_seed(), &id, sizeof(id));
+}
+
+bool channel_map_channel_eq(const struct routing_channel *chan,
+			    const struct short_channel_id *scid)
+{
+	return short_channel_id_eq(&chan->scid, scid);
+}
+
+static void destroy_routing_channel(struct routing_channel *chan)
 {
+	for (size_t i = 0; i < ARRAY_SIZE(chan->connections); i++)
+		if (chan->connections[i])
+			chan->connections[i]->channel = NULL;
+	channel_map_del(chan->rstate->channels, chan);
+	uintmap_del(&chan->rstate->ordered_channels,
+		    short_channel_id_to_uint(&chan->scid));
+}
+
+static struct routing_channel *new_routing_channel(struct routing_state *rstate,
+						   const struct short_channel_id *scid)
+{
+	struct routing_channel *chan;
+
+	/* Allocated off the map, so they go away before it does. */
+	chan = tal(rstate->channels, struct routing_channel);
+	chan->rstate = rstate;
+	chan->scid = *scid;
+	chan->connections[0] = chan->connections[1] = NULL;
+	channel_map_add(rstate->channels, chan);
+	uintmap_add(&rstate->ordered_channels, short_channel_id_to_uint(scid),
+		    chan);
+	tal_add_destructor(chan, destroy_routing_channel);
+	return chan;
+}
+
+/* How many records the gossip_store needs to keep for chan: its
+ * announcement, and the updates for each side, but updates are only
+ * stored once there's an announcement. */
+static size_t channel_store_records(const struct routing_channel *chan)
+{
+	size_t records = 0;
+	bool announced = false;
+
+	for (size_t i = 0; i < ARRAY_SIZE(chan->connections); i++) {
+		const struct node_connection *c = chan->connections[i];
+		if (!c)
+			continue;
+		announced |= (c->channel_announcement != NULL);
+		records += (c->channel_update != NULL);
+	}
+	return announced ? 1 + records : 0;
+}
+
+/* Call these either side of changing what channel_store_records() sees,
+ * to keep rstate->store_live current. */
+static void uncount_store_records(const struct routing_channel *chan)
+{
+	if (chan)
+		chan->rstate->store_live -= channel_store_records(chan);
+}
+
+static void count_store_records(const struct routing_channel *chan)
+{
+	if (chan)
+		chan->rstate->store_live += channel_store_records(chan);
+}
+
+/* Remove connection from the channel index; frees channel if it was
+ * the last direction we knew. */
+static void unindex_connection(struct node_connection *nc)
+{
+	struct routing_channel *chan = nc->channel;
+
+	if (!chan)
+		return;
+
+	uncount_store_records(chan);
+	for (size_t i = 0; i < ARRAY_SIZE(chan->connections); i++)
+		if (chan->connections[i] == nc)
+			chan->connections[i] = NULL;
+	nc->channel = NULL;
+
+	if (!chan->connections[0] && !chan->connections[1])
+		tal_free(chan);
+	else
+		count_store_records(chan);
+}
+
+/* File connection in the channel index under its current
+ * short_channel_id and direction, replacing any previous entry. */
+static void index_connection(struct routing_state *rstate,
+			     struct node_connection *nc)
+{
+	struct routing_channel *chan;
+	u8 direction = nc->flags & 0x1;
+
+	unindex_connection(nc);
+
+	chan = channel_map_get(rstate->channels, &nc->short_channel_id);
+	if (!chan)
+		chan = new_routing_channel(rstate, &nc->short_channel_id);
+	else if (chan->connections[direction])
+		chan->connections[direction]->channel = NULL;
+
+	uncount_store_records(chan);
+	chan->connections[direction] = nc;
+	nc->channel = chan;
+	count_store_records(chan);
+}
+
+/* rstate->ordered_nodes is keyed by the first 8 bytes of the node id:
+ * nodes which share those are chained off the first, in order. */
+static u64 node_order_key(const struct pubkey *id)
+{
+	u8 der[PUBKEY_DER_LEN];
+	beint64_t bekey;
+
+	pubkey_to_der(der, id);
+	memcpy(&bekey, der, sizeof(bekey));
+	return be64_to_cpu(bekey);
+}
+
+static void order_node(struct routing_state *rstate, struct node *node)
+{
+	u64 key = node_order_key(&node->id);
+	struct node *head = uintmap_get(&rstate->ordered_nodes, key), **prev;
+
+	if (!head || pubkey_cmp(&node->id, &head->id) < 0) {
+		node->same_order_key = head;
+		if (head)
+			uintmap_del(&rstate->ordered_nodes, key);
+		uintmap_add(&rstate->ordered_nodes, key, node);
+		return;
+	}
+
+	prev = &head->same_order_key;
+	while (*prev && pubkey_cmp(&(*prev)->id, &node->id) < 0)
+		prev = &(*prev)->same_order_key;
+	node->same_order_key = *prev;
+	*prev = node;
+}
+
+static void unorder_node(struct routing_state *rstate, struct node *node)
+{
+	u64 key = node_order_key(&node->id);
+	struct node *head = uintmap_get(&rstate->ordered_nodes, key), **prev;
+
+	if (head == node) {
+		uintmap_del(&rstate->ordered_nodes, key);
+		if (node->same_order_key)
+			uintmap_add(&rstate->ordered_nodes, key,
+				    node->same_order_key);
+		return;
+	}
+
+	for (prev = &head->same_order_key; *prev != node;
+	     prev = &(*prev)->same_order_key)
+		assert(*prev);
+	*prev = node->same_order_key;
+}
+
+struct node *first_node_from(struct routing_state *rstate,
+			     const struct pubkey *id)
+{
+	u64 key;
+	struct node *n;
+
+	if (!id)
+		return uintmap_first(&rstate->ordered_nodes, &key);
+
+	key = node_order_key(id);
+	for (n = uintmap_get(&rstate->ordered_nodes, key);
+	     n;
+	     n = n->same_order_key) {
+		if (pubkey_cmp(&n->id, id) >= 0)
+			return n;
+	}
+	return uintmap_after(&rstate->ordered_nodes, &key);
+}
+
+struct node *next_node(struct routing_state *rstate, const struct node *n)
+{
+	u64 key;
+
+	if (n->same_order_key)
+		return n->same_order_key;
+	key = node_order_key(&n->id);
+	return uintmap_after(&rstate->ordered_nodes, &key);
+}
+
+/* The route_graph snapshot, below. */
+static void routing_graph_changed(struct routing_state *rstate);
+static void route_graph_update(struct routing_state *rstate,
+			       const struct node_connection *nc);
+
+static void destroy_node(struct node *node, struct routing_state *rstate)
+{
+	size_t n = tal_count(rstate->node_array);
+	struct node *last = rstate->node_array[n - 1];
+
+	routing_graph_changed(rstate);
+	unorder_node(rstate, node);
+	if (node->node_announcement)
+		rstate->store_live--;
+
+	/* Fill our slot with the last one. */
+	assert(rstate->node_array[node->index] == node);
+	rstate->node_array[node->index] = last;
+	last->index = node->index;
+	tal_resize(&rstate->node_array, n - 1);
+
 	/* These remove themselves from the array. */
 	while (tal_count(node->in))
 		tal_free(node->in[0]);
@@ -116,7 +355,12 @@ static struct node *new_node(struct routing_state *rstate,
 	n->last_timestamp = -1;
 	n->addresses = tal_arr(n, struct wireaddr, 0);
 	node_map_add(rstate->nodes, n);
-	tal_add_destructor(n, destroy_node);
+	order_node(rstate, n);
+	routing_graph_changed(rstate);
+	n->index = tal_count(rstate->node_array);
+	tal_resize(&rstate->node_array, n->index + 1);
+	rstate->node_array[n->index] = n;
+	tal_add_destructor2(n, destroy_node, rstate);
 
 	return n;
 }
@@ -138,8 +382,100 @@ static bool remove_conn_from_array(struct node_connection ***conns,
 	return false;
 }
 
-static void destroy_connection(struct node_connection *nc)
+/* rstate->expiry is a binary heap, oldest last_timestamp first, so
+ * pruning only has to look at the connections which are due. */
+static void expiry_set(struct routing_state *rstate, size_t i,
+		       struct node_connection *nc)
 {
+	rstate->expiry[i] = nc;
+	nc->expiry_index = i;
+}
+
+static void expiry_sift_up(struct routing_state *rstate, size_t i)
+{
+	struct node_connection *nc = rstate->expiry[i];
+
+	while (i > 0) {
+		size_t parent = (i - 1) / 2;
+		if (rstate->expiry[parent]->last_timestamp <= nc->last_timestamp)
+			break;
+		expiry_set(rstate, i, rstate->expiry[parent]);
+		i = parent;
+	}
+	expiry_set(rstate, i, nc);
+}
+
+static void expiry_sift_down(struct routing_state *rstate, size_t i)
+{
+	struct node_connection *nc = rstate->expiry[i];
+	size_t n = tal_count(rstate->expiry);
+
+	for (;;) {
+		size_t child = 2 * i + 1;
+		if (child >= n)
+			break;
+		if (child + 1 < n
+		    && rstate->expiry[child + 1]->last_timestamp
+		    < rstate->expiry[child]->last_timestamp)
+			child++;
+		if (nc->last_timestamp <= rstate->expiry[child]->last_timestamp)
+			break;
+		expiry_set(rstate, i, rstate->expiry[child]);
+		i = child;
+	}
+	expiry_set(rstate, i, nc);
+}
+
+/* Add nc to the heap, or move it after its last_timestamp changed. */
+static void expiry_update(struct routing_state *rstate,
+			  struct node_connection *nc)
+{
+	size_t n = tal_count(rstate->expiry);
+
+	if (nc->expiry_index == NO_EXPIRY) {
+		tal_resize(&rstate->expiry, n + 1);
+		expiry_set(rstate, n, nc);
+		expiry_sift_up(rstate, n);
+		return;
+	}
+	expiry_sift_up(rstate, nc->expiry_index);
+	expiry_sift_down(rstate, nc->expiry_index);
+}
+
+static void expiry_remove(struct routing_state *rstate,
+			  struct node_connection *nc)
+{
+	size_t i = nc->expiry_index, n = tal_count(rstate->expiry);
+	struct node_connection *last;
+
+	if (i == NO_EXPIRY)
+		return;
+
+	nc->expiry_index = NO_EXPIRY;
+	last = rstate->expiry[n - 1];
+	tal_resize(&rstate->expiry, n - 1);
+
+	/* Move the last entry into the hole, then to where it belongs. */
+	if (i != n - 1) {
+		expiry_set(rstate, i, last);
+		expiry_sift_up(rstate, i);
+		expiry_sift_down(rstate, last->expiry_index);
+	}
+}
+
+struct node_connection *routing_first_expiry(const struct routing_state *rstate)
+{
+	if (tal_count(rstate->expiry) == 0)
+		return NULL;
+	return rstate->expiry[0];
+}
+
+static void destroy_connection(struct node_connection *nc,
+			       struct routing_state *rstate)
+{
+	routing_graph_changed(rstate);
+	expiry_remove(rstate, nc);
+	unindex_connection(nc);
 	if (!remove_conn_from_array(&nc->dst->in, nc)
 	    || !remove_conn_from_array(&nc->src->out, nc))
 		/* FIXME! */
@@ -169,23 +505,12 @@ struct node_connection *get_connection_by_scid(const struct routing_state *rstat
 					      const struct short_channel_id *schanid,
 					      const u8 direction)
 {
-	struct node *n;
-	int i, num_conn;
-	struct node_map *nodes = rstate->nodes;
-	struct node_connection *c;
-	struct node_map_iter it;
-
-	//FIXME(cdecker) We probably want to speed this up by indexing by chanid.
-	for (n = node_map_first(nodes, &it); n; n = node_map_next(nodes, &it)) {
-	        num_conn = tal_count(n->out);
-		for (i = 0; i < num_conn; i++){
-			c = n->out[i];
-			if (short_channel_id_eq(&c->short_channel_id, schanid) &&
-			    (c->flags&0x1) == direction)
-			    return c;
-		}
-	}
-	return NULL;
+	struct routing_channel *chan;
+
+	chan = channel_map_get(rstate->channels, schanid);
+	if (!chan)
+		return NULL;
+	return chan->connections[direction & 0x1];
 }
 
 static struct node_connection *
@@ -225,6 +550,8 @@ get_or_make_connection(struct routing_state *rstate,
 	nc->dst = to;
 	nc->channel_announcement = NULL;
 	nc->channel_update = NULL;
+	nc->channel = NULL;
+	nc->expiry_index = NO_EXPIRY;
 
 	/* Hook it into in/out arrays. */
 	i = tal_count(to->in);
@@ -234,7 +561,8 @@ get_or_make_connection(struct routing_state *rstate,
 	tal_resize(&from->out, i+1);
 	from->out[i] = nc;
 
-	tal_add_destructor(nc, destroy_connection);
+	tal_add_destructor2(nc, destroy_connection, rstate);
+	routing_graph_changed(rstate);
 	return nc;
 }
 
@@ -252,6 +580,8 @@ struct node_connection *half_add_connection(
 	nc->active = false;
 	nc->flags = flags;
 	nc->last_timestamp = -1;
+	index_connection(rstate, nc);
+	route_graph_update(rstate, nc);
 	return nc;
 }
 
@@ -260,30 +590,233 @@ struct node_connection *half_add_connection(
 /* Too big to reach, but don't overflow if added. */
 #define INFINITE 0x3FFFFFFFFFFFFFFFULL
 
-static void clear_bfg(struct node_map *nodes)
+/* Temporary data for find_route_bfg, one per node. */
+struct bfg_scratch {
+	struct {
+		/* Total to get to here from target. */
+		u64 total;
+		/* Total risk premium of this route. */
+		u64 risk;
+		/* Where that came from. */
+		struct node_connection *prev;
+	} hop[ROUTING_MAX_HOPS+1];
+};
+
+/* Temporary data for find_route_layered, one per node: hop[h] is only
+ * valid if generation matches query->generation and bit h of reached
+ * is set. */
+struct layered_scratch {
+	u64 generation;
+	u32 reached;
+	struct {
+		/* Total to get to here from target. */
+		u64 total;
+		/* Total risk premium of this route. */
+		u64 risk;
+		/* Index of the route_graph edge that came from. */
+		u32 prev;
+		/* Which BFG run would have found this via prev, and which
+		 * run would first extend it: see layered_one_edge(). */
+		u32 prev_run, run;
+	} hop[ROUTING_MAX_HOPS+1];
+};
+
+struct route_query {
+	/* Bumped for every search, so we never clear layered[]. */
+	u64 generation;
+
+	/* Indexed by node->index; grown as the graph grows. */
+	struct layered_scratch *layered;
+	struct bfg_scratch *bfg;
+
+	/* Nodes reached with exactly h hops, and a bitmap of those
+	 * reached with h+1. */
+	u32 *frontier;
+	u64 *next_bits;
+};
+
+struct route_query *new_route_query(const tal_t *ctx)
 {
-	struct node *n;
-	struct node_map_iter it;
+	struct route_query *query = tal(ctx, struct route_query);
+
+	query->generation = 0;
+	query->layered = tal_arr(query, struct layered_scratch, 0);
+	query->bfg = tal_arr(query, struct bfg_scratch, 0);
+	query->frontier = tal_arr(query, u32, 0);
+	query->next_bits = tal_arr(query, u64, 0);
+	return query;
+}
+
+/* Snapshot of the edges, for find_route_layered.  Nodes are numbered as
+ * in rstate->node_array; node i's incoming edges are in_start[i] to
+ * in_start[i+1]-1 of each edge array.  It's rebuilt when nodes or
+ * connections come or go; set_connection_values() patches the rest in
+ * place, via node_connection->route_edge. */
+struct route_graph {
+	struct routing_state *rstate;
+	size_t num_nodes;
+	u32 *in_start;
+
+	/* One entry per edge: src is a node index. */
+	u32 *src;
+	u32 *base_fee;
+	u32 *proportional_fee;
+	u32 *delay;
+	bool *active;
+
+	/* So we can hand back real connections at the end. */
+	struct node_connection **conn;
+};
+
+static void destroy_route_graph(struct route_graph *graph)
+{
+	graph->rstate->route_graph = NULL;
+}
+
+/* Nodes or connections were added or removed. */
+static void routing_graph_changed(struct routing_state *rstate)
+{
+	/* We'll rebuild it when someone next wants a route. */
+	tal_free(rstate->route_graph);
+}
+
+/* Copy nc's routing values into the snapshot, if we have one. */
+static void route_graph_update(struct routing_state *rstate,
+			       const struct node_connection *nc)
+{
+	struct route_graph *graph = rstate->route_graph;
+
+	if (!graph)
+		return;
+
+	assert(graph->conn[nc->route_edge] == nc);
+	graph->base_fee[nc->route_edge] = nc->base_fee;
+	graph->proportional_fee[nc->route_edge] = nc->proportional_fee;
+	graph->delay[nc->route_edge] = nc->delay;
+	graph->active[nc->route_edge] = nc->active;
+}
+
+void set_connection_values(struct routing_state *rstate,
+			   struct node_connection *nc,
+			   u32 base_fee,
+			   u32 proportional_fee,
+			   u32 delay,
+			   bool active,
+			   s64 timestamp,
+			   u32 htlc_minimum_msat)
+{
+	nc->delay = delay;
+	nc->htlc_minimum_msat = htlc_minimum_msat;
+	nc->base_fee = base_fee;
+	nc->proportional_fee = proportional_fee;
+	nc->active = active;
+	nc->last_timestamp = timestamp;
+
+	if (nc->proportional_fee >= MAX_PROPORTIONAL_FEE) {
+		status_trace("Channel %s(%d) massive proportional fee %u:"
+			     " disabling.",
+			     type_to_string(trc, struct short_channel_id,
+					    &nc->short_channel_id),
+			     nc->flags & 0x1,
+			     proportional_fee);
+		nc->active = false;
+	}
+	route_graph_update(rstate, nc);
+}
+
+static struct route_graph *build_route_graph(struct routing_state *rstate)
+{
+	struct route_graph *graph = tal(rstate, struct route_graph);
+	size_t i, j, e, num_edges = 0;
+
+	graph->rstate = rstate;
+	graph->num_nodes = tal_count(rstate->node_array);
+	for (i = 0; i < graph->num_nodes; i++)
+		num_edges += tal_count(rstate->node_array[i]->in);
+
+	graph->in_start = tal_arr(graph, u32, graph->num_nodes + 1);
+	graph->src = tal_arr(graph, u32, num_edges);
+	graph->base_fee = tal_arr(graph, u32, num_edges);
+	graph->proportional_fee = tal_arr(graph, u32, num_edges);
+	graph->delay = tal_arr(graph, u32, num_edges);
+	graph->active = tal_arr(graph, bool, num_edges);
+	graph->conn = tal_arr(graph, struct node_connection *, num_edges);
+
+	for (i = e = 0; i < graph->num_nodes; i++) {
+		struct node *n = rstate->node_array[i];
+
+		graph->in_start[i] = e;
+		for (j = 0; j < tal_count(n->in); j++) {
+			struct node_connection *c = n->in[j];
+			graph->src[e] = c->src->index;
+			graph->base_fee[e] = c->base_fee;
+			graph->proportional_fee[e] = c->proportional_fee;
+			graph->delay[e] = c->delay;
+			graph->active[e] = c->active;
+			graph->conn[e] = c;
+			c->route_edge = e;
+			e++;
+		}
+	}
+	graph->in_start[i] = e;
+	assert(e == num_edges);
 
-	for (n = node_map_first(nodes, &it); n; n = node_map_next(nodes, &it)) {
-		size_t i;
-		for (i = 0; i < ARRAY_SIZE(n->bfg); i++) {
-			n->bfg[i].total = INFINITE;
-			n->bfg[i].risk = 0;
+	tal_add_destructor(graph, destroy_route_graph);
+	return graph;
+}
+
+/* Catch anyone changing a connection without set_connection_values(). */
+static void check_route_edge(const struct route_graph *graph,
+			     const struct node_connection *nc)
+{
+#if DEVELOPER
+	u32 e = nc->route_edge;
+
+	assert(graph->conn[e] == nc);
+	assert(graph->base_fee[e] == nc->base_fee);
+	assert(graph->proportional_fee[e] == nc->proportional_fee);
+	assert(graph->delay[e] == nc->delay);
+	assert(graph->active[e] == nc->active);
+#endif
+}
+
+static const struct route_graph *get_route_graph(struct routing_state *rstate)
+{
+	if (!rstate->route_graph)
+		rstate->route_graph = build_route_graph(rstate);
+	return rstate->route_graph;
+}
+
+static void clear_bfg(struct route_query *query, size_t num_nodes)
+{
+	size_t i, h;
+
+	if (tal_count(query->bfg) < num_nodes)
+		tal_resize(&query->bfg, num_nodes);
+
+	for (i = 0; i < num_nodes; i++) {
+		for (h = 0; h < ARRAY_SIZE(query->bfg[i].hop); h++) {
+			query->bfg[i].hop[h].total = INFINITE;
+			query->bfg[i].hop[h].risk = 0;
 		}
 	}
 }
 
-static u64 connection_fee(const struct node_connection *c, u64 msatoshi)
+static u64 channel_fee(u32 base_fee, u32 proportional_fee, u64 msatoshi)
 {
 	u64 fee;
 
 	assert(msatoshi < MAX_MSATOSHI);
-	assert(c->proportional_fee < MAX_PROPORTIONAL_FEE);
+	assert(proportional_fee < MAX_PROPORTIONAL_FEE);
 
-	fee = (c->proportional_fee * msatoshi) / 1000000;
-	/* This can't overflow: c->base_fee is a u32 */
-	return c->base_fee + fee;
+	fee = (proportional_fee * msatoshi) / 1000000;
+	/* This can't overflow: base_fee is a u32 */
+	return base_fee + fee;
+}
+
+static u64 connection_fee(const struct node_connection *c, u64 msatoshi)
+{
+	return channel_fee(c->base_fee, c->proportional_fee, msatoshi);
 }
 
 /* Risk of passing through this channel.  We insert a tiny constant here
@@ -295,9 +828,12 @@ static u64 risk_fee(u64 amount, u32 delay, double riskfactor)
 
 /* We track totals, rather than costs.  That's because the fee depends
  * on the current amount passing through. */
-static void bfg_one_edge(struct node *node, size_t edgenum, double riskfactor)
+static void bfg_one_edge(struct route_query *query,
+			 struct node *node, size_t edgenum, double riskfactor)
 {
 	struct node_connection *c = node->in[edgenum];
+	struct bfg_scratch *ns = &query->bfg[node->index];
+	struct bfg_scratch *ps = &query->bfg[c->src->index];
 	size_t h;
 
 	assert(c->dst == node);
@@ -306,85 +842,66 @@ static void bfg_one_edge(struct node *node, size_t edgenum, double riskfactor)
 		u64 fee;
 		u64 risk;
 
-		if (node->bfg[h].total == INFINITE)
+		if (ns->hop[h].total == INFINITE)
 			continue;
 
-		fee = connection_fee(c, node->bfg[h].total);
-		risk = node->bfg[h].risk + risk_fee(node->bfg[h].total + fee,
-						    c->delay, riskfactor);
+		fee = connection_fee(c, ns->hop[h].total);
+		risk = ns->hop[h].risk + risk_fee(ns->hop[h].total + fee,
+						  c->delay, riskfactor);
 
-		if (node->bfg[h].total + fee + risk >= MAX_MSATOSHI) {
+		if (ns->hop[h].total + fee + risk >= MAX_MSATOSHI) {
 			SUPERVERBOSE("...extreme %"PRIu64
 				     " + fee %"PRIu64
 				     " + risk %"PRIu64" ignored",
-				     node->bfg[h].total, fee, risk);
+				     ns->hop[h].total, fee, risk);
 			continue;
 		}
 
-		if (node->bfg[h].total + fee + risk
-		    < c->src->bfg[h+1].total + c->src->bfg[h+1].risk) {
+		if (ns->hop[h].total + fee + risk
+		    < ps->hop[h+1].total + ps->hop[h+1].risk) {
 			SUPERVERBOSE("...%s can reach here in hoplen %zu total %"PRIu64,
 				     type_to_string(trc, struct pubkey,
 						    &c->src->id),
-				     h, node->bfg[h].total + fee);
-			c->src->bfg[h+1].total = node->bfg[h].total + fee;
-			c->src->bfg[h+1].risk = risk;
-			c->src->bfg[h+1].prev = c;
+				     h, ns->hop[h].total + fee);
+			ps->hop[h+1].total = ns->hop[h].total + fee;
+			ps->hop[h+1].risk = risk;
+			ps->hop[h+1].prev = c;
 		}
 	}
 }
 
-/* riskfactor is already scaled to per-block amount */
+/* src is the target, dst is us: see find_route(). */
 static struct node_connection *
-find_route(const tal_t *ctx, struct routing_state *rstate,
-	   const struct pubkey *from, const struct pubkey *to, u64 msatoshi,
-	   double riskfactor, u64 *fee, struct node_connection ***route)
+find_route_bfg(const tal_t *ctx, struct routing_state *rstate,
+	       struct route_query *query,
+	       struct node *src, struct node *dst, u64 msatoshi,
+	       double riskfactor, u64 *fee, struct node_connection ***route)
 {
-	struct node *n, *src, *dst;
-	struct node_map_iter it;
+	struct bfg_scratch *bfg;
+	struct node *n;
 	struct node_connection *first_conn;
 	int runs, i, best;
-
-	/* Note: we map backwards, since we know the amount of satoshi we want
-	 * at the end, and need to derive how much we need to send. */
-	dst = get_node(rstate, from);
-	src = get_node(rstate, to);
-
-	if (!src) {
-		status_trace("find_route: cannot find %s",
-			     type_to_string(trc, struct pubkey, to));
-		return NULL;
-	} else if (!dst) {
-		status_trace("find_route: cannot find myself (%s)",
-			     type_to_string(trc, struct pubkey, to));
-		return NULL;
-	} else if (dst == src) {
-		status_trace("find_route: this is %s, refusing to create empty route",
-			     type_to_string(trc, struct pubkey, to));
-		return NULL;
-	}
-
-	if (msatoshi >= MAX_MSATOSHI) {
-		status_trace("find_route: can't route huge amount %"PRIu64,
-			     msatoshi);
-		return NULL;
-	}
+	size_t num_nodes = tal_count(rstate->node_array);
 
 	/* Reset all the information. */
-	clear_bfg(rstate->nodes);
+	clear_bfg(query, num_nodes);
+	bfg = query->bfg;
 
 	/* Bellman-Ford-Gibson: like Bellman-Ford, but keep values for
 	 * every path length. */
-	src->bfg[0].total = msatoshi;
-	src->bfg[0].risk = 0;
+	bfg[src->index].hop[0].total = msatoshi;
+	bfg[src->index].hop[0].risk = 0;
 
 	for (runs = 0; runs < ROUTING_MAX_HOPS; runs++) {
+		size_t ni;
+
 		SUPERVERBOSE("Run %i", runs);
 		/* Run through every edge. */
-		for (n = node_map_first(rstate->nodes, &it);
-		     n;
-		     n = node_map_next(rstate->nodes, &it)) {
-			size_t num_edges = tal_count(n->in);
+		for (ni = 0; ni < num_nodes; ni++) {
+			size_t num_edges;
+
+			n = rstate->node_array[ni];
+			num_edges = tal_count(n->in);
 			for (i = 0; i < num_edges; i++) {
 				SUPERVERBOSE("Node %s edge %i/%zu",
 					     type_to_string(trc, struct pubkey,
@@ -394,7 +911,7 @@ find_route(const tal_t *ctx, struct routing_state *rstate,
 					SUPERVERBOSE("...inactive");
 					continue;
 				}
-				bfg_one_edge(n, i, riskfactor);
+				bfg_one_edge(query, n, i, riskfactor);
 				SUPERVERBOSE("...done");
 			}
 		}
@@ -402,30 +919,31 @@ find_route(const tal_t *ctx, struct routing_state *rstate,
 
 	best = 0;
 	for (i = 1; i <= ROUTING_MAX_HOPS; i++) {
-		if (dst->bfg[i].total < dst->bfg[best].total)
+		if (bfg[dst->index].hop[i].total
+		    < bfg[dst->index].hop[best].total)
 			best = i;
 	}
 
 	/* No route? */
-	if (dst->bfg[best].total >= INFINITE) {
+	if (bfg[dst->index].hop[best].total >= INFINITE) {
 		status_trace("find_route: No route to %s",
-			     type_to_string(trc, struct pubkey, to));
+			     type_to_string(trc, struct pubkey, &src->id));
 		return NULL;
 	}
 
 	/* Save route from *next* hop (we return first hop as peer).
 	 * Note that we take our own fees into account for routing, even
 	 * though we don't pay them: it presumably effects preference. */
-	first_conn = dst->bfg[best].prev;
-	dst = dst->bfg[best].prev->dst;
+	first_conn = bfg[dst->index].hop[best].prev;
+	dst = first_conn->dst;
 	best--;
 
-	*fee = dst->bfg[best].total - msatoshi;
+	*fee = bfg[dst->index].hop[best].total - msatoshi;
 	*route = tal_arr(ctx, struct node_connection *, best);
 	for (i = 0, n = dst;
 	     i < best;
-	     n = n->bfg[best-i].prev->dst, i++) {
-		(*route)[i] = n->bfg[best-i].prev;
+	     n = bfg[n->index].hop[best-i].prev->dst, i++) {
+		(*route)[i] = bfg[n->index].hop[best-i].prev;
 	}
 	assert(n == src);
 
@@ -444,11 +962,235 @@ find_route(const tal_t *ctx, struct routing_state *rstate,
 			msatoshi -= connection_fee((*route)[i], msatoshi);
 		}
 		status_trace(" =%"PRIi64"(%+"PRIi64")",
-			     (*route)[best-1]->dst->bfg[best-1].total, *fee);
+			     bfg[(*route)[best-1]->dst->index].hop[best-1].total,
+			     *fee);
+	}
+	return first_conn;
+}
+
+/* Like bfg_one_edge, but for a single hop length h, and edge e of the
+ * snapshot rather than a node_connection.  Returns true if this is the
+ * first time we've reached the source of e in h+1 hops.
+ *
+ * Equally cheap routes are common, so we break ties as BFG would: it
+ * keeps whichever it found first.  Each run of BFG visits the edges in
+ * snapshot order, and a node's cost found while visiting an earlier
+ * node's edges is extended in the same run, otherwise in the next. */
+static bool layered_one_edge(struct route_query *query,
+			     const struct route_graph *graph,
+			     u32 node, size_t h, u32 e, double riskfactor)
+{
+	struct layered_scratch *ns = &query->layered[node];
+	struct layered_scratch *ps = &query->layered[graph->src[e]];
+	u64 fee, risk, total = ns->hop[h].total;
+	u32 bit = 1U << (h + 1);
+	bool first;
+
+	fee = channel_fee(graph->base_fee[e], graph->proportional_fee[e],
+			  total);
+	risk = ns->hop[h].risk + risk_fee(total + fee, graph->delay[e],
+					  riskfactor);
+
+	if (total + fee + risk >= MAX_MSATOSHI) {
+		SUPERVERBOSE("...extreme %"PRIu64
+			     " + fee %"PRIu64
+			     " + risk %"PRIu64" ignored",
+			     total, fee, risk);
+		return false;
+	}
+
+	if (ps->generation != query->generation) {
+		ps->generation = query->generation;
+		ps->reached = 0;
+	}
+	first = !(ps->reached & bit);
+	if (!first) {
+		u64 cost = total + fee + risk;
+		u64 best = ps->hop[h+1].total + ps->hop[h+1].risk;
+
+		if (cost > best)
+			return false;
+		if (cost == best
+		    && (ns->hop[h].run > ps->hop[h+1].prev_run
+			|| (ns->hop[h].run == ps->hop[h+1].prev_run
+			    && e > ps->hop[h+1].prev)))
+			return false;
+	}
+
+	SUPERVERBOSE("...%s can reach here in hoplen %zu total %"PRIu64,
+		     type_to_string(trc, struct pubkey,
+				    &graph->conn[e]->src->id),
+		     h, total + fee);
+	ps->reached |= bit;
+	ps->hop[h+1].total = total + fee;
+	ps->hop[h+1].risk = risk;
+	ps->hop[h+1].prev = e;
+	ps->hop[h+1].prev_run = ns->hop[h].run;
+	ps->hop[h+1].run = ns->hop[h].run + (graph->src[e] < node);
+	return first;
+}
+
+/* src is the target, dst is us: see find_route().  This computes
+ * exactly what find_route_bfg does: the cheapest way to reach each node
+ * in each number of hops.  But BFG sweeps every edge ROUTING_MAX_HOPS
+ * times; this only extends the nodes reached in h hops to find those
+ * reached in h+1, walking graph rather than the nodes themselves, which
+ * keeps the edges we touch packed together.  We visit each frontier in
+ * node_array order, as BFG does, so ties are broken the same way. */
+static struct node_connection *
+find_route_layered(const tal_t *ctx, const struct route_graph *graph,
+		   struct route_query *query,
+		   struct node *src, struct node *dst, u64 msatoshi,
+		   double riskfactor, u64 *fee, struct node_connection ***route)
+{
+	struct layered_scratch *d;
+	struct node *n;
+	struct node_connection *first_conn;
+	size_t h, i, num, num_words = (graph->num_nodes + 63) / 64;
+	int best;
+	u32 e;
+
+	/* New nodes start with generation 0, which is never current. */
+	if (tal_count(query->layered) < graph->num_nodes) {
+		tal_resizez(&query->layered, graph->num_nodes);
+		tal_resize(&query->frontier, graph->num_nodes);
+		tal_resize(&query->next_bits, num_words);
+	}
+	d = query->layered;
+
+	/* Invalidates everyone's temporary data. */
+	query->generation++;
+
+	d[src->index].generation = query->generation;
+	d[src->index].reached = 1;
+	d[src->index].hop[0].total = msatoshi;
+	d[src->index].hop[0].risk = 0;
+	d[src->index].hop[0].run = 0;
+	query->frontier[0] = src->index;
+	num = 1;
+
+	for (h = 0; h < ROUTING_MAX_HOPS && num; h++) {
+		SUPERVERBOSE("Hop %zu: %zu nodes", h, num);
+		memset(query->next_bits, 0, num_words * sizeof(u64));
+		for (i = 0; i < num; i++) {
+			u32 ni = query->frontier[i];
+
+			for (e = graph->in_start[ni];
+			     e < graph->in_start[ni+1];
+			     e++) {
+				u32 p = graph->src[e];
+				if (!graph->active[e]) {
+					SUPERVERBOSE("...inactive");
+					continue;
+				}
+				if (layered_one_edge(query, graph, ni, h, e,
+						     riskfactor))
+					query->next_bits[p / 64]
+						|= 1ULL << (p % 64);
+			}
+		}
+
+		/* The next frontier, in node order. */
+		num = 0;
+		for (i = 0; i < num_words; i++) {
+			u64 bits = query->next_bits[i];
+			while (bits) {
+				query->frontier[num++]
+					= i * 64 + __builtin_ctzll(bits);
+				bits &= bits - 1;
+			}
+		}
 	}
+
+	/* Like BFG, pick the cheapest total, preferring fewer hops. */
+	best = -1;
+	if (d[dst->index].generation == query->generation) {
+		for (h = 1; h <= ROUTING_MAX_HOPS; h++) {
+			if (!(d[dst->index].reached & (1U << h)))
+				continue;
+			if (best < 0
+			    || d[dst->index].hop[h].total
+			    < d[dst->index].hop[best].total)
+				best = h;
+		}
+	}
+
+	/* No route? */
+	if (best < 0) {
+		status_trace("find_route: No route to %s",
+			     type_to_string(trc, struct pubkey, &src->id));
+		return NULL;
+	}
+
+	/* Save route from *next* hop (we return first hop as peer).
+	 * Note that we take our own fees into account for routing, even
+	 * though we don't pay them: it presumably effects preference. */
+	first_conn = graph->conn[d[dst->index].hop[best].prev];
+	check_route_edge(graph, first_conn);
+	n = first_conn->dst;
+	best--;
+
+	*fee = d[n->index].hop[best].total - msatoshi;
+	*route = tal_arr(ctx, struct node_connection *, best);
+	for (i = 0; i < best; n = (*route)[i++]->dst) {
+		(*route)[i] = graph->conn[d[n->index].hop[best-i].prev];
+		check_route_edge(graph, (*route)[i]);
+	}
+	assert(n == src);
+
+	status_trace("find_route: via %s (%zu hops, fee %"PRIu64")",
+		     type_to_string(trc, struct pubkey, &first_conn->dst->id),
+		     tal_count(*route) + 1, *fee);
 	return first_conn;
 }
 
+/* riskfactor is already scaled to per-block amount.  All temporary
+ * state lives in query: the nodes themselves are only read. */
+static struct node_connection *
+find_route(const tal_t *ctx, struct routing_state *rstate,
+	   struct route_query *query,
+	   const struct pubkey *from, const struct pubkey *to, u64 msatoshi,
+	   double riskfactor, u64 *fee, struct node_connection ***route)
+{
+	struct node *src, *dst;
+
+	/* Note: we map backwards, since we know the amount of satoshi we want
+	 * at the end, and need to derive how much we need to send. */
+	dst = get_node(rstate, from);
+	src = get_node(rstate, to);
+
+	if (!src) {
+		status_trace("find_route: cannot find %s",
+			     type_to_string(trc, struct pubkey, to));
+		return NULL;
+	} else if (!dst) {
+		status_trace("find_route: cannot find myself (%s)",
+			     type_to_string(trc, struct pubkey, to));
+		return NULL;
+	} else if (dst == src) {
+		status_trace("find_route: this is %s, refusing to create empty route",
+			     type_to_string(trc, struct pubkey, to));
+		return NULL;
+	}
+
+	if (msatoshi >= MAX_MSATOSHI) {
+		status_trace("find_route: can't route huge amount %"PRIu64,
+			     msatoshi);
+		return NULL;
+	}
+
+	switch (rstate->route_engine) {
+	case ROUTE_ENGINE_LAYERED:
+		return find_route_layered(ctx, get_route_graph(rstate), query,
+					  src, dst, msatoshi, riskfactor,
+					  fee, route);
+	case ROUTE_ENGINE_BFG:
+		return find_route_bfg(ctx, rstate, query, src, dst,
+				      msatoshi, riskfactor, fee, route);
+	}
+	abort();
+}
+
 static struct node_connection *
 add_channel_direction(struct routing_state *rstate, const struct pubkey *from,
 		      const struct pubkey *to,
@@ -470,6 +1212,7 @@ add_channel_direction(struct routing_state *rstate, const struct pubkey *from,
 		memcpy(&c1->short_channel_id, short_channel_id,
 		       sizeof(c->short_channel_id));
 		c1->flags = direction;
+		index_connection(rstate, c1);
 		c = c1;
 	} else {
 		/* We don't know this channel at all, create it */
@@ -478,9 +1221,11 @@ add_channel_direction(struct routing_state *rstate, const struct pubkey *from,
 
 	/* Remember the announcement so we can forward it to new peers */
 	if (announcement) {
+		uncount_store_records(c->channel);
 		tal_free(c->channel_announcement);
 		c->channel_announcement = tal_dup_arr(c, u8, announcement,
 						      tal_count(announcement), 0);
+		count_store_records(c->channel);
 	}
 
 	return c;
@@ -519,6 +1264,43 @@ static bool check_channel_announcement(
 	       check_signed_hash(&hash, bitcoin2_sig, bitcoin2_key);
 }
 
+/* While master always processes in order, bitcoind is async, so they could
+ * theoretically return out of order. */
+static struct pending_cannouncement *
+find_pending_cannouncement(struct routing_state *rstate,
+			   const struct short_channel_id *scid)
+{
+	struct pending_cannouncement *i;
+
+	list_for_each(&rstate->pending_cannouncement, i, list) {
+		if (short_channel_id_eq(scid, &i->short_channel_id))
+			return i;
+	}
+	return NULL;
+}
+
+/* Have we already verified this exact channel_announcement? */
+static bool cannouncement_known(struct routing_state *rstate,
+				const struct short_channel_id *scid,
+				const u8 *announce)
+{
+	struct pending_cannouncement *pending;
+	struct node_connection *c;
+
+	pending = find_pending_cannouncement(rstate, scid);
+	if (pending)
+		return memeq(pending->announce, tal_len(pending->announce),
+			     announce, tal_len(announce));
+
+	c = get_connection_by_scid(rstate, scid, 0);
+	if (!c)
+		c = get_connection_by_scid(rstate, scid, 1);
+	return c && c->channel_announcement
+		&& memeq(c->channel_announcement,
+			 tal_len(c->channel_announcement),
+			 announce, tal_len(announce));
+}
+
 const struct short_channel_id *handle_channel_announcement(
 	struct routing_state *rstate,
 	const u8 *announce TAKES)
@@ -584,6 +1366,16 @@ const struct short_channel_id *handle_channel_announcement(
 		return NULL;
 	}
 
+	/* Every peer sends us the same announcements, so don't spend four
+	 * signature checks (and a txout lookup) on one we already have. */
+	if (cannouncement_known(rstate, &pending->short_channel_id,
+				pending->announce)) {
+		status_trace("Ignoring duplicate channel_announcement for %s",
+			     tag);
+		tal_free(pending);
+		return NULL;
+	}
+
 	if (!check_channel_announcement(&pending->node_id_1, &pending->node_id_2,
 					&pending->bitcoin_key_1,
 					&pending->bitcoin_key_2,
@@ -606,19 +1398,65 @@ const struct short_channel_id *handle_channel_announcement(
 	return &pending->short_channel_id;
 }
 
-/* While master always processes in order, bitcoind is async, so they could
- * theoretically return out of order. */
-static struct pending_cannouncement *
-find_pending_cannouncement(struct routing_state *rstate,
-			   const struct short_channel_id *scid)
+/* Add both directions of a channel whose announcement we've checked.
+ * Returns true if it was new to us, and so queued for broadcast. */
+static bool add_channel_announcement(struct routing_state *rstate,
+				     const struct short_channel_id *scid,
+				     const struct pubkey *node_id_1,
+				     const struct pubkey *node_id_2,
+				     const u8 *announce)
 {
-	struct pending_cannouncement *i;
+	struct node_connection *c0, *c1;
+	char *tag;
+	bool forward;
 
-	list_for_each(&rstate->pending_cannouncement, i, list) {
-		if (short_channel_id_eq(scid, &i->short_channel_id))
-			return i;
+	/* Is this a new connection? It is if we don't know the
+	 * channel yet, or do not have a matching announcement in the
+	 * case of side-loaded channels*/
+	c0 = get_connection(rstate, node_id_2, node_id_1);
+	c1 = get_connection(rstate, node_id_1, node_id_2);
+	forward = !c0 || !c1 || !c0->channel_announcement || !c1->channel_announcement;
+
+	add_channel_direction(rstate, node_id_1, node_id_2, scid, announce);
+	add_channel_direction(rstate, node_id_2, node_id_1, scid, announce);
+
+	if (forward) {
+		tag = type_to_string(trc, struct short_channel_id, scid);
+		tal_resize(&tag, strlen(tag));
+		if (queue_broadcast(rstate->broadcasts,
+				    WIRE_CHANNEL_ANNOUNCEMENT,
+				    (u8*)tag, announce))
+			status_failed(STATUS_FAIL_INTERNAL_ERROR,
+				      "Announcement %s was replaced?",
+				      tal_hex(trc, announce));
+		tal_free(tag);
 	}
-	return NULL;
+	return forward;
+}
+
+bool routing_add_channel_announcement(struct routing_state *rstate,
+				      const u8 *announce)
+{
+	const tal_t *tmpctx = tal_tmpctx(rstate);
+	secp256k1_ecdsa_signature sigs[4];
+	struct bitcoin_blkid chain_hash;
+	struct short_channel_id scid;
+	struct pubkey node_id_1, node_id_2, bitcoin_key_1, bitcoin_key_2;
+	u8 *features;
+	bool ok;
+
+	ok = fromwire_channel_announcement(tmpctx, announce, NULL,
+					   &sigs[0], &sigs[1],
+					   &sigs[2], &sigs[3],
+					   &features, &chain_hash, &scid,
+					   &node_id_1, &node_id_2,
+					   &bitcoin_key_1, &bitcoin_key_2)
+		&& structeq(&chain_hash, &rstate->chain_hash);
+	if (ok)
+		add_channel_announcement(rstate, &scid, &node_id_1, &node_id_2,
+					 announce);
+	tal_free(tmpctx);
+	return ok;
 }
 
 bool handle_pending_cannouncement(struct routing_state *rstate,
@@ -626,7 +1464,6 @@ bool handle_pending_cannouncement(struct routing_state *rstate,
 				  const u8 *outscript)
 {
 	bool forward, local;
-	struct node_connection *c0, *c1;
 	const char *tag;
 	const u8 *s;
 	struct pending_cannouncement *pending;
@@ -668,26 +1505,12 @@ bool handle_pending_cannouncement(struct routing_state *rstate,
 		return false;
 	}
 
-	/* Is this a new connection? It is if we don't know the
-	 * channel yet, or do not have a matching announcement in the
-	 * case of side-loaded channels*/
-	c0 = get_connection(rstate, &pending->node_id_2, &pending->node_id_1);
-	c1 = get_connection(rstate, &pending->node_id_1, &pending->node_id_2);
-	forward = !c0 || !c1 || !c0->channel_announcement || !c1->channel_announcement;
-
-	add_channel_direction(rstate, &pending->node_id_1, &pending->node_id_2,
-			      &pending->short_channel_id, pending->announce);
-	add_channel_direction(rstate, &pending->node_id_2, &pending->node_id_1,
-			      &pending->short_channel_id, pending->announce);
-
-	if (forward) {
-		if (queue_broadcast(rstate->broadcasts,
-				    WIRE_CHANNEL_ANNOUNCEMENT,
-				    (u8*)tag, pending->announce))
-			status_failed(STATUS_FAIL_INTERNAL_ERROR,
-				      "Announcement %s was replaced?",
-				      tal_hex(trc, pending->announce));
-	}
+	forward = add_channel_announcement(rstate, &pending->short_channel_id,
+					   &pending->node_id_1,
+					   &pending->node_id_2,
+					   pending->announce);
+	if (forward && rstate->store)
+		gossip_store_add(rstate->store, pending->announce);
 
 	local = pubkey_eq(&pending->node_id_1, &rstate->local_id) ||
 		pubkey_eq(&pending->node_id_2, &rstate->local_id);
@@ -722,7 +1545,9 @@ static bool update_to_pending(struct routing_state *rstate,
 	return true;
 }
 
-void handle_channel_update(struct routing_state *rstate, const u8 *update)
+/* Apply update if it's current; checks the signature unless verified. */
+static bool apply_channel_update(struct routing_state *rstate,
+				 const u8 *update, bool verified)
 {
 	u8 *serialized;
 	struct node_connection *c;
@@ -746,7 +1571,7 @@ void handle_channel_update(struct routing_state *rstate, const u8 *update)
 				     &htlc_minimum_msat, &fee_base_msat,
 				     &fee_proportional_millionths)) {
 		tal_free(tmpctx);
-		return;
+		return false;
 	}
 	direction = flags & 0x1;
 
@@ -760,7 +1585,7 @@ void handle_channel_update(struct routing_state *rstate, const u8 *update)
 			     type_to_string(tmpctx, struct bitcoin_blkid,
 					    &chain_hash));
 		tal_free(tmpctx);
-		return;
+		return false;
 	}
 
 	status_trace("Received channel_update for channel %s(%d)",
@@ -773,7 +1598,7 @@ void handle_channel_update(struct routing_state *rstate, const u8 *update)
 			     type_to_string(trc, struct short_channel_id,
 					    &short_channel_id), direction);
 		tal_free(tmpctx);
-		return;
+		return false;
 	}
 
 	c = get_connection_by_scid(rstate, &short_channel_id, direction);
@@ -783,38 +1608,27 @@ void handle_channel_update(struct routing_state *rstate, const u8 *update)
 			     type_to_string(trc, struct short_channel_id,
 					    &short_channel_id));
 		tal_free(tmpctx);
-		return;
+		return false;
 	} else if (c->last_timestamp >= timestamp) {
 		status_trace("Ignoring outdated update.");
 		tal_free(tmpctx);
-		return;
-	} else if (!check_channel_update(&c->src->id, &signature, serialized)) {
+		return false;
+	} else if (!verified
+		   && !check_channel_update(&c->src->id, &signature, serialized)) {
 		status_trace("Signature verification failed.");
 		tal_free(tmpctx);
-		return;
+		return false;
 	}
 
 	//FIXME(cdecker) Check signatures
-	c->last_timestamp = timestamp;
-	c->delay = expiry;
-	c->htlc_minimum_msat = htlc_minimum_msat;
-	c->base_fee = fee_base_msat;
-	c->proportional_fee = fee_proportional_millionths;
-	c->active = (flags & ROUTING_FLAGS_DISABLED) == 0;
 	status_trace("Channel %s(%d) was updated.",
 		     type_to_string(trc, struct short_channel_id,
 				    &short_channel_id),
 		     direction);
-
-	if (c->proportional_fee >= MAX_PROPORTIONAL_FEE) {
-		status_trace("Channel %s(%d) massive proportional fee %u:"
-			     " disabling.",
-			     type_to_string(trc, struct short_channel_id,
-					    &short_channel_id),
-			     direction,
-			     fee_proportional_millionths);
-		c->active = false;
-	}
+	set_connection_values(rstate, c, fee_base_msat,
+			      fee_proportional_millionths, expiry,
+			      (flags & ROUTING_FLAGS_DISABLED) == 0,
+			      timestamp, htlc_minimum_msat);
 
 	u8 *tag = tal_arr(tmpctx, u8, 0);
 	towire_short_channel_id(&tag, &short_channel_id);
@@ -824,9 +1638,25 @@ void handle_channel_update(struct routing_state *rstate, const u8 *update)
 			tag,
 			serialized);
 
+	uncount_store_records(c->channel);
 	tal_free(c->channel_update);
 	c->channel_update = tal_steal(c, serialized);
+	count_store_records(c->channel);
+	expiry_update(rstate, c);
 	tal_free(tmpctx);
+	return true;
+}
+
+void handle_channel_update(struct routing_state *rstate, const u8 *update)
+{
+	if (apply_channel_update(rstate, update, false) && rstate->store)
+		gossip_store_add(rstate->store, update);
+}
+
+bool routing_add_channel_update(struct routing_state *rstate,
+				const u8 *update)
+{
+	return apply_channel_update(rstate, update, true);
 }
 
 static struct wireaddr *read_addresses(const tal_t *ctx, const u8 *ser)
@@ -863,8 +1693,8 @@ static struct wireaddr *read_addresses(const tal_t *ctx, const u8 *ser)
 	return wireaddrs;
 }
 
-void handle_node_announcement(
-	struct routing_state *rstate, const u8 *node_ann)
+static bool apply_node_announcement(struct routing_state *rstate,
+				    const u8 *node_ann, bool verified)
 {
 	u8 *serialized;
 	struct sha256_double hash;
@@ -885,7 +1715,7 @@ void handle_node_announcement(
 					&node_id, rgb_color, alias,
 					&addresses)) {
 		tal_free(tmpctx);
-		return;
+		return false;
 	}
 
 	/* BOLT #7:
@@ -898,35 +1728,40 @@ void handle_node_announcement(
 		status_trace("Ignoring node announcement, unsupported features %s.",
 			     tal_hex(tmpctx, features));
 		tal_free(tmpctx);
-		return;
+		return false;
 	}
 
 	status_trace("Received node_announcement for node %s",
 		     type_to_string(trc, struct pubkey, &node_id));
 
-	sha256_double(&hash, serialized + 66, tal_count(serialized) - 66);
-	if (!check_signed_hash(&hash, &signature, &node_id)) {
-		status_trace("Ignoring node announcement, signature verification failed.");
-		tal_free(tmpctx);
-		return;
-	}
+	/* Cheap checks first: we mostly see announcements we already have. */
 	node = get_node(rstate, &node_id);
 
 	if (!node) {
 		status_trace("Node not found, was the node_announcement preceded by at least channel_announcement?");
 		tal_free(tmpctx);
-		return;
+		return false;
 	} else if (node->last_timestamp >= timestamp) {
 		status_trace("Ignoring node announcement, it's outdated.");
 		tal_free(tmpctx);
-		return;
+		return false;
+	}
+
+	if (!verified) {
+		sha256_double(&hash, serialized + 66,
+			      tal_count(serialized) - 66);
+		if (!check_signed_hash(&hash, &signature, &node_id)) {
+			status_trace("Ignoring node announcement, signature verification failed.");
+			tal_free(tmpctx);
+			return false;
+		}
 	}
 
 	wireaddrs = read_addresses(tmpctx, addresses);
 	if (!wireaddrs) {
 		status_trace("Unable to parse addresses.");
-		tal_free(serialized);
-		return;
+		tal_free(tmpctx);
+		return false;
 	}
 	tal_free(node->addresses);
 	node->addresses = tal_steal(node, wireaddrs);
@@ -941,9 +1776,24 @@ void handle_node_announcement(
 			WIRE_NODE_ANNOUNCEMENT,
 			tag,
 			serialized);
+	if (!node->node_announcement)
+		rstate->store_live++;
 	tal_free(node->node_announcement);
 	node->node_announcement = tal_steal(node, serialized);
 	tal_free(tmpctx);
+	return true;
+}
+
+void handle_node_announcement(struct routing_state *rstate, const u8 *node_ann)
+{
+	if (apply_node_announcement(rstate, node_ann, false) && rstate->store)
+		gossip_store_add(rstate->store, node_ann);
+}
+
+bool routing_add_node_announcement(struct routing_state *rstate,
+				   const u8 *node_ann)
+{
+	return apply_node_announcement(rstate, node_ann, true);
 }
 
 struct route_hop *get_route(tal_t *ctx, struct routing_state *rstate,
@@ -960,7 +1810,8 @@ struct route_hop *get_route(tal_t *ctx, struct routing_state *rstate,
 	int i;
 	struct node_connection *first_conn;
 
-	first_conn = find_route(ctx, rstate, source, destination, msatoshi,
+	first_conn = find_route(ctx, rstate, rstate->route_query,
+				source, destination, msatoshi,
 				riskfactor / BLOCKS_PER_YEAR / 10000,
 				&fee, &route);
 
@@ -3,6 +3,7 @@
 #include "config.h"
 #include <bitcoin/pubkey.h>
 #include <ccan/htable/htable_type.h>
+#include <ccan/intmap/intmap.h>
 #include <gossipd/broadcast.h>
 #include <wire/wire.h>
 
@@ -37,8 +38,19 @@ struct node_connection {
 	/* Cached `channel_announcement` and `channel_update` we might forward to new peers*/
 	u8 *channel_announcement;
 	u8 *channel_update;
+
+	/* Entry in rstate->channels we're filed under, or NULL. */
+	struct routing_channel *channel;
+
+	/* Our slot in rstate->expiry, or NO_EXPIRY if not announced. */
+	size_t expiry_index;
+
+	/* Our edge in rstate->route_graph, if that exists. */
+	u32 route_edge;
 };
 
+#define NO_EXPIRY SIZE_MAX
+
 struct node {
 	struct pubkey id;
 
@@ -51,15 +63,8 @@ struct node {
 	/* Routes connecting to us, from us. */
 	struct node_connection **in, **out;
 
-	/* Temporary data for routefinding. */
-	struct {
-		/* Total to get to here from target. */
-		u64 total;
-		/* Total risk premium of this route. */
-		u64 risk;
-		/* Where that came from. */
-		struct node_connection *prev;
-	} bfg[ROUTING_MAX_HOPS+1];
+	/* Our slot in rstate->node_array, and any route_query scratch. */
+	size_t index;
 
 	/* UTF-8 encoded alias as tal_arr, not zero terminated */
 	u8 *alias;
@@ -69,6 +74,9 @@ struct node {
 
 	/* Cached `node_announcement` we might forward to new peers. */
 	u8 *node_announcement;
+
+	/* Next node in rstate->ordered_nodes with the same key, if any. */
+	struct node *same_order_key;
 };
 
 const secp256k1_pubkey *node_map_keyof_node(const struct node *n);
@@ -76,10 +84,61 @@ size_t node_map_hash_key(const secp256k1_pubkey *key);
 bool node_map_node_eq(const struct node *n, const secp256k1_pubkey *key);
 HTABLE_DEFINE_TYPE(struct node, node_map_keyof_node, node_map_hash_key, node_map_node_eq, node_map);
 
+/* Both directions of a channel, so we can look them up by short_channel_id */
+struct routing_channel {
+	struct routing_state *rstate;
+
+	struct short_channel_id scid;
+
+	/* Indexed by direction (flags & 0x1), NULL if we don't know it. */
+	struct node_connection *connections[2];
+};
+
+const struct short_channel_id *channel_map_keyof_channel(const struct routing_channel *chan);
+size_t channel_map_hash_key(const struct short_channel_id *scid);
+bool channel_map_channel_eq(const struct routing_channel *chan,
+			    const struct short_channel_id *scid);
+HTABLE_DEFINE_TYPE(struct routing_channel, channel_map_keyof_channel, channel_map_hash_key, channel_map_channel_eq, channel_map);
+
+/* Per-query temporary data for routefinding, so searches don't write
+ * to the nodes themselves. */
+struct route_query;
+
+struct route_query *new_route_query(const tal_t *ctx);
+
+/* Change a connection's routing values.  Use this rather than setting
+ * them directly, so routes use the new values. */
+void set_connection_values(struct routing_state *rstate,
+			   struct node_connection *nc,
+			   u32 base_fee,
+			   u32 proportional_fee,
+			   u32 delay,
+			   bool active,
+			   s64 timestamp,
+			   u32 htlc_minimum_msat);
+
+/* Which algorithm get_route() uses. */
+enum route_engine {
+	/* Same results as BFG, but only extends the nodes reached in
+	 * each number of hops. */
+	ROUTE_ENGINE_LAYERED,
+	/* The original Bellman-Ford-Gibson, kept for differential testing. */
+	ROUTE_ENGINE_BFG
+};
+
 struct routing_state {
 	/* All known nodes. */
 	struct node_map *nodes;
 
+	/* All known channels, by short_channel_id. */
+	struct channel_map *channels;
+
+	/* The same channels in short_channel_id order, for listing. */
+	UINTMAP(struct routing_channel *) ordered_channels;
+
+	/* All known nodes in id order, for listing: see first_node_from(). */
+	UINTMAP(struct node *) ordered_nodes;
+
 	/* channel_announcement which are pending short_channel_id lookup */
 	struct list_head pending_cannouncement;
 
@@ -89,6 +148,28 @@ struct routing_state {
 
 	/* Our own ID so we can identify local channels */
 	struct pubkey local_id;
+
+	/* All known nodes again, densely packed: see node->index. */
+	struct node **node_array;
+
+	/* How we find routes. */
+	enum route_engine route_engine;
+
+	/* Scratch space for get_route(). */
+	struct route_query *route_query;
+
+	/* Snapshot of the graph for routing, or NULL if it's out of date. */
+	struct route_graph *route_graph;
+
+	/* Where we save gossip we've accepted, or NULL. */
+	struct gossip_store *store;
+
+	/* How many records compacting the store would keep. */
+	size_t store_live;
+
+	/* Connections with a channel_update, as a min-heap on
+	 * last_timestamp: see routing_first_expiry(). */
+	struct node_connection **expiry;
 };
 
 struct route_hop {
@@ -117,6 +198,15 @@ struct node_connection *get_connection_by_scid(const struct routing_state *rstat
 					       const struct short_channel_id *schanid,
 					      const u8 direction);
 
+/* Nodes in id order: the first with id at or after @id (or the very
+ * first, if @id is NULL), and the one after @n.  NULL at the end. */
+struct node *first_node_from(struct routing_state *rstate,
+			     const struct pubkey *id);
+struct node *next_node(struct routing_state *rstate, const struct node *n);
+
+/* The announced connection with the oldest channel_update, or NULL. */
+struct node_connection *routing_first_expiry(const struct routing_state *rstate);
+
 /* Handlers for incoming messages */
 
 /**
@@ -142,6 +232,16 @@ bool handle_pending_cannouncement(struct routing_state *rstate,
 void handle_channel_update(struct routing_state *rstate, const u8 *update);
 void handle_node_announcement(struct routing_state *rstate, const u8 *node);
 
+/* Add messages we've already checked (ie. from the gossip_store), without
+ * verifying signatures or looking up the funding txout again.  Returns
+ * false if the message no longer applies. */
+bool routing_add_channel_announcement(struct routing_state *rstate,
+				      const u8 *announce);
+bool routing_add_channel_update(struct routing_state *rstate,
+				const u8 *update);
+bool routing_add_node_announcement(struct routing_state *rstate,
+				   const u8 *node_ann);
+
 /* Compute a route to a destination, for a given amount and riskfactor. */
 struct route_hop *get_route(tal_t *ctx, struct routing_state *rstate,
 			    const struct pubkey *source,
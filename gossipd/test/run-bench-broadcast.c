@@ -0,0 +1,134 @@
+#include <assert.h>
+#include <ccan/err/err.h>
+#include <ccan/opt/opt.h>
+#include <ccan/time/time.h>
+#include <common/pseudorand.h>
+#include <common/utils.h>
+#include <stdio.h>
+
+#include "../broadcast.c"
+
+/* AUTOGENERATED MOCKS START */
+/* AUTOGENERATED MOCKS END */
+
+/* Like a channel_update tag: short_channel_id then direction. */
+static u8 *make_tag(const tal_t *ctx, size_t chan, u16 direction)
+{
+	u8 *tag = tal_arrz(ctx, u8, 10);
+
+	memcpy(tag, &chan, sizeof(chan));
+	memcpy(tag + 8, &direction, sizeof(direction));
+	return tag;
+}
+
+/* What queue_broadcast used to do before we indexed tags. */
+static bool linear_queue_broadcast(struct broadcast_state *bstate,
+				   const int type,
+				   const u8 *tag,
+				   const u8 *payload)
+{
+	struct queued_message *msg;
+	u64 index;
+	bool evicted = false;
+
+	for (msg = uintmap_first(&bstate->broadcasts, &index);
+	     msg;
+	     msg = uintmap_after(&bstate->broadcasts, &index)) {
+		if (msg->type == type && memcmp(msg->tag, tag, tal_len(tag)) == 0) {
+			uintmap_del(&bstate->broadcasts, index);
+			tal_free(msg);
+			evicted = true;
+			break;
+		}
+	}
+
+	msg = new_queued_message(bstate, type, tag, payload);
+	uintmap_add(&bstate->broadcasts, bstate->next_index, msg);
+	bstate->next_index += 1;
+	return evicted;
+}
+
+static size_t run(struct broadcast_state *bstate, u8 **tags, const u8 *payload,
+		  bool linear)
+{
+	size_t num_evicted = 0;
+
+	for (size_t i = 0; i < tal_count(tags); i++) {
+		if (linear)
+			num_evicted += linear_queue_broadcast(bstate, 258,
+							      tags[i], payload);
+		else
+			num_evicted += queue_broadcast(bstate, 258,
+						       tags[i], payload);
+	}
+	return num_evicted;
+}
+
+int main(int argc, char *argv[])
+{
+	tal_t *ctx = tal_tmpctx(NULL);
+	struct broadcast_state *bstate;
+	size_t num_updates = 100000, num_channels = 50000, num_evicted;
+	struct timemono start, end;
+	struct queued_message *msg;
+	u64 index;
+	u8 **tags, *payload;
+	bool linear = false;
+
+	opt_register_noarg("--linear", opt_set_bool, &linear,
+			   "Also time the old linear scan replacement");
+	opt_parse(&argc, argv, opt_log_stderr_exit);
+
+	if (argc > 1)
+		num_updates = atoi(argv[1]);
+	if (argc > 2)
+		num_channels = atoi(argv[2]);
+	if (argc > 3 || num_channels < 1)
+		opt_usage_and_exit("[num_updates [num_channels]]");
+
+	/* Build the tags up front, so we only time the queue. */
+	tags = tal_arr(ctx, u8 *, num_updates);
+	for (size_t i = 0; i < num_updates; i++)
+		tags[i] = make_tag(tags, pseudorand(num_channels),
+				   pseudorand(2));
+	payload = tal_arrz(ctx, u8, 128);
+
+	bstate = new_broadcast_state(ctx);
+	start = time_mono();
+	num_evicted = run(bstate, tags, payload, false);
+	end = time_mono();
+
+	/* Exactly one message left per distinct tag. */
+	index = 0;
+	for (msg = uintmap_first(&bstate->broadcasts, &index);
+	     msg;
+	     msg = uintmap_after(&bstate->broadcasts, &index)) {
+		assert(msg->index == index);
+		assert(broadcast_map_get(bstate->by_tag, msg) == msg);
+		num_evicted++;
+	}
+	assert(num_evicted == num_updates);
+
+	printf("%zu channel_updates over %zu channels in %"PRIu64" msec (%"PRIu64" nanoseconds per update)\n",
+	       num_updates, num_channels,
+	       time_to_msec(timemono_between(end, start)),
+	       time_to_nsec(time_divide(timemono_between(end, start),
+					num_updates)));
+
+	if (linear) {
+		tal_free(bstate);
+		bstate = new_broadcast_state(ctx);
+		start = time_mono();
+		run(bstate, tags, payload, true);
+		end = time_mono();
+		printf("%zu linear channel_updates in %"PRIu64" msec (%"PRIu64" nanoseconds per update)\n",
+		       num_updates,
+		       time_to_msec(timemono_between(end, start)),
+		       time_to_nsec(time_divide(timemono_between(end, start),
+						num_updates)));
+	}
+
+	tal_free(ctx);
+	opt_free_table();
+	return 0;
+}
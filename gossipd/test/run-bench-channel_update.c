@@ -0,0 +1,267 @@
+#include <assert.h>
+#include <bitcoin/pubkey.h>
+#include <bitcoin/signature.h>
+#include <ccan/err/err.h>
+#include <ccan/opt/opt.h>
+#include <ccan/tal/str/str.h>
+#include <ccan/time/time.h>
+#include <common/pseudorand.h>
+#include <common/status.h>
+#include <common/type_to_string.h>
+#include <stdio.h>
+
+/* We create far too many connections to log them all. */
+#define status_trace(fmt, ...) do { } while(0)
+
+/* We use made-up pubkeys, so ordering is all we need. */
+static int fake_pubkey_cmp(const struct pubkey *a, const struct pubkey *b)
+{
+	return memcmp(a, b, sizeof(*a));
+}
+
+/* We don't sign our fake updates, so don't try to check them. */
+static bool fake_check_signed_hash(const struct sha256_double *hash,
+				   const secp256k1_ecdsa_signature *signature,
+				   const struct pubkey *key)
+{
+	return true;
+}
+
+/* Made-up pubkeys don't serialize either: order_node() only needs
+ * bytes which sort the same way. */
+static void fake_pubkey_to_der(u8 der[PUBKEY_DER_LEN], const struct pubkey *key)
+{
+	memcpy(der, key, PUBKEY_DER_LEN);
+}
+
+#define pubkey_cmp fake_pubkey_cmp
+#define pubkey_to_der fake_pubkey_to_der
+#define check_signed_hash fake_check_signed_hash
+#include "../routing.c"
+
+struct broadcast_state *new_broadcast_state(tal_t *ctx UNNEEDED)
+{
+	return NULL;
+}
+
+/* What our fake channel_update carries after the signature. */
+struct bench_update {
+	struct short_channel_id scid;
+	u32 timestamp;
+	u16 flags;
+};
+
+bool fromwire_channel_update(const void *p, size_t *plen UNNEEDED,
+			     secp256k1_ecdsa_signature *signature,
+			     struct bitcoin_blkid *chain_hash,
+			     struct short_channel_id *short_channel_id,
+			     u32 *timestamp, u16 *flags,
+			     u16 *cltv_expiry_delta,
+			     u64 *htlc_minimum_msat,
+			     u32 *fee_base_msat,
+			     u32 *fee_proportional_millionths)
+{
+	struct bench_update u;
+
+	memcpy(&u, (const u8 *)p + 66, sizeof(u));
+	memset(signature, 0, sizeof(*signature));
+	memset(chain_hash, 0, sizeof(*chain_hash));
+	*short_channel_id = u.scid;
+	*timestamp = u.timestamp;
+	*flags = u.flags;
+	*cltv_expiry_delta = 6;
+	*htlc_minimum_msat = 0;
+	*fee_base_msat = 1;
+	*fee_proportional_millionths = 10;
+	return true;
+}
+
+bool queue_broadcast(struct broadcast_state *bstate UNNEEDED,
+		     const int type UNNEEDED,
+		     const u8 *tag UNNEEDED,
+		     const u8 *payload UNNEEDED)
+{
+	return false;
+}
+
+void towire_short_channel_id(u8 **pptr UNNEEDED,
+			     const struct short_channel_id *short_channel_id UNNEEDED)
+{
+}
+
+void towire_u16(u8 **pptr UNNEEDED, u16 v UNNEEDED)
+{
+}
+
+/* AUTOGENERATED MOCKS START */
+/* Generated stub for fromwire_channel_announcement */
+bool fromwire_channel_announcement(const tal_t *ctx UNNEEDED, const void *p UNNEEDED, size_t *plen UNNEEDED, secp256k1_ecdsa_signature *node_signature_1 UNNEEDED, secp256k1_ecdsa_signature *node_signature_2 UNNEEDED, secp256k1_ecdsa_signature *bitcoin_signature_1 UNNEEDED, secp256k1_ecdsa_signature *bitcoin_signature_2 UNNEEDED, u8 **features UNNEEDED, struct bitcoin_blkid *chain_hash UNNEEDED, struct short_channel_id *short_channel_id UNNEEDED, struct pubkey *node_id_1 UNNEEDED, struct pubkey *node_id_2 UNNEEDED, struct pubkey *bitcoin_key_1 UNNEEDED, struct pubkey *bitcoin_key_2 UNNEEDED)
+{ fprintf(stderr, "fromwire_channel_announcement called!\n"); abort(); }
+/* Generated stub for fromwire_node_announcement */
+bool fromwire_node_announcement(const tal_t *ctx UNNEEDED, const void *p UNNEEDED, size_t *plen UNNEEDED, secp256k1_ecdsa_signature *signature UNNEEDED, u8 **features UNNEEDED, u32 *timestamp UNNEEDED, struct pubkey *node_id UNNEEDED, u8 rgb_color[3] UNNEEDED, u8 alias[32] UNNEEDED, u8 **addresses UNNEEDED)
+{ fprintf(stderr, "fromwire_node_announcement called!\n"); abort(); }
+/* Generated stub for fromwire_u8 */
+u8 fromwire_u8(const u8 **cursor UNNEEDED, size_t *max UNNEEDED)
+{ fprintf(stderr, "fromwire_u8 called!\n"); abort(); }
+/* Generated stub for fromwire_wireaddr */
+bool fromwire_wireaddr(const u8 **cursor UNNEEDED, size_t *max UNNEEDED, struct wireaddr *addr UNNEEDED)
+{ fprintf(stderr, "fromwire_wireaddr called!\n"); abort(); }
+/* Generated stub for gossip_store_add */
+void gossip_store_add(struct gossip_store *gs UNNEEDED, const u8 *msg UNNEEDED)
+{ fprintf(stderr, "gossip_store_add called!\n"); abort(); }
+/* Generated stub for status_failed */
+void status_failed(enum status_fail code UNNEEDED, const char *fmt UNNEEDED, ...)
+{ fprintf(stderr, "status_failed called!\n"); abort(); }
+/* Generated stub for towire_pubkey */
+void towire_pubkey(u8 **pptr UNNEEDED, const struct pubkey *pubkey UNNEEDED)
+{ fprintf(stderr, "towire_pubkey called!\n"); abort(); }
+/* AUTOGENERATED MOCKS END */
+
+const void *trc;
+
+static struct pubkey nodeid(size_t n)
+{
+	struct pubkey id;
+
+	memset(&id, 0, sizeof(id));
+	memcpy(&id, &n, sizeof(n));
+	return id;
+}
+
+static struct short_channel_id channelid(size_t n)
+{
+	struct short_channel_id scid;
+
+	scid.blocknum = 100000 + n / 1000;
+	scid.txnum = n % 1000;
+	scid.outnum = n % 3;
+	return scid;
+}
+
+/* Channel n joins neighbours on a ring, then second-neighbours, so
+ * every (from, to) pair is distinct. */
+static void add_channel(struct routing_state *rstate, size_t num_nodes,
+			size_t n)
+{
+	struct pubkey a = nodeid(n % num_nodes);
+	struct pubkey b = nodeid((n % num_nodes + 1 + n / num_nodes) % num_nodes);
+	struct short_channel_id scid = channelid(n);
+
+	half_add_connection(rstate, &a, &b, &scid,
+			    get_channel_direction(&a, &b));
+	half_add_connection(rstate, &b, &a, &scid,
+			    get_channel_direction(&b, &a));
+}
+
+static u8 *make_update(const tal_t *ctx, size_t n, u16 direction,
+		       u32 timestamp)
+{
+	u8 *update = tal_arrz(ctx, u8, 66 + sizeof(struct bench_update));
+	struct bench_update u;
+
+	memset(&u, 0, sizeof(u));
+	u.scid = channelid(n);
+	u.timestamp = timestamp;
+	u.flags = direction;
+	memcpy(update + 66, &u, sizeof(u));
+	return update;
+}
+
+/* What get_connection_by_scid used to do before we indexed channels. */
+static struct node_connection *
+linear_get_connection_by_scid(const struct routing_state *rstate,
+			      const struct short_channel_id *schanid,
+			      const u8 direction)
+{
+	struct node *n;
+	struct node_map_iter it;
+
+	for (n = node_map_first(rstate->nodes, &it);
+	     n;
+	     n = node_map_next(rstate->nodes, &it)) {
+		for (size_t i = 0; i < tal_count(n->out); i++) {
+			struct node_connection *c = n->out[i];
+			if (short_channel_id_eq(&c->short_channel_id, schanid)
+			    && (c->flags & 0x1) == direction)
+				return c;
+		}
+	}
+	return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+	static const struct bitcoin_blkid zerohash;
+	const tal_t *ctx = trc = tal_tmpctx(NULL);
+	struct routing_state *rstate;
+	size_t num_channels = 100, num_runs = 1000, num_nodes;
+	struct timemono start, end;
+	struct pubkey me = nodeid(0);
+	u8 **updates;
+	size_t *chans;
+	bool linear = false;
+
+	secp256k1_ctx = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY
+						 | SECP256K1_CONTEXT_SIGN);
+
+	rstate = new_routing_state(ctx, &zerohash, &me);
+	opt_register_noarg("--linear", opt_set_bool, &linear,
+			   "Also time the old linear scan lookup");
+
+	opt_parse(&argc, argv, opt_log_stderr_exit);
+
+	if (argc > 1)
+		num_channels = atoi(argv[1]);
+	if (argc > 2)
+		num_runs = atoi(argv[2]);
+	if (argc > 3 || num_channels < 10)
+		opt_usage_and_exit("[num_channels [num_runs]]");
+
+	num_nodes = num_channels / 2;
+	for (size_t i = 0; i < num_channels; i++)
+		add_channel(rstate, num_nodes, i);
+
+	/* Build the updates up front, so we only time ingestion. */
+	updates = tal_arr(ctx, u8 *, num_runs);
+	chans = tal_arr(ctx, size_t, num_runs);
+	for (size_t i = 0; i < num_runs; i++) {
+		chans[i] = pseudorand(num_channels);
+		updates[i] = make_update(updates, chans[i], pseudorand(2), i + 1);
+	}
+
+	start = time_mono();
+	for (size_t i = 0; i < num_runs; i++)
+		handle_channel_update(rstate, updates[i]);
+	end = time_mono();
+
+	/* Every update should have landed on its channel. */
+	for (size_t i = 0; i < num_runs; i++) {
+		struct short_channel_id scid = channelid(chans[i]);
+		assert(get_connection_by_scid(rstate, &scid, 0)
+		       || get_connection_by_scid(rstate, &scid, 1));
+	}
+
+	printf("%zu channel_updates in %zu channels in %"PRIu64" msec (%"PRIu64" nanoseconds per update)\n",
+	       num_runs, num_channels,
+	       time_to_msec(timemono_between(end, start)),
+	       time_to_nsec(time_divide(timemono_between(end, start), num_runs)));
+
+	if (linear) {
+		start = time_mono();
+		for (size_t i = 0; i < num_runs; i++) {
+			struct short_channel_id scid = channelid(chans[i]);
+			assert(linear_get_connection_by_scid(rstate, &scid, 0)
+			       == get_connection_by_scid(rstate, &scid, 0));
+		}
+		end = time_mono();
+		printf("%zu linear scan lookups in %"PRIu64" msec (%"PRIu64" nanoseconds per lookup)\n",
+		       num_runs,
+		       time_to_msec(timemono_between(end, start)),
+		       time_to_nsec(time_divide(timemono_between(end, start), num_runs)));
+	}
+
+	tal_free(ctx);
+	secp256k1_context_destroy(secp256k1_ctx);
+	opt_free_table();
+	return 0;
+}
@@ -0,0 +1,190 @@
+#include <assert.h>
+#include <bitcoin/pubkey.h>
+#include <bitcoin/script.h>
+#include <common/status.h>
+#include <common/utils.h>
+#include <stdio.h>
+
+#define status_trace(fmt, ...) do { } while(0)
+
+/* We're only interested in how many signatures we check. */
+static size_t num_sigchecks;
+static bool fake_check_signed_hash(const struct sha256_double *hash,
+				   const secp256k1_ecdsa_signature *signature,
+				   const struct pubkey *key)
+{
+	num_sigchecks++;
+	return true;
+}
+
+#define check_signed_hash fake_check_signed_hash
+#include "../routing.c"
+
+struct broadcast_state *new_broadcast_state(tal_t *ctx UNNEEDED)
+{
+	return NULL;
+}
+
+bool queue_broadcast(struct broadcast_state *bstate UNNEEDED,
+		     const int type UNNEEDED,
+		     const u8 *tag UNNEEDED,
+		     const u8 *payload UNNEEDED)
+{
+	return false;
+}
+
+void towire_pubkey(u8 **pptr UNNEEDED, const struct pubkey *pubkey UNNEEDED)
+{
+}
+
+/* What our fake announcements say, whatever their bytes. */
+static struct pubkey node_1, node_2, bitcoin_1, bitcoin_2;
+static struct short_channel_id scid;
+static u32 node_timestamp;
+
+bool fromwire_channel_announcement(const tal_t *ctx, const void *p UNNEEDED, size_t *plen UNNEEDED, secp256k1_ecdsa_signature *node_signature_1, secp256k1_ecdsa_signature *node_signature_2, secp256k1_ecdsa_signature *bitcoin_signature_1, secp256k1_ecdsa_signature *bitcoin_signature_2, u8 **features, struct bitcoin_blkid *chain_hash, struct short_channel_id *short_channel_id, struct pubkey *node_id_1, struct pubkey *node_id_2, struct pubkey *bitcoin_key_1, struct pubkey *bitcoin_key_2)
+{
+	memset(node_signature_1, 0, sizeof(*node_signature_1));
+	memset(node_signature_2, 0, sizeof(*node_signature_2));
+	memset(bitcoin_signature_1, 0, sizeof(*bitcoin_signature_1));
+	memset(bitcoin_signature_2, 0, sizeof(*bitcoin_signature_2));
+	*features = tal_arr(ctx, u8, 0);
+	memset(chain_hash, 0, sizeof(*chain_hash));
+	*short_channel_id = scid;
+	*node_id_1 = node_1;
+	*node_id_2 = node_2;
+	*bitcoin_key_1 = bitcoin_1;
+	*bitcoin_key_2 = bitcoin_2;
+	return true;
+}
+
+bool fromwire_node_announcement(const tal_t *ctx, const void *p UNNEEDED, size_t *plen UNNEEDED, secp256k1_ecdsa_signature *signature, u8 **features, u32 *timestamp, struct pubkey *node_id, u8 rgb_color[3], u8 alias[32], u8 **addresses)
+{
+	memset(signature, 0, sizeof(*signature));
+	*features = tal_arr(ctx, u8, 0);
+	*timestamp = node_timestamp;
+	*node_id = node_1;
+	memset(rgb_color, 0, 3);
+	memset(alias, 0, 32);
+	*addresses = tal_arr(ctx, u8, 0);
+	return true;
+}
+
+/* AUTOGENERATED MOCKS START */
+/* Generated stub for fromwire_channel_update */
+bool fromwire_channel_update(const void *p UNNEEDED, size_t *plen UNNEEDED, secp256k1_ecdsa_signature *signature UNNEEDED, struct bitcoin_blkid *chain_hash UNNEEDED, struct short_channel_id *short_channel_id UNNEEDED, u32 *timestamp UNNEEDED, u16 *flags UNNEEDED, u16 *cltv_expiry_delta UNNEEDED, u64 *htlc_minimum_msat UNNEEDED, u32 *fee_base_msat UNNEEDED, u32 *fee_proportional_millionths UNNEEDED)
+{ fprintf(stderr, "fromwire_channel_update called!\n"); abort(); }
+/* Generated stub for fromwire_u8 */
+u8 fromwire_u8(const u8 **cursor UNNEEDED, size_t *max UNNEEDED)
+{ fprintf(stderr, "fromwire_u8 called!\n"); abort(); }
+/* Generated stub for fromwire_wireaddr */
+bool fromwire_wireaddr(const u8 **cursor UNNEEDED, size_t *max UNNEEDED, struct wireaddr *addr UNNEEDED)
+{ fprintf(stderr, "fromwire_wireaddr called!\n"); abort(); }
+/* Generated stub for gossip_store_add */
+void gossip_store_add(struct gossip_store *gs UNNEEDED, const u8 *msg UNNEEDED)
+{ fprintf(stderr, "gossip_store_add called!\n"); abort(); }
+/* Generated stub for status_failed */
+void status_failed(enum status_fail code UNNEEDED, const char *fmt UNNEEDED, ...)
+{ fprintf(stderr, "status_failed called!\n"); abort(); }
+/* Generated stub for towire_short_channel_id */
+void towire_short_channel_id(u8 **pptr UNNEEDED,
+			     const struct short_channel_id *short_channel_id UNNEEDED)
+{ fprintf(stderr, "towire_short_channel_id called!\n"); abort(); }
+/* Generated stub for towire_u16 */
+void towire_u16(u8 **pptr UNNEEDED, u16 v UNNEEDED)
+{ fprintf(stderr, "towire_u16 called!\n"); abort(); }
+/* AUTOGENERATED MOCKS END */
+
+const void *trc;
+
+static struct pubkey make_key(char c)
+{
+	struct privkey tmp;
+	struct pubkey key;
+
+	memset(&tmp, c, sizeof(tmp));
+	pubkey_from_privkey(&tmp, &key);
+	return key;
+}
+
+/* Only the bytes after the signatures count as the announcement. */
+static u8 *make_announce(const tal_t *ctx, u8 variant)
+{
+	u8 *announce = tal_arrz(ctx, u8, 300);
+	announce[258] = variant;
+	return announce;
+}
+
+int main(void)
+{
+	static const struct bitcoin_blkid zerohash;
+	const tal_t *ctx = trc = tal_tmpctx(NULL);
+	struct routing_state *rstate;
+	const struct short_channel_id *pending_scid;
+	struct pubkey me;
+	struct node *n;
+	u8 *announce, *outscript;
+
+	secp256k1_ctx = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY
+						 | SECP256K1_CONTEXT_SIGN);
+
+	me = make_key('m');
+	node_1 = make_key('a');
+	node_2 = make_key('b');
+	bitcoin_1 = make_key('c');
+	bitcoin_2 = make_key('d');
+	scid.blocknum = 100;
+	scid.txnum = 2;
+	scid.outnum = 1;
+	outscript = scriptpubkey_p2wsh(ctx,
+				       bitcoin_redeem_2of2(ctx, &bitcoin_1,
+							   &bitcoin_2));
+
+	rstate = new_routing_state(ctx, &zerohash, &me);
+
+	/* First one gets checked, and needs a txout lookup. */
+	announce = make_announce(ctx, 0);
+	pending_scid = handle_channel_announcement(rstate, announce);
+	assert(pending_scid);
+	assert(num_sigchecks == 4);
+
+	/* The same again, while that's pending, is ignored. */
+	assert(!handle_channel_announcement(rstate, announce));
+	assert(num_sigchecks == 4);
+
+	/* As is the same once we know the channel. */
+	handle_pending_cannouncement(rstate, &scid, outscript);
+	assert(get_connection_by_scid(rstate, &scid, 0));
+	/* Both directions share one announcement in the store. */
+	assert(rstate->store_live == 1);
+	assert(!handle_channel_announcement(rstate, announce));
+	assert(num_sigchecks == 4);
+
+	/* A different announcement for the same channel is checked. */
+	announce = make_announce(ctx, 1);
+	assert(handle_channel_announcement(rstate, announce));
+	assert(num_sigchecks == 8);
+
+	/* A node_announcement is only checked if we'd use it. */
+	node_timestamp = 1;
+	handle_node_announcement(rstate, announce);
+	assert(num_sigchecks == 9);
+	assert(get_node(rstate, &node_1)->last_timestamp == 1);
+	handle_node_announcement(rstate, announce);
+	assert(num_sigchecks == 9);
+	assert(rstate->store_live == 2);
+
+	/* Losing the channel loses its announcement, and the node's. */
+	tal_free(get_connection_by_scid(rstate, &scid, 0));
+	assert(rstate->store_live == 2);
+	tal_free(get_connection_by_scid(rstate, &scid, 1));
+	assert(rstate->store_live == 1);
+	n = get_node(rstate, &node_1);
+	node_map_del(rstate->nodes, n);
+	tal_free(n);
+	assert(rstate->store_live == 0);
+
+	tal_free(ctx);
+	secp256k1_context_destroy(secp256k1_ctx);
+	return 0;
+}
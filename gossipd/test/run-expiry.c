@@ -0,0 +1,159 @@
+#include <assert.h>
+#include <bitcoin/pubkey.h>
+#include <bitcoin/signature.h>
+#include <ccan/tal/str/str.h>
+#include <common/pseudorand.h>
+#include <common/status.h>
+#include <common/type_to_string.h>
+#include <stdio.h>
+
+/* We create far too many connections to log them all. */
+#define status_trace(fmt, ...) do { } while(0)
+
+/* We use made-up pubkeys, so ordering is all we need. */
+static int fake_pubkey_cmp(const struct pubkey *a, const struct pubkey *b)
+{
+	return memcmp(a, b, sizeof(*a));
+}
+
+/* Made-up pubkeys don't serialize either: order_node() only needs
+ * bytes which sort the same way. */
+static void fake_pubkey_to_der(u8 der[PUBKEY_DER_LEN], const struct pubkey *key)
+{
+	memcpy(der, key, PUBKEY_DER_LEN);
+}
+
+#define pubkey_cmp fake_pubkey_cmp
+#define pubkey_to_der fake_pubkey_to_der
+#include "../routing.c"
+
+struct broadcast_state *new_broadcast_state(tal_t *ctx UNNEEDED)
+{
+	return NULL;
+}
+
+bool queue_broadcast(struct broadcast_state *bstate UNNEEDED,
+		     const int type UNNEEDED,
+		     const u8 *tag UNNEEDED,
+		     const u8 *payload UNNEEDED)
+{
+	return false;
+}
+
+void towire_short_channel_id(u8 **pptr UNNEEDED,
+			     const struct short_channel_id *short_channel_id UNNEEDED)
+{
+}
+
+void towire_u16(u8 **pptr UNNEEDED, u16 v UNNEEDED)
+{
+}
+
+/* AUTOGENERATED MOCKS START */
+/* Generated stub for fromwire_channel_announcement */
+bool fromwire_channel_announcement(const tal_t *ctx UNNEEDED, const void *p UNNEEDED, size_t *plen UNNEEDED, secp256k1_ecdsa_signature *node_signature_1 UNNEEDED, secp256k1_ecdsa_signature *node_signature_2 UNNEEDED, secp256k1_ecdsa_signature *bitcoin_signature_1 UNNEEDED, secp256k1_ecdsa_signature *bitcoin_signature_2 UNNEEDED, u8 **features UNNEEDED, struct bitcoin_blkid *chain_hash UNNEEDED, struct short_channel_id *short_channel_id UNNEEDED, struct pubkey *node_id_1 UNNEEDED, struct pubkey *node_id_2 UNNEEDED, struct pubkey *bitcoin_key_1 UNNEEDED, struct pubkey *bitcoin_key_2 UNNEEDED)
+{ fprintf(stderr, "fromwire_channel_announcement called!\n"); abort(); }
+/* Generated stub for fromwire_channel_update */
+bool fromwire_channel_update(const void *p UNNEEDED, size_t *plen UNNEEDED, secp256k1_ecdsa_signature *signature UNNEEDED, struct bitcoin_blkid *chain_hash UNNEEDED, struct short_channel_id *short_channel_id UNNEEDED, u32 *timestamp UNNEEDED, u16 *flags UNNEEDED, u16 *cltv_expiry_delta UNNEEDED, u64 *htlc_minimum_msat UNNEEDED, u32 *fee_base_msat UNNEEDED, u32 *fee_proportional_millionths UNNEEDED)
+{ fprintf(stderr, "fromwire_channel_update called!\n"); abort(); }
+/* Generated stub for fromwire_node_announcement */
+bool fromwire_node_announcement(const tal_t *ctx UNNEEDED, const void *p UNNEEDED, size_t *plen UNNEEDED, secp256k1_ecdsa_signature *signature UNNEEDED, u8 **features UNNEEDED, u32 *timestamp UNNEEDED, struct pubkey *node_id UNNEEDED, u8 rgb_color[3] UNNEEDED, u8 alias[32] UNNEEDED, u8 **addresses UNNEEDED)
+{ fprintf(stderr, "fromwire_node_announcement called!\n"); abort(); }
+/* Generated stub for fromwire_u8 */
+u8 fromwire_u8(const u8 **cursor UNNEEDED, size_t *max UNNEEDED)
+{ fprintf(stderr, "fromwire_u8 called!\n"); abort(); }
+/* Generated stub for fromwire_wireaddr */
+bool fromwire_wireaddr(const u8 **cursor UNNEEDED, size_t *max UNNEEDED, struct wireaddr *addr UNNEEDED)
+{ fprintf(stderr, "fromwire_wireaddr called!\n"); abort(); }
+/* Generated stub for gossip_store_add */
+void gossip_store_add(struct gossip_store *gs UNNEEDED, const u8 *msg UNNEEDED)
+{ fprintf(stderr, "gossip_store_add called!\n"); abort(); }
+/* Generated stub for status_failed */
+void status_failed(enum status_fail code UNNEEDED, const char *fmt UNNEEDED, ...)
+{ fprintf(stderr, "status_failed called!\n"); abort(); }
+/* Generated stub for towire_pubkey */
+void towire_pubkey(u8 **pptr UNNEEDED, const struct pubkey *pubkey UNNEEDED)
+{ fprintf(stderr, "towire_pubkey called!\n"); abort(); }
+/* AUTOGENERATED MOCKS END */
+
+const void *trc;
+
+static struct pubkey nodeid(size_t n)
+{
+	struct pubkey id;
+
+	memset(&id, 0, sizeof(id));
+	memcpy(&id, &n, sizeof(n));
+	return id;
+}
+
+/* Give nc a new timestamp, as a channel_update would. */
+static void set_timestamp(struct routing_state *rstate,
+			  struct node_connection *nc, s64 timestamp)
+{
+	nc->last_timestamp = timestamp;
+	expiry_update(rstate, nc);
+}
+
+static void check_heap(const struct routing_state *rstate)
+{
+	for (size_t i = 0; i < tal_count(rstate->expiry); i++) {
+		assert(rstate->expiry[i]->expiry_index == i);
+		if (i)
+			assert(rstate->expiry[(i - 1) / 2]->last_timestamp
+			       <= rstate->expiry[i]->last_timestamp);
+	}
+}
+
+int main(void)
+{
+	static const struct bitcoin_blkid zerohash;
+	const tal_t *ctx = trc = tal_tmpctx(NULL);
+	struct routing_state *rstate;
+	struct pubkey me = nodeid(0);
+	struct node_connection **ncs, *nc;
+	size_t num = 1000;
+	s64 prev;
+
+	secp256k1_ctx = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY
+						 | SECP256K1_CONTEXT_SIGN);
+	rstate = new_routing_state(ctx, &zerohash, &me);
+
+	ncs = tal_arr(ctx, struct node_connection *, num);
+	for (size_t i = 0; i < num; i++) {
+		struct pubkey a = nodeid(i), b = nodeid(i + 1);
+		struct short_channel_id scid;
+
+		memset(&scid, 0, sizeof(scid));
+		scid.blocknum = i;
+		ncs[i] = half_add_connection(rstate, &a, &b, &scid, 0);
+		/* Not announced yet, so nothing to expire. */
+		assert(ncs[i]->expiry_index == NO_EXPIRY);
+		set_timestamp(rstate, ncs[i], pseudorand(1000));
+		check_heap(rstate);
+	}
+	assert(tal_count(rstate->expiry) == num);
+
+	/* Refresh some, and free some from the middle. */
+	for (size_t i = 0; i < num; i += 3) {
+		set_timestamp(rstate, ncs[i], 1000 + pseudorand(1000));
+		check_heap(rstate);
+	}
+	for (size_t i = 1; i < num; i += 7) {
+		tal_free(ncs[i]);
+		check_heap(rstate);
+	}
+
+	/* Everything comes off oldest first. */
+	prev = -1;
+	while ((nc = routing_first_expiry(rstate)) != NULL) {
+		assert(nc->last_timestamp >= prev);
+		prev = nc->last_timestamp;
+		tal_free(nc);
+		check_heap(rstate);
+	}
+
+	tal_free(ctx);
+	secp256k1_context_destroy(secp256k1_ctx);
+	return 0;
+}
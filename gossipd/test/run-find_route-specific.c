@@ -34,6 +34,9 @@ u8 fromwire_u8(const u8 **cursor UNNEEDED, size_t *max UNNEEDED)
 /* Generated stub for fromwire_wireaddr */
 bool fromwire_wireaddr(const u8 **cursor UNNEEDED, size_t *max UNNEEDED, struct wireaddr *addr UNNEEDED)
 { fprintf(stderr, "fromwire_wireaddr called!\n"); abort(); }
+/* Generated stub for gossip_store_add */
+void gossip_store_add(struct gossip_store *gs UNNEEDED, const u8 *msg UNNEEDED)
+{ fprintf(stderr, "gossip_store_add called!\n"); abort(); }
 /* Generated stub for queue_broadcast */
 bool queue_broadcast(struct broadcast_state *bstate UNNEEDED,
 			     const int type UNNEEDED,
@@ -85,41 +88,26 @@ int main(void)
 
 	/* [{'active': True, 'short_id': '6990:2:1/1', 'fee_per_kw': 10, 'delay': 5, 'flags': 1, 'destination': '0230ad0e74ea03976b28fda587bb75bdd357a1938af4424156a18265167f5e40ae', 'source': '02ea622d5c8d6143f15ed3ce1d501dd0d3d09d3b1c83a44d0034949f8a9ab60f06', 'last_update': 1504064344}, */
 	nc = get_or_make_connection(rstate, &c, &b);
-	nc->active = true;
-	nc->base_fee = 0;
-	nc->proportional_fee = 10;
-	nc->delay = 5;
 	nc->flags = 1;
-	nc->last_timestamp = 1504064344;
+	set_connection_values(rstate, nc, 0, 10, 5, true, 1504064344, 0);
 
 	/* {'active': True, 'short_id': '6989:2:1/0', 'fee_per_kw': 10, 'delay': 5, 'flags': 0, 'destination': '03c173897878996287a8100469f954dd820fcd8941daed91c327f168f3329be0bf', 'source': '0230ad0e74ea03976b28fda587bb75bdd357a1938af4424156a18265167f5e40ae', 'last_update': 1504064344}, */
 	nc = get_or_make_connection(rstate, &b, &a);
-	nc->active = true;
-	nc->base_fee = 0;
-	nc->proportional_fee = 10;
-	nc->delay = 5;
 	nc->flags = 0;
-	nc->last_timestamp = 1504064344;
+	set_connection_values(rstate, nc, 0, 10, 5, true, 1504064344, 0);
 
 	/* {'active': True, 'short_id': '6990:2:1/0', 'fee_per_kw': 10, 'delay': 5, 'flags': 0, 'destination': '02ea622d5c8d6143f15ed3ce1d501dd0d3d09d3b1c83a44d0034949f8a9ab60f06', 'source': '0230ad0e74ea03976b28fda587bb75bdd357a1938af4424156a18265167f5e40ae', 'last_update': 1504064344}, */
 	nc = get_or_make_connection(rstate, &b, &c);
-	nc->active = true;
-	nc->base_fee = 0;
-	nc->proportional_fee = 10;
-	nc->delay = 5;
 	nc->flags = 0;
-	nc->last_timestamp = 1504064344;
+	set_connection_values(rstate, nc, 0, 10, 5, true, 1504064344, 0);
 
 	/* {'active': True, 'short_id': '6989:2:1/1', 'fee_per_kw': 10, 'delay': 5, 'flags': 1, 'destination': '0230ad0e74ea03976b28fda587bb75bdd357a1938af4424156a18265167f5e40ae', 'source': '03c173897878996287a8100469f954dd820fcd8941daed91c327f168f3329be0bf', 'last_update': 1504064344}]} */
 	nc = get_or_make_connection(rstate, &a, &b);
-	nc->active = true;
-	nc->base_fee = 0;
-	nc->proportional_fee = 10;
-	nc->delay = 5;
 	nc->flags = 1;
-	nc->last_timestamp = 1504064344;
+	set_connection_values(rstate, nc, 0, 10, 5, true, 1504064344, 0);
 
-	nc = find_route(ctx, rstate, &a, &c, 100000, riskfactor, &fee, &route);
+	nc = find_route(ctx, rstate, rstate->route_query, &a, &c, 100000,
+			riskfactor, &fee, &route);
 	assert(nc);
 	assert(tal_count(route) == 1);
 	assert(pubkey_eq(&route[0]->src->id, &b));
@@ -27,6 +27,9 @@ u8 fromwire_u8(const u8 **cursor UNNEEDED, size_t *max UNNEEDED)
 /* Generated stub for fromwire_wireaddr */
 bool fromwire_wireaddr(const u8 **cursor UNNEEDED, size_t *max UNNEEDED, struct wireaddr *addr UNNEEDED)
 { fprintf(stderr, "fromwire_wireaddr called!\n"); abort(); }
+/* Generated stub for gossip_store_add */
+void gossip_store_add(struct gossip_store *gs UNNEEDED, const u8 *msg UNNEEDED)
+{ fprintf(stderr, "gossip_store_add called!\n"); abort(); }
 /* Generated stub for queue_broadcast */
 bool queue_broadcast(struct broadcast_state *bstate UNNEEDED,
 			     const int type UNNEEDED,
@@ -58,15 +61,124 @@ static struct node_connection *add_connection(struct routing_state *rstate,
 					      u32 delay)
 {
 	struct node_connection *c = get_or_make_connection(rstate, from, to);
-	c->base_fee = base_fee;
-	c->proportional_fee = proportional_fee;
-	c->delay = delay;
-	c->active = true;
 	memset(&c->short_channel_id, 0, sizeof(c->short_channel_id));
 	c->flags = get_channel_direction(from, to);
+	set_connection_values(rstate, c, base_fee, proportional_fee, delay,
+			      true, 0, 0);
 	return c;
 }
 
+/* Run both route engines, and make sure they agree. */
+static struct node_connection *
+find_route_both(const tal_t *ctx, struct routing_state *rstate,
+		const struct pubkey *from, const struct pubkey *to,
+		u64 msatoshi, double riskfactor,
+		u64 *fee, struct node_connection ***route)
+{
+	struct node_connection *nc, *nc_bfg, **route_bfg;
+	struct route_query *query = new_route_query(ctx);
+	u64 fee_bfg;
+
+	/* Separate scratch space, so neither query disturbs the other. */
+	rstate->route_engine = ROUTE_ENGINE_BFG;
+	nc_bfg = find_route(ctx, rstate, query, from, to, msatoshi, riskfactor,
+			    &fee_bfg, &route_bfg);
+	rstate->route_engine = ROUTE_ENGINE_LAYERED;
+	nc = find_route(ctx, rstate, rstate->route_query, from, to,
+			msatoshi, riskfactor, fee, route);
+	tal_free(query);
+
+	assert(nc == nc_bfg);
+	if (nc) {
+		assert(*fee == fee_bfg);
+		assert(tal_count(*route) == tal_count(route_bfg));
+		for (size_t i = 0; i < tal_count(*route); i++)
+			assert((*route)[i] == route_bfg[i]);
+	}
+	return nc;
+}
+
+static struct pubkey nodeid(size_t n)
+{
+	struct privkey tmp;
+	struct pubkey id;
+
+	memset(&tmp, 0, sizeof(tmp));
+	memcpy(&tmp, &n, sizeof(n));
+	tmp.secret.data[31] = 1;
+	pubkey_from_privkey(&tmp, &id);
+	return id;
+}
+
+/* Random graphs, where routes may need many hops, inactive channels
+ * must be avoided, and a cheap route may be too long: both engines must
+ * still give exactly the same answer. */
+static void test_random_graphs(const tal_t *ctx, size_t num_nodes,
+			       size_t num_queries)
+{
+	static const struct bitcoin_blkid zerohash;
+	struct pubkey me = nodeid(0);
+	const double riskfactor = 1.0 / BLOCKS_PER_YEAR / 10000;
+	struct routing_state *rstate = new_routing_state(ctx, &zerohash, &me);
+	size_t found = 0;
+
+	for (size_t i = 0; i < num_nodes; i++) {
+		struct pubkey id = nodeid(i);
+		new_node(rstate, &id);
+	}
+
+	/* A long, cheap chain, plus random (dearer) shortcuts. */
+	for (size_t i = 1; i < num_nodes; i++) {
+		struct pubkey from = nodeid(i - 1), to = nodeid(i);
+		add_connection(rstate, &from, &to, 0, 1, 1);
+		add_connection(rstate, &to, &from, 0, 1, 1);
+	}
+	for (size_t i = 0; i < num_nodes * 2; i++) {
+		struct pubkey from = nodeid(pseudorand(num_nodes));
+		struct pubkey to = nodeid(pseudorand(num_nodes));
+		struct node_connection *c;
+
+		if (pubkey_eq(&from, &to))
+			continue;
+		c = add_connection(rstate, &from, &to,
+				   pseudorand(1000), pseudorand(1000),
+				   pseudorand(144));
+		if (pseudorand(10) == 0)
+			set_connection_values(rstate, c, c->base_fee,
+					      c->proportional_fee, c->delay,
+					      false, 0, 0);
+	}
+
+	for (size_t i = 0; i < num_queries; i++) {
+		const struct route_graph *graph;
+		struct node *n;
+		struct node_connection *c;
+		struct pubkey from = nodeid(pseudorand(num_nodes));
+		struct pubkey to = nodeid(pseudorand(num_nodes));
+		struct node_connection **route;
+		u64 fee;
+
+		found += (find_route_both(ctx, rstate, &from, &to,
+					  pseudorand(1000000) + 1, riskfactor,
+					  &fee, &route) != NULL);
+
+		/* Updates are patched into the snapshot, not rebuilt. */
+		graph = get_route_graph(rstate);
+		n = rstate->node_array[pseudorand(num_nodes)];
+		if (!tal_count(n->in))
+			continue;
+		c = n->in[pseudorand(tal_count(n->in))];
+		set_connection_values(rstate, c,
+				      pseudorand(1000), pseudorand(1000),
+				      pseudorand(144), pseudorand(10) != 0,
+				      0, 0);
+		assert(rstate->route_graph == graph);
+	}
+	/* Most of them should have worked. */
+	assert(found > num_queries / 2);
+	tal_free(rstate);
+}
+
 int main(void)
 {
 	static const struct bitcoin_blkid zerohash;
@@ -95,7 +207,7 @@ int main(void)
 	/* A<->B */
 	add_connection(rstate, &a, &b, 1, 1, 1);
 
-	nc = find_route(ctx, rstate, &a, &b, 1000, riskfactor, &fee, &route);
+	nc = find_route_both(ctx, rstate, &a, &b, 1000, riskfactor, &fee, &route);
 	assert(nc);
 	assert(tal_count(route) == 0);
 	assert(fee == 0);
@@ -110,7 +222,7 @@ int main(void)
 	status_trace("C = %s", type_to_string(trc, struct pubkey, &c));
 	add_connection(rstate, &b, &c, 1, 1, 1);
 
-	nc = find_route(ctx, rstate, &a, &c, 1000, riskfactor, &fee, &route);
+	nc = find_route_both(ctx, rstate, &a, &c, 1000, riskfactor, &fee, &route);
 	assert(nc);
 	assert(tal_count(route) == 1);
 	assert(fee == 1);
@@ -125,27 +237,30 @@ int main(void)
 	add_connection(rstate, &d, &c, 0, 2, 1);
 
 	/* Will go via D for small amounts. */
-	nc = find_route(ctx, rstate, &a, &c, 1000, riskfactor, &fee, &route);
+	nc = find_route_both(ctx, rstate, &a, &c, 1000, riskfactor, &fee, &route);
 	assert(nc);
 	assert(tal_count(route) == 1);
 	assert(pubkey_eq(&route[0]->src->id, &d));
 	assert(fee == 0);
 
 	/* Will go via B for large amounts. */
-	nc = find_route(ctx, rstate, &a, &c, 3000000, riskfactor, &fee, &route);
+	nc = find_route_both(ctx, rstate, &a, &c, 3000000, riskfactor, &fee, &route);
 	assert(nc);
 	assert(tal_count(route) == 1);
 	assert(pubkey_eq(&route[0]->src->id, &b));
 	assert(fee == 1 + 3);
 
 	/* Make B->C inactive, force it back via D */
-	get_connection(rstate, &b, &c)->active = false;
-	nc = find_route(ctx, rstate, &a, &c, 3000000, riskfactor, &fee, &route);
+	set_connection_values(rstate, get_connection(rstate, &b, &c),
+			      1, 1, 1, false, 0, 0);
+	nc = find_route_both(ctx, rstate, &a, &c, 3000000, riskfactor, &fee, &route);
 	assert(nc);
 	assert(tal_count(route) == 1);
 	assert(pubkey_eq(&route[0]->src->id, &d));
 	assert(fee == 0 + 6);
 
+	test_random_graphs(ctx, 100, 500);
+
 	tal_free(ctx);
 	secp256k1_context_destroy(secp256k1_ctx);
 	return 0;
@@ -0,0 +1,206 @@
+#include <assert.h>
+#include <ccan/endian/endian.h>
+#include <common/status.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#define status_trace(fmt, ...) do { } while(0)
+
+#include "../gossip_store.c"
+
+/* How many of each we've been asked to replay. */
+static size_t num_replayed[3];
+
+bool routing_add_channel_announcement(struct routing_state *rstate UNNEEDED,
+				      const u8 *announce UNNEEDED)
+{
+	num_replayed[0]++;
+	return true;
+}
+
+bool routing_add_channel_update(struct routing_state *rstate UNNEEDED,
+				const u8 *update UNNEEDED)
+{
+	num_replayed[1]++;
+	return true;
+}
+
+bool routing_add_node_announcement(struct routing_state *rstate UNNEEDED,
+				   const u8 *node_ann UNNEEDED)
+{
+	num_replayed[2]++;
+	return true;
+}
+
+int fromwire_peektype(const u8 *cursor)
+{
+	be16 be_type;
+
+	if (tal_len(cursor) < sizeof(be_type))
+		return -1;
+	memcpy(&be_type, cursor, sizeof(be_type));
+	return be16_to_cpu(be_type);
+}
+
+/* AUTOGENERATED MOCKS START */
+/* Generated stub for channel_map_channel_eq */
+bool channel_map_channel_eq(const struct routing_channel *chan UNNEEDED,
+			    const struct short_channel_id *scid UNNEEDED)
+{ fprintf(stderr, "channel_map_channel_eq called!\n"); abort(); }
+/* Generated stub for channel_map_hash_key */
+size_t channel_map_hash_key(const struct short_channel_id *scid UNNEEDED)
+{ fprintf(stderr, "channel_map_hash_key called!\n"); abort(); }
+/* Generated stub for channel_map_keyof_channel */
+const struct short_channel_id *channel_map_keyof_channel(const struct routing_channel *chan UNNEEDED)
+{ fprintf(stderr, "channel_map_keyof_channel called!\n"); abort(); }
+/* Generated stub for node_map_hash_key */
+size_t node_map_hash_key(const secp256k1_pubkey *key UNNEEDED)
+{ fprintf(stderr, "node_map_hash_key called!\n"); abort(); }
+/* Generated stub for node_map_keyof_node */
+const secp256k1_pubkey *node_map_keyof_node(const struct node *n UNNEEDED)
+{ fprintf(stderr, "node_map_keyof_node called!\n"); abort(); }
+/* Generated stub for node_map_node_eq */
+bool node_map_node_eq(const struct node *n UNNEEDED, const secp256k1_pubkey *key UNNEEDED)
+{ fprintf(stderr, "node_map_node_eq called!\n"); abort(); }
+/* Generated stub for status_failed */
+void status_failed(enum status_fail code UNNEEDED, const char *fmt UNNEEDED, ...)
+{ fprintf(stderr, "status_failed called!\n"); abort(); }
+/* AUTOGENERATED MOCKS END */
+
+static u8 *make_msg(const tal_t *ctx, int type, size_t len)
+{
+	u8 *msg = tal_arrz(ctx, u8, len);
+	be16 be_type = cpu_to_be16(type);
+
+	memcpy(msg, &be_type, sizeof(be_type));
+	return msg;
+}
+
+static off_t store_size(void)
+{
+	struct stat st;
+
+	assert(stat(GOSSIP_STORE_FILENAME, &st) == 0);
+	return st.st_size;
+}
+
+static void reset_replayed(void)
+{
+	memset(num_replayed, 0, sizeof(num_replayed));
+}
+
+int main(void)
+{
+	const tal_t *ctx = tal_tmpctx(NULL);
+	char dirname[] = "/tmp/gossip_store-XXXXXX";
+	struct routing_state *rstate;
+	struct gossip_store *gs;
+	beint32_t belen;
+	off_t size;
+	int fd;
+
+	assert(mkdtemp(dirname));
+	assert(chdir(dirname) == 0);
+
+	/* Nothing in it for compaction to keep. */
+	rstate = tal(ctx, struct routing_state);
+	rstate->channels = tal(rstate, struct channel_map);
+	channel_map_init(rstate->channels);
+	rstate->nodes = tal(rstate, struct node_map);
+	node_map_init(rstate->nodes);
+	rstate->store_live = 0;
+
+	/* A fresh store is just a header. */
+	gs = gossip_store_new(ctx);
+	gossip_store_load(gs, rstate);
+	assert(gs->count == 0);
+	assert(store_size() == 1);
+
+	gossip_store_add(gs, make_msg(ctx, WIRE_CHANNEL_ANNOUNCEMENT, 300));
+	gossip_store_add(gs, make_msg(ctx, WIRE_CHANNEL_UPDATE, 130));
+	gossip_store_add(gs, make_msg(ctx, WIRE_NODE_ANNOUNCEMENT, 150));
+	gossip_store_add(gs, make_msg(ctx, WIRE_CHANNEL_UPDATE, 130));
+	tal_free(gs);
+	size = store_size();
+	assert(size == 1 + 4 * 4 + 300 + 130 + 150 + 130);
+
+	/* Replays everything in order. */
+	gs = gossip_store_new(ctx);
+	gossip_store_load(gs, rstate);
+	assert(gs->count == 4);
+	assert(num_replayed[0] == 1);
+	assert(num_replayed[1] == 2);
+	assert(num_replayed[2] == 1);
+	tal_free(gs);
+
+	/* A half-written record (we crashed) gets dropped. */
+	fd = open(GOSSIP_STORE_FILENAME, O_WRONLY|O_APPEND);
+	belen = cpu_to_be32(100);
+	assert(write(fd, &belen, sizeof(belen)) == sizeof(belen));
+	assert(write(fd, "partial", 7) == 7);
+	close(fd);
+
+	reset_replayed();
+	gs = gossip_store_new(ctx);
+	gossip_store_load(gs, rstate);
+	assert(gs->count == 4);
+	assert(num_replayed[1] == 2);
+	assert(store_size() == size);
+
+	tal_free(gs);
+
+	/* So does a record too long to be a wire message, and anything
+	 * after it. */
+	fd = open(GOSSIP_STORE_FILENAME, O_WRONLY|O_APPEND);
+	belen = cpu_to_be32(0xFFFFFFF0);
+	assert(write(fd, &belen, sizeof(belen)) == sizeof(belen));
+	belen = cpu_to_be32(7);
+	assert(write(fd, &belen, sizeof(belen)) == sizeof(belen));
+	assert(write(fd, "garbage", 7) == 7);
+	close(fd);
+
+	reset_replayed();
+	gs = gossip_store_new(ctx);
+	gossip_store_load(gs, rstate);
+	assert(gs->count == 4);
+	assert(num_replayed[1] == 2);
+	assert(store_size() == size);
+
+	/* We can still append after that. */
+	gossip_store_add(gs, make_msg(ctx, WIRE_NODE_ANNOUNCEMENT, 150));
+	assert(store_size() == size + 4 + 150);
+
+	/* rstate has none of it, so compaction drops everything. */
+	gossip_store_compact(gs, rstate);
+	assert(gs->count == 0);
+	assert(store_size() == 1);
+	gossip_store_add(gs, make_msg(ctx, WIRE_CHANNEL_UPDATE, 130));
+	tal_free(gs);
+
+	reset_replayed();
+	gs = gossip_store_new(ctx);
+	gossip_store_load(gs, rstate);
+	assert(gs->count == 1);
+	assert(num_replayed[1] == 1);
+	tal_free(gs);
+
+	/* A store from another version is discarded. */
+	fd = open(GOSSIP_STORE_FILENAME, O_WRONLY);
+	assert(write(fd, "\xFF", 1) == 1);
+	close(fd);
+
+	reset_replayed();
+	gs = gossip_store_new(ctx);
+	gossip_store_load(gs, rstate);
+	assert(gs->count == 0);
+	assert(num_replayed[1] == 0);
+	assert(store_size() == 1);
+	tal_free(gs);
+
+	unlink(GOSSIP_STORE_FILENAME);
+	assert(chdir("/") == 0);
+	rmdir(dirname);
+	tal_free(ctx);
+	return 0;
+}
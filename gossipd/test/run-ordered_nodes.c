@@ -0,0 +1,188 @@
+#include <assert.h>
+#include <bitcoin/pubkey.h>
+#include <bitcoin/signature.h>
+#include <ccan/tal/str/str.h>
+#include <common/status.h>
+#include <common/type_to_string.h>
+#include <stdio.h>
+
+#define status_trace(fmt, ...) do { } while(0)
+
+/* We use made-up pubkeys, so ordering is all we need. */
+static int fake_pubkey_cmp(const struct pubkey *a, const struct pubkey *b)
+{
+	return memcmp(a, b, sizeof(*a));
+}
+
+/* Made-up pubkeys don't serialize either: order_node() only needs
+ * bytes which sort the same way. */
+static void fake_pubkey_to_der(u8 der[PUBKEY_DER_LEN], const struct pubkey *key)
+{
+	memcpy(der, key, PUBKEY_DER_LEN);
+}
+
+#define pubkey_cmp fake_pubkey_cmp
+#define pubkey_to_der fake_pubkey_to_der
+#include "../routing.c"
+
+struct broadcast_state *new_broadcast_state(tal_t *ctx UNNEEDED)
+{
+	return NULL;
+}
+
+bool queue_broadcast(struct broadcast_state *bstate UNNEEDED,
+		     const int type UNNEEDED,
+		     const u8 *tag UNNEEDED,
+		     const u8 *payload UNNEEDED)
+{
+	return false;
+}
+
+void towire_short_channel_id(u8 **pptr UNNEEDED,
+			     const struct short_channel_id *short_channel_id UNNEEDED)
+{
+}
+
+void towire_u16(u8 **pptr UNNEEDED, u16 v UNNEEDED)
+{
+}
+
+/* AUTOGENERATED MOCKS START */
+/* Generated stub for fromwire_channel_announcement */
+bool fromwire_channel_announcement(const tal_t *ctx UNNEEDED, const void *p UNNEEDED, size_t *plen UNNEEDED, secp256k1_ecdsa_signature *node_signature_1 UNNEEDED, secp256k1_ecdsa_signature *node_signature_2 UNNEEDED, secp256k1_ecdsa_signature *bitcoin_signature_1 UNNEEDED, secp256k1_ecdsa_signature *bitcoin_signature_2 UNNEEDED, u8 **features UNNEEDED, struct bitcoin_blkid *chain_hash UNNEEDED, struct short_channel_id *short_channel_id UNNEEDED, struct pubkey *node_id_1 UNNEEDED, struct pubkey *node_id_2 UNNEEDED, struct pubkey *bitcoin_key_1 UNNEEDED, struct pubkey *bitcoin_key_2 UNNEEDED)
+{ fprintf(stderr, "fromwire_channel_announcement called!\n"); abort(); }
+/* Generated stub for fromwire_channel_update */
+bool fromwire_channel_update(const void *p UNNEEDED, size_t *plen UNNEEDED, secp256k1_ecdsa_signature *signature UNNEEDED, struct bitcoin_blkid *chain_hash UNNEEDED, struct short_channel_id *short_channel_id UNNEEDED, u32 *timestamp UNNEEDED, u16 *flags UNNEEDED, u16 *cltv_expiry_delta UNNEEDED, u64 *htlc_minimum_msat UNNEEDED, u32 *fee_base_msat UNNEEDED, u32 *fee_proportional_millionths UNNEEDED)
+{ fprintf(stderr, "fromwire_channel_update called!\n"); abort(); }
+/* Generated stub for fromwire_node_announcement */
+bool fromwire_node_announcement(const tal_t *ctx UNNEEDED, const void *p UNNEEDED, size_t *plen UNNEEDED, secp256k1_ecdsa_signature *signature UNNEEDED, u8 **features UNNEEDED, u32 *timestamp UNNEEDED, struct pubkey *node_id UNNEEDED, u8 rgb_color[3] UNNEEDED, u8 alias[32] UNNEEDED, u8 **addresses UNNEEDED)
+{ fprintf(stderr, "fromwire_node_announcement called!\n"); abort(); }
+/* Generated stub for fromwire_u8 */
+u8 fromwire_u8(const u8 **cursor UNNEEDED, size_t *max UNNEEDED)
+{ fprintf(stderr, "fromwire_u8 called!\n"); abort(); }
+/* Generated stub for fromwire_wireaddr */
+bool fromwire_wireaddr(const u8 **cursor UNNEEDED, size_t *max UNNEEDED, struct wireaddr *addr UNNEEDED)
+{ fprintf(stderr, "fromwire_wireaddr called!\n"); abort(); }
+/* Generated stub for gossip_store_add */
+void gossip_store_add(struct gossip_store *gs UNNEEDED, const u8 *msg UNNEEDED)
+{ fprintf(stderr, "gossip_store_add called!\n"); abort(); }
+/* Generated stub for status_failed */
+void status_failed(enum status_fail code UNNEEDED, const char *fmt UNNEEDED, ...)
+{ fprintf(stderr, "status_failed called!\n"); abort(); }
+/* Generated stub for towire_pubkey */
+void towire_pubkey(u8 **pptr UNNEEDED, const struct pubkey *pubkey UNNEEDED)
+{ fprintf(stderr, "towire_pubkey called!\n"); abort(); }
+/* AUTOGENERATED MOCKS END */
+
+const void *trc;
+
+/* Ids which share their first 8 bytes when hi matches. */
+static struct pubkey nodeid(u64 hi, u8 lo)
+{
+	struct pubkey id;
+
+	memset(&id, 0, sizeof(id));
+	memcpy(&id, &hi, sizeof(hi));
+	((u8 *)&id)[8] = lo;
+	return id;
+}
+
+/* Everything first_node_from() and next_node() give us, from id. */
+static struct node **walk(const tal_t *ctx, struct routing_state *rstate,
+			  const struct pubkey *id)
+{
+	struct node **nodes = tal_arr(ctx, struct node *, 0);
+
+	for (struct node *n = first_node_from(rstate, id);
+	     n;
+	     n = next_node(rstate, n)) {
+		size_t num = tal_count(nodes);
+		tal_resize(&nodes, num + 1);
+		nodes[num] = n;
+	}
+	return nodes;
+}
+
+static void free_node(struct routing_state *rstate, struct node *n)
+{
+	node_map_del(rstate->nodes, n);
+	tal_free(n);
+}
+
+static void check_order(const tal_t *ctx, struct routing_state *rstate)
+{
+	struct node **nodes = walk(ctx, rstate, NULL);
+
+	assert(tal_count(nodes) == tal_count(rstate->node_array));
+	for (size_t i = 1; i < tal_count(nodes); i++)
+		assert(pubkey_cmp(&nodes[i-1]->id, &nodes[i]->id) < 0);
+
+	/* Starting from any of them gives the rest. */
+	for (size_t i = 0; i < tal_count(nodes); i++) {
+		struct node **rest = walk(ctx, rstate, &nodes[i]->id);
+		assert(tal_count(rest) == tal_count(nodes) - i);
+		assert(memeq(rest, tal_len(rest),
+			     nodes + i, tal_len(rest)));
+		tal_free(rest);
+	}
+	tal_free(nodes);
+}
+
+int main(void)
+{
+	static const struct bitcoin_blkid zerohash;
+	const tal_t *ctx = trc = tal_tmpctx(NULL);
+	struct routing_state *rstate;
+	struct pubkey me = nodeid(0, 0), id;
+	struct node_connection *nc[6];
+	struct short_channel_id scid;
+	struct node **nodes;
+
+	secp256k1_ctx = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY
+						 | SECP256K1_CONTEXT_SIGN);
+	rstate = new_routing_state(ctx, &zerohash, &me);
+	assert(!first_node_from(rstate, NULL));
+	memset(&scid, 0, sizeof(scid));
+
+	/* Three which share a key, added out of order, and two which
+	 * don't. */
+	nc[0] = half_add_connection(rstate, &me, (id = nodeid(5, 2), &id),
+				    &scid, 0);
+	nc[1] = half_add_connection(rstate, &me, (id = nodeid(5, 3), &id),
+				    &scid, 0);
+	nc[2] = half_add_connection(rstate, &me, (id = nodeid(5, 1), &id),
+				    &scid, 0);
+	nc[3] = half_add_connection(rstate, &me, (id = nodeid(9, 0), &id),
+				    &scid, 0);
+	nc[4] = half_add_connection(rstate, &me, (id = nodeid(2, 7), &id),
+				    &scid, 0);
+	check_order(ctx, rstate);
+
+	/* Between two of them, or past the end of a chain. */
+	id = nodeid(5, 0);
+	assert(first_node_from(rstate, &id) == nc[2]->dst);
+	id = nodeid(5, 4);
+	assert(first_node_from(rstate, &id) == nc[3]->dst);
+	id = nodeid(10, 0);
+	assert(!first_node_from(rstate, &id));
+
+	/* Removing the head of a chain, and one from the middle. */
+	nc[5] = half_add_connection(rstate, &me, (id = nodeid(5, 0), &id),
+				    &scid, 0);
+	check_order(ctx, rstate);
+	free_node(rstate, nc[5]->dst);
+	free_node(rstate, nc[0]->dst);
+	check_order(ctx, rstate);
+
+	nodes = walk(ctx, rstate, NULL);
+	assert(tal_count(nodes) == 5);
+	assert(nodes[0] == rstate->node_array[0]);
+	assert(nodes[1] == nc[4]->dst);
+	assert(nodes[2] == nc[2]->dst);
+	assert(nodes[3] == nc[1]->dst);
+	assert(nodes[4] == nc[3]->dst);
+
+	tal_free(ctx);
+	secp256k1_context_destroy(secp256k1_ctx);
+	return 0;
+}
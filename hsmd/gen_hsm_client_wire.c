@@ -0,0 +1,655 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#include <hsmd/gen_hsm_client_wire.h>
+#include <ccan/mem/mem.h>
+#include <ccan/tal/str/str.h>
+#include <stdio.h>
+
+const char *hsm_client_wire_type_name(int e)
+{
+	static char invalidbuf[sizeof("INVALID ") + STR_MAX_CHARS(e)];
+
+	switch ((enum hsm_client_wire_type)e) {
+	case WIRE_HSMSTATUS_CLIENT_BAD_REQUEST: return "WIRE_HSMSTATUS_CLIENT_BAD_REQUEST";
+	case WIRE_HSM_INIT: return "WIRE_HSM_INIT";
+	case WIRE_HSM_INIT_REPLY: return "WIRE_HSM_INIT_REPLY";
+	case WIRE_HSM_CLIENT_HSMFD: return "WIRE_HSM_CLIENT_HSMFD";
+	case WIRE_HSM_CLIENT_HSMFD_REPLY: return "WIRE_HSM_CLIENT_HSMFD_REPLY";
+	case WIRE_HSM_SIGN_FUNDING: return "WIRE_HSM_SIGN_FUNDING";
+	case WIRE_HSM_SIGN_FUNDING_REPLY: return "WIRE_HSM_SIGN_FUNDING_REPLY";
+	case WIRE_HSM_NODE_ANNOUNCEMENT_SIG_REQ: return "WIRE_HSM_NODE_ANNOUNCEMENT_SIG_REQ";
+	case WIRE_HSM_NODE_ANNOUNCEMENT_SIG_REPLY: return "WIRE_HSM_NODE_ANNOUNCEMENT_SIG_REPLY";
+	case WIRE_HSM_SIGN_WITHDRAWAL: return "WIRE_HSM_SIGN_WITHDRAWAL";
+	case WIRE_HSM_SIGN_WITHDRAWAL_REPLY: return "WIRE_HSM_SIGN_WITHDRAWAL_REPLY";
+	case WIRE_HSM_SIGN_INVOICE: return "WIRE_HSM_SIGN_INVOICE";
+	case WIRE_HSM_SIGN_INVOICE_REPLY: return "WIRE_HSM_SIGN_INVOICE_REPLY";
+	case WIRE_HSM_ECDH_REQ: return "WIRE_HSM_ECDH_REQ";
+	case WIRE_HSM_ECDH_RESP: return "WIRE_HSM_ECDH_RESP";
+	case WIRE_HSM_CANNOUNCEMENT_SIG_REQ: return "WIRE_HSM_CANNOUNCEMENT_SIG_REQ";
+	case WIRE_HSM_CANNOUNCEMENT_SIG_REPLY: return "WIRE_HSM_CANNOUNCEMENT_SIG_REPLY";
+	case WIRE_HSM_CUPDATE_SIG_REQ: return "WIRE_HSM_CUPDATE_SIG_REQ";
+	case WIRE_HSM_CUPDATE_SIG_REPLY: return "WIRE_HSM_CUPDATE_SIG_REPLY";
+	}
+
+	sprintf(invalidbuf, "INVALID %i", e);
+	return invalidbuf;
+}
+
+bool fromwire_hsmstatus_client_bad_request(const tal_t *ctx, const void *p, size_t *plen, struct pubkey *id, u8 **msg)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSMSTATUS_CLIENT_BAD_REQUEST)
+		return false;
+	//4th case id
+	fromwire_pubkey(&cursor, plen, id);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case msg
+	*msg = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *msg, len);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_init(const void *p, size_t *plen, bool *new)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_INIT)
+		return false;
+	//3th case new
+	*new = fromwire_bool(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_init_reply(const void *p, size_t *plen, struct pubkey *node_id, struct secret *peer_seed, struct ext_key *bip32)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_INIT_REPLY)
+		return false;
+	//4th case node_id
+	fromwire_pubkey(&cursor, plen, node_id);
+	//4th case peer_seed
+	fromwire_secret(&cursor, plen, peer_seed);
+	//4th case bip32
+	fromwire_ext_key(&cursor, plen, bip32);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_client_hsmfd(const void *p, size_t *plen, struct pubkey  *pubkey, u64 *capabilities)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_CLIENT_HSMFD)
+		return false;
+	/* Which identity to report for requests */
+	//4th case pubkey
+	fromwire_pubkey (&cursor, plen, pubkey);
+	//3th case capabilities
+	*capabilities = fromwire_u64(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_client_hsmfd_reply(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_CLIENT_HSMFD_REPLY)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_sign_funding(const tal_t *ctx, const void *p, size_t *plen, u64 *satoshi_out, u64 *change_out, u32 *change_keyindex, struct pubkey *our_pubkey, struct pubkey *their_pubkey, struct utxo **inputs)
+{
+	u16 num_inputs;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_SIGN_FUNDING)
+		return false;
+	//3th case satoshi_out
+	*satoshi_out = fromwire_u64(&cursor, plen);
+	//3th case change_out
+	*change_out = fromwire_u64(&cursor, plen);
+	//3th case change_keyindex
+	*change_keyindex = fromwire_u32(&cursor, plen);
+	//4th case our_pubkey
+	fromwire_pubkey(&cursor, plen, our_pubkey);
+	//4th case their_pubkey
+	fromwire_pubkey(&cursor, plen, their_pubkey);
+	//3th case num_inputs
+	num_inputs = fromwire_u16(&cursor, plen);
+	//2nd case inputs
+	*inputs = num_inputs ? tal_arr(ctx, struct utxo, num_inputs) : NULL;
+	for (size_t i = 0; i < num_inputs; i++)
+		fromwire_utxo(ctx, &cursor, plen, *inputs + i);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_sign_funding_reply(const void *p, size_t *plen, struct bitcoin_tx *tx)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_SIGN_FUNDING_REPLY)
+		return false;
+	//4th case tx
+	fromwire_bitcoin_tx(&cursor, plen, tx);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_node_announcement_sig_req(const tal_t *ctx, const void *p, size_t *plen, u8 **announcement)
+{
+	u16 annlen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_NODE_ANNOUNCEMENT_SIG_REQ)
+		return false;
+	//3th case annlen
+	annlen = fromwire_u16(&cursor, plen);
+	//2nd case announcement
+	*announcement = annlen ? tal_arr(ctx, u8, annlen) : NULL;
+	fromwire_u8_array(&cursor, plen, *announcement, annlen);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_node_announcement_sig_reply(const void *p, size_t *plen, secp256k1_ecdsa_signature *signature)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_NODE_ANNOUNCEMENT_SIG_REPLY)
+		return false;
+	//4th case signature
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, signature);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_sign_withdrawal(const tal_t *ctx, const void *p, size_t *plen, u64 *satoshi_out, u64 *change_out, u32 *change_keyindex, u8 **scriptpubkey, struct utxo **inputs)
+{
+	u16 scriptpubkey_len;
+	u16 num_inputs;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_SIGN_WITHDRAWAL)
+		return false;
+	//3th case satoshi_out
+	*satoshi_out = fromwire_u64(&cursor, plen);
+	//3th case change_out
+	*change_out = fromwire_u64(&cursor, plen);
+	//3th case change_keyindex
+	*change_keyindex = fromwire_u32(&cursor, plen);
+	//3th case scriptpubkey_len
+	scriptpubkey_len = fromwire_u16(&cursor, plen);
+	//2nd case scriptpubkey
+	*scriptpubkey = scriptpubkey_len ? tal_arr(ctx, u8, scriptpubkey_len) : NULL;
+	fromwire_u8_array(&cursor, plen, *scriptpubkey, scriptpubkey_len);
+	//3th case num_inputs
+	num_inputs = fromwire_u16(&cursor, plen);
+	//2nd case inputs
+	*inputs = num_inputs ? tal_arr(ctx, struct utxo, num_inputs) : NULL;
+	for (size_t i = 0; i < num_inputs; i++)
+		fromwire_utxo(ctx, &cursor, plen, *inputs + i);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_sign_withdrawal_reply(const void *p, size_t *plen, struct bitcoin_tx *tx)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_SIGN_WITHDRAWAL_REPLY)
+		return false;
+	//4th case tx
+	fromwire_bitcoin_tx(&cursor, plen, tx);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_sign_invoice(const tal_t *ctx, const void *p, size_t *plen, u8 **u5bytes, u8 **hrp)
+{
+	u16 len;
+	u16 hrplen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_SIGN_INVOICE)
+		return false;
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case u5bytes
+	*u5bytes = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *u5bytes, len);
+	//3th case hrplen
+	hrplen = fromwire_u16(&cursor, plen);
+	//2nd case hrp
+	*hrp = hrplen ? tal_arr(ctx, u8, hrplen) : NULL;
+	fromwire_u8_array(&cursor, plen, *hrp, hrplen);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_sign_invoice_reply(const void *p, size_t *plen, secp256k1_ecdsa_recoverable_signature *sig)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_SIGN_INVOICE_REPLY)
+		return false;
+	//4th case sig
+	fromwire_secp256k1_ecdsa_recoverable_signature(&cursor, plen, sig);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_ecdh_req(const void *p, size_t *plen, struct pubkey *point)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_ECDH_REQ)
+		return false;
+	//4th case point
+	fromwire_pubkey(&cursor, plen, point);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_ecdh_resp(const void *p, size_t *plen, struct secret *ss)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_ECDH_RESP)
+		return false;
+	//4th case ss
+	fromwire_secret(&cursor, plen, ss);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_cannouncement_sig_req(const tal_t *ctx, const void *p, size_t *plen, struct pubkey *bitcoin_id, u8 **ca)
+{
+	u16 calen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_CANNOUNCEMENT_SIG_REQ)
+		return false;
+	//4th case bitcoin_id
+	fromwire_pubkey(&cursor, plen, bitcoin_id);
+	//3th case calen
+	calen = fromwire_u16(&cursor, plen);
+	//2nd case ca
+	*ca = calen ? tal_arr(ctx, u8, calen) : NULL;
+	fromwire_u8_array(&cursor, plen, *ca, calen);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_cannouncement_sig_reply(const void *p, size_t *plen, secp256k1_ecdsa_signature *node_signature)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_CANNOUNCEMENT_SIG_REPLY)
+		return false;
+	//4th case node_signature
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, node_signature);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_cupdate_sig_req(const tal_t *ctx, const void *p, size_t *plen, u8 **cu)
+{
+	u16 culen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_CUPDATE_SIG_REQ)
+		return false;
+	//3th case culen
+	culen = fromwire_u16(&cursor, plen);
+	//2nd case cu
+	*cu = culen ? tal_arr(ctx, u8, culen) : NULL;
+	fromwire_u8_array(&cursor, plen, *cu, culen);
+	return cursor != NULL;
+}
+
+bool fromwire_hsm_cupdate_sig_reply(const tal_t *ctx, const void *p, size_t *plen, u8 **cu)
+{
+	u16 culen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_HSM_CUPDATE_SIG_REPLY)
+		return false;
+	//3th case culen
+	culen = fromwire_u16(&cursor, plen);
+	//2nd case cu
+	*cu = culen ? tal_arr(ctx, u8, culen) : NULL;
+	fromwire_u8_array(&cursor, plen, *cu, culen);
+	return cursor != NULL;
+}
+
+u8 *towire_hsmstatus_client_bad_request(const tal_t *ctx, const struct pubkey *id, const u8 *msg)
+{
+	u16 len = tal_count(msg);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSMSTATUS_CLIENT_BAD_REQUEST);
+	towire_pubkey(&p, id);
+	towire_u16(&p, len);
+	towire_u8_array(&p, msg, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_init(const tal_t *ctx, bool new)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_INIT);
+	towire_bool(&p, new);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_init_reply(const tal_t *ctx, const struct pubkey *node_id, const struct secret *peer_seed, const struct ext_key *bip32)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_INIT_REPLY);
+	towire_pubkey(&p, node_id);
+	towire_secret(&p, peer_seed);
+	towire_ext_key(&p, bip32);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_client_hsmfd(const tal_t *ctx, const struct pubkey  *pubkey, u64 capabilities)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_CLIENT_HSMFD);
+	/* Which identity to report for requests */
+	towire_pubkey (&p, pubkey);
+	towire_u64(&p, capabilities);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_client_hsmfd_reply(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_CLIENT_HSMFD_REPLY);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_sign_funding(const tal_t *ctx, u64 satoshi_out, u64 change_out, u32 change_keyindex, const struct pubkey *our_pubkey, const struct pubkey *their_pubkey, const struct utxo *inputs)
+{
+	u16 num_inputs = tal_count(inputs);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_SIGN_FUNDING);
+	towire_u64(&p, satoshi_out);
+	towire_u64(&p, change_out);
+	towire_u32(&p, change_keyindex);
+	towire_pubkey(&p, our_pubkey);
+	towire_pubkey(&p, their_pubkey);
+	towire_u16(&p, num_inputs);
+	for (size_t i = 0; i < num_inputs; i++)
+
+		towire_utxo(&p, inputs + i);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_sign_funding_reply(const tal_t *ctx, const struct bitcoin_tx *tx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_SIGN_FUNDING_REPLY);
+	towire_bitcoin_tx(&p, tx);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_node_announcement_sig_req(const tal_t *ctx, const u8 *announcement)
+{
+	u16 annlen = tal_count(announcement);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_NODE_ANNOUNCEMENT_SIG_REQ);
+	towire_u16(&p, annlen);
+	towire_u8_array(&p, announcement, annlen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_node_announcement_sig_reply(const tal_t *ctx, const secp256k1_ecdsa_signature *signature)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_NODE_ANNOUNCEMENT_SIG_REPLY);
+	towire_secp256k1_ecdsa_signature(&p, signature);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_sign_withdrawal(const tal_t *ctx, u64 satoshi_out, u64 change_out, u32 change_keyindex, const u8 *scriptpubkey, const struct utxo *inputs)
+{
+	u16 scriptpubkey_len = tal_count(scriptpubkey);
+	u16 num_inputs = tal_count(inputs);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_SIGN_WITHDRAWAL);
+	towire_u64(&p, satoshi_out);
+	towire_u64(&p, change_out);
+	towire_u32(&p, change_keyindex);
+	towire_u16(&p, scriptpubkey_len);
+	towire_u8_array(&p, scriptpubkey, scriptpubkey_len);
+	towire_u16(&p, num_inputs);
+	for (size_t i = 0; i < num_inputs; i++)
+
+		towire_utxo(&p, inputs + i);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_sign_withdrawal_reply(const tal_t *ctx, const struct bitcoin_tx *tx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_SIGN_WITHDRAWAL_REPLY);
+	towire_bitcoin_tx(&p, tx);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_sign_invoice(const tal_t *ctx, const u8 *u5bytes, const u8 *hrp)
+{
+	u16 len = tal_count(u5bytes);
+	u16 hrplen = tal_count(hrp);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_SIGN_INVOICE);
+	towire_u16(&p, len);
+	towire_u8_array(&p, u5bytes, len);
+	towire_u16(&p, hrplen);
+	towire_u8_array(&p, hrp, hrplen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_sign_invoice_reply(const tal_t *ctx, const secp256k1_ecdsa_recoverable_signature *sig)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_SIGN_INVOICE_REPLY);
+	towire_secp256k1_ecdsa_recoverable_signature(&p, sig);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_ecdh_req(const tal_t *ctx, const struct pubkey *point)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_ECDH_REQ);
+	towire_pubkey(&p, point);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_ecdh_resp(const tal_t *ctx, const struct secret *ss)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_ECDH_RESP);
+	towire_secret(&p, ss);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_cannouncement_sig_req(const tal_t *ctx, const struct pubkey *bitcoin_id, const u8 *ca)
+{
+	u16 calen = tal_count(ca);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_CANNOUNCEMENT_SIG_REQ);
+	towire_pubkey(&p, bitcoin_id);
+	towire_u16(&p, calen);
+	towire_u8_array(&p, ca, calen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_cannouncement_sig_reply(const tal_t *ctx, const secp256k1_ecdsa_signature *node_signature)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_CANNOUNCEMENT_SIG_REPLY);
+	towire_secp256k1_ecdsa_signature(&p, node_signature);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_cupdate_sig_req(const tal_t *ctx, const u8 *cu)
+{
+	u16 culen = tal_count(cu);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_CUPDATE_SIG_REQ);
+	towire_u16(&p, culen);
+	towire_u8_array(&p, cu, culen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_hsm_cupdate_sig_reply(const tal_t *ctx, const u8 *cu)
+{
+	u16 culen = tal_count(cu);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_HSM_CUPDATE_SIG_REPLY);
+	towire_u16(&p, culen);
+	towire_u8_array(&p, cu, culen);
+
+	return memcheck(p, tal_count(p));
+}
+
+
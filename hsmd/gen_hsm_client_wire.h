@@ -0,0 +1,121 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#ifndef LIGHTNING_HSMD_GEN_HSM_CLIENT_WIRE_H
+#define LIGHTNING_HSMD_GEN_HSM_CLIENT_WIRE_H
+#include <ccan/tal/tal.h>
+#include <wire/wire.h>
+#include <common/bip32.h>
+
+#include <common/utxo.h>
+
+enum hsm_client_wire_type {
+	/* Clients should not give a bad request but not the HSM's decision to crash. */
+	WIRE_HSMSTATUS_CLIENT_BAD_REQUEST = 1000,
+	/* Start the HSM. */
+	WIRE_HSM_INIT = 11,
+	WIRE_HSM_INIT_REPLY = 111,
+	/* Get a new HSM FD, with the specified capabilities */
+	WIRE_HSM_CLIENT_HSMFD = 9,
+	/* No content, just an fd. */
+	WIRE_HSM_CLIENT_HSMFD_REPLY = 109,
+	/* Return signature for a funding tx. */
+	/* FIXME: This should also take their commit sig & details, to verify. */
+	WIRE_HSM_SIGN_FUNDING = 4,
+	WIRE_HSM_SIGN_FUNDING_REPLY = 104,
+	/* Master asks the HSM to sign a node_announcement */
+	WIRE_HSM_NODE_ANNOUNCEMENT_SIG_REQ = 6,
+	WIRE_HSM_NODE_ANNOUNCEMENT_SIG_REPLY = 106,
+	/* Sign a withdrawal request */
+	WIRE_HSM_SIGN_WITHDRAWAL = 7,
+	WIRE_HSM_SIGN_WITHDRAWAL_REPLY = 107,
+	/* Sign an invoice */
+	WIRE_HSM_SIGN_INVOICE = 8,
+	WIRE_HSM_SIGN_INVOICE_REPLY = 108,
+	/* Give me ECDH(node-id-secret,point) */
+	WIRE_HSM_ECDH_REQ = 1,
+	WIRE_HSM_ECDH_RESP = 100,
+	WIRE_HSM_CANNOUNCEMENT_SIG_REQ = 2,
+	WIRE_HSM_CANNOUNCEMENT_SIG_REPLY = 102,
+	WIRE_HSM_CUPDATE_SIG_REQ = 3,
+	WIRE_HSM_CUPDATE_SIG_REPLY = 103,
+};
+const char *hsm_client_wire_type_name(int e);
+
+bool fromwire_hsmstatus_client_bad_request(const tal_t *ctx, const void *p, size_t *plen, struct pubkey *id, u8 **msg);
+
+bool fromwire_hsm_init(const void *p, size_t *plen, bool *new);
+
+bool fromwire_hsm_init_reply(const void *p, size_t *plen, struct pubkey *node_id, struct secret *peer_seed, struct ext_key *bip32);
+
+bool fromwire_hsm_client_hsmfd(const void *p, size_t *plen, struct pubkey  *pubkey, u64 *capabilities);
+
+bool fromwire_hsm_client_hsmfd_reply(const void *p, size_t *plen);
+
+bool fromwire_hsm_sign_funding(const tal_t *ctx, const void *p, size_t *plen, u64 *satoshi_out, u64 *change_out, u32 *change_keyindex, struct pubkey *our_pubkey, struct pubkey *their_pubkey, struct utxo **inputs);
+
+bool fromwire_hsm_sign_funding_reply(const void *p, size_t *plen, struct bitcoin_tx *tx);
+
+bool fromwire_hsm_node_announcement_sig_req(const tal_t *ctx, const void *p, size_t *plen, u8 **announcement);
+
+bool fromwire_hsm_node_announcement_sig_reply(const void *p, size_t *plen, secp256k1_ecdsa_signature *signature);
+
+bool fromwire_hsm_sign_withdrawal(const tal_t *ctx, const void *p, size_t *plen, u64 *satoshi_out, u64 *change_out, u32 *change_keyindex, u8 **scriptpubkey, struct utxo **inputs);
+
+bool fromwire_hsm_sign_withdrawal_reply(const void *p, size_t *plen, struct bitcoin_tx *tx);
+
+bool fromwire_hsm_sign_invoice(const tal_t *ctx, const void *p, size_t *plen, u8 **u5bytes, u8 **hrp);
+
+bool fromwire_hsm_sign_invoice_reply(const void *p, size_t *plen, secp256k1_ecdsa_recoverable_signature *sig);
+
+bool fromwire_hsm_ecdh_req(const void *p, size_t *plen, struct pubkey *point);
+
+bool fromwire_hsm_ecdh_resp(const void *p, size_t *plen, struct secret *ss);
+
+bool fromwire_hsm_cannouncement_sig_req(const tal_t *ctx, const void *p, size_t *plen, struct pubkey *bitcoin_id, u8 **ca);
+
+bool fromwire_hsm_cannouncement_sig_reply(const void *p, size_t *plen, secp256k1_ecdsa_signature *node_signature);
+
+bool fromwire_hsm_cupdate_sig_req(const tal_t *ctx, const void *p, size_t *plen, u8 **cu);
+
+bool fromwire_hsm_cupdate_sig_reply(const tal_t *ctx, const void *p, size_t *plen, u8 **cu);
+
+u8 *towire_hsmstatus_client_bad_request(const tal_t *ctx, const struct pubkey *id, const u8 *msg);
+
+u8 *towire_hsm_init(const tal_t *ctx, bool new);
+
+u8 *towire_hsm_init_reply(const tal_t *ctx, const struct pubkey *node_id, const struct secret *peer_seed, const struct ext_key *bip32);
+
+u8 *towire_hsm_client_hsmfd(const tal_t *ctx, const struct pubkey  *pubkey, u64 capabilities);
+
+u8 *towire_hsm_client_hsmfd_reply(const tal_t *ctx);
+
+u8 *towire_hsm_sign_funding(const tal_t *ctx, u64 satoshi_out, u64 change_out, u32 change_keyindex, const struct pubkey *our_pubkey, const struct pubkey *their_pubkey, const struct utxo *inputs);
+
+u8 *towire_hsm_sign_funding_reply(const tal_t *ctx, const struct bitcoin_tx *tx);
+
+u8 *towire_hsm_node_announcement_sig_req(const tal_t *ctx, const u8 *announcement);
+
+u8 *towire_hsm_node_announcement_sig_reply(const tal_t *ctx, const secp256k1_ecdsa_signature *signature);
+
+u8 *towire_hsm_sign_withdrawal(const tal_t *ctx, u64 satoshi_out, u64 change_out, u32 change_keyindex, const u8 *scriptpubkey, const struct utxo *inputs);
+
+u8 *towire_hsm_sign_withdrawal_reply(const tal_t *ctx, const struct bitcoin_tx *tx);
+
+u8 *towire_hsm_sign_invoice(const tal_t *ctx, const u8 *u5bytes, const u8 *hrp);
+
+u8 *towire_hsm_sign_invoice_reply(const tal_t *ctx, const secp256k1_ecdsa_recoverable_signature *sig);
+
+u8 *towire_hsm_ecdh_req(const tal_t *ctx, const struct pubkey *point);
+
+u8 *towire_hsm_ecdh_resp(const tal_t *ctx, const struct secret *ss);
+
+u8 *towire_hsm_cannouncement_sig_req(const tal_t *ctx, const struct pubkey *bitcoin_id, const u8 *ca);
+
+u8 *towire_hsm_cannouncement_sig_reply(const tal_t *ctx, const secp256k1_ecdsa_signature *node_signature);
+
+u8 *towire_hsm_cupdate_sig_req(const tal_t *ctx, const u8 *cu);
+
+u8 *towire_hsm_cupdate_sig_reply(const tal_t *ctx, const u8 *cu);
+
+#endif /* LIGHTNING_HSMD_GEN_HSM_CLIENT_WIRE_H */
+
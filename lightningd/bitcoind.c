@@ -1,4 +1,5 @@
-/* Code for talking to bitcoind.  We use bitcoin-cli. */
+/* Code for talking to bitcoind.  We use bitcoin-cli, or talk JSON-RPC over
+ * HTTP ourselves if we were given --bitcoin-rpcconnect. */
 #include "bitcoin/base58.h"
 #include "bitcoin/block.h"
 #include "bitcoin/shadouble.h"
@@ -6,10 +7,13 @@
 #include "bitcoind.h"
 #include "lightningd.h"
 #include "log.h"
+#include <ccan/array_size/array_size.h>
 #include <ccan/cast/cast.h>
 #include <ccan/io/io.h>
 #include <ccan/pipecmd/pipecmd.h>
+#include <ccan/read_write_all/read_write_all.h>
 #include <ccan/str/hex/hex.h>
+#include <ccan/str/str.h>
 #include <ccan/take/take.h>
 #include <ccan/tal/grab_file/grab_file.h>
 #include <ccan/tal/path/path.h>
@@ -21,6 +25,10 @@
 #include <errno.h>
 #include <inttypes.h>
 #include <lightningd/chaintopology.h>
+#include <netdb.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 #define BITCOIN_CLI "bitcoin-cli"
 
@@ -30,17 +38,23 @@ static char **gather_args(const struct bitcoind *bitcoind,
 			  const tal_t *ctx, const char *cmd, va_list ap)
 {
 	size_t n = 0;
-	char **args = tal_arr(ctx, char *, 2);
+	char **args = tal_arr(ctx, char *, 1);
 
-	args[n++] = cast_const(char *, bitcoind->chainparams->cli);
-	if (bitcoind->chainparams->cli_args) {
-		args[n++] = cast_const(char *, bitcoind->chainparams->cli_args);
+	/* Over JSON-RPC, args are just the method and its params. */
+	if (!bitcoind->rpcconnect) {
+		args[n++] = cast_const(char *, bitcoind->chainparams->cli);
 		tal_resize(&args, n + 1);
-	}
+		if (bitcoind->chainparams->cli_args) {
+			args[n++] = cast_const(char *,
+					       bitcoind->chainparams->cli_args);
+			tal_resize(&args, n + 1);
+		}
 
-	if (bitcoind->datadir) {
-		args[n++] = tal_fmt(args, "-datadir=%s", bitcoind->datadir);
-		tal_resize(&args, n + 1);
+		if (bitcoind->datadir) {
+			args[n++] = tal_fmt(args, "-datadir=%s",
+					    bitcoind->datadir);
+			tal_resize(&args, n + 1);
+		}
 	}
 	args[n++] = cast_const(char *, cmd);
 	tal_resize(&args, n + 1);
@@ -101,31 +115,19 @@ static char *bcli_args(struct bitcoin_cli *bcli)
 	return ret;
 }
 
-static void bcli_finished(struct io_conn *conn, struct bitcoin_cli *bcli)
+/* Common to both backends: handle exit status, then process() output. */
+static void bcli_done(struct bitcoin_cli *bcli, int exitstatus)
 {
-	int ret, status;
 	struct bitcoind *bitcoind = bcli->bitcoind;
 
-	/* FIXME: If we waited for SIGCHILD, this could never hang! */
-	ret = waitpid(bcli->pid, &status, 0);
-	if (ret != bcli->pid)
-		fatal("%s %s", bcli_args(bcli),
-		      ret == 0 ? "not exited?" : strerror(errno));
-
-	if (!WIFEXITED(status))
-		fatal("%s died with signal %i",
-		      bcli_args(bcli),
-		      WTERMSIG(status));
-
 	if (!bcli->exitstatus) {
-		if (WEXITSTATUS(status) != 0) {
+		if (exitstatus != 0) {
 			/* Allow 60 seconds of spurious errors, eg. reorg. */
 			struct timerel t;
 
 			log_unusual(bcli->bitcoind->log,
 				    "%s exited with status %u",
-				    bcli_args(bcli),
-				    WEXITSTATUS(status));
+				    bcli_args(bcli), exitstatus);
 
 			if (!bitcoind->error_count)
 				bitcoind->first_error_time = time_mono();
@@ -135,7 +137,7 @@ static void bcli_finished(struct io_conn *conn, struct bitcoin_cli *bcli)
 			if (time_greater(t, time_from_sec(60)))
 				fatal("%s exited %u (after %u other errors) '%.*s'",
 				      bcli_args(bcli),
-				      WEXITSTATUS(status),
+				      exitstatus,
 				      bitcoind->error_count,
 				      (int)bcli->output_bytes,
 				      bcli->output);
@@ -144,13 +146,11 @@ static void bcli_finished(struct io_conn *conn, struct bitcoin_cli *bcli)
 			goto done;
 		}
 	} else
-		*bcli->exitstatus = WEXITSTATUS(status);
+		*bcli->exitstatus = exitstatus;
 
-	if (WEXITSTATUS(status) == 0)
+	if (exitstatus == 0)
 		bitcoind->error_count = 0;
 
-	bitcoind->req_running = false;
-
 	/* Don't continue if were only here because we were freed for shutdown */
 	if (bitcoind->shutdown)
 		return;
@@ -161,8 +161,29 @@ static void bcli_finished(struct io_conn *conn, struct bitcoin_cli *bcli)
 
 done:
 	tal_free(bcli);
+}
 
-	next_bcli(bitcoind);
+static void bcli_finished(struct io_conn *conn, struct bitcoin_cli *bcli)
+{
+	int ret, status;
+	struct bitcoind *bitcoind = bcli->bitcoind;
+
+	/* FIXME: If we waited for SIGCHILD, this could never hang! */
+	ret = waitpid(bcli->pid, &status, 0);
+	if (ret != bcli->pid)
+		fatal("%s %s", bcli_args(bcli),
+		      ret == 0 ? "not exited?" : strerror(errno));
+
+	if (!WIFEXITED(status))
+		fatal("%s died with signal %i",
+		      bcli_args(bcli),
+		      WTERMSIG(status));
+
+	bitcoind->req_running = false;
+	bcli_done(bcli, WEXITSTATUS(status));
+
+	if (!bitcoind->shutdown)
+		next_bcli(bitcoind);
 }
 
 static void next_bcli(struct bitcoind *bitcoind)
@@ -187,6 +208,370 @@ static void next_bcli(struct bitcoind *bitcoind)
 	io_set_finish(conn, bcli_finished, bcli);
 }
 
+/* bitcoin-cli turns these positional params into JSON numbers or bools
+ * (see vRPCConvertParams in bitcoin's rpc/client.cpp), so we do too. */
+static const struct rpc_convert_param {
+	const char *method;
+	size_t param;
+} rpc_convert_params[] = {
+	{ "estimatesmartfee", 0 },
+	{ "getblock", 1 },
+	{ "getblockhash", 0 },
+	{ "gettxout", 1 },
+	{ "gettxout", 2 },
+};
+
+static bool rpc_param_is_json(const char *method, size_t param)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(rpc_convert_params); i++) {
+		if (streq(rpc_convert_params[i].method, method)
+		    && rpc_convert_params[i].param == param)
+			return true;
+	}
+	return false;
+}
+
+static char *base64(const tal_t *ctx, const char *str)
+{
+	static const char enc[] =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	size_t len = strlen(str), n = 0;
+	const u8 *in = (const u8 *)str;
+	char *out = tal_arr(ctx, char, (len + 2) / 3 * 4 + 1);
+
+	for (size_t i = 0; i < len; i += 3) {
+		u32 v = (u32)in[i] << 16;
+		if (i + 1 < len)
+			v |= (u32)in[i+1] << 8;
+		if (i + 2 < len)
+			v |= in[i+2];
+		out[n++] = enc[(v >> 18) & 0x3F];
+		out[n++] = enc[(v >> 12) & 0x3F];
+		out[n++] = i + 1 < len ? enc[(v >> 6) & 0x3F] : '=';
+		out[n++] = i + 2 < len ? enc[v & 0x3F] : '=';
+	}
+	out[n] = '\0';
+	return out;
+}
+
+/* args[0] is the method, the rest are params.  We generate all of these
+ * ourselves (numbers, hex and estimate modes), so none need escaping. */
+static char *rpc_request(const tal_t *ctx, const struct bitcoind *bitcoind,
+			 char **args)
+{
+	char *body = tal_fmt(ctx,
+			     "{\"jsonrpc\":\"1.0\",\"id\":0,"
+			     "\"method\":\"%s\",\"params\":[", args[0]);
+
+	for (size_t i = 1; args[i]; i++) {
+		const char *fmt = rpc_param_is_json(args[0], i - 1)
+			? "%s%s" : "%s\"%s\"";
+		tal_append_fmt(&body, fmt, i == 1 ? "" : ",", args[i]);
+	}
+	tal_append_fmt(&body, "]}");
+
+	return tal_fmt(ctx,
+		       "POST / HTTP/1.1\r\n"
+		       "Host: %s\r\n"
+		       "Authorization: Basic %s\r\n"
+		       "Content-Type: application/json\r\n"
+		       "Content-Length: %zu\r\n"
+		       "\r\n"
+		       "%s",
+		       bitcoind->rpcconnect, bitcoind->rpcauth,
+		       strlen(body), take(body));
+}
+
+/* Returns false if we don't have all the headers yet.  If they make no
+ * sense, *httpcode is 0 and we close the connection once it's reported. */
+static bool rpc_parse_headers(const char *buf, size_t len,
+			      int *httpcode, size_t *hdrlen, size_t *bodylen,
+			      bool *keepalive)
+{
+	const char *end, *line, *eol;
+	bool have_len = false;
+
+	end = memmem(buf, len, "\r\n\r\n", 4);
+	if (!end)
+		return false;
+	*hdrlen = end + 4 - buf;
+
+	if (sscanf(buf, "HTTP/1.%*c %d", httpcode) != 1 || *httpcode <= 0)
+		goto bad;
+	*keepalive = strstarts(buf, "HTTP/1.1");
+
+	for (line = strstr(buf, "\r\n") + 2; line < end; line = eol + 2) {
+		eol = strstr(line, "\r\n");
+		if (strncasecmp(line, "Content-Length:", 15) == 0) {
+			*bodylen = strtoul(line + 15, NULL, 10);
+			have_len = true;
+		} else if (strncasecmp(line, "Connection:", 11) == 0) {
+			/* "close" or "keep-alive" */
+			*keepalive = (memmem(line, eol - line, "lose", 4) == NULL);
+		}
+	}
+
+	if (!have_len)
+		goto bad;
+	return true;
+
+bad:
+	*httpcode = 0;
+	*bodylen = 0;
+	*keepalive = false;
+	return true;
+}
+
+/* Hand back whatever bitcoind said, as bitcoin-cli would on failure. */
+static int rpc_bad_reply(struct bitcoin_cli *bcli, int httpcode,
+			 const char *buf, size_t len)
+{
+	bcli->output = tal_strndup(bcli, buf, len);
+	bcli->output_bytes = strlen(bcli->output);
+	return httpcode >= 300 ? httpcode : 1;
+}
+
+/* Turn the JSON-RPC reply into what bitcoin-cli would have printed and
+ * returned, so process() callbacks don't care which backend we used. */
+static int rpc_result(struct bitcoin_cli *bcli, int httpcode,
+		      const char *buf, size_t bodylen)
+{
+	const jsmntok_t *tokens, *errtok, *codetok, *msgtok, *resulttok;
+	char *body = tal_strndup(bcli, buf, bodylen);
+	bool valid;
+	long code;
+	size_t len;
+
+	if (httpcode == 401 || httpcode == 403)
+		fatal("bitcoind refused --bitcoin-rpcuser/--bitcoin-rpcpassword"
+		      " (HTTP %i)", httpcode);
+
+	tokens = json_parse_input(body, bodylen, &valid);
+	/* eg. 503 "Work queue depth exceeded" is plain text. */
+	if (!tokens || tokens[0].type != JSMN_OBJECT)
+		return rpc_bad_reply(bcli, httpcode, body, bodylen);
+
+	errtok = json_get_member(body, tokens, "error");
+	if (errtok && !json_tok_is_null(body, errtok)) {
+		codetok = json_get_member(body, errtok, "code");
+		msgtok = json_get_member(body, errtok, "message");
+		if (!codetok || !msgtok)
+			return rpc_bad_reply(bcli, httpcode, body, bodylen);
+		code = strtol(body + codetok->start, NULL, 10);
+		bcli->output = tal_fmt(bcli,
+				       "error code: %li\n"
+				       "error message:\n%.*s\n",
+				       code, msgtok->end - msgtok->start,
+				       body + msgtok->start);
+		bcli->output_bytes = strlen(bcli->output);
+		return labs(code);
+	}
+
+	resulttok = json_get_member(body, tokens, "result");
+	if (!resulttok)
+		return rpc_bad_reply(bcli, httpcode, body, bodylen);
+
+	/* Results can be whole blocks, so reuse body rather than copy.
+	 * Like bitcoin-cli, strings lose their quotes. */
+	if (json_tok_is_null(body, resulttok))
+		len = 0;
+	else {
+		len = resulttok->end - resulttok->start;
+		memmove(body, body + resulttok->start, len);
+		body[len++] = '\n';
+	}
+	bcli->output = body;
+	bcli->output_bytes = len;
+	return 0;
+}
+
+/* One keep-alive HTTP connection to bitcoind. */
+struct rpc_conn {
+	struct list_node list;
+	struct bitcoind *bitcoind;
+
+	/* Request we're running, NULL if idle. */
+	struct bitcoin_cli *bcli;
+
+	/* Has bitcoind already answered on this connection? */
+	bool reused;
+
+	char *request;
+	char *buf;
+	size_t len, new_len;
+
+	/* Once we've seen the headers. */
+	size_t hdrlen, bodylen;
+	int httpcode;
+	bool keepalive;
+};
+
+static void next_rpc(struct bitcoind *bitcoind);
+
+static struct io_plan *rpc_conn_next(struct io_conn *conn, struct rpc_conn *rc);
+
+static struct io_plan *rpc_conn_done(struct io_conn *conn, struct rpc_conn *rc)
+{
+	struct bitcoind *bitcoind = rc->bitcoind;
+	int exitstatus;
+
+	/* Garbled headers: report them, and keepalive is false so we close. */
+	if (!rc->httpcode)
+		exitstatus = rpc_bad_reply(rc->bcli, 0, rc->buf, rc->hdrlen);
+	else
+		exitstatus = rpc_result(rc->bcli, rc->httpcode,
+					rc->buf + rc->hdrlen, rc->bodylen);
+	rc->reused = true;
+
+	/* We stay busy during process(), so requests it makes go elsewhere */
+	bcli_done(rc->bcli, exitstatus);
+	rc->bcli = NULL;
+
+	if (!rc->keepalive)
+		return io_close(conn);
+
+	next_rpc(bitcoind);
+	return rpc_conn_next(conn, rc);
+}
+
+static struct io_plan *rpc_read_more(struct io_conn *conn, struct rpc_conn *rc)
+{
+	rc->len += rc->new_len;
+	/* We always leave room to terminate, for parsing the headers. */
+	rc->buf[rc->len] = '\0';
+
+	if (!rc->hdrlen
+	    && rpc_parse_headers(rc->buf, rc->len, &rc->httpcode,
+				 &rc->hdrlen, &rc->bodylen, &rc->keepalive)) {
+		if (tal_count(rc->buf) <= rc->hdrlen + rc->bodylen)
+			tal_resize(&rc->buf, rc->hdrlen + rc->bodylen + 1);
+	}
+
+	if (rc->hdrlen && rc->len >= rc->hdrlen + rc->bodylen)
+		return rpc_conn_done(conn, rc);
+
+	if (rc->len + 1 == tal_count(rc->buf))
+		tal_resize(&rc->buf, tal_count(rc->buf) * 2);
+
+	return io_read_partial(conn, rc->buf + rc->len,
+			       tal_count(rc->buf) - rc->len - 1,
+			       &rc->new_len, rpc_read_more, rc);
+}
+
+static struct io_plan *rpc_read_init(struct io_conn *conn, struct rpc_conn *rc)
+{
+	rc->new_len = 0;
+	rc->hdrlen = 0;
+	/* We keep the buffer: blocks will need a big one every time. */
+	if (!rc->buf)
+		rc->buf = tal_arr(rc, char, 1024);
+	return rpc_read_more(conn, rc);
+}
+
+static struct io_plan *rpc_conn_next(struct io_conn *conn, struct rpc_conn *rc)
+{
+	/* Idle: next_rpc() will wake us when there's a request for us. */
+	if (!rc->bcli)
+		return io_wait(conn, rc, rpc_conn_next, rc);
+
+	rc->len = 0;
+	tal_free(rc->request);
+	rc->request = rpc_request(rc, rc->bitcoind, rc->bcli->args);
+	return io_write(conn, rc->request, strlen(rc->request),
+			rpc_read_init, rc);
+}
+
+static struct io_plan *rpc_conn_init(struct io_conn *conn, struct rpc_conn *rc)
+{
+	return io_connect(conn, rc->bitcoind->rpcaddr, rpc_conn_next, rc);
+}
+
+static void rpc_conn_finished(struct io_conn *conn, struct rpc_conn *rc)
+{
+	struct bitcoind *bitcoind = rc->bitcoind;
+	struct bitcoin_cli *bcli = rc->bcli;
+
+	list_del_from(&bitcoind->rpc_conns, &rc->list);
+	bitcoind->num_rpc_conns--;
+
+	if (bitcoind->shutdown)
+		return;
+
+	if (bcli) {
+		if (rc->reused && rc->len == 0) {
+			/* bitcoind timed out our idle connection as we
+			 * sent: it never saw this, so just try again. */
+			list_add(&bitcoind->pending, &bcli->list);
+		} else {
+			/* Like bitcoin-cli failing to connect. */
+			bcli->output = tal_fmt(bcli, "error: %s",
+					       errno ? strerror(errno)
+					       : "connection closed");
+			bcli->output_bytes = strlen(bcli->output);
+			bcli_done(bcli, 1);
+		}
+	}
+	next_rpc(bitcoind);
+}
+
+static void new_rpc_conn(struct bitcoind *bitcoind, struct bitcoin_cli *bcli)
+{
+	struct rpc_conn *rc = tal(bitcoind, struct rpc_conn);
+	struct io_conn *conn;
+	int fd;
+
+	fd = socket(bitcoind->rpcaddr->ai_family,
+		    bitcoind->rpcaddr->ai_socktype,
+		    bitcoind->rpcaddr->ai_protocol);
+	if (fd < 0)
+		fatal("Creating socket for bitcoind: %s", strerror(errno));
+
+	rc->bitcoind = bitcoind;
+	rc->bcli = bcli;
+	rc->reused = false;
+	rc->request = NULL;
+	rc->buf = NULL;
+	rc->len = 0;
+	list_add_tail(&bitcoind->rpc_conns, &rc->list);
+	bitcoind->num_rpc_conns++;
+
+	/* This lifetime is attached to bitcoind; rc lives as long as conn */
+	conn = notleak(io_new_conn(bitcoind, fd, rpc_conn_init, rc));
+	tal_steal(conn, rc);
+	io_set_finish(conn, rpc_conn_finished, rc);
+}
+
+static struct rpc_conn *idle_rpc_conn(struct bitcoind *bitcoind)
+{
+	struct rpc_conn *rc;
+
+	list_for_each(&bitcoind->rpc_conns, rc, list) {
+		if (!rc->bcli)
+			return rc;
+	}
+	return NULL;
+}
+
+/* Hand pending requests to idle connections, opening more if allowed. */
+static void next_rpc(struct bitcoind *bitcoind)
+{
+	struct bitcoin_cli *bcli;
+	struct rpc_conn *rc;
+
+	while (!list_empty(&bitcoind->pending)) {
+		rc = idle_rpc_conn(bitcoind);
+		if (!rc && bitcoind->num_rpc_conns >= bitcoind->rpcconnections)
+			return;
+
+		bcli = list_pop(&bitcoind->pending, struct bitcoin_cli, list);
+		if (rc) {
+			rc->bcli = bcli;
+			io_wake(rc);
+		} else
+			new_rpc_conn(bitcoind, bcli);
+	}
+}
+
 static void process_donothing(struct bitcoin_cli *bcli)
 {
 }
@@ -239,7 +624,10 @@ start_bitcoin_cli(struct bitcoind *bitcoind,
 	va_end(ap);
 
 	list_add_tail(&bitcoind->pending, &bcli->list);
-	next_bcli(bitcoind);
+	if (bitcoind->rpcconnect)
+		next_rpc(bitcoind);
+	else
+		next_bcli(bitcoind);
 }
 
 static bool extract_feerate(struct bitcoin_cli *bcli,
@@ -268,7 +656,7 @@ static bool extract_feerate(struct bitcoin_cli *bcli,
 }
 
 struct estimatefee {
-	size_t i;
+	size_t outstanding;
 	const u32 *blocks;
 	const char **estmode;
 
@@ -278,44 +666,34 @@ struct estimatefee {
 	u32 *satoshi_per_kw;
 };
 
-static void do_one_estimatefee(struct bitcoind *bitcoind,
-			       struct estimatefee *efee);
+/* One of the estimates we asked for. */
+struct estimatefee_one {
+	struct estimatefee *efee;
+	size_t i;
+};
 
 static void process_estimatefee(struct bitcoin_cli *bcli)
 {
 	double feerate;
-	struct estimatefee *efee = bcli->cb_arg;
+	struct estimatefee_one *one = bcli->cb_arg;
+	struct estimatefee *efee = one->efee;
 
 	/* FIXME: We could trawl recent blocks for median fee... */
 	if (!extract_feerate(bcli, bcli->output, bcli->output_bytes, &feerate)) {
 		log_unusual(bcli->bitcoind->log, "Unable to estimate %s/%u fee",
-			    efee->estmode[efee->i], efee->blocks[efee->i]);
-		efee->satoshi_per_kw[efee->i] = 0;
+			    efee->estmode[one->i], efee->blocks[one->i]);
+		efee->satoshi_per_kw[one->i] = 0;
 	} else
 		/* Rate in satoshi per kw. */
-		efee->satoshi_per_kw[efee->i] = feerate * 100000000 / 4;
+		efee->satoshi_per_kw[one->i] = feerate * 100000000 / 4;
 
-	efee->i++;
-	if (efee->i == tal_count(efee->satoshi_per_kw)) {
+	tal_free(one);
+	if (--efee->outstanding == 0) {
 		efee->cb(bcli->bitcoind, efee->satoshi_per_kw, efee->arg);
 		tal_free(efee);
-	} else {
-		/* Next */
-		do_one_estimatefee(bcli->bitcoind, efee);
 	}
 }
 
-static void do_one_estimatefee(struct bitcoind *bitcoind,
-			       struct estimatefee *efee)
-{
-	char blockstr[STR_MAX_CHARS(u32)];
-
-	sprintf(blockstr, "%u", efee->blocks[efee->i]);
-	start_bitcoin_cli(bitcoind, NULL, process_estimatefee, false, NULL, efee,
-			  "estimatesmartfee", blockstr, efee->estmode[efee->i],
-			  NULL);
-}
-
 void bitcoind_estimate_fees_(struct bitcoind *bitcoind,
 			     const u32 blocks[], const char *estmode[],
 			     size_t num_estimates,
@@ -325,7 +703,7 @@ void bitcoind_estimate_fees_(struct bitcoind *bitcoind,
 {
 	struct estimatefee *efee = tal(bitcoind, struct estimatefee);
 
-	efee->i = 0;
+	efee->outstanding = num_estimates;
 	efee->blocks = tal_dup_arr(efee, u32, blocks, num_estimates, 0);
 	efee->estmode = tal_dup_arr(efee, const char *, estmode, num_estimates,
 				    0);
@@ -333,7 +711,19 @@ void bitcoind_estimate_fees_(struct bitcoind *bitcoind,
 	efee->arg = arg;
 	efee->satoshi_per_kw = tal_arr(efee, u32, num_estimates);
 
-	do_one_estimatefee(bitcoind, efee);
+	/* Ask for them all at once: they needn't wait for each other. */
+	for (size_t i = 0; i < num_estimates; i++) {
+		struct estimatefee_one *one = tal(efee, struct estimatefee_one);
+		char blockstr[STR_MAX_CHARS(u32)];
+
+		one->efee = efee;
+		one->i = i;
+		sprintf(blockstr, "%u", efee->blocks[i]);
+		start_bitcoin_cli(bitcoind, NULL, process_estimatefee, false,
+				  NULL, one,
+				  "estimatesmartfee", blockstr,
+				  efee->estmode[i], NULL);
+	}
 }
 
 static void process_sendrawtx(struct bitcoin_cli *bcli)
@@ -640,6 +1030,8 @@ static void destroy_bitcoind(struct bitcoind *bitcoind)
 {
 	/* Suppresses the callbacks from bcli_finished as we free conns. */
 	bitcoind->shutdown = true;
+	if (bitcoind->rpcaddr)
+		freeaddrinfo(bitcoind->rpcaddr);
 }
 
 static char **cmdarr(const tal_t *ctx, const struct bitcoind *bitcoind,
@@ -654,40 +1046,136 @@ static char **cmdarr(const tal_t *ctx, const struct bitcoind *bitcoind,
 	return args;
 }
 
+/* Run bcli->args synchronously, filling in output; returns exit status. */
+static int bcli_sync(struct bitcoin_cli *bcli)
+{
+	int ret, status;
+
+	bcli->pid = pipecmdarr(&bcli->fd, NULL, &bcli->fd, bcli->args);
+	if (bcli->pid < 0)
+		fatal("%s exec failed: %s", bcli->args[0], strerror(errno));
+
+	bcli->output = grab_fd(bcli, bcli->fd);
+	if (!bcli->output)
+		fatal("Reading from %s failed: %s",
+		      bcli->args[0], strerror(errno));
+	bcli->output_bytes = tal_count(bcli->output) - 1;
+
+	ret = waitpid(bcli->pid, &status, 0);
+	if (ret != bcli->pid)
+		fatal("Waiting for %s: %s", bcli->args[0], strerror(errno));
+	if (!WIFEXITED(status))
+		fatal("Death of %s: signal %i",
+		      bcli->args[0], WTERMSIG(status));
+
+	return WEXITSTATUS(status);
+}
+
+/* Same as bcli_sync, but over a one-shot JSON-RPC connection. */
+static int rpc_sync(struct bitcoin_cli *bcli)
+{
+	struct bitcoind *bitcoind = bcli->bitcoind;
+	char *req = rpc_request(bcli, bitcoind, bcli->args);
+	char *buf = tal_arr(bcli, char, 1024);
+	size_t len = 0, hdrlen = 0, bodylen = 0;
+	int fd, httpcode;
+	bool keepalive;
+
+	fd = socket(bitcoind->rpcaddr->ai_family,
+		    bitcoind->rpcaddr->ai_socktype,
+		    bitcoind->rpcaddr->ai_protocol);
+	if (fd < 0)
+		fatal("Creating socket for bitcoind: %s", strerror(errno));
+	if (connect(fd, bitcoind->rpcaddr->ai_addr,
+		    bitcoind->rpcaddr->ai_addrlen) != 0)
+		fatal("Connecting to bitcoind at %s:%u: %s",
+		      bitcoind->rpcconnect, bitcoind->rpcport,
+		      strerror(errno));
+	if (!write_all(fd, req, strlen(req)))
+		fatal("Writing to bitcoind: %s", strerror(errno));
+
+	while (!hdrlen || len < hdrlen + bodylen) {
+		ssize_t r;
+
+		if (len + 1 == tal_count(buf))
+			tal_resize(&buf, tal_count(buf) * 2);
+		r = read(fd, buf + len, tal_count(buf) - len - 1);
+		if (r <= 0)
+			fatal("Reading from bitcoind: %s",
+			      r == 0 ? "connection closed" : strerror(errno));
+		len += r;
+		buf[len] = '\0';
+		if (!hdrlen)
+			rpc_parse_headers(buf, len, &httpcode,
+					  &hdrlen, &bodylen, &keepalive);
+	}
+	close(fd);
+
+	if (!httpcode)
+		return rpc_bad_reply(bcli, 0, buf, hdrlen);
+	return rpc_result(bcli, httpcode, buf + hdrlen, bodylen);
+}
+
+static void init_rpc(struct bitcoind *bitcoind)
+{
+	struct addrinfo hints;
+	char port[STR_MAX_CHARS(u16)];
+	char *userpass;
+	int err;
+
+	if (!bitcoind->rpcuser || !bitcoind->rpcpassword)
+		fatal("--bitcoin-rpcconnect needs --bitcoin-rpcuser"
+		      " and --bitcoin-rpcpassword");
+	if (!bitcoind->rpcconnections)
+		fatal("--bitcoin-rpcconnections must be at least 1");
+
+	userpass = tal_fmt(bitcoind, "%s:%s",
+			   bitcoind->rpcuser, bitcoind->rpcpassword);
+	bitcoind->rpcauth = base64(bitcoind, userpass);
+	tal_free(userpass);
+
+	if (!bitcoind->rpcport)
+		bitcoind->rpcport = bitcoind->chainparams->rpc_port;
+	sprintf(port, "%u", bitcoind->rpcport);
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	err = getaddrinfo(bitcoind->rpcconnect, port, &hints,
+			  &bitcoind->rpcaddr);
+	if (err)
+		fatal("Looking up bitcoind %s:%s: %s",
+		      bitcoind->rpcconnect, port, gai_strerror(err));
+}
+
 void wait_for_bitcoind(struct bitcoind *bitcoind)
 {
-	int from, ret, status;
-	pid_t child;
-	char **cmd = cmdarr(bitcoind, bitcoind, "echo", NULL);
-	char *output;
+	struct bitcoin_cli *bcli = tal(bitcoind, struct bitcoin_cli);
 	bool printed = false;
+	int status;
+
+	if (bitcoind->rpcconnect)
+		init_rpc(bitcoind);
+
+	bcli->bitcoind = bitcoind;
+	bcli->args = cmdarr(bcli, bitcoind, "echo", NULL);
 
 	for (;;) {
-		child = pipecmdarr(&from, NULL, &from, cmd);
-		if (child < 0)
-			fatal("%s exec failed: %s", cmd[0], strerror(errno));
-
-		output = grab_fd(cmd, from);
-		if (!output)
-			fatal("Reading from %s failed: %s",
-			      cmd[0], strerror(errno));
-
-		ret = waitpid(child, &status, 0);
-		if (ret != child)
-			fatal("Waiting for %s: %s", cmd[0], strerror(errno));
-		if (!WIFEXITED(status))
-			fatal("Death of %s: signal %i",
-			      cmd[0], WTERMSIG(status));
-
-		if (WEXITSTATUS(status) == 0)
+		if (bitcoind->rpcconnect)
+			status = rpc_sync(bcli);
+		else
+			status = bcli_sync(bcli);
+
+		if (status == 0)
 			break;
 
 		/* bitcoin/src/rpc/protocol.h:
 		 *	RPC_IN_WARMUP = -28, //!< Client still warming up
 		 */
-		if (WEXITSTATUS(status) != 28)
-			fatal("%s exited with code %i: %s",
-			      cmd[0], WEXITSTATUS(status), output);
+		if (status != 28)
+			fatal("%s exited with code %i: %.*s",
+			      bcli_args(bcli), status,
+			      (int)bcli->output_bytes, bcli->output);
 
 		if (!printed) {
 			log_unusual(bitcoind->log,
@@ -696,7 +1184,7 @@ void wait_for_bitcoind(struct bitcoind *bitcoind)
 		}
 		sleep(1);
 	}
-	tal_free(cmd);
+	tal_free(bcli);
 }
 
 struct bitcoind *new_bitcoind(const tal_t *ctx,
@@ -714,6 +1202,14 @@ struct bitcoind *new_bitcoind(const tal_t *ctx,
 	bitcoind->shutdown = false;
 	bitcoind->error_count = 0;
 	list_head_init(&bitcoind->pending);
+	bitcoind->rpcconnect = NULL;
+	bitcoind->rpcport = 0;
+	bitcoind->rpcuser = bitcoind->rpcpassword = NULL;
+	bitcoind->rpcconnections = 4;
+	bitcoind->rpcaddr = NULL;
+	bitcoind->rpcauth = NULL;
+	list_head_init(&bitcoind->rpc_conns);
+	bitcoind->num_rpc_conns = 0;
 	tal_add_destructor(bitcoind, destroy_bitcoind);
 
 	return bitcoind;
@@ -9,6 +9,7 @@
 #include <ccan/typesafe_cb/typesafe_cb.h>
 #include <stdbool.h>
 
+struct addrinfo;
 struct bitcoin_blkid;
 struct bitcoin_tx_output;
 struct block;
@@ -34,7 +35,7 @@ struct bitcoind {
 	/* Main lightningd structure */
 	struct lightningd *ld;
 
-	/* Are we currently running a bitcoind request (it's ratelimited) */
+	/* Are we currently running a bitcoin-cli request (it's ratelimited) */
 	bool req_running;
 
 	/* Pending requests. */
@@ -49,6 +50,22 @@ struct bitcoind {
 
 	/* Ignore results, we're shutting down. */
 	bool shutdown;
+
+	/* If set, we talk JSON-RPC to bitcoind here, not via bitcoin-cli. */
+	char *rpcconnect;
+	u16 rpcport;
+	char *rpcuser, *rpcpassword;
+
+	/* How many requests we run at once (one per connection). */
+	u32 rpcconnections;
+
+	/* Resolved rpcconnect:rpcport, and base64 "rpcuser:rpcpassword" */
+	struct addrinfo *rpcaddr;
+	char *rpcauth;
+
+	/* Keep-alive connections to rpcconnect. */
+	struct list_head rpc_conns;
+	size_t num_rpc_conns;
 };
 
 struct bitcoind *new_bitcoind(const tal_t *ctx,
@@ -16,10 +16,29 @@
 #include <common/timeout.h>
 #include <common/utils.h>
 #include <inttypes.h>
+#include <wallet/db.h>
 
 /* Mutual recursion via timer. */
 static void try_extend_tip(struct chain_topology *topo);
 
+/* Most blocks we'll fetch ahead of the tip while catching up. */
+#define PREFETCH_BLOCKS 16
+
+/* A block we've asked bitcoind for, but not added yet. */
+struct prefetch {
+	/* In topo->prefetch, by height. */
+	struct list_node list;
+	struct chain_topology *topo;
+	u32 height;
+
+	/* Has bitcoind answered?  blk is NULL if there's no such block. */
+	bool done;
+	struct bitcoin_block *blk;
+
+	/* Thrown away while bitcoind was busy fetching it. */
+	bool discarded;
+};
+
 static void next_topology_timer(struct chain_topology *topo)
 {
 	/* This takes care of its own lifetime. */
@@ -27,41 +46,89 @@ static void next_topology_timer(struct chain_topology *topo)
 			     try_extend_tip, topo));
 }
 
+static const struct bitcoin_blkid *tip_blkid(const struct chain_topology *topo)
+{
+	return &topo->blkids[tal_count(topo->blkids) - 1];
+}
+
 /* FIXME: Remove tx from block when peer done. */
 static void add_tx_to_block(struct block *b,
-			    const struct bitcoin_tx *tx, const u32 txnum)
+			    const struct bitcoin_tx *tx,
+			    const struct bitcoin_txid *txid, const u32 txnum)
 {
 	size_t n = tal_count(b->txs);
 
+	/* add_tip indexes these, once we're done resizing. */
 	tal_resize(&b->txs, n+1);
-	tal_resize(&b->txnums, n+1);
-	b->txs[n] = tal_steal(b->txs, tx);
-	b->txnums[n] = txnum;
+	b->txs[n].txid = *txid;
+	b->txs[n].block = b;
+	b->txs[n].txnum = txnum;
+	b->txs[n].tx = tal_steal(b, tx);
 }
 
 static bool we_broadcast(const struct chain_topology *topo,
 			 const struct bitcoin_txid *txid)
 {
-	const struct outgoing_tx *otx;
+	return outgoing_tx_map_get(&topo->outgoing_txmap, txid) != NULL;
+}
 
-	list_for_each(&topo->outgoing_txs, otx, list) {
-		if (structeq(&otx->txid, txid))
-			return true;
-	}
-	return false;
+/* What bitcoin_tx_skim() tells us about a tx before we pull it. */
+struct tx_interest {
+	const struct chain_topology *topo;
+	bool spends_watched, pays_us;
+};
+
+static void skim_input(const struct bitcoin_txid *txid, u32 index, void *arg)
+{
+	struct tx_interest *interest = arg;
+	struct txwatch_output out;
+
+	out.txid = *txid;
+	out.index = index;
+	if (txowatch_hash_get(&interest->topo->txowatches, &out))
+		interest->spends_watched = true;
+}
+
+static void skim_output(const u8 *script, size_t script_len, void *arg)
+{
+	struct tx_interest *interest = arg;
+
+	if (txfilter_match_script(interest->topo->bitcoind->ld->owned_txfilter,
+				  script, script_len))
+		interest->pays_us = true;
 }
 
-static void filter_block_txs(struct chain_topology *topo, struct block *b)
+static void filter_block_txs(struct chain_topology *topo, struct block *b,
+			     const struct bitcoin_block *blk)
 {
-	size_t i;
-	u64 satoshi_owned;
+	const u8 *p = blk->raw_txs;
+	size_t len = blk->raw_txs_len;
+	u64 i, satoshi_owned;
 
-	/* Now we see if any of those txs are interesting. */
-	for (i = 0; i < tal_count(b->full_txs); i++) {
-		const struct bitcoin_tx *tx = b->full_txs[i];
+	/* Now we see if any of those txs are interesting: we only
+	 * deserialize the ones which are. */
+	for (i = 0; i < blk->num_txs; i++) {
+		const u8 *start = p;
+		size_t txlen;
+		struct tx_interest interest;
+		struct bitcoin_tx *tx;
 		struct bitcoin_txid txid;
 		size_t j;
 
+		interest.topo = topo;
+		interest.spends_watched = interest.pays_us = false;
+		bitcoin_tx_skim(&p, &len, &txid, skim_input, skim_output,
+				&interest);
+		/* bitcoin_block_from_hex() already checked them. */
+		assert(p);
+
+		if (!interest.spends_watched && !interest.pays_us
+		    && !watching_txid(topo, &txid) && !we_broadcast(topo, &txid))
+			continue;
+
+		txlen = p - start;
+		tx = pull_bitcoin_tx(b, &start, &txlen);
+
 		/* Tell them if it spends a txo we care about. */
 		for (j = 0; j < tal_count(tx->input); j++) {
 			struct txwatch_output out;
@@ -75,63 +142,32 @@ static void filter_block_txs(struct chain_topology *topo, struct block *b)
 		}
 
 		satoshi_owned = 0;
-		if (txfilter_match(topo->bitcoind->ld->owned_txfilter, tx)) {
+		if (interest.pays_us) {
 			wallet_extract_owned_outputs(topo->bitcoind->ld->wallet,
 						     tx, &satoshi_owned);
 		}
 
 		/* We did spends first, in case that tells us to watch tx. */
-		bitcoin_txid(tx, &txid);
 		if (watching_txid(topo, &txid) || we_broadcast(topo, &txid) ||
 		    satoshi_owned != 0)
-			add_tx_to_block(b, tx, i);
+			add_tx_to_block(b, tx, &txid, i);
+		else
+			tal_free(tx);
 	}
-	b->full_txs = tal_free(b->full_txs);
-}
-
-static const struct bitcoin_tx *tx_in_block(const struct block *b,
-					    const struct bitcoin_txid *txid)
-{
-	size_t i, n = tal_count(b->txs);
-
-	for (i = 0; i < n; i++) {
-		struct bitcoin_txid this_txid;
-		bitcoin_txid(b->txs[i], &this_txid);
-		if (structeq(&this_txid, txid))
-			return b->txs[i];
-	}
-	return NULL;
-}
-
-/* FIXME: Use hash table. */
-static struct block *block_for_tx(const struct chain_topology *topo,
-				  const struct bitcoin_txid *txid,
-				  const struct bitcoin_tx **tx)
-{
-	struct block *b;
-	const struct bitcoin_tx *dummy_tx;
-
-	if (!tx)
-		tx = &dummy_tx;
-
-	for (b = topo->tip; b; b = b->prev) {
-		*tx = tx_in_block(b, txid);
-		if (*tx)
-			return b;
-	}
-	return NULL;
 }
 
 size_t get_tx_depth(const struct chain_topology *topo,
 		    const struct bitcoin_txid *txid,
 		    const struct bitcoin_tx **tx)
 {
-	const struct block *b;
+	const struct block_tx *btx;
 
-	b = block_for_tx(topo, txid, tx);
-	if (!b)
+	btx = block_tx_map_get(&topo->block_txs, txid);
+	if (tx)
+		*tx = btx ? btx->tx : NULL;
+	if (!btx)
 		return 0;
-	return topo->tip->height - b->height + 1;
+	return get_block_height(topo) - btx->block->height + 1;
 }
 
 struct txs_to_broadcast {
@@ -192,7 +228,7 @@ static void rebroadcast_txs(struct chain_topology *topo, struct command *cmd)
 	/* Put any txs we want to broadcast in ->txs. */
 	txs->txs = tal_arr(txs, const char *, 0);
 	list_for_each(&topo->outgoing_txs, otx, list) {
-		if (block_for_tx(topo, &otx->txid, NULL))
+		if (block_tx_map_get(&topo->block_txs, &otx->txid))
 			continue;
 
 		tal_resize(&txs->txs, num_txs+1);
@@ -208,6 +244,7 @@ static void rebroadcast_txs(struct chain_topology *topo, struct command *cmd)
 static void destroy_outgoing_tx(struct outgoing_tx *otx)
 {
 	list_del(&otx->list);
+	outgoing_tx_map_del(&otx->topo->outgoing_txmap, otx);
 }
 
 static void clear_otx_peer(struct peer *peer, struct outgoing_tx *otx)
@@ -236,7 +273,8 @@ static void broadcast_done(struct bitcoind *bitcoind,
 	} else {
 		/* For continual rebroadcasting, until peer freed. */
 		tal_steal(otx->peer, otx);
-		list_add_tail(&bitcoind->ld->topology->outgoing_txs, &otx->list);
+		list_add_tail(&otx->topo->outgoing_txs, &otx->list);
+		outgoing_tx_map_add(&otx->topo->outgoing_txmap, otx);
 		tal_add_destructor(otx, destroy_outgoing_tx);
 	}
 }
@@ -250,6 +288,7 @@ void broadcast_tx(struct chain_topology *topo,
 	struct outgoing_tx *otx = tal(topo, struct outgoing_tx);
 	const u8 *rawtx = linearize_tx(otx, tx);
 
+	otx->topo = topo;
 	otx->peer = peer;
 	bitcoin_txid(tx, &otx->txid);
 	otx->hextx = tal_hex(otx, rawtx);
@@ -278,6 +317,25 @@ static const char *feerate_name(enum feerate feerate)
 /* Mutual recursion via timer. */
 static void next_updatefee_timer(struct chain_topology *topo);
 
+/* What we call each feerate in the db. */
+static char *feerate_varname(enum feerate feerate)
+{
+	return feerate == FEERATE_IMMEDIATE ? "feerate_immediate"
+		: feerate == FEERATE_NORMAL ? "feerate_normal" : "feerate_slow";
+}
+
+/* Estimates jump around: we follow a rise at once (so we're never
+ * underpaying for long), but only come halfway down each time. */
+static u32 smooth_feerate(u32 old, u32 estimate)
+{
+	/* No estimate?  Stick with what we had. */
+	if (estimate == 0)
+		return old;
+	if (estimate >= old)
+		return estimate;
+	return old - (old - estimate) / 2;
+}
+
 /* We sanitize feerates if necessary to put them in descending order. */
 static void update_feerates(struct bitcoind *bitcoind,
 			    const u32 *satoshi_per_kw,
@@ -287,12 +345,14 @@ static void update_feerates(struct bitcoind *bitcoind,
 	bool changed = false;
 
 	for (size_t i = 0; i < NUM_FEERATES; i++) {
-		if (satoshi_per_kw[i] != topo->feerate[i])
-			log_debug(topo->log, "%s feerate %u (was %u)",
+		u32 feerate = smooth_feerate(topo->feerate[i], satoshi_per_kw[i]);
+
+		if (feerate != topo->feerate[i])
+			log_debug(topo->log, "%s feerate %u (was %u, estimate %u)",
 				  feerate_name(i),
-				  satoshi_per_kw[i], topo->feerate[i]);
+				  feerate, topo->feerate[i], satoshi_per_kw[i]);
 		old_feerates[i] = topo->feerate[i];
-		topo->feerate[i] = satoshi_per_kw[i];
+		topo->feerate[i] = feerate;
 	}
 
 	for (size_t i = 0; i < NUM_FEERATES; i++) {
@@ -309,8 +369,13 @@ static void update_feerates(struct bitcoind *bitcoind,
 			changed = true;
 	}
 
-	if (changed)
+	if (changed) {
+		/* So we have something sensible as soon as we restart. */
+		for (size_t i = 0; i < NUM_FEERATES; i++)
+			db_set_intvar(bitcoind->ld->wallet->db,
+				      feerate_varname(i), topo->feerate[i]);
 		notify_feerate_change(bitcoind->ld);
+	}
 
 	next_updatefee_timer(topo);
 }
@@ -338,9 +403,9 @@ static void next_updatefee_timer(struct chain_topology *topo)
 /* Once we're run out of new blocks to add, call this. */
 static void updates_complete(struct chain_topology *topo)
 {
-	if (topo->tip != topo->prev_tip) {
+	if (!structeq(tip_blkid(topo), &topo->prev_tip)) {
 		/* Tell lightningd about new block. */
-		notify_new_block(topo->bitcoind->ld, topo->tip->height);
+		notify_new_block(topo->bitcoind->ld, get_block_height(topo));
 
 		/* Tell watch code to re-evaluate all txs. */
 		watch_topology_changed(topo);
@@ -348,109 +413,212 @@ static void updates_complete(struct chain_topology *topo)
 		/* Maybe need to rebroadcast. */
 		rebroadcast_txs(topo, NULL);
 
-		topo->prev_tip = topo->tip;
+		topo->prev_tip = *tip_blkid(topo);
 	}
 
 	/* Try again soon. */
 	next_topology_timer(topo);
 }
 
-static void add_tip(struct chain_topology *topo, struct block *b)
+/* Forget the ids of blocks too deep to be reorganized out. */
+static void trim_blkids(struct chain_topology *topo)
 {
-	/* Only keep the transactions we care about. */
-	filter_block_txs(topo, b);
+	size_t n = tal_count(topo->blkids), keep = topo->retain_blocks + 1;
 
-	block_map_add(&topo->block_map, b);
+	/* Do it in batches, so it's cheap per block. */
+	if (n < keep * 2)
+		return;
 
-	/* Attach to tip; b is now the tip. */
-	assert(b->height == topo->tip->height + 1);
-	b->prev = topo->tip;
-	topo->tip->next = b;
-	topo->tip = b;
+	memmove(topo->blkids, topo->blkids + n - keep,
+		keep * sizeof(topo->blkids[0]));
+	tal_resize(&topo->blkids, keep);
+	topo->blkids_base += n - keep;
 }
 
 static struct block *new_block(struct chain_topology *topo,
-			       struct bitcoin_block *blk,
 			       unsigned int height)
 {
 	struct block *b = tal(topo, struct block);
 
-	sha256_double(&b->blkid.shad, &blk->hdr, sizeof(blk->hdr));
-	log_debug(topo->log, "Adding block %s",
-		  type_to_string(ltmp, struct bitcoin_blkid, &b->blkid));
-	assert(!block_map_get(&topo->block_map, &b->blkid));
-	b->next = NULL;
-	b->prev = NULL;
-
 	b->height = height;
+	b->txs = tal_arr(b, struct block_tx, 0);
 
-	b->hdr = blk->hdr;
+	return b;
+}
 
-	b->txs = tal_arr(b, const struct bitcoin_tx *, 0);
-	b->txnums = tal_arr(b, u32, 0);
-	b->full_txs = tal_steal(b, blk->tx);
+static void add_tip(struct chain_topology *topo,
+		    const struct bitcoin_block *blk)
+{
+	struct block *b = new_block(topo, get_block_height(topo) + 1);
+	size_t n = tal_count(topo->blkids);
+	struct bitcoin_blkid blkid;
 
-	return b;
+	sha256_double(&blkid.shad, &blk->hdr, sizeof(blk->hdr));
+	log_debug(topo->log, "Adding block %s",
+		  type_to_string(ltmp, struct bitcoin_blkid, &blkid));
+
+	/* Only keep the transactions we care about. */
+	filter_block_txs(topo, b, blk);
+
+	/* We only need the block itself if it has some. */
+	if (tal_count(b->txs)) {
+		assert(!block_map_get(&topo->block_map, &b->height));
+		block_map_add(&topo->block_map, b);
+		for (size_t i = 0; i < tal_count(b->txs); i++)
+			block_tx_map_add(&topo->block_txs, &b->txs[i]);
+	} else
+		tal_free(b);
+
+	/* This is now the tip. */
+	tal_resize(&topo->blkids, n + 1);
+	topo->blkids[n] = blkid;
+	trim_blkids(topo);
 }
 
 static void remove_tip(struct chain_topology *topo)
 {
-	struct block *b = topo->tip;
-	size_t i, n = tal_count(b->txs);
+	size_t i, n = tal_count(topo->blkids);
+	int height = get_block_height(topo);
+	struct block *b;
+
+	if (n == 1)
+		fatal("Block %u (%s) reorganized out, and we don't remember"
+		      " the one before it!",
+		      height,
+		      type_to_string(ltmp, struct bitcoin_blkid, tip_blkid(topo)));
 
 	/* Move tip back one. */
-	topo->tip = b->prev;
-	if (!topo->tip)
-		fatal("Initial block %u (%s) reorganized out!",
-		      b->height,
-		      type_to_string(ltmp, struct bitcoin_blkid, &b->blkid));
+	tal_resize(&topo->blkids, n - 1);
+
+	b = block_map_get(&topo->block_map, &height);
+	if (!b)
+		return;
 
 	/* Notify that txs are kicked out. */
-	for (i = 0; i < n; i++)
-		txwatch_fire(topo, b->txs[i], 0);
+	block_map_del(&topo->block_map, b);
+	for (i = 0; i < tal_count(b->txs); i++) {
+		block_tx_map_del(&topo->block_txs, &b->txs[i]);
+		txwatch_fire(topo, b->txs[i].tx, 0);
+	}
 
 	tal_free(b);
 }
 
+/* Throw away everything we've fetched ahead: after a reorg or once we hit
+ * the end of the chain, they're no use to us. */
+static void discard_prefetch(struct chain_topology *topo)
+{
+	struct prefetch *pf;
+
+	while ((pf = list_pop(&topo->prefetch, struct prefetch, list)) != NULL) {
+		if (pf->done)
+			tal_free(pf);
+		else {
+			/* Looks like a leak, but the bitcoind callback frees it */
+			pf->discarded = true;
+			notleak(pf);
+		}
+	}
+}
+
 static void have_new_block(struct bitcoind *bitcoind,
 			   struct bitcoin_block *blk,
-			   struct chain_topology *topo)
+			   struct prefetch *pf)
 {
-	/* Unexpected predecessor?  Free predecessor, refetch it. */
-	if (!structeq(&topo->tip->blkid, &blk->hdr.prev_hash))
-		remove_tip(topo);
-	else
-		add_tip(topo, new_block(topo, blk, topo->tip->height + 1));
+	if (pf->discarded) {
+		tal_free(pf);
+		return;
+	}
 
-	/* Try for next one. */
-	try_extend_tip(topo);
+	pf->blk = tal_steal(pf, blk);
+	pf->done = true;
+	try_extend_tip(pf->topo);
 }
 
 static void get_new_block(struct bitcoind *bitcoind,
 			  const struct bitcoin_blkid *blkid,
-			  struct chain_topology *topo)
+			  struct prefetch *pf)
 {
+	if (pf->discarded) {
+		tal_free(pf);
+		return;
+	}
+
 	if (!blkid) {
-		/* No such block, we're done. */
-		updates_complete(topo);
+		/* No such block: pf->blk NULL tells try_extend_tip we're done */
+		pf->done = true;
+		try_extend_tip(pf->topo);
+		return;
+	}
+	bitcoind_getrawblock(bitcoind, blkid, have_new_block, pf);
+}
+
+/* Ask for blocks up to prefetch_window past the tip. */
+static void fill_prefetch(struct chain_topology *topo)
+{
+	struct prefetch *pf = list_tail(&topo->prefetch, struct prefetch, list);
+	u32 height;
+
+	/* No point asking past a block which doesn't exist. */
+	if (pf && pf->done && !pf->blk)
 		return;
+
+	height = pf ? pf->height + 1 : get_block_height(topo) + 1;
+	while (height <= get_block_height(topo) + topo->prefetch_window) {
+		pf = tal(topo, struct prefetch);
+		pf->topo = topo;
+		pf->height = height++;
+		pf->done = pf->discarded = false;
+		pf->blk = NULL;
+		list_add_tail(&topo->prefetch, &pf->list);
+		bitcoind_getblockhash(topo->bitcoind, pf->height,
+				      get_new_block, pf);
 	}
-	bitcoind_getrawblock(bitcoind, blkid, have_new_block, topo);
 }
 
 static void try_extend_tip(struct chain_topology *topo)
 {
-	bitcoind_getblockhash(topo->bitcoind, topo->tip->height + 1,
-			      get_new_block, topo);
+	struct prefetch *pf;
+
+	/* Blocks can arrive in any order: we add them in order. */
+	while ((pf = list_top(&topo->prefetch, struct prefetch, list)) != NULL
+	       && pf->done) {
+		if (!pf->blk) {
+			/* No such block, we're done. */
+			discard_prefetch(topo);
+			topo->prefetch_window = 1;
+			updates_complete(topo);
+			return;
+		}
+
+		assert(pf->height == get_block_height(topo) + 1);
+		list_del_from(&topo->prefetch, &pf->list);
+
+		/* Unexpected predecessor?  Free predecessor, refetch it
+		 * (and everything after it, which may be on the wrong fork) */
+		if (!structeq(tip_blkid(topo), &pf->blk->hdr.prev_hash)) {
+			remove_tip(topo);
+			discard_prefetch(topo);
+		} else {
+			add_tip(topo, pf->blk);
+			/* We're catching up: fetch further ahead. */
+			if (topo->prefetch_window < PREFETCH_BLOCKS)
+				topo->prefetch_window *= 2;
+		}
+		tal_free(pf);
+	}
+
+	fill_prefetch(topo);
 }
 
 static void init_topo(struct bitcoind *bitcoind,
 		      struct bitcoin_block *blk,
 		      struct chain_topology *topo)
 {
-	topo->root = new_block(topo, blk, topo->first_blocknum);
-	block_map_add(&topo->block_map, topo->root);
-	topo->tip = topo->prev_tip = topo->root;
+	topo->blkids = tal_arr(topo, struct bitcoin_blkid, 1);
+	sha256_double(&topo->blkids[0].shad, &blk->hdr, sizeof(blk->hdr));
+	topo->blkids_base = topo->first_blocknum;
+	topo->prev_tip = topo->blkids[0];
 
 	io_break(topo);
 }
@@ -483,7 +651,7 @@ static void get_init_blockhash(struct bitcoind *bitcoind, u32 blockcount,
 
 u32 get_block_height(const struct chain_topology *topo)
 {
-	return topo->tip->height;
+	return topo->blkids_base + tal_count(topo->blkids) - 1;
 }
 
 /* We may only have estimate for 2 blocks, for example.  Extrapolate. */
@@ -528,23 +696,15 @@ u32 get_feerate(const struct chain_topology *topo, enum feerate feerate)
 struct txlocator *locate_tx(const void *ctx, const struct chain_topology *topo,
 			    const struct bitcoin_txid *txid)
 {
-	struct block *block = block_for_tx(topo, txid, NULL);
-	if (block == NULL) {
+	const struct block_tx *btx = block_tx_map_get(&topo->block_txs, txid);
+	if (btx == NULL) {
 		return NULL;
 	}
 
 	struct txlocator *loc = talz(ctx, struct txlocator);
-	loc->blkheight = block->height;
-	size_t i, n = tal_count(block->txs);
-	for (i = 0; i < n; i++) {
-		struct bitcoin_txid this_txid;
-		bitcoin_txid(block->txs[i], &this_txid);
-		if (structeq(&this_txid, txid)){
-			loc->index = block->txnums[i];
-			return loc;
-		}
-	}
-	return tal_free(loc);
+	loc->blkheight = btx->block->height;
+	loc->index = btx->txnum;
+	return loc;
 }
 
 #if DEVELOPER
@@ -668,6 +828,8 @@ void chaintopology_mark_pointers_used(struct htable *memtable,
 	struct txwatch *w;
 	struct txowatch_hash_iter owit;
 	struct txowatch *ow;
+	struct block_map_iter bit;
+	struct block *b;
 
 	/* memleak can't see inside hash tables, so do them manually */
 	for (w = txwatch_hash_first(&topo->txwatches, &wit);
@@ -679,6 +841,11 @@ void chaintopology_mark_pointers_used(struct htable *memtable,
 	     ow;
 	     ow = txowatch_hash_next(&topo->txowatches, &owit))
 		memleak_scan_region(memtable, ow);
+
+	for (b = block_map_first(&topo->block_map, &bit);
+	     b;
+	     b = block_map_next(&topo->block_map, &bit))
+		memleak_scan_region(memtable, b);
 }
 #endif /* DEVELOPER */
 
@@ -697,7 +864,12 @@ struct chain_topology *new_topology(struct lightningd *ld, struct log *log)
 	struct chain_topology *topo = tal(ld, struct chain_topology);
 
 	block_map_init(&topo->block_map);
+	block_tx_map_init(&topo->block_txs);
 	list_head_init(&topo->outgoing_txs);
+	outgoing_tx_map_init(&topo->outgoing_txmap);
+	list_head_init(&topo->prefetch);
+	topo->prefetch_window = 1;
+	topo->retain_blocks = 1000;
 	txwatch_hash_init(&topo->txwatches);
 	txowatch_hash_init(&topo->txowatches);
 	topo->log = log;
@@ -715,7 +887,14 @@ void setup_topology(struct chain_topology *topo,
 		    struct timers *timers,
 		    struct timerel poll_time, u32 first_peer_block)
 {
-	memset(&topo->feerate, 0, sizeof(topo->feerate));
+	struct db *db = topo->bitcoind->ld->wallet->db;
+
+	/* Start with what we knew last time, until bitcoind tells us more. */
+	db_begin_transaction(db);
+	for (size_t i = 0; i < NUM_FEERATES; i++)
+		topo->feerate[i] = db_get_intvar(db, feerate_varname(i), 0);
+	db_commit_transaction(db);
+
 	topo->timers = timers;
 	topo->poll_time = poll_time;
 	/* Start one before the block we are interested in (as we won't
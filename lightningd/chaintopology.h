@@ -25,47 +25,54 @@ enum feerate {
 };
 #define NUM_FEERATES (FEERATE_SLOW+1)
 
-/* Off topology->outgoing_txs */
+/* Off topology->outgoing_txs (and indexed in topology->outgoing_txmap) */
 struct outgoing_tx {
 	struct list_node list;
+	struct chain_topology *topo;
 	struct peer *peer;
 	const char *hextx;
 	struct bitcoin_txid txid;
 	void (*failed)(struct peer *peer, int exitstatus, const char *err);
 };
 
-struct block {
-	int height;
-
-	/* Actual header. */
-	struct bitcoin_block_hdr hdr;
-
-	/* Previous block (if any). */
-	struct block *prev;
+/* A transaction we care about, in block->txs. */
+struct block_tx {
+	/* Key for topology->block_txs */
+	struct bitcoin_txid txid;
+	struct block *block;
 
-	/* Next block (if any). */
-	struct block *next;
+	/* Index within the block */
+	u32 txnum;
+	const struct bitcoin_tx *tx;
+};
 
-	/* Key for hash table */
-	struct bitcoin_blkid blkid;
+/* A block holding transactions we care about: we don't keep the others. */
+struct block {
+	int height;
 
 	/* Transactions in this block we care about */
-	const struct bitcoin_tx **txs;
+	struct block_tx *txs;
+};
 
-	/* And their associated index in the block */
-	u32 *txnums;
+/* Hash blocks by height */
+static inline const int *keyof_block_map(const struct block *b)
+{
+	return &b->height;
+}
 
-	/* Full copy of txs (trimmed to txs list in connect_block) */
-	struct bitcoin_tx **full_txs;
-};
+static inline size_t hash_height(const int *key)
+{
+	return *key;
+}
 
-/* Hash blocks by sha */
-static inline const struct bitcoin_blkid *keyof_block_map(const struct block *b)
+static inline bool block_eq(const struct block *b, const int *key)
 {
-	return &b->blkid;
+	return b->height == *key;
 }
+HTABLE_DEFINE_TYPE(struct block, keyof_block_map, hash_height, block_eq, block_map);
 
-static inline size_t hash_sha(const struct bitcoin_blkid *key)
+/* Hash txs in blocks, and txs we're broadcasting, by txid */
+static inline size_t hash_txid(const struct bitcoin_txid *key)
 {
 	size_t ret;
 
@@ -73,16 +80,45 @@ static inline size_t hash_sha(const struct bitcoin_blkid *key)
 	return ret;
 }
 
-static inline bool block_eq(const struct block *b, const struct bitcoin_blkid *key)
+static inline const struct bitcoin_txid *keyof_block_tx_map(const struct block_tx *btx)
 {
-	return structeq(&b->blkid, key);
+	return &btx->txid;
 }
-HTABLE_DEFINE_TYPE(struct block, keyof_block_map, hash_sha, block_eq, block_map);
+
+static inline bool block_tx_eq(const struct block_tx *btx,
+			       const struct bitcoin_txid *key)
+{
+	return structeq(&btx->txid, key);
+}
+HTABLE_DEFINE_TYPE(struct block_tx, keyof_block_tx_map, hash_txid, block_tx_eq, block_tx_map);
+
+static inline const struct bitcoin_txid *keyof_outgoing_tx_map(const struct outgoing_tx *otx)
+{
+	return &otx->txid;
+}
+
+static inline bool outgoing_tx_eq(const struct outgoing_tx *otx,
+				  const struct bitcoin_txid *key)
+{
+	return structeq(&otx->txid, key);
+}
+HTABLE_DEFINE_TYPE(struct outgoing_tx, keyof_outgoing_tx_map, hash_txid, outgoing_tx_eq, outgoing_tx_map);
 
 struct chain_topology {
-	struct block *root;
-	struct block *prev_tip, *tip;
+	/* Ids of blocks from blkids_base up to the tip, by height.  We only
+	 * remember retain_blocks below the tip: no reorg goes deeper. */
+	struct bitcoin_blkid *blkids;
+	u32 blkids_base;
+	u32 retain_blocks;
+
+	/* The tip when we last told everyone about it. */
+	struct bitcoin_blkid prev_tip;
+
+	/* Blocks with transactions we care about, by height */
 	struct block_map block_map;
+
+	/* Every tx in block->txs for those blocks */
+	struct block_tx_map block_txs;
 	u32 feerate[NUM_FEERATES];
 	bool startup;
 
@@ -103,6 +139,12 @@ struct chain_topology {
 
 	/* Bitcoin transactions we're broadcasting */
 	struct list_head outgoing_txs;
+	struct outgoing_tx_map outgoing_txmap;
+
+	/* Blocks we're fetching ahead of tip, lowest first.  We fetch up to
+	 * prefetch_window at once, which grows while we're catching up. */
+	struct list_head prefetch;
+	size_t prefetch_window;
 
 	/* Force a particular fee rate regardless of estimatefee (satoshis/kb) */
 	u32 *override_fee_rate;
@@ -0,0 +1,17 @@
+struct {
+	enum peer_state v;
+	const char *name;
+} enum_peer_state_names[] = {
+	{ UNINITIALIZED, "UNINITIALIZED" },
+	{ OPENINGD, "OPENINGD" },
+	{ CHANNELD_AWAITING_LOCKIN, "CHANNELD_AWAITING_LOCKIN" },
+	{ CHANNELD_NORMAL, "CHANNELD_NORMAL" },
+	{ CHANNELD_SHUTTING_DOWN, "CHANNELD_SHUTTING_DOWN" },
+	{ CLOSINGD_SIGEXCHANGE, "CLOSINGD_SIGEXCHANGE" },
+	{ CLOSINGD_COMPLETE, "CLOSINGD_COMPLETE" },
+	{ FUNDING_SPEND_SEEN, "FUNDING_SPEND_SEEN" },
+	{ ONCHAIND_CHEATED, "ONCHAIND_CHEATED" },
+	{ ONCHAIND_THEIR_UNILATERAL, "ONCHAIND_THEIR_UNILATERAL" },
+	{ ONCHAIND_OUR_UNILATERAL, "ONCHAIND_OUR_UNILATERAL" },
+	{ ONCHAIND_MUTUAL, "ONCHAIND_MUTUAL" },
+	{ 0, NULL } };
@@ -180,22 +180,44 @@ void gossip_init(struct lightningd *ld)
 	tal_free(tmpctx);
 }
 
+/* We ask gossipd for this many entries at a time, so neither it nor the
+ * messages between us grow with the whole graph. */
+#define GOSSIP_PAGE_SIZE 1000
+
+/* Without a limit we still stop here, so one reply can't be the whole
+ * graph: the caller gets {next} to carry on from. */
+#define GOSSIP_DEFAULT_LIMIT 10000
+
+/* A getnodes command, part way through its pages. */
+struct getnodes_state {
+	struct command *cmd;
+	struct json_result *response;
+	/* Just this node, if not NULL. */
+	struct pubkey *id;
+	/* Where the next page starts, or NULL for the beginning. */
+	struct pubkey *first;
+	/* How many more nodes the caller wants. */
+	u64 remaining;
+};
+
+static void getnodes_next_page(struct getnodes_state *gs);
+
 static void json_getnodes_reply(struct subd *gossip, const u8 *reply,
 				const int *fds,
-				struct command *cmd)
+				struct getnodes_state *gs)
 {
 	struct gossip_getnodes_entry *nodes;
-	struct json_result *response = new_json_result(cmd);
+	struct json_result *response = gs->response;
+	struct pubkey *nexts;
 	size_t i, j;
 
-	if (!fromwire_gossip_getnodes_reply(reply, reply, NULL, &nodes)) {
-		command_fail(cmd, "Malformed gossip_getnodes response");
+	if (!fromwire_gossip_getnodes_reply(reply, reply, NULL, &nexts,
+					    &nodes)
+	    || tal_count(nexts) > 1) {
+		command_fail(gs->cmd, "Malformed gossip_getnodes response");
 		return;
 	}
 
-	json_object_start(response, NULL);
-	json_array_start(response, "nodes");
-
 	for (i = 0; i < tal_count(nodes); i++) {
 		json_object_start(response, NULL);
 		json_add_pubkey(response, "nodeid", &nodes[i].nodeid);
@@ -206,22 +228,88 @@ static void json_getnodes_reply(struct subd *gossip, const u8 *reply,
 		json_array_end(response);
 		json_object_end(response);
 	}
+
+	gs->remaining -= tal_count(nodes);
+	if (tal_count(nexts) && gs->remaining) {
+		tal_free(gs->first);
+		gs->first = tal_steal(gs, nexts);
+		getnodes_next_page(gs);
+		return;
+	}
+
 	json_array_end(response);
+	if (tal_count(nexts))
+		json_add_pubkey(response, "next", &nexts[0]);
 	json_object_end(response);
-	command_success(cmd, response);
+	command_success(gs->cmd, response);
+}
+
+static void getnodes_next_page(struct getnodes_state *gs)
+{
+	u16 limit = gs->remaining < GOSSIP_PAGE_SIZE
+		? gs->remaining : GOSSIP_PAGE_SIZE;
+	u8 *req = towire_gossip_getnodes_request(gs, gs->id, gs->first,
+						 limit);
+	subd_req(gs->cmd, gs->cmd->ld->gossip, take(req), -1, 0,
+		 json_getnodes_reply, gs);
 }
 
 static void json_getnodes(struct command *cmd, const char *buffer,
 			  const jsmntok_t *params)
 {
-	u8 *req = towire_gossip_getnodes_request(cmd);
-	subd_req(cmd, cmd->ld->gossip, req, -1, 0, json_getnodes_reply, cmd);
+	struct getnodes_state *gs = tal(cmd, struct getnodes_state);
+	jsmntok_t *idtok, *firsttok, *limittok;
+	unsigned int limit;
+
+	if (!json_get_params(buffer, params,
+			     "?id", &idtok,
+			     "?first", &firsttok,
+			     "?limit", &limittok,
+			     NULL)) {
+		command_fail(cmd, "Invalid arguments");
+		return;
+	}
+
+	/* These are arrays of zero or one on the wire. */
+	gs->cmd = cmd;
+	gs->id = NULL;
+	if (idtok) {
+		gs->id = tal_arr(gs, struct pubkey, 1);
+		if (!json_tok_pubkey(buffer, idtok, gs->id)) {
+			command_fail(cmd, "Invalid id");
+			return;
+		}
+	}
+
+	gs->first = NULL;
+	if (firsttok) {
+		gs->first = tal_arr(gs, struct pubkey, 1);
+		if (!json_tok_pubkey(buffer, firsttok, gs->first)) {
+			command_fail(cmd, "Invalid first");
+			return;
+		}
+	}
+
+	gs->remaining = GOSSIP_DEFAULT_LIMIT;
+	if (limittok) {
+		if (!json_tok_number(buffer, limittok, &limit) || limit == 0) {
+			command_fail(cmd, "Invalid limit");
+			return;
+		}
+		gs->remaining = limit;
+	}
+
+	gs->response = new_json_result(cmd);
+	json_object_start(gs->response, NULL);
+	json_array_start(gs->response, "nodes");
+	getnodes_next_page(gs);
 	command_still_pending(cmd);
 }
 
 static const struct json_command getnodes_command = {
-    "getnodes", json_getnodes, "Retrieve all nodes in our local network view",
-    "Returns a list of all nodes that we know about"};
+    "getnodes", json_getnodes,
+    "Retrieve nodes in our local network view, optionally just {id}, or {limit} (default 10000) of them in id order from {first}",
+    "Returns a list of the nodes that we know about, and {next} to pass as {first} if {limit} cut it short"};
 AUTODATA(json_command, &getnodes_command);
 
 static void json_getroute_reply(struct subd *gossip, const u8 *reply, const int *fds,
@@ -309,22 +397,43 @@ static const struct json_command getroute_command = {
 };
 AUTODATA(json_command, &getroute_command);
 
+/* A getchannels command, part way through its pages. */
+struct getchannels_state {
+	struct command *cmd;
+	struct json_result *response;
+	/* Only channels from this node, if not NULL. */
+	struct pubkey *source;
+	bool active_only;
+	struct short_channel_id first, last;
+	/* How many more short_channel_ids the caller wants. */
+	u64 remaining;
+};
+
+static void getchannels_next_page(struct getchannels_state *gs);
+
 /* Called upon receiving a getchannels_reply from `gossipd` */
 static void json_getchannels_reply(struct subd *gossip, const u8 *reply,
-				   const int *fds, struct command *cmd)
+				   const int *fds,
+				   struct getchannels_state *gs)
 {
-	size_t i;
+	size_t i, num_chans = 0;
 	struct gossip_getchannels_entry *entries;
-	struct json_result *response = new_json_result(cmd);
+	struct json_result *response = gs->response;
+	struct short_channel_id next;
+	bool more;
 
-	if (!fromwire_gossip_getchannels_reply(reply, reply, NULL, &entries)) {
-		command_fail(cmd, "Invalid reply from gossipd");
+	if (!fromwire_gossip_getchannels_reply(reply, reply, NULL, &more,
+					       &next, &entries)) {
+		command_fail(gs->cmd, "Invalid reply from gossipd");
 		return;
 	}
 
-	json_object_start(response, NULL);
-	json_array_start(response, "channels");
 	for (i = 0; i < tal_count(entries); i++) {
+		/* Both directions of a channel are next to each other. */
+		if (i == 0
+		    || !short_channel_id_eq(&entries[i].short_channel_id,
+					    &entries[i-1].short_channel_id))
+			num_chans++;
 		json_object_start(response, NULL);
 		json_add_pubkey(response, "source", &entries[i].source);
 		json_add_pubkey(response, "destination",
@@ -346,21 +455,110 @@ static void json_getchannels_reply(struct subd *gossip, const u8 *reply,
 		}
 		json_object_end(response);
 	}
+
+	gs->remaining -= num_chans;
+	gs->first = next;
+	if (more && gs->remaining) {
+		getchannels_next_page(gs);
+		return;
+	}
+
 	json_array_end(response);
+	if (more)
+		json_add_short_channel_id(response, "next", &next);
 	json_object_end(response);
-	command_success(cmd, response);
+	command_success(gs->cmd, response);
+}
+
+static void getchannels_next_page(struct getchannels_state *gs)
+{
+	u16 limit = gs->remaining < GOSSIP_PAGE_SIZE
+		? gs->remaining : GOSSIP_PAGE_SIZE;
+	u8 *req = towire_gossip_getchannels_request(gs, gs->source,
+						    gs->active_only,
+						    &gs->first, &gs->last,
+						    limit);
+	subd_req(gs->cmd->ld->gossip, gs->cmd->ld->gossip, take(req), -1, 0,
+		 json_getchannels_reply, gs);
+}
+
+static bool json_tok_short_channel_id(const char *buffer,
+				      const jsmntok_t *tok,
+				      struct short_channel_id *scid)
+{
+	return short_channel_id_from_str(buffer + tok->start,
+					 tok->end - tok->start, scid);
 }
 
 static void json_getchannels(struct command *cmd, const char *buffer,
 			     const jsmntok_t *params)
 {
-	u8 *req = towire_gossip_getchannels_request(cmd);
-	subd_req(cmd->ld->gossip, cmd->ld->gossip,
-		 req, -1, 0, json_getchannels_reply, cmd);
+	struct getchannels_state *gs = tal(cmd, struct getchannels_state);
+	jsmntok_t *sourcetok, *activetok, *firsttok, *lasttok, *limittok;
+	unsigned int limit;
+
+	if (!json_get_params(buffer, params,
+			     "?source", &sourcetok,
+			     "?active", &activetok,
+			     "?first", &firsttok,
+			     "?last", &lasttok,
+			     "?limit", &limittok,
+			     NULL)) {
+		command_fail(cmd, "Invalid arguments");
+		return;
+	}
+
+	/* An array of zero or one on the wire. */
+	gs->cmd = cmd;
+	gs->source = NULL;
+	if (sourcetok) {
+		gs->source = tal_arr(gs, struct pubkey, 1);
+		if (!json_tok_pubkey(buffer, sourcetok, gs->source)) {
+			command_fail(cmd, "Invalid source");
+			return;
+		}
+	}
+
+	gs->active_only = false;
+	if (activetok && !json_tok_bool(buffer, activetok, &gs->active_only)) {
+		command_fail(cmd, "Invalid active");
+		return;
+	}
+
+	memset(&gs->first, 0, sizeof(gs->first));
+	if (firsttok && !json_tok_short_channel_id(buffer, firsttok,
+						   &gs->first)) {
+		command_fail(cmd, "Invalid first");
+		return;
+	}
+
+	gs->last.blocknum = 0xFFFFFF;
+	gs->last.txnum = 0xFFFFFF;
+	gs->last.outnum = 0xFFFF;
+	if (lasttok && !json_tok_short_channel_id(buffer, lasttok,
+						  &gs->last)) {
+		command_fail(cmd, "Invalid last");
+		return;
+	}
+
+	gs->remaining = GOSSIP_DEFAULT_LIMIT;
+	if (limittok) {
+		if (!json_tok_number(buffer, limittok, &limit) || limit == 0) {
+			command_fail(cmd, "Invalid limit");
+			return;
+		}
+		gs->remaining = limit;
+	}
+
+	gs->response = new_json_result(cmd);
+	json_object_start(gs->response, NULL);
+	json_array_start(gs->response, "channels");
+	getchannels_next_page(gs);
 	command_still_pending(cmd);
 }
 
 static const struct json_command getchannels_command = {
-    "getchannels", json_getchannels, "List all known channels.",
-    "Returns a 'channels' array with all known channels including their fees."};
+    "getchannels", json_getchannels,
+    "List known channels, optionally only from {source}, only {active} ones, or from {first} to {last} short_channel_id, at most {limit} (default 10000) short_channel_ids, each with one entry per direction.",
+    "Returns a 'channels' array with the matching channels including their fees, and {next} to pass as {first} if {limit} cut it short."};
 AUTODATA(json_command, &getchannels_command);
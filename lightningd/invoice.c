@@ -9,6 +9,8 @@
 #include <ccan/tal/str/str.h>
 #include <common/bech32.h>
 #include <common/bolt11.h>
+#include <common/memleak.h>
+#include <common/timeout.h>
 #include <common/utils.h>
 #include <errno.h>
 #include <hsmd/gen_hsm_client_wire.h>
@@ -130,6 +132,11 @@ static void json_invoice(struct command *cmd,
 			     buffer + exp->start);
 		return;
 	}
+	/* The wallet orders invoices by a 32-bit expiry_time. */
+	if (expiry >= UINT32_MAX - time_now().ts.tv_sec) {
+		command_fail(cmd, "expiry %"PRIu64" too large", expiry);
+		return;
+	}
 
 	invoice = wallet_invoice_create(cmd->ld->wallet,
 					take(msatoshi_val),
@@ -511,3 +518,29 @@ static const struct json_command decodepay_command = {
 	"Returns a verbose description on success"
 };
 AUTODATA(json_command, &decodepay_command);
+
+static void autoclean_invoices(struct lightningd *ld)
+{
+	u64 now = time_now().ts.tv_sec;
+	size_t deleted;
+
+	if (now > ld->autocleaninvoice_expired_by) {
+		deleted = wallet_invoice_delete_expired(ld->wallet,
+				now - ld->autocleaninvoice_expired_by);
+		if (deleted)
+			log_debug(ld->log, "autocleaninvoice: deleted %zu"
+				  " expired invoices", deleted);
+	}
+	invoice_autoclean_start(ld);
+}
+
+void invoice_autoclean_start(struct lightningd *ld)
+{
+	if (!ld->autocleaninvoice_cycle)
+		return;
+
+	/* This takes care of its own lifetime. */
+	notleak(new_reltimer(&ld->timers, ld,
+			     time_from_sec(ld->autocleaninvoice_cycle),
+			     autoclean_invoices, ld));
+}
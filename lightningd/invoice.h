@@ -6,4 +6,9 @@
 #include <ccan/list/list.h>
 #include <ccan/tal/tal.h>
 
+struct lightningd;
+
+/* Start deleting expired invoices, if --autocleaninvoice-cycle is set. */
+void invoice_autoclean_start(struct lightningd *ld);
+
 #endif /* LIGHTNING_LIGHTNINGD_INVOICE_H */
@@ -28,6 +28,7 @@
 #include <lightningd/jsonrpc.h>
 #include <lightningd/log.h>
 #include <lightningd/options.h>
+#include <lightningd/peer_htlcs.h>
 #include <onchaind/onchain_wire.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -53,6 +54,11 @@ static struct lightningd *new_lightningd(const tal_t *ctx,
 	list_head_init(&ld->peers);
 	htlc_in_map_init(&ld->htlcs_in);
 	htlc_out_map_init(&ld->htlcs_out);
+	uintmap_init(&ld->htlc_deadlines);
+	ld->htlc_deadline_seq = 0;
+	ld->db_durability = DB_DURABILITY_LEGACY;
+	ld->autocleaninvoice_cycle = 0;
+	ld->autocleaninvoice_expired_by = 86400;
 	ld->log_book = log_book;
 	ld->log = new_log(log_book, log_book, "lightningd(%u):", (int)getpid());
 	ld->alias = NULL;
@@ -232,6 +238,35 @@ static void init_txfilter(struct wallet *w, struct txfilter *filter)
 	}
 }
 
+/* poll() gives us no context pointer, so flush_and_poll needs this. */
+static struct db *group_commit_db;
+
+/* In WAL mode, we checkpoint once this many pages are in the log and
+ * we've nothing else to do, or once it's this many times bigger anyway. */
+#define WAL_CHECKPOINT_PAGES 1000
+#define WAL_CHECKPOINT_BUSY_FACTOR 10
+
+/* Everything since we last polled was done in one SQL transaction, which
+ * we commit now.  Replies it queued are only written once poll says
+ * their fd is writable, which is after this, so nobody hears about
+ * anything before it's on disk. */
+static int flush_and_poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+	int r;
+
+	db_flush(group_commit_db);
+
+	if (group_commit_db->wal_pages >= WAL_CHECKPOINT_PAGES) {
+		/* Anything waiting goes first, unless the log's too big. */
+		r = debug_poll(fds, nfds, 0);
+		if (r != 0 && group_commit_db->wal_pages
+		    < WAL_CHECKPOINT_PAGES * WAL_CHECKPOINT_BUSY_FACTOR)
+			return r;
+		db_checkpoint(group_commit_db);
+	}
+	return debug_poll(fds, nfds, timeout);
+}
+
 int main(int argc, char *argv[])
 {
 	struct log_book *log_book;
@@ -277,6 +312,7 @@ int main(int argc, char *argv[])
 
 	/* Initialize wallet, now that we are in the correct directory */
 	ld->wallet = wallet_new(ld, ld->log);
+	db_set_durability(ld->wallet->db, ld->db_durability);
 	ld->owned_txfilter = txfilter_new(ld);
 
 	/* Set up HSM. */
@@ -316,6 +352,7 @@ int main(int argc, char *argv[])
 	}
 	if (!wallet_htlcs_reconnect(ld->wallet, &ld->htlcs_in, &ld->htlcs_out))
 		fatal("could not reconnect htlcs loaded from wallet, wallet may be inconsistent.");
+	htlcs_index_deadlines(ld);
 
 	peer_first_blocknum = wallet_channels_first_blocknum(ld->wallet);
 
@@ -341,6 +378,14 @@ int main(int argc, char *argv[])
 	/* Now kick off topology update, now peers have watches. */
 	begin_topology(ld->topology);
 
+	/* And the invoice cleaner, if they asked for it. */
+	invoice_autoclean_start(ld);
+
+	/* From now on, commit everything each loop does together. */
+	group_commit_db = ld->wallet->db;
+	group_commit_db->group_commit = true;
+	io_poll_override(flush_and_poll);
+
 	for (;;) {
 		struct timer *expired;
 		void *v = io_loop(&ld->timers, &expired);
@@ -357,6 +402,7 @@ int main(int argc, char *argv[])
 	}
 
 	shutdown_subdaemons(ld);
+	db_flush(ld->wallet->db);
 
 	tal_free(ld);
 	opt_free_table();
@@ -4,6 +4,7 @@
 #include <bitcoin/chainparams.h>
 #include <bitcoin/privkey.h>
 #include <ccan/container_of/container_of.h>
+#include <ccan/intmap/intmap.h>
 #include <ccan/time/time.h>
 #include <ccan/timer/timer.h>
 #include <lightningd/htlc_end.h>
@@ -128,7 +129,15 @@ struct lightningd {
 	struct htlc_in_map htlcs_in;
 	struct htlc_out_map htlcs_out;
 
+	/* Those which we have to check by some block, by deadline. */
+	UINTMAP(struct htlc_deadline *) htlc_deadlines;
+	u32 htlc_deadline_seq;
+
 	struct wallet *wallet;
+	/* --db-durability */
+	enum db_durability db_durability;
+	/* How often to delete invoices this long expired (0 = never) */
+	u32 autocleaninvoice_cycle, autocleaninvoice_expired_by;
 
 	/* Maintained by invoices.c */
 	struct invoices *invoices;
@@ -27,6 +27,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <wallet/db.h>
 #include <wire/wire.h>
 
 /* Tal wrappers for opt. */
@@ -149,6 +150,19 @@ static void opt_show_network(char buf[OPT_SHOW_LEN],
 	snprintf(buf, OPT_SHOW_LEN, "%s", get_chainparams(ld)->network_name);
 }
 
+static char *opt_set_db_durability(const char *arg, struct lightningd *ld)
+{
+	if (!db_durability_from_name(arg, &ld->db_durability))
+		return tal_fmt(NULL, "Unknown db durability '%s'", arg);
+	return NULL;
+}
+
+static void opt_show_db_durability(char buf[OPT_SHOW_LEN],
+				   const struct lightningd *ld)
+{
+	snprintf(buf, OPT_SHOW_LEN, "%s", db_durability_name(ld->db_durability));
+}
+
 static char *opt_set_rgb(const char *arg, struct lightningd *ld)
 {
 	ld->rgb = tal_free(ld->rgb);
@@ -237,6 +251,9 @@ static void config_register_opts(struct lightningd *ld)
 	opt_register_arg("--default-fee-rate", opt_set_u32, opt_show_u32,
 			 &ld->topology->default_fee_rate,
 			 "Satoshis per kb if can't estimate fees");
+	opt_register_arg("--block-retention=<blocks>", opt_set_u32, opt_show_u32,
+			 &ld->topology->retain_blocks,
+			 "Block ids to remember below the tip (deepest reorg we can follow)");
 	opt_register_arg("--cltv-delta", opt_set_u32, opt_show_u32,
 			 &ld->config.cltv_expiry_delta,
 			 "Number of blocks for ctlv_expiry_delta");
@@ -532,6 +549,32 @@ void register_opts(struct lightningd *ld)
 	opt_register_arg("--bitcoin-datadir", opt_set_talstr, NULL,
 			 &ld->topology->bitcoind->datadir,
 			 "-datadir arg for bitcoin-cli");
+	opt_register_arg("--bitcoin-rpcconnect", opt_set_talstr, NULL,
+			 &ld->topology->bitcoind->rpcconnect,
+			 "Talk JSON-RPC to bitcoind at this host, not bitcoin-cli");
+	opt_register_arg("--bitcoin-rpcport", opt_set_u16, opt_show_u16,
+			 &ld->topology->bitcoind->rpcport,
+			 "bitcoind JSON-RPC port (0 means network default)");
+	opt_register_arg("--bitcoin-rpcuser", opt_set_talstr, NULL,
+			 &ld->topology->bitcoind->rpcuser,
+			 "bitcoind JSON-RPC username");
+	opt_register_arg("--bitcoin-rpcpassword", opt_set_talstr, NULL,
+			 &ld->topology->bitcoind->rpcpassword,
+			 "bitcoind JSON-RPC password");
+	opt_register_arg("--bitcoin-rpcconnections", opt_set_u32, opt_show_u32,
+			 &ld->topology->bitcoind->rpcconnections,
+			 "Maximum concurrent JSON-RPC connections to bitcoind");
+	opt_register_arg("--db-durability=<profile>", opt_set_db_durability,
+			 opt_show_db_durability, ld,
+			 "Wallet database journal: legacy, wal (fastest, may"
+			 " lose the last commits on power loss) or wal-full");
+	opt_register_arg("--autocleaninvoice-cycle=<s>", opt_set_u32,
+			 opt_show_u32, &ld->autocleaninvoice_cycle,
+			 "Every this many seconds, delete long-expired unpaid"
+			 " invoices (0 means never)");
+	opt_register_arg("--autocleaninvoice-expired-by=<s>", opt_set_u32,
+			 opt_show_u32, &ld->autocleaninvoice_expired_by,
+			 "Delete unpaid invoices once expired this many seconds");
 	opt_register_arg("--rgb", opt_set_rgb, NULL, ld,
 			 "RRGGBB hex color for node");
 	opt_register_arg("--alias", opt_set_alias, NULL, ld,
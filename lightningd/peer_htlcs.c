@@ -6,6 +6,7 @@
 #include <channeld/gen_channel_wire.h>
 #include <common/derive_basepoints.h>
 #include <common/htlc_wire.h>
+#include <common/memleak.h>
 #include <common/overflows.h>
 #include <common/sphinx.h>
 #include <gossipd/gen_gossip_wire.h>
@@ -190,12 +191,17 @@ static bool check_cltv(struct htlc_in *hin,
 	return false;
 }
 
+/* Put HTLCs into ld->htlc_deadlines: an incoming one once we fulfill it. */
+static void add_htlc_out_deadline(struct lightningd *ld, struct htlc_out *hout);
+static void add_htlc_in_deadline(struct lightningd *ld, struct htlc_in *hin);
+
 static void fulfill_htlc(struct htlc_in *hin, const struct preimage *preimage)
 {
 	u8 *msg;
 
 	hin->preimage = tal_dup(hin, struct preimage, preimage);
 	htlc_in_check(hin, __func__);
+	add_htlc_in_deadline(hin->key.peer->ld, hin);
 
 	/* We update state now to signal it's in progress, for persistence. */
 	htlc_in_update_state(hin->key.peer, hin, SENT_REMOVE_HTLC);
@@ -364,6 +370,7 @@ static void rcvd_htlc_reply(struct subd *subd, const u8 *msg, const int *fds,
 
 	/* Add it to lookup table now we know id. */
 	connect_htlc_out(&subd->ld->htlcs_out, hout);
+	add_htlc_out_deadline(subd->ld, hout);
 
 	/* When channeld includes it in commitment, we'll make it persistent. */
 }
@@ -1388,92 +1395,121 @@ static u32 htlc_in_deadline(const struct lightningd *ld,
 	return hin->cltv_expiry - (ld->config.cltv_expiry_delta + 1)/2;
 }
 
-void notify_new_block(struct lightningd *ld, u32 height)
-{
-	bool removed;
+/* An HTLC in ld->htlc_deadlines: a child of the HTLC, so it goes with it. */
+struct htlc_deadline {
+	struct lightningd *ld;
+	/* Deadline in the upper 32 bits, so the map is in deadline order. */
+	u64 index;
+	/* Exactly one of these. */
+	struct htlc_in *hin;
+	struct htlc_out *hout;
+};
 
-	/* BOLT #2:
-	 *
-	 * A node ... MUST fail the channel if an HTLC which it offered is in
-	 * either node's current commitment transaction past this timeout
-	 * deadline.
-	 */
-	/* FIXME: use db to look this up in one go (earliest deadline per-peer) */
-	do {
-		struct htlc_out *hout;
-		struct htlc_out_map_iter outi;
+static void destroy_htlc_deadline(struct htlc_deadline *d)
+{
+	uintmap_del(&d->ld->htlc_deadlines, d->index);
+}
 
-		removed = false;
+static void add_htlc_deadline(struct lightningd *ld, const tal_t *htlc,
+			      u32 deadline,
+			      struct htlc_in *hin, struct htlc_out *hout)
+{
+	/* The uintmap isn't tal, so memleak can't see it points to this */
+	struct htlc_deadline *d = notleak(tal(htlc, struct htlc_deadline));
 
-		for (hout = htlc_out_map_first(&ld->htlcs_out, &outi);
-		     hout;
-		     hout = htlc_out_map_next(&ld->htlcs_out, &outi)) {
-			/* Not timed out yet? */
-			if (height < htlc_out_deadline(hout))
-				continue;
+	d->ld = ld;
+	d->hin = hin;
+	d->hout = hout;
+	/* Lower bits just make it unique. */
+	do {
+		d->index = ((u64)deadline << 32) | ld->htlc_deadline_seq++;
+	} while (!uintmap_add(&ld->htlc_deadlines, d->index, d));
+	tal_add_destructor(d, destroy_htlc_deadline);
+}
 
-			/* Peer on chain already? */
-			if (peer_on_chain(hout->key.peer))
-				continue;
+static void add_htlc_out_deadline(struct lightningd *ld, struct htlc_out *hout)
+{
+	add_htlc_deadline(ld, hout, htlc_out_deadline(hout), NULL, hout);
+}
 
-			/* Peer already failed, or we hit it? */
-			if (hout->key.peer->error)
-				continue;
+static void add_htlc_in_deadline(struct lightningd *ld, struct htlc_in *hin)
+{
+	add_htlc_deadline(ld, hin, htlc_in_deadline(ld, hin), hin, NULL);
+}
 
-			peer_fail_permanent(hout->key.peer,
-					    "Offered HTLC %"PRIu64
-					    " %s cltv %u hit deadline",
-					    hout->key.id,
-					    htlc_state_name(hout->hstate),
-					    hout->cltv_expiry);
-			removed = true;
-		}
-	/* Iteration while removing is safe, but can skip entries! */
-	} while (removed);
+void htlcs_index_deadlines(struct lightningd *ld)
+{
+	struct htlc_in_map_iter ini;
+	struct htlc_out_map_iter outi;
+	struct htlc_in *hin;
+	struct htlc_out *hout;
 
+	for (hout = htlc_out_map_first(&ld->htlcs_out, &outi);
+	     hout;
+	     hout = htlc_out_map_next(&ld->htlcs_out, &outi))
+		add_htlc_out_deadline(ld, hout);
 
-	/* BOLT #2:
-	 *
-	 * A node MUST estimate a fulfillment deadline for each HTLC it is
-	 * attempting to fulfill.  A node ... MUST fail the connection if a
-	 * HTLC it has fulfilled is in either node's current commitment
-	 * transaction past this fulfillment deadline.
-	 */
-	do {
-		struct htlc_in *hin;
-		struct htlc_in_map_iter ini;
+	for (hin = htlc_in_map_first(&ld->htlcs_in, &ini);
+	     hin;
+	     hin = htlc_in_map_next(&ld->htlcs_in, &ini)) {
+		/* Not fulfilled?  If overdue, that's their problem... */
+		if (hin->preimage)
+			add_htlc_in_deadline(ld, hin);
+	}
+}
 
-		removed = false;
+void notify_new_block(struct lightningd *ld, u32 height)
+{
+	struct htlc_deadline *d;
+	u64 index;
 
-		for (hin = htlc_in_map_first(&ld->htlcs_in, &ini);
-		     hin;
-		     hin = htlc_in_map_next(&ld->htlcs_in, &ini)) {
-			/* Not fulfilled?  If overdue, that's their problem... */
-			if (!hin->preimage)
-				continue;
+	/* Each HTLC comes out of the map once its deadline is reached: if
+	 * its peer is already on chain or failed, nothing more to do. */
+	while ((d = uintmap_first(&ld->htlc_deadlines, &index)) != NULL
+	       && (index >> 32) <= height) {
+		struct htlc_in *hin = d->hin;
+		struct htlc_out *hout = d->hout;
+		struct peer *peer = hin ? hin->key.peer : hout->key.peer;
 
-			/* Not timed out yet? */
-			if (height < htlc_in_deadline(ld, hin))
-				continue;
+		tal_free(d);
 
-			/* Peer on chain already? */
-			if (peer_on_chain(hin->key.peer))
-				continue;
+		/* Peer on chain already? */
+		if (peer_on_chain(peer))
+			continue;
 
-			/* Peer already failed, or we hit it? */
-			if (hin->key.peer->error)
-				continue;
+		/* Peer already failed, or we hit it? */
+		if (peer->error)
+			continue;
 
-			peer_fail_permanent(hin->key.peer,
+		/* BOLT #2:
+		 *
+		 * A node ... MUST fail the channel if an HTLC which it
+		 * offered is in either node's current commitment
+		 * transaction past this timeout deadline.
+		 */
+		if (hout)
+			peer_fail_permanent(peer,
+					    "Offered HTLC %"PRIu64
+					    " %s cltv %u hit deadline",
+					    hout->key.id,
+					    htlc_state_name(hout->hstate),
+					    hout->cltv_expiry);
+		/* BOLT #2:
+		 *
+		 * A node MUST estimate a fulfillment deadline for each HTLC
+		 * it is attempting to fulfill.  A node ... MUST fail the
+		 * connection if a HTLC it has fulfilled is in either node's
+		 * current commitment transaction past this fulfillment
+		 * deadline.
+		 */
+		else
+			peer_fail_permanent(peer,
 					    "Fulfilled HTLC %"PRIu64
 					    " %s cltv %u hit deadline",
 					    hin->key.id,
 					    htlc_state_name(hin->hstate),
 					    hin->cltv_expiry);
-			removed = true;
-		}
-	/* Iteration while removing is safe, but can skip entries! */
-	} while (removed);
+	}
 }
 
 void notify_feerate_change(struct lightningd *ld)
@@ -48,4 +48,7 @@ void onchain_failed_our_htlc(const struct peer *peer,
 			     const struct htlc_stub *htlc,
 			     const char *why);
 void onchain_fulfilled_htlc(struct peer *peer, const struct preimage *preimage);
+
+/* Once HTLCs are loaded, index them by the block they need checking at. */
+void htlcs_index_deadlines(struct lightningd *ld);
 #endif /* LIGHTNING_LIGHTNINGD_PEER_HTLCS_H */
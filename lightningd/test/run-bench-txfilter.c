@@ -0,0 +1,138 @@
+#include "../txfilter.c"
+#include <assert.h>
+#include <bitcoin/tx.h>
+#include <ccan/err/err.h>
+#include <ccan/opt/opt.h>
+#include <ccan/time/time.h>
+#include <common/pseudorand.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+/* AUTOGENERATED MOCKS START */
+/* AUTOGENERATED MOCKS END */
+
+/* We don't care about real keys, just plausible DER bytes. */
+static void fake_derkey(u8 derkey[PUBKEY_DER_LEN], size_t n)
+{
+	memset(derkey, 0, PUBKEY_DER_LEN);
+	derkey[0] = 0x02;
+	memcpy(derkey + 1, &n, sizeof(n));
+}
+
+/* A tx paying to two p2wpkh outputs: ours if n is a key index < num_keys. */
+static struct bitcoin_tx *fake_tx(const tal_t *ctx, size_t n, size_t num_keys)
+{
+	struct bitcoin_tx *tx = tal(ctx, struct bitcoin_tx);
+	u8 derkey[PUBKEY_DER_LEN];
+
+	tx->output = tal_arr(tx, struct bitcoin_tx_output, 2);
+	for (size_t i = 0; i < tal_count(tx->output); i++) {
+		fake_derkey(derkey, n + i * num_keys);
+		tx->output[i].amount = 1000;
+		tx->output[i].script = scriptpubkey_p2wpkh_derkey(tx, derkey);
+	}
+	return tx;
+}
+
+/* What txfilter_match did before we indexed scripts. */
+static bool linear_match(const u8 **scripts, const struct bitcoin_tx *tx)
+{
+	for (size_t i = 0; i < tal_count(tx->output); i++) {
+		for (size_t j = 0; j < tal_count(scripts); j++) {
+			if (memeq(tx->output[i].script,
+				  tal_len(tx->output[i].script),
+				  scripts[j], tal_len(scripts[j])))
+				return true;
+		}
+	}
+	return false;
+}
+
+int main(int argc, char *argv[])
+{
+	const tal_t *ctx = tal_tmpctx(NULL);
+	struct txfilter *filter;
+	struct bitcoin_tx **txs;
+	size_t num_keys = 1000, num_txs = 400, matched, expected = 0;
+	struct timemono start, end;
+	bool linear = false;
+	u8 derkey[PUBKEY_DER_LEN];
+
+	opt_register_noarg("--linear", opt_set_bool, &linear,
+			   "Also time the old linear scan");
+	opt_parse(&argc, argv, opt_log_stderr_exit);
+
+	if (argc > 1)
+		num_keys = atoi(argv[1]);
+	if (argc > 2)
+		num_txs = atoi(argv[2]);
+	if (argc > 3 || num_keys == 0)
+		opt_usage_and_exit("[num_keys [num_txs]]");
+
+	filter = txfilter_new(ctx);
+	start = time_mono();
+	for (size_t i = 0; i < num_keys; i++) {
+		fake_derkey(derkey, i);
+		txfilter_add_derkey(filter, derkey);
+	}
+	end = time_mono();
+	printf("%zu keys added in %"PRIu64" msec\n",
+	       num_keys, time_to_msec(timemono_between(end, start)));
+
+	/* Adding again changes nothing. */
+	fake_derkey(derkey, 0);
+	txfilter_add_derkey(filter, derkey);
+	assert(filter->scriptpubkeys.raw.elems == num_keys * 2);
+
+	/* One tx in ten pays us. */
+	txs = tal_arr(ctx, struct bitcoin_tx *, num_txs);
+	for (size_t i = 0; i < num_txs; i++) {
+		if (i % 10 == 0) {
+			txs[i] = fake_tx(txs, pseudorand(num_keys), num_keys);
+			expected++;
+		} else
+			txs[i] = fake_tx(txs, num_keys + i, num_keys);
+	}
+
+	start = time_mono();
+	matched = 0;
+	for (size_t i = 0; i < num_txs; i++)
+		matched += txfilter_match(filter, txs[i]);
+	end = time_mono();
+	assert(matched == expected);
+
+	printf("%zu txs filtered against %zu keys in %"PRIu64" usec (%"PRIu64" nanoseconds per tx)\n",
+	       num_txs, num_keys,
+	       time_to_usec(timemono_between(end, start)),
+	       time_to_nsec(time_divide(timemono_between(end, start), num_txs)));
+
+	if (linear) {
+		const u8 **scripts = tal_arr(ctx, const u8 *, 0);
+		struct scriptpubkey_set_iter it;
+		struct script_span *s;
+
+		for (s = scriptpubkey_set_first(&filter->scriptpubkeys, &it);
+		     s;
+		     s = scriptpubkey_set_next(&filter->scriptpubkeys, &it)) {
+			size_t n = tal_count(scripts);
+			tal_resize(&scripts, n + 1);
+			scripts[n] = s->script;
+		}
+
+		start = time_mono();
+		matched = 0;
+		for (size_t i = 0; i < num_txs; i++)
+			matched += linear_match(scripts, txs[i]);
+		end = time_mono();
+		assert(matched == expected);
+
+		printf("%zu txs linearly scanned in %"PRIu64" usec (%"PRIu64" nanoseconds per tx)\n",
+		       num_txs,
+		       time_to_usec(timemono_between(end, start)),
+		       time_to_nsec(time_divide(timemono_between(end, start), num_txs)));
+	}
+
+	tal_free(ctx);
+	opt_free_table();
+	return 0;
+}
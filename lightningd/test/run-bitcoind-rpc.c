@@ -0,0 +1,333 @@
+#include "../../common/json.c"
+#include "../bitcoind.c"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+
+/* Nothing to do for these: we don't touch the db. */
+void db_begin_transaction_(struct db *db UNNEEDED, const char *location UNNEEDED)
+{
+}
+
+void db_commit_transaction(struct db *db UNNEEDED)
+{
+}
+
+void log_(struct log *log UNNEEDED, enum log_level level UNNEEDED,
+	  const char *fmt UNNEEDED, ...)
+{
+}
+
+/* AUTOGENERATED MOCKS START */
+/* Generated stub for fatal */
+void   fatal(const char *fmt UNNEEDED, ...)
+{ fprintf(stderr, "fatal called!\n"); abort(); }
+/* AUTOGENERATED MOCKS END */
+
+/* Our fake bitcoind knows getblockcount and getblockhash, and hangs up
+ * after every max_per_conn replies, like an idle timeout would.  If
+ * canned is set, the next request gets that instead. */
+#define FAKE_BLOCKCOUNT 100
+
+struct fake_bitcoind {
+	size_t max_per_conn;
+	size_t open, max_open, accepted, requests;
+	const char *canned;
+};
+
+struct fake_conn {
+	struct fake_bitcoind *fb;
+	char buf[4096];
+	size_t len, new_len;
+	size_t served;
+	char *reply;
+};
+
+static char *fake_blockhash(const tal_t *ctx, u32 height)
+{
+	return tal_fmt(ctx, "%056u%08x", 0, height);
+}
+
+static struct io_plan *fake_read_request(struct io_conn *conn,
+					 struct fake_conn *fc);
+
+static struct io_plan *fake_replied(struct io_conn *conn, struct fake_conn *fc)
+{
+	if (++fc->served == fc->fb->max_per_conn)
+		return io_close(conn);
+	fc->len = fc->new_len = 0;
+	return fake_read_request(conn, fc);
+}
+
+static char *fake_result(const tal_t *ctx, const char *buf, size_t len)
+{
+	const jsmntok_t *toks, *method, *params;
+	char *body = tal_strndup(ctx, buf, len);
+	bool valid;
+	unsigned int height;
+
+	toks = json_parse_input(body, len, &valid);
+	assert(toks);
+	method = json_get_member(body, toks, "method");
+	params = json_get_member(body, toks, "params");
+	assert(method && params && params->type == JSMN_ARRAY);
+
+	if (json_tok_streq(body, method, "getblockcount")) {
+		assert(params->size == 0);
+		return tal_fmt(ctx, "\"result\":%u,\"error\":null",
+			       FAKE_BLOCKCOUNT);
+	}
+
+	assert(json_tok_streq(body, method, "getblockhash"));
+	assert(params->size == 1);
+	/* Must be a number, not a string. */
+	assert(params[1].type == JSMN_PRIMITIVE);
+	assert(json_tok_number(body, &params[1], &height));
+	if (height > FAKE_BLOCKCOUNT)
+		return tal_fmt(ctx, "\"result\":null,\"error\":"
+			       "{\"code\":-8,\"message\":\"Block height out of range\"}");
+	return tal_fmt(ctx, "\"result\":\"%s\",\"error\":null",
+		       fake_blockhash(ctx, height));
+}
+
+static struct io_plan *fake_read_more(struct io_conn *conn,
+				      struct fake_conn *fc)
+{
+	const char *end, *clen;
+	char *result;
+
+	fc->len += fc->new_len;
+	fc->buf[fc->len] = '\0';
+
+	end = strstr(fc->buf, "\r\n\r\n");
+	if (end) {
+		size_t hdrlen = end + 4 - fc->buf, bodylen;
+
+		assert(strstarts(fc->buf, "POST / HTTP/1.1\r\n"));
+		assert(strstr(fc->buf, "\r\nAuthorization: Basic dXNlcjpwYXNz\r\n"));
+		clen = strstr(fc->buf, "\r\nContent-Length: ");
+		assert(clen && clen < end);
+		bodylen = atol(clen + strlen("\r\nContent-Length: "));
+
+		if (fc->len >= hdrlen + bodylen) {
+			assert(fc->len == hdrlen + bodylen);
+			fc->fb->requests++;
+			fc->reply = tal_free(fc->reply);
+			if (fc->fb->canned) {
+				fc->reply = tal_strdup(fc, fc->fb->canned);
+				fc->fb->canned = NULL;
+				return io_write(conn, fc->reply,
+						strlen(fc->reply),
+						fake_replied, fc);
+			}
+			result = fake_result(fc, fc->buf + hdrlen, bodylen);
+			fc->reply = tal_fmt(fc, "{%s,\"id\":0}", result);
+			fc->reply = tal_fmt(fc,
+					    "HTTP/1.1 %s\r\n"
+					    "Content-Type: application/json\r\n"
+					    "Content-Length: %zu\r\n"
+					    "\r\n"
+					    "%s",
+					    strstr(result, "null,\"error\":{")
+					    ? "500 Internal Server Error"
+					    : "200 OK",
+					    strlen(fc->reply), fc->reply);
+			return io_write(conn, fc->reply, strlen(fc->reply),
+					fake_replied, fc);
+		}
+	}
+
+	assert(fc->len < sizeof(fc->buf) - 1);
+	return io_read_partial(conn, fc->buf + fc->len,
+			       sizeof(fc->buf) - 1 - fc->len,
+			       &fc->new_len, fake_read_more, fc);
+}
+
+static struct io_plan *fake_read_request(struct io_conn *conn,
+					 struct fake_conn *fc)
+{
+	return fake_read_more(conn, fc);
+}
+
+static void fake_conn_finished(struct io_conn *conn, struct fake_conn *fc)
+{
+	fc->fb->open--;
+}
+
+static struct io_plan *fake_conn_init(struct io_conn *conn,
+				      struct fake_bitcoind *fb)
+{
+	struct fake_conn *fc = tal(conn, struct fake_conn);
+
+	fc->fb = fb;
+	fc->len = fc->new_len = fc->served = 0;
+	fc->reply = NULL;
+	fb->accepted++;
+	if (++fb->open > fb->max_open)
+		fb->max_open = fb->open;
+	io_set_finish(conn, fake_conn_finished, fc);
+	return fake_read_request(conn, fc);
+}
+
+/* What the client saw. */
+struct results {
+	size_t outstanding;
+	u32 blockcount;
+	bool *hash_ok;
+};
+
+static void got_blockhash(struct bitcoind *bitcoind,
+			  const struct bitcoin_blkid *blkid,
+			  struct results *res)
+{
+	/* We asked for height i*11 in slot i: find which this is. */
+	size_t i;
+	char hex[hex_str_size(sizeof(*blkid))];
+
+	res->outstanding--;
+	for (i = 0; i < tal_count(res->hash_ok); i++) {
+		if (res->hash_ok[i])
+			continue;
+		if (i * 11 > FAKE_BLOCKCOUNT) {
+			if (!blkid)
+				break;
+			continue;
+		}
+		if (!blkid)
+			continue;
+		bitcoin_blkid_to_hex(blkid, hex, sizeof(hex));
+		if (streq(hex, fake_blockhash(res->hash_ok, i * 11)))
+			break;
+	}
+	assert(i < tal_count(res->hash_ok));
+	res->hash_ok[i] = true;
+
+	if (!res->outstanding)
+		io_break(res);
+}
+
+static void got_no_blockhash(struct bitcoind *bitcoind,
+			     const struct bitcoin_blkid *blkid,
+			     struct results *res)
+{
+	assert(!blkid);
+	if (!--res->outstanding)
+		io_break(res);
+}
+
+static void got_blockcount(struct bitcoind *bitcoind, u32 blockcount,
+			   struct results *res)
+{
+	res->blockcount = blockcount;
+	if (!--res->outstanding)
+		io_break(res);
+}
+
+int main(void)
+{
+	const tal_t *ctx = tal_tmpctx(NULL);
+	struct lightningd *ld = tal(ctx, struct lightningd);
+	struct bitcoind *bitcoind;
+	struct fake_bitcoind fb;
+	struct results res;
+	struct sockaddr_in addr;
+	socklen_t addrlen = sizeof(addr);
+	char *req;
+	int fd;
+
+	/* Our fake hangs up on us: write() must fail, not kill us. */
+	signal(SIGPIPE, SIG_IGN);
+
+	ld->wallet = tal(ld, struct wallet);
+	ld->wallet->db = NULL;
+	bitcoind = new_bitcoind(ctx, ld, NULL);
+
+	fd = socket(AF_INET, SOCK_STREAM, 0);
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	assert(bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+	assert(listen(fd, 5) == 0);
+	assert(getsockname(fd, (struct sockaddr *)&addr, &addrlen) == 0);
+
+	memset(&fb, 0, sizeof(fb));
+	fb.max_per_conn = 3;
+	io_new_listener(ctx, fd, fake_conn_init, &fb);
+
+	bitcoind->rpcconnect = "127.0.0.1";
+	bitcoind->rpcport = ntohs(addr.sin_port);
+	bitcoind->rpcuser = "user";
+	bitcoind->rpcpassword = "pass";
+	bitcoind->rpcconnections = 2;
+	init_rpc(bitcoind);
+
+	/* Params are converted as bitcoin-cli would. */
+	req = rpc_request(ctx, bitcoind,
+			  cmdarr(ctx, bitcoind, "getblock", "00ff", "false",
+				 NULL));
+	assert(streq(strchr(req, '{'),
+		     "{\"jsonrpc\":\"1.0\",\"id\":0,"
+		     "\"method\":\"getblock\",\"params\":[\"00ff\",false]}"));
+
+	/* Heights 0, 11, ... 110: the last is out of range. */
+	res.hash_ok = tal_arrz(ctx, bool, 11);
+	res.outstanding = tal_count(res.hash_ok) + 1;
+	res.blockcount = 0;
+	for (size_t i = 0; i < tal_count(res.hash_ok); i++)
+		bitcoind_getblockhash(bitcoind, i * 11, got_blockhash, &res);
+	bitcoind_getblockcount(bitcoind, got_blockcount, &res);
+
+	assert(io_loop(NULL, NULL) == &res);
+
+	assert(res.blockcount == FAKE_BLOCKCOUNT);
+	for (size_t i = 0; i < tal_count(res.hash_ok); i++)
+		assert(res.hash_ok[i]);
+
+	/* Ran concurrently, but never more than we allowed. */
+	assert(fb.max_open == 2);
+	/* Hangups made us reconnect, but no request was sent twice. */
+	assert(fb.accepted > 2);
+	assert(fb.requests == tal_count(res.hash_ok) + 1);
+	assert(bitcoind->error_count == 0);
+
+	/* Nonsense from bitcoind is a failed request, not fatal(). */
+	const char *canned[] = {
+		/* What bitcoind says when its RPC work queue is full. */
+		"HTTP/1.1 503 Service Unavailable\r\n"
+		"Content-Type: text/html\r\n"
+		"Content-Length: 25\r\n"
+		"\r\n"
+		"Work queue depth exceeded",
+		/* Garbled status line: we hang up this connection. */
+		"HTTP/1.1 busy\r\n"
+		"\r\n",
+		/* No Content-Length, so we can't find the end. */
+		"HTTP/1.1 200 OK\r\n"
+		"\r\n"
+		"{\"result\":null,\"error\":null,\"id\":0}",
+		/* JSON, but not JSON-RPC. */
+		"HTTP/1.1 200 OK\r\n"
+		"Content-Length: 2\r\n"
+		"\r\n"
+		"{}",
+	};
+	for (size_t i = 0; i < ARRAY_SIZE(canned); i++) {
+		fb.canned = canned[i];
+		res.outstanding = 1;
+		bitcoind_getblockhash(bitcoind, 1, got_no_blockhash, &res);
+		assert(io_loop(NULL, NULL) == &res);
+		assert(!fb.canned);
+	}
+
+	/* And we still talk to bitcoind fine afterwards. */
+	memset(res.hash_ok, 0, tal_count(res.hash_ok) * sizeof(bool));
+	res.outstanding = 1;
+	bitcoind_getblockhash(bitcoind, 0, got_blockhash, &res);
+	assert(io_loop(NULL, NULL) == &res);
+	assert(res.hash_ok[0]);
+	assert(fb.requests == tal_count(res.hash_ok) + 1 + ARRAY_SIZE(canned) + 1);
+
+	tal_free(ctx);
+	return 0;
+}
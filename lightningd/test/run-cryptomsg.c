@@ -68,6 +68,13 @@ static struct io_plan *check_msg_write(struct io_conn *conn, struct peer *peer)
 	return NULL;
 }
 
+static struct io_plan *check_batch_write(struct io_conn *conn,
+					 struct peer *peer)
+{
+	assert(tal_count(write_buf) == 3 * (2 + 16 + 5 + 16));
+	return NULL;
+}
+
 static struct io_plan *check_msg_read(struct io_conn *conn, struct peer *peer,
 				      u8 *msg)
 {
@@ -132,6 +139,22 @@ int main(void)
 		peer_read_message(NULL, &cs_in, check_msg_read);
 		assert(read_buf_len == 0);
 	}
+
+	/* A batch goes out as one write, and reads back as three messages. */
+	{
+		const u8 **msgs = tal_arr(tmpctx, const u8 *, 3);
+
+		for (i = 0; i < 3; i++)
+			msgs[i] = msg;
+		write_buf = tal_arr(tmpctx, char, 0);
+		peer_write_messages(NULL, &cs_out, msgs, check_batch_write);
+		read_buf = write_buf;
+		read_buf_len = tal_count(read_buf);
+		write_buf = tal_arr(tmpctx, char, 0);
+		for (i = 0; i < 3; i++)
+			peer_read_message(NULL, &cs_in, check_msg_read);
+		assert(read_buf_len == 0);
+	}
 	tal_free(tmpctx);
 	return 0;
 }
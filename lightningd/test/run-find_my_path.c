@@ -16,12 +16,21 @@ void crashlog_activate(const char *argv0 UNNEEDED, struct log *log UNNEEDED)
 /* Generated stub for db_begin_transaction_ */
 void db_begin_transaction_(struct db *db UNNEEDED, const char *location UNNEEDED)
 { fprintf(stderr, "db_begin_transaction_ called!\n"); abort(); }
+/* Generated stub for db_checkpoint */
+void db_checkpoint(struct db *db UNNEEDED)
+{ fprintf(stderr, "db_checkpoint called!\n"); abort(); }
 /* Generated stub for db_commit_transaction */
 void db_commit_transaction(struct db *db UNNEEDED)
 { fprintf(stderr, "db_commit_transaction called!\n"); abort(); }
+/* Generated stub for db_flush */
+void db_flush(struct db *db UNNEEDED)
+{ fprintf(stderr, "db_flush called!\n"); abort(); }
 /* Generated stub for db_get_intvar */
 s64 db_get_intvar(struct db *db UNNEEDED, char *varname UNNEEDED, s64 defval UNNEEDED)
 { fprintf(stderr, "db_get_intvar called!\n"); abort(); }
+/* Generated stub for db_set_durability */
+void db_set_durability(struct db *db UNNEEDED, enum db_durability durability UNNEEDED)
+{ fprintf(stderr, "db_set_durability called!\n"); abort(); }
 /* Generated stub for debug_poll */
 int debug_poll(struct pollfd *fds UNNEEDED, nfds_t nfds UNNEEDED, int timeout UNNEEDED)
 { fprintf(stderr, "debug_poll called!\n"); abort(); }
@@ -43,6 +52,12 @@ size_t hash_htlc_key(const struct htlc_key *htlc_key UNNEEDED)
 /* Generated stub for hsm_init */
 void hsm_init(struct lightningd *ld UNNEEDED, bool newdir UNNEEDED)
 { fprintf(stderr, "hsm_init called!\n"); abort(); }
+/* Generated stub for htlcs_index_deadlines */
+void htlcs_index_deadlines(struct lightningd *ld UNNEEDED)
+{ fprintf(stderr, "htlcs_index_deadlines called!\n"); abort(); }
+/* Generated stub for invoice_autoclean_start */
+void invoice_autoclean_start(struct lightningd *ld UNNEEDED)
+{ fprintf(stderr, "invoice_autoclean_start called!\n"); abort(); }
 /* Generated stub for log_ */
 void log_(struct log *log UNNEEDED, enum log_level level UNNEEDED, const char *fmt UNNEEDED, ...)
 
@@ -0,0 +1,352 @@
+#include "../peer_htlcs.c"
+#include <stdio.h>
+
+/* The HTLC ids peer_fail_permanent() was asked about, in order. */
+static u64 *failed_ids;
+
+void peer_fail_permanent(struct peer *peer UNNEEDED, const char *fmt, ...)
+{
+	va_list ap;
+	u64 id;
+	size_t n = tal_count(failed_ids);
+
+	/* Every message is "<Offered|Fulfilled> HTLC <id> ..." */
+	va_start(ap, fmt);
+	id = va_arg(ap, u64);
+	va_end(ap);
+
+	tal_resize(&failed_ids, n + 1);
+	failed_ids[n] = id;
+}
+
+size_t hash_htlc_key(const struct htlc_key *k)
+{
+	return k->id;
+}
+
+/* AUTOGENERATED MOCKS START */
+/* Generated stub for connect_htlc_in */
+void connect_htlc_in(struct htlc_in_map *map UNNEEDED, struct htlc_in *hin UNNEEDED)
+{ fprintf(stderr, "connect_htlc_in called!\n"); abort(); }
+/* Generated stub for connect_htlc_out */
+void connect_htlc_out(struct htlc_out_map *map UNNEEDED, struct htlc_out *hout UNNEEDED)
+{ fprintf(stderr, "connect_htlc_out called!\n"); abort(); }
+/* Generated stub for feerate_max */
+u32 feerate_max(struct lightningd *ld UNNEEDED)
+{ fprintf(stderr, "feerate_max called!\n"); abort(); }
+/* Generated stub for feerate_min */
+u32 feerate_min(struct lightningd *ld UNNEEDED)
+{ fprintf(stderr, "feerate_min called!\n"); abort(); }
+/* Generated stub for find_htlc_in */
+struct htlc_in *find_htlc_in(const struct htlc_in_map *map UNNEEDED,
+			     const struct peer *peer UNNEEDED,
+			     u64 htlc_id UNNEEDED)
+{ fprintf(stderr, "find_htlc_in called!\n"); abort(); }
+/* Generated stub for find_htlc_out */
+struct htlc_out *find_htlc_out(const struct htlc_out_map *map UNNEEDED,
+			       const struct peer *peer UNNEEDED,
+			       u64 htlc_id UNNEEDED)
+{ fprintf(stderr, "find_htlc_out called!\n"); abort(); }
+/* Generated stub for fromwire_channel_got_commitsig */
+bool fromwire_channel_got_commitsig(const tal_t *ctx UNNEEDED, const void *p UNNEEDED, size_t *plen UNNEEDED, u64 *commitnum UNNEEDED, u32 *feerate UNNEEDED, secp256k1_ecdsa_signature *signature UNNEEDED, secp256k1_ecdsa_signature **htlc_signature UNNEEDED, struct added_htlc **added UNNEEDED, struct secret **shared_secret UNNEEDED, struct fulfilled_htlc **fulfilled UNNEEDED, struct failed_htlc **failed UNNEEDED, struct changed_htlc **changed UNNEEDED, struct bitcoin_tx *tx UNNEEDED)
+{ fprintf(stderr, "fromwire_channel_got_commitsig called!\n"); abort(); }
+/* Generated stub for fromwire_channel_got_revoke */
+bool fromwire_channel_got_revoke(const tal_t *ctx UNNEEDED, const void *p UNNEEDED, size_t *plen UNNEEDED, u64 *revokenum UNNEEDED, struct sha256 *per_commitment_secret UNNEEDED, struct pubkey *next_per_commit_point UNNEEDED, struct changed_htlc **changed UNNEEDED)
+{ fprintf(stderr, "fromwire_channel_got_revoke called!\n"); abort(); }
+/* Generated stub for fromwire_channel_offer_htlc_reply */
+bool fromwire_channel_offer_htlc_reply(const tal_t *ctx UNNEEDED, const void *p UNNEEDED, size_t *plen UNNEEDED, u64 *id UNNEEDED, u16 *failure_code UNNEEDED, u8 **failurestr UNNEEDED)
+{ fprintf(stderr, "fromwire_channel_offer_htlc_reply called!\n"); abort(); }
+/* Generated stub for fromwire_channel_sending_commitsig */
+bool fromwire_channel_sending_commitsig(const tal_t *ctx UNNEEDED, const void *p UNNEEDED, size_t *plen UNNEEDED, u64 *commitnum UNNEEDED, u32 *feerate UNNEEDED, struct changed_htlc **changed UNNEEDED, secp256k1_ecdsa_signature *commit_sig UNNEEDED, secp256k1_ecdsa_signature **htlc_sigs UNNEEDED)
+{ fprintf(stderr, "fromwire_channel_sending_commitsig called!\n"); abort(); }
+/* Generated stub for fromwire_gossip_resolve_channel_reply */
+bool fromwire_gossip_resolve_channel_reply(const tal_t *ctx UNNEEDED, const void *p UNNEEDED, size_t *plen UNNEEDED, struct pubkey **keys UNNEEDED)
+{ fprintf(stderr, "fromwire_gossip_resolve_channel_reply called!\n"); abort(); }
+/* Generated stub for get_block_height */
+u32 get_block_height(const struct chain_topology *topo UNNEEDED)
+{ fprintf(stderr, "get_block_height called!\n"); abort(); }
+/* Generated stub for get_feerate */
+u32 get_feerate(const struct chain_topology *topo UNNEEDED, enum feerate feerate UNNEEDED)
+{ fprintf(stderr, "get_feerate called!\n"); abort(); }
+/* Generated stub for htlc_in_check */
+struct htlc_in *htlc_in_check(const struct htlc_in *hin UNNEEDED, const char *abortstr UNNEEDED)
+{ fprintf(stderr, "htlc_in_check called!\n"); abort(); }
+/* Generated stub for htlc_out_check */
+struct htlc_out *htlc_out_check(const struct htlc_out *hout UNNEEDED,
+				const char *abortstr UNNEEDED)
+{ fprintf(stderr, "htlc_out_check called!\n"); abort(); }
+/* Generated stub for log_ */
+void log_(struct log *log UNNEEDED, enum log_level level UNNEEDED, const char *fmt UNNEEDED, ...)
+
+{ fprintf(stderr, "log_ called!\n"); abort(); }
+/* Generated stub for new_htlc_in */
+struct htlc_in *new_htlc_in(const tal_t *ctx UNNEEDED,
+			    struct peer *peer UNNEEDED, u64 id UNNEEDED,
+			    u64 msatoshi UNNEEDED, u32 cltv_expiry UNNEEDED,
+			    const struct sha256 *payment_hash UNNEEDED,
+			    const struct secret *shared_secret UNNEEDED,
+			    const u8 *onion_routing_packet UNNEEDED)
+{ fprintf(stderr, "new_htlc_in called!\n"); abort(); }
+/* Generated stub for new_htlc_out */
+struct htlc_out *new_htlc_out(const tal_t *ctx UNNEEDED,
+			      struct peer *peer UNNEEDED,
+			      u64 msatoshi UNNEEDED, u32 cltv_expiry UNNEEDED,
+			      const struct sha256 *payment_hash UNNEEDED,
+			      const u8 *onion_routing_packet UNNEEDED,
+			      struct htlc_in *in UNNEEDED,
+			      struct command *cmd UNNEEDED)
+{ fprintf(stderr, "new_htlc_out called!\n"); abort(); }
+/* Generated stub for onion_type_name */
+const char *onion_type_name(int e UNNEEDED)
+{ fprintf(stderr, "onion_type_name called!\n"); abort(); }
+/* Generated stub for parse_onionpacket */
+struct onionpacket *parse_onionpacket(
+	const tal_t *ctx UNNEEDED,
+	const void *src UNNEEDED,
+	const size_t srclen
+	)
+{ fprintf(stderr, "parse_onionpacket called!\n"); abort(); }
+/* Generated stub for payment_failed */
+void payment_failed(struct lightningd *ld UNNEEDED, const struct htlc_out *hout UNNEEDED,
+		    const char *localfail UNNEEDED)
+{ fprintf(stderr, "payment_failed called!\n"); abort(); }
+/* Generated stub for payment_succeeded */
+void payment_succeeded(struct lightningd *ld UNNEEDED, struct htlc_out *hout UNNEEDED,
+		       const struct preimage *rval UNNEEDED)
+{ fprintf(stderr, "payment_succeeded called!\n"); abort(); }
+/* Generated stub for peer_by_id */
+struct peer *peer_by_id(struct lightningd *ld UNNEEDED, const struct pubkey *id UNNEEDED)
+{ fprintf(stderr, "peer_by_id called!\n"); abort(); }
+/* Generated stub for peer_internal_error */
+void peer_internal_error(struct peer *peer UNNEEDED, const char *fmt UNNEEDED, ...)
+{ fprintf(stderr, "peer_internal_error called!\n"); abort(); }
+/* Generated stub for peer_last_tx */
+void peer_last_tx(struct peer *peer UNNEEDED, struct bitcoin_tx *tx UNNEEDED,
+		  const secp256k1_ecdsa_signature *sig UNNEEDED)
+{ fprintf(stderr, "peer_last_tx called!\n"); abort(); }
+/* Generated stub for peer_state_name */
+const char *peer_state_name(enum peer_state state UNNEEDED)
+{ fprintf(stderr, "peer_state_name called!\n"); abort(); }
+/* Generated stub for process_onionpacket */
+struct route_step *process_onionpacket(
+	const tal_t * ctx UNNEEDED,
+	const struct onionpacket *packet UNNEEDED,
+	const u8 *shared_secret UNNEEDED,
+	const u8 *assocdata UNNEEDED,
+	const size_t assocdatalen
+	)
+{ fprintf(stderr, "process_onionpacket called!\n"); abort(); }
+/* Generated stub for serialize_onionpacket */
+u8 *serialize_onionpacket(
+	const tal_t *ctx UNNEEDED,
+	const struct onionpacket *packet UNNEEDED)
+{ fprintf(stderr, "serialize_onionpacket called!\n"); abort(); }
+/* Generated stub for subd_req_ */
+void subd_req_(const tal_t *ctx UNNEEDED,
+	       struct subd *sd UNNEEDED,
+	       const u8 *msg_out UNNEEDED,
+	       int fd_out UNNEEDED, size_t num_fds_in UNNEEDED,
+	       void (*replycb)(struct subd * UNNEEDED, const u8 * UNNEEDED, const int * UNNEEDED, void *) UNNEEDED,
+	       void *replycb_data UNNEEDED)
+{ fprintf(stderr, "subd_req_ called!\n"); abort(); }
+/* Generated stub for subd_send_msg */
+void subd_send_msg(struct subd *sd UNNEEDED, const u8 *msg_out UNNEEDED)
+{ fprintf(stderr, "subd_send_msg called!\n"); abort(); }
+/* Generated stub for towire_channel_fail_htlc */
+u8 *towire_channel_fail_htlc(const tal_t *ctx UNNEEDED, u64 id UNNEEDED, const u8 *error_pkt UNNEEDED, u16 errcode UNNEEDED, const struct short_channel_id *which_channel UNNEEDED)
+{ fprintf(stderr, "towire_channel_fail_htlc called!\n"); abort(); }
+/* Generated stub for towire_channel_feerates */
+u8 *towire_channel_feerates(const tal_t *ctx UNNEEDED, u32 feerate UNNEEDED, u32 min_feerate UNNEEDED, u32 max_feerate UNNEEDED)
+{ fprintf(stderr, "towire_channel_feerates called!\n"); abort(); }
+/* Generated stub for towire_channel_fulfill_htlc */
+u8 *towire_channel_fulfill_htlc(const tal_t *ctx UNNEEDED, u64 id UNNEEDED, const struct preimage *payment_preimage UNNEEDED)
+{ fprintf(stderr, "towire_channel_fulfill_htlc called!\n"); abort(); }
+/* Generated stub for towire_channel_got_commitsig_reply */
+u8 *towire_channel_got_commitsig_reply(const tal_t *ctx UNNEEDED)
+{ fprintf(stderr, "towire_channel_got_commitsig_reply called!\n"); abort(); }
+/* Generated stub for towire_channel_got_revoke_reply */
+u8 *towire_channel_got_revoke_reply(const tal_t *ctx UNNEEDED)
+{ fprintf(stderr, "towire_channel_got_revoke_reply called!\n"); abort(); }
+/* Generated stub for towire_channel_offer_htlc */
+u8 *towire_channel_offer_htlc(const tal_t *ctx UNNEEDED, u64 amount_msat UNNEEDED, u32 cltv_expiry UNNEEDED, const struct sha256 *payment_hash UNNEEDED, const u8 onion_routing_packet[1366])
+{ fprintf(stderr, "towire_channel_offer_htlc called!\n"); abort(); }
+/* Generated stub for towire_channel_sending_commitsig_reply */
+u8 *towire_channel_sending_commitsig_reply(const tal_t *ctx UNNEEDED)
+{ fprintf(stderr, "towire_channel_sending_commitsig_reply called!\n"); abort(); }
+/* Generated stub for towire_gossip_resolve_channel_request */
+u8 *towire_gossip_resolve_channel_request(const tal_t *ctx UNNEEDED, const struct short_channel_id *channel_id UNNEEDED)
+{ fprintf(stderr, "towire_gossip_resolve_channel_request called!\n"); abort(); }
+/* Generated stub for towire_onchain_known_preimage */
+u8 *towire_onchain_known_preimage(const tal_t *ctx UNNEEDED, const struct preimage *preimage UNNEEDED)
+{ fprintf(stderr, "towire_onchain_known_preimage called!\n"); abort(); }
+/* Generated stub for wallet_channel_save */
+void wallet_channel_save(struct wallet *w UNNEEDED, struct wallet_channel *chan UNNEEDED,
+			 u32 current_block_height UNNEEDED)
+{ fprintf(stderr, "wallet_channel_save called!\n"); abort(); }
+/* Generated stub for wallet_htlc_save_in */
+void wallet_htlc_save_in(struct wallet *wallet UNNEEDED,
+			 const struct wallet_channel *chan UNNEEDED, struct htlc_in *in UNNEEDED)
+{ fprintf(stderr, "wallet_htlc_save_in called!\n"); abort(); }
+/* Generated stub for wallet_htlc_save_out */
+void wallet_htlc_save_out(struct wallet *wallet UNNEEDED,
+			  const struct wallet_channel *chan UNNEEDED,
+			  struct htlc_out *out UNNEEDED)
+{ fprintf(stderr, "wallet_htlc_save_out called!\n"); abort(); }
+/* Generated stub for wallet_htlc_update */
+void wallet_htlc_update(struct wallet *wallet UNNEEDED, const u64 htlc_dbid UNNEEDED,
+			const enum htlc_state new_state UNNEEDED,
+			const struct preimage *payment_key UNNEEDED)
+{ fprintf(stderr, "wallet_htlc_update called!\n"); abort(); }
+/* Generated stub for wallet_invoice_find_unpaid */
+const struct invoice *wallet_invoice_find_unpaid(struct wallet *wallet UNNEEDED,
+						 const struct sha256 *rhash UNNEEDED)
+{ fprintf(stderr, "wallet_invoice_find_unpaid called!\n"); abort(); }
+/* Generated stub for wallet_invoice_resolve */
+void wallet_invoice_resolve(struct wallet *wallet UNNEEDED,
+			    const struct invoice *invoice UNNEEDED,
+			    u64 msatoshi_received UNNEEDED)
+{ fprintf(stderr, "wallet_invoice_resolve called!\n"); abort(); }
+/* Generated stub for wallet_payment_store */
+void wallet_payment_store(struct wallet *wallet UNNEEDED,
+			  const struct sha256 *payment_hash UNNEEDED)
+{ fprintf(stderr, "wallet_payment_store called!\n"); abort(); }
+/* Generated stub for wallet_shachain_add_hash */
+bool wallet_shachain_add_hash(struct wallet *wallet UNNEEDED,
+			      struct wallet_shachain *chain UNNEEDED,
+			      uint64_t index UNNEEDED,
+			      const struct sha256 *hash UNNEEDED)
+{ fprintf(stderr, "wallet_shachain_add_hash called!\n"); abort(); }
+/* AUTOGENERATED MOCKS END */
+
+static struct htlc_out *new_hout(const tal_t *ctx, struct peer *peer,
+				 u64 id, u32 cltv_expiry)
+{
+	struct htlc_out *hout = tal(ctx, struct htlc_out);
+
+	hout->key.peer = peer;
+	hout->key.id = id;
+	hout->cltv_expiry = cltv_expiry;
+	hout->hstate = SENT_ADD_ACK_REVOCATION;
+	return hout;
+}
+
+static struct htlc_in *new_hin(const tal_t *ctx, struct peer *peer,
+			       u64 id, u32 cltv_expiry, bool fulfilled)
+{
+	struct htlc_in *hin = tal(ctx, struct htlc_in);
+
+	hin->key.peer = peer;
+	hin->key.id = id;
+	hin->cltv_expiry = cltv_expiry;
+	hin->hstate = SENT_REMOVE_HTLC;
+	if (fulfilled)
+		hin->preimage = talz(hin, struct preimage);
+	else
+		hin->preimage = NULL;
+	return hin;
+}
+
+/* Checks, and forgets, what failed since last time. */
+static void check_failed(const u64 *ids, size_t num)
+{
+	assert(tal_count(failed_ids) == num);
+	for (size_t i = 0; i < num; i++)
+		assert(failed_ids[i] == ids[i]);
+	tal_resize(&failed_ids, 0);
+}
+
+static size_t num_deadlines(struct lightningd *ld)
+{
+	struct htlc_deadline *d;
+	size_t num = 0;
+	u64 index;
+
+	for (d = uintmap_first(&ld->htlc_deadlines, &index);
+	     d;
+	     d = uintmap_after(&ld->htlc_deadlines, &index))
+		num++;
+	return num;
+}
+
+int main(void)
+{
+	const tal_t *ctx = tal_tmpctx(NULL);
+	struct lightningd *ld = tal(ctx, struct lightningd);
+	struct peer *peer = talz(ctx, struct peer);
+	struct htlc_out *hout;
+
+	failed_ids = tal_arr(ctx, u64, 0);
+	uintmap_init(&ld->htlc_deadlines);
+	ld->htlc_deadline_seq = 0;
+	ld->config.cltv_expiry_delta = 6;
+	htlc_in_map_init(&ld->htlcs_in);
+	htlc_out_map_init(&ld->htlcs_out);
+	peer->state = CHANNELD_NORMAL;
+	peer->error = NULL;
+
+	/* Offered HTLCs hit their deadline the block after cltv_expiry,
+	 * fulfilled ones half our cltv_expiry_delta (rounded up) before.
+	 * Equal deadlines come out in the order they went in. */
+	add_htlc_out_deadline(ld, new_hout(ctx, peer, 1, 150));
+	add_htlc_out_deadline(ld, new_hout(ctx, peer, 2, 109));
+	hout = new_hout(ctx, peer, 3, 130);
+	add_htlc_out_deadline(ld, hout);
+	add_htlc_in_deadline(ld, new_hin(ctx, peer, 4, 113, true));
+	add_htlc_out_deadline(ld, new_hout(ctx, peer, 5, 109));
+	assert(num_deadlines(ld) == 5);
+
+	/* Nothing due yet. */
+	notify_new_block(ld, 109);
+	check_failed(NULL, 0);
+	assert(num_deadlines(ld) == 5);
+
+	/* 2 and 5 at 110, 4 at 113 - 3 = 110 too. */
+	notify_new_block(ld, 110);
+	check_failed((u64[]){ 2, 4, 5 }, 3);
+	assert(num_deadlines(ld) == 2);
+
+	/* They only come out once. */
+	notify_new_block(ld, 110);
+	check_failed(NULL, 0);
+
+	/* Freeing an HTLC takes it out of the index. */
+	tal_free(hout);
+	assert(num_deadlines(ld) == 1);
+	notify_new_block(ld, 200);
+	check_failed((u64[]){ 1 }, 1);
+	assert(num_deadlines(ld) == 0);
+
+	/* Nothing to do if the peer is already failed or on chain, but
+	 * they still leave the index. */
+	add_htlc_out_deadline(ld, new_hout(ctx, peer, 6, 300));
+	peer->error = (u8 *)"";
+	notify_new_block(ld, 301);
+	check_failed(NULL, 0);
+	assert(num_deadlines(ld) == 0);
+	peer->error = NULL;
+
+	add_htlc_out_deadline(ld, new_hout(ctx, peer, 7, 300));
+	peer->state = ONCHAIND_OUR_UNILATERAL;
+	notify_new_block(ld, 301);
+	check_failed(NULL, 0);
+	assert(num_deadlines(ld) == 0);
+	peer->state = CHANNELD_NORMAL;
+
+	/* HTLCs loaded from the db get indexed at startup: all the ones we
+	 * offered, but only the incoming ones we fulfilled. */
+	htlc_out_map_add(&ld->htlcs_out, new_hout(ctx, peer, 8, 400));
+	htlc_out_map_add(&ld->htlcs_out, new_hout(ctx, peer, 9, 350));
+	htlc_in_map_add(&ld->htlcs_in, new_hin(ctx, peer, 10, 420, true));
+	htlc_in_map_add(&ld->htlcs_in, new_hin(ctx, peer, 11, 380, false));
+	htlcs_index_deadlines(ld);
+	assert(num_deadlines(ld) == 3);
+
+	notify_new_block(ld, 500);
+	check_failed((u64[]){ 9, 8, 10 }, 3);
+	assert(num_deadlines(ld) == 0);
+
+	htlc_in_map_clear(&ld->htlcs_in);
+	htlc_out_map_clear(&ld->htlcs_out);
+	tal_free(ctx);
+	return 0;
+}
@@ -2,26 +2,70 @@
 
 #include <bitcoin/script.h>
 #include <ccan/crypto/ripemd160/ripemd160.h>
+#include <ccan/crypto/siphash24/siphash24.h>
+#include <ccan/htable/htable_type.h>
+#include <ccan/mem/mem.h>
+#include <common/pseudorand.h>
 #include <common/utils.h>
 
-struct txfilter {
-	u8 **scriptpubkeys;
+/* We look up output scripts by their bytes. */
+struct script_span {
+	const u8 *script;
+	size_t len;
 };
 
+static const struct script_span *script_span_keyof(const struct script_span *s)
+{
+	return s;
+}
+
+static size_t script_span_hash_key(const struct script_span *key)
+{
+	return siphash24(siphash_seed(), key->script, key->len);
+}
+
+static bool script_span_eq(const struct script_span *s,
+			   const struct script_span *key)
+{
+	return memeq(s->script, s->len, key->script, key->len);
+}
+HTABLE_DEFINE_TYPE(struct script_span, script_span_keyof, script_span_hash_key,
+		   script_span_eq, scriptpubkey_set);
+
+struct txfilter {
+	/* Every scriptpubkey we've been given (once, however often added) */
+	struct scriptpubkey_set scriptpubkeys;
+};
 
+static void destroy_txfilter(struct txfilter *filter)
+{
+	scriptpubkey_set_clear(&filter->scriptpubkeys);
+}
 
 struct txfilter *txfilter_new(const tal_t *ctx)
 {
 	struct txfilter *filter = tal(ctx, struct txfilter);
-	filter->scriptpubkeys = tal_arr(filter, u8*, 0);
+	scriptpubkey_set_init(&filter->scriptpubkeys);
+	tal_add_destructor(filter, destroy_txfilter);
 	return filter;
 }
 
 void txfilter_add_scriptpubkey(struct txfilter *filter, u8 *script)
 {
-	size_t count = tal_count(filter->scriptpubkeys);
-	tal_resize(&filter->scriptpubkeys, count + 1);
-	filter->scriptpubkeys[count] = tal_dup_arr(filter, u8, script, tal_len(script), 0);
+	struct script_span *s, key;
+
+	key.script = script;
+	key.len = tal_len(script);
+	if (scriptpubkey_set_get(&filter->scriptpubkeys, &key)) {
+		if (taken(script))
+			tal_free(script);
+		return;
+	}
+
+	s = tal(filter, struct script_span);
+	s->script = tal_dup_arr(s, u8, script, key.len, 0);
+	s->len = key.len;
+	scriptpubkey_set_add(&filter->scriptpubkeys, s);
 }
 
 void txfilter_add_derkey(struct txfilter *filter, u8 derkey[PUBKEY_DER_LEN])
@@ -39,16 +83,22 @@ void txfilter_add_derkey(struct txfilter *filter, u8 derkey[PUBKEY_DER_LEN])
 }
 
 
+bool txfilter_match_script(const struct txfilter *filter,
+			   const u8 *script, size_t script_len)
+{
+	struct script_span key;
+
+	key.script = script;
+	key.len = script_len;
+	return scriptpubkey_set_get(&filter->scriptpubkeys, &key) != NULL;
+}
+
 bool txfilter_match(const struct txfilter *filter, const struct bitcoin_tx *tx)
 {
-	u8 *oscript;
 	for (size_t i = 0; i < tal_count(tx->output); i++) {
-		oscript = tx->output[i].script;
-
-		for (size_t j = 0; j < tal_count(filter->scriptpubkeys); j++) {
-			if (scripteq(oscript, filter->scriptpubkeys[j]))
-				return true;
-		}
+		if (txfilter_match_script(filter, tx->output[i].script,
+					  tal_len(tx->output[i].script)))
+			return true;
 	}
 	return false;
 }
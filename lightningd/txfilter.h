@@ -28,6 +28,12 @@ void txfilter_add_derkey(struct txfilter *filter, u8 derkey[PUBKEY_DER_LEN]);
  */
 bool txfilter_match(const struct txfilter *filter, const struct bitcoin_tx *tx);
 
+/**
+ * txfilter_match_script -- Check whether an output script matches the filter
+ */
+bool txfilter_match_script(const struct txfilter *filter,
+			   const u8 *script, size_t script_len);
+
 /**
  * txfilter_add_scriptpubkey -- Add a serialized scriptpubkey to the filter
  */
@@ -0,0 +1,505 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#include <onchaind/gen_onchain_wire.h>
+#include <ccan/mem/mem.h>
+#include <ccan/tal/str/str.h>
+#include <stdio.h>
+
+const char *onchain_wire_type_name(int e)
+{
+	static char invalidbuf[sizeof("INVALID ") + STR_MAX_CHARS(e)];
+
+	switch ((enum onchain_wire_type)e) {
+	case WIRE_ONCHAIN_INIT: return "WIRE_ONCHAIN_INIT";
+	case WIRE_ONCHAIN_HTLC: return "WIRE_ONCHAIN_HTLC";
+	case WIRE_ONCHAIN_INIT_REPLY: return "WIRE_ONCHAIN_INIT_REPLY";
+	case WIRE_ONCHAIN_BROADCAST_TX: return "WIRE_ONCHAIN_BROADCAST_TX";
+	case WIRE_ONCHAIN_SPENT: return "WIRE_ONCHAIN_SPENT";
+	case WIRE_ONCHAIN_DEPTH: return "WIRE_ONCHAIN_DEPTH";
+	case WIRE_ONCHAIN_UNWATCH_TX: return "WIRE_ONCHAIN_UNWATCH_TX";
+	case WIRE_ONCHAIN_KNOWN_PREIMAGE: return "WIRE_ONCHAIN_KNOWN_PREIMAGE";
+	case WIRE_ONCHAIN_EXTRACTED_PREIMAGE: return "WIRE_ONCHAIN_EXTRACTED_PREIMAGE";
+	case WIRE_ONCHAIN_MISSING_HTLC_OUTPUT: return "WIRE_ONCHAIN_MISSING_HTLC_OUTPUT";
+	case WIRE_ONCHAIN_HTLC_TIMEOUT: return "WIRE_ONCHAIN_HTLC_TIMEOUT";
+	case WIRE_ONCHAIN_ALL_IRREVOCABLY_RESOLVED: return "WIRE_ONCHAIN_ALL_IRREVOCABLY_RESOLVED";
+	case WIRE_ONCHAIN_ADD_UTXO: return "WIRE_ONCHAIN_ADD_UTXO";
+	}
+
+	sprintf(invalidbuf, "INVALID %i", e);
+	return invalidbuf;
+}
+
+bool fromwire_onchain_init(const tal_t *ctx, const void *p, size_t *plen, struct privkey *seed, struct shachain *shachain, u64 *funding_amount_satoshi, struct pubkey *old_remote_per_commitment_point, struct pubkey *remote_per_commitment_point, u32 *local_to_self_delay, u32 *remote_to_self_delay, u32 *feerate_per_kw, u64 *local_dust_limit_satoshi, struct pubkey *remote_revocation_basepoint, struct bitcoin_txid *our_broadcast_txid, u8 **local_scriptpubkey, u8 **remote_scriptpubkey, struct pubkey *ourwallet_pubkey, enum side *funder, struct pubkey *remote_payment_basepoint, struct pubkey *remote_htlc_basepoint, struct pubkey *remote_delayed_payment_basepoint, struct bitcoin_tx *tx, u32 *tx_blockheight, u32 *reasonable_depth, secp256k1_ecdsa_signature **htlc_signature, u64 *num_htlcs)
+{
+	u16 local_scriptpubkey_len;
+	u16 remote_scriptpubkey_len;
+	u16 num_htlc_sigs;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_INIT)
+		return false;
+	//4th case seed
+	fromwire_privkey(&cursor, plen, seed);
+	//4th case shachain
+	fromwire_shachain(&cursor, plen, shachain);
+	//3th case funding_amount_satoshi
+	*funding_amount_satoshi = fromwire_u64(&cursor, plen);
+	/* Remote per commit point for committed tx. */
+	//4th case old_remote_per_commitment_point
+	fromwire_pubkey(&cursor, plen, old_remote_per_commitment_point);
+	/* Remote per commit point for current tx (needed if we haven't got revoke_and_ack yet). */
+	//4th case remote_per_commitment_point
+	fromwire_pubkey(&cursor, plen, remote_per_commitment_point);
+	//3th case local_to_self_delay
+	*local_to_self_delay = fromwire_u32(&cursor, plen);
+	//3th case remote_to_self_delay
+	*remote_to_self_delay = fromwire_u32(&cursor, plen);
+	//3th case feerate_per_kw
+	*feerate_per_kw = fromwire_u32(&cursor, plen);
+	//3th case local_dust_limit_satoshi
+	*local_dust_limit_satoshi = fromwire_u64(&cursor, plen);
+	//4th case remote_revocation_basepoint
+	fromwire_pubkey(&cursor, plen, remote_revocation_basepoint);
+	/* Gives an easy way to tell if it's our unilateral close or theirs... */
+	//4th case our_broadcast_txid
+	fromwire_bitcoin_txid(&cursor, plen, our_broadcast_txid);
+	//3th case local_scriptpubkey_len
+	local_scriptpubkey_len = fromwire_u16(&cursor, plen);
+	//2nd case local_scriptpubkey
+	*local_scriptpubkey = local_scriptpubkey_len ? tal_arr(ctx, u8, local_scriptpubkey_len) : NULL;
+	fromwire_u8_array(&cursor, plen, *local_scriptpubkey, local_scriptpubkey_len);
+	//3th case remote_scriptpubkey_len
+	remote_scriptpubkey_len = fromwire_u16(&cursor, plen);
+	//2nd case remote_scriptpubkey
+	*remote_scriptpubkey = remote_scriptpubkey_len ? tal_arr(ctx, u8, remote_scriptpubkey_len) : NULL;
+	fromwire_u8_array(&cursor, plen, *remote_scriptpubkey, remote_scriptpubkey_len);
+	//4th case ourwallet_pubkey
+	fromwire_pubkey(&cursor, plen, ourwallet_pubkey);
+	/* We need these two for commit number obscurer */
+	//3th case funder
+	*funder = fromwire_side(&cursor, plen);
+	//4th case remote_payment_basepoint
+	fromwire_pubkey(&cursor, plen, remote_payment_basepoint);
+	//4th case remote_htlc_basepoint
+	fromwire_pubkey(&cursor, plen, remote_htlc_basepoint);
+	//4th case remote_delayed_payment_basepoint
+	fromwire_pubkey(&cursor, plen, remote_delayed_payment_basepoint);
+	//4th case tx
+	fromwire_bitcoin_tx(&cursor, plen, tx);
+	//3th case tx_blockheight
+	*tx_blockheight = fromwire_u32(&cursor, plen);
+	//3th case reasonable_depth
+	*reasonable_depth = fromwire_u32(&cursor, plen);
+	//3th case num_htlc_sigs
+	num_htlc_sigs = fromwire_u16(&cursor, plen);
+	//2nd case htlc_signature
+	*htlc_signature = num_htlc_sigs ? tal_arr(ctx, secp256k1_ecdsa_signature, num_htlc_sigs) : NULL;
+	for (size_t i = 0; i < num_htlc_sigs; i++)
+		fromwire_secp256k1_ecdsa_signature(&cursor, plen, *htlc_signature + i);
+	//3th case num_htlcs
+	*num_htlcs = fromwire_u64(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_onchain_htlc(const void *p, size_t *plen, struct htlc_stub *htlc, bool *tell_if_missing, bool *tell_immediately)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_HTLC)
+		return false;
+	//4th case htlc
+	fromwire_htlc_stub(&cursor, plen, htlc);
+	/* If it's not in the commitment tx, tell us (immediately or htlc_missing_depth) */
+	//3th case tell_if_missing
+	*tell_if_missing = fromwire_bool(&cursor, plen);
+	//3th case tell_immediately
+	*tell_immediately = fromwire_bool(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_onchain_init_reply(const void *p, size_t *plen, u8 *state)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_INIT_REPLY)
+		return false;
+	//3th case state
+	*state = fromwire_u8(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_onchain_broadcast_tx(const void *p, size_t *plen, struct bitcoin_tx *tx)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_BROADCAST_TX)
+		return false;
+	//4th case tx
+	fromwire_bitcoin_tx(&cursor, plen, tx);
+	return cursor != NULL;
+}
+
+bool fromwire_onchain_spent(const void *p, size_t *plen, struct bitcoin_tx *tx, u32 *input_num, u32 *blockheight)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_SPENT)
+		return false;
+	//4th case tx
+	fromwire_bitcoin_tx(&cursor, plen, tx);
+	//3th case input_num
+	*input_num = fromwire_u32(&cursor, plen);
+	//3th case blockheight
+	*blockheight = fromwire_u32(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_onchain_depth(const void *p, size_t *plen, struct bitcoin_txid *txid, u32 *depth)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_DEPTH)
+		return false;
+	//4th case txid
+	fromwire_bitcoin_txid(&cursor, plen, txid);
+	//3th case depth
+	*depth = fromwire_u32(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_onchain_unwatch_tx(const void *p, size_t *plen, struct bitcoin_txid *txid, u32 *num_outputs)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_UNWATCH_TX)
+		return false;
+	//4th case txid
+	fromwire_bitcoin_txid(&cursor, plen, txid);
+	//3th case num_outputs
+	*num_outputs = fromwire_u32(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_onchain_known_preimage(const void *p, size_t *plen, struct preimage *preimage)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_KNOWN_PREIMAGE)
+		return false;
+	//4th case preimage
+	fromwire_preimage(&cursor, plen, preimage);
+	return cursor != NULL;
+}
+
+bool fromwire_onchain_extracted_preimage(const void *p, size_t *plen, struct preimage *preimage)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_EXTRACTED_PREIMAGE)
+		return false;
+	//4th case preimage
+	fromwire_preimage(&cursor, plen, preimage);
+	return cursor != NULL;
+}
+
+bool fromwire_onchain_missing_htlc_output(const void *p, size_t *plen, struct htlc_stub *htlc)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_MISSING_HTLC_OUTPUT)
+		return false;
+	//4th case htlc
+	fromwire_htlc_stub(&cursor, plen, htlc);
+	return cursor != NULL;
+}
+
+bool fromwire_onchain_htlc_timeout(const void *p, size_t *plen, struct htlc_stub *htlc)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_HTLC_TIMEOUT)
+		return false;
+	//4th case htlc
+	fromwire_htlc_stub(&cursor, plen, htlc);
+	return cursor != NULL;
+}
+
+bool fromwire_onchain_all_irrevocably_resolved(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_ALL_IRREVOCABLY_RESOLVED)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_onchain_add_utxo(const void *p, size_t *plen, struct bitcoin_txid *prev_out_tx, u32 *prev_out_index, struct pubkey *per_commit_point, u64 *value)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ONCHAIN_ADD_UTXO)
+		return false;
+	//4th case prev_out_tx
+	fromwire_bitcoin_txid(&cursor, plen, prev_out_tx);
+	//3th case prev_out_index
+	*prev_out_index = fromwire_u32(&cursor, plen);
+	//4th case per_commit_point
+	fromwire_pubkey(&cursor, plen, per_commit_point);
+	//3th case value
+	*value = fromwire_u64(&cursor, plen);
+	return cursor != NULL;
+}
+
+u8 *towire_onchain_init(const tal_t *ctx, const struct privkey *seed, const struct shachain *shachain, u64 funding_amount_satoshi, const struct pubkey *old_remote_per_commitment_point, const struct pubkey *remote_per_commitment_point, u32 local_to_self_delay, u32 remote_to_self_delay, u32 feerate_per_kw, u64 local_dust_limit_satoshi, const struct pubkey *remote_revocation_basepoint, const struct bitcoin_txid *our_broadcast_txid, const u8 *local_scriptpubkey, const u8 *remote_scriptpubkey, const struct pubkey *ourwallet_pubkey, enum side funder, const struct pubkey *remote_payment_basepoint, const struct pubkey *remote_htlc_basepoint, const struct pubkey *remote_delayed_payment_basepoint, const struct bitcoin_tx *tx, u32 tx_blockheight, u32 reasonable_depth, const secp256k1_ecdsa_signature *htlc_signature, u64 num_htlcs)
+{
+	u16 local_scriptpubkey_len = tal_count(local_scriptpubkey);
+	u16 remote_scriptpubkey_len = tal_count(remote_scriptpubkey);
+	u16 num_htlc_sigs = tal_count(htlc_signature);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_INIT);
+	towire_privkey(&p, seed);
+	towire_shachain(&p, shachain);
+	towire_u64(&p, funding_amount_satoshi);
+	/* Remote per commit point for committed tx. */
+	towire_pubkey(&p, old_remote_per_commitment_point);
+	/* Remote per commit point for current tx (needed if we haven't got revoke_and_ack yet). */
+	towire_pubkey(&p, remote_per_commitment_point);
+	towire_u32(&p, local_to_self_delay);
+	towire_u32(&p, remote_to_self_delay);
+	towire_u32(&p, feerate_per_kw);
+	towire_u64(&p, local_dust_limit_satoshi);
+	towire_pubkey(&p, remote_revocation_basepoint);
+	/* Gives an easy way to tell if it's our unilateral close or theirs... */
+	towire_bitcoin_txid(&p, our_broadcast_txid);
+	towire_u16(&p, local_scriptpubkey_len);
+	towire_u8_array(&p, local_scriptpubkey, local_scriptpubkey_len);
+	towire_u16(&p, remote_scriptpubkey_len);
+	towire_u8_array(&p, remote_scriptpubkey, remote_scriptpubkey_len);
+	towire_pubkey(&p, ourwallet_pubkey);
+	/* We need these two for commit number obscurer */
+	towire_side(&p, funder);
+	towire_pubkey(&p, remote_payment_basepoint);
+	towire_pubkey(&p, remote_htlc_basepoint);
+	towire_pubkey(&p, remote_delayed_payment_basepoint);
+	towire_bitcoin_tx(&p, tx);
+	towire_u32(&p, tx_blockheight);
+	towire_u32(&p, reasonable_depth);
+	towire_u16(&p, num_htlc_sigs);
+	for (size_t i = 0; i < num_htlc_sigs; i++)
+
+		towire_secp256k1_ecdsa_signature(&p, htlc_signature + i);
+	towire_u64(&p, num_htlcs);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_onchain_htlc(const tal_t *ctx, const struct htlc_stub *htlc, bool tell_if_missing, bool tell_immediately)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_HTLC);
+	towire_htlc_stub(&p, htlc);
+	/* If it's not in the commitment tx, tell us (immediately or htlc_missing_depth) */
+	towire_bool(&p, tell_if_missing);
+	towire_bool(&p, tell_immediately);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_onchain_init_reply(const tal_t *ctx, u8 state)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_INIT_REPLY);
+	towire_u8(&p, state);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_onchain_broadcast_tx(const tal_t *ctx, const struct bitcoin_tx *tx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_BROADCAST_TX);
+	towire_bitcoin_tx(&p, tx);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_onchain_spent(const tal_t *ctx, const struct bitcoin_tx *tx, u32 input_num, u32 blockheight)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_SPENT);
+	towire_bitcoin_tx(&p, tx);
+	towire_u32(&p, input_num);
+	towire_u32(&p, blockheight);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_onchain_depth(const tal_t *ctx, const struct bitcoin_txid *txid, u32 depth)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_DEPTH);
+	towire_bitcoin_txid(&p, txid);
+	towire_u32(&p, depth);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_onchain_unwatch_tx(const tal_t *ctx, const struct bitcoin_txid *txid, u32 num_outputs)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_UNWATCH_TX);
+	towire_bitcoin_txid(&p, txid);
+	towire_u32(&p, num_outputs);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_onchain_known_preimage(const tal_t *ctx, const struct preimage *preimage)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_KNOWN_PREIMAGE);
+	towire_preimage(&p, preimage);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_onchain_extracted_preimage(const tal_t *ctx, const struct preimage *preimage)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_EXTRACTED_PREIMAGE);
+	towire_preimage(&p, preimage);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_onchain_missing_htlc_output(const tal_t *ctx, const struct htlc_stub *htlc)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_MISSING_HTLC_OUTPUT);
+	towire_htlc_stub(&p, htlc);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_onchain_htlc_timeout(const tal_t *ctx, const struct htlc_stub *htlc)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_HTLC_TIMEOUT);
+	towire_htlc_stub(&p, htlc);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_onchain_all_irrevocably_resolved(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_ALL_IRREVOCABLY_RESOLVED);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_onchain_add_utxo(const tal_t *ctx, const struct bitcoin_txid *prev_out_tx, u32 prev_out_index, const struct pubkey *per_commit_point, u64 value)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ONCHAIN_ADD_UTXO);
+	towire_bitcoin_txid(&p, prev_out_tx);
+	towire_u32(&p, prev_out_index);
+	towire_pubkey(&p, per_commit_point);
+	towire_u64(&p, value);
+
+	return memcheck(p, tal_count(p));
+}
+
+
@@ -0,0 +1,94 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#ifndef LIGHTNING_ONCHAIND_GEN_ONCHAIN_WIRE_H
+#define LIGHTNING_ONCHAIND_GEN_ONCHAIN_WIRE_H
+#include <ccan/tal/tal.h>
+#include <wire/wire.h>
+#include <common/htlc_wire.h>
+
+#include <onchaind/onchain_wire.h>
+
+enum onchain_wire_type {
+	/* Begin!  Here's the onchain tx which spends funding tx, followed by all HTLCs. */
+	WIRE_ONCHAIN_INIT = 5001,
+	/* This is all the HTLCs: one per message */
+	WIRE_ONCHAIN_HTLC = 5002,
+	/* This sets what the state is, depending on tx. */
+	WIRE_ONCHAIN_INIT_REPLY = 5101,
+	/* onchaind->master: Send out a tx. */
+	WIRE_ONCHAIN_BROADCAST_TX = 5003,
+	/* master->onchaind: Notifier that an output has been spent by input_num of tx. */
+	WIRE_ONCHAIN_SPENT = 5004,
+	/* master->onchaind: We will receive more than one of these, as depth changes. */
+	WIRE_ONCHAIN_DEPTH = 5005,
+	/* onchaind->master: We don't want to watch this tx, or its outputs */
+	WIRE_ONCHAIN_UNWATCH_TX = 5006,
+	/* master->onchaind: We know HTLC preimage */
+	WIRE_ONCHAIN_KNOWN_PREIMAGE = 5007,
+	/* onchaind->master: We discovered HTLC preimage */
+	WIRE_ONCHAIN_EXTRACTED_PREIMAGE = 5008,
+	/* onchaind->master: this HTLC was missing from commit tx. */
+	WIRE_ONCHAIN_MISSING_HTLC_OUTPUT = 5009,
+	/* onchaind->master: this HTLC has timed out (after reasonable_depth) */
+	WIRE_ONCHAIN_HTLC_TIMEOUT = 5010,
+	/* onchaind->master: this peer can be forgotten */
+	WIRE_ONCHAIN_ALL_IRREVOCABLY_RESOLVED = 5011,
+	/* onchaind->master: hey, I identified a UTXO you'll want to track */
+	WIRE_ONCHAIN_ADD_UTXO = 5012,
+};
+const char *onchain_wire_type_name(int e);
+
+bool fromwire_onchain_init(const tal_t *ctx, const void *p, size_t *plen, struct privkey *seed, struct shachain *shachain, u64 *funding_amount_satoshi, struct pubkey *old_remote_per_commitment_point, struct pubkey *remote_per_commitment_point, u32 *local_to_self_delay, u32 *remote_to_self_delay, u32 *feerate_per_kw, u64 *local_dust_limit_satoshi, struct pubkey *remote_revocation_basepoint, struct bitcoin_txid *our_broadcast_txid, u8 **local_scriptpubkey, u8 **remote_scriptpubkey, struct pubkey *ourwallet_pubkey, enum side *funder, struct pubkey *remote_payment_basepoint, struct pubkey *remote_htlc_basepoint, struct pubkey *remote_delayed_payment_basepoint, struct bitcoin_tx *tx, u32 *tx_blockheight, u32 *reasonable_depth, secp256k1_ecdsa_signature **htlc_signature, u64 *num_htlcs);
+
+bool fromwire_onchain_htlc(const void *p, size_t *plen, struct htlc_stub *htlc, bool *tell_if_missing, bool *tell_immediately);
+
+bool fromwire_onchain_init_reply(const void *p, size_t *plen, u8 *state);
+
+bool fromwire_onchain_broadcast_tx(const void *p, size_t *plen, struct bitcoin_tx *tx);
+
+bool fromwire_onchain_spent(const void *p, size_t *plen, struct bitcoin_tx *tx, u32 *input_num, u32 *blockheight);
+
+bool fromwire_onchain_depth(const void *p, size_t *plen, struct bitcoin_txid *txid, u32 *depth);
+
+bool fromwire_onchain_unwatch_tx(const void *p, size_t *plen, struct bitcoin_txid *txid, u32 *num_outputs);
+
+bool fromwire_onchain_known_preimage(const void *p, size_t *plen, struct preimage *preimage);
+
+bool fromwire_onchain_extracted_preimage(const void *p, size_t *plen, struct preimage *preimage);
+
+bool fromwire_onchain_missing_htlc_output(const void *p, size_t *plen, struct htlc_stub *htlc);
+
+bool fromwire_onchain_htlc_timeout(const void *p, size_t *plen, struct htlc_stub *htlc);
+
+bool fromwire_onchain_all_irrevocably_resolved(const void *p, size_t *plen);
+
+bool fromwire_onchain_add_utxo(const void *p, size_t *plen, struct bitcoin_txid *prev_out_tx, u32 *prev_out_index, struct pubkey *per_commit_point, u64 *value);
+
+u8 *towire_onchain_init(const tal_t *ctx, const struct privkey *seed, const struct shachain *shachain, u64 funding_amount_satoshi, const struct pubkey *old_remote_per_commitment_point, const struct pubkey *remote_per_commitment_point, u32 local_to_self_delay, u32 remote_to_self_delay, u32 feerate_per_kw, u64 local_dust_limit_satoshi, const struct pubkey *remote_revocation_basepoint, const struct bitcoin_txid *our_broadcast_txid, const u8 *local_scriptpubkey, const u8 *remote_scriptpubkey, const struct pubkey *ourwallet_pubkey, enum side funder, const struct pubkey *remote_payment_basepoint, const struct pubkey *remote_htlc_basepoint, const struct pubkey *remote_delayed_payment_basepoint, const struct bitcoin_tx *tx, u32 tx_blockheight, u32 reasonable_depth, const secp256k1_ecdsa_signature *htlc_signature, u64 num_htlcs);
+
+u8 *towire_onchain_htlc(const tal_t *ctx, const struct htlc_stub *htlc, bool tell_if_missing, bool tell_immediately);
+
+u8 *towire_onchain_init_reply(const tal_t *ctx, u8 state);
+
+u8 *towire_onchain_broadcast_tx(const tal_t *ctx, const struct bitcoin_tx *tx);
+
+u8 *towire_onchain_spent(const tal_t *ctx, const struct bitcoin_tx *tx, u32 input_num, u32 blockheight);
+
+u8 *towire_onchain_depth(const tal_t *ctx, const struct bitcoin_txid *txid, u32 depth);
+
+u8 *towire_onchain_unwatch_tx(const tal_t *ctx, const struct bitcoin_txid *txid, u32 num_outputs);
+
+u8 *towire_onchain_known_preimage(const tal_t *ctx, const struct preimage *preimage);
+
+u8 *towire_onchain_extracted_preimage(const tal_t *ctx, const struct preimage *preimage);
+
+u8 *towire_onchain_missing_htlc_output(const tal_t *ctx, const struct htlc_stub *htlc);
+
+u8 *towire_onchain_htlc_timeout(const tal_t *ctx, const struct htlc_stub *htlc);
+
+u8 *towire_onchain_all_irrevocably_resolved(const tal_t *ctx);
+
+u8 *towire_onchain_add_utxo(const tal_t *ctx, const struct bitcoin_txid *prev_out_tx, u32 prev_out_index, const struct pubkey *per_commit_point, u64 value);
+
+#endif /* LIGHTNING_ONCHAIND_GEN_ONCHAIN_WIRE_H */
+
@@ -0,0 +1,369 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#include <openingd/gen_opening_wire.h>
+#include <ccan/mem/mem.h>
+#include <ccan/tal/str/str.h>
+#include <stdio.h>
+
+const char *opening_wire_type_name(int e)
+{
+	static char invalidbuf[sizeof("INVALID ") + STR_MAX_CHARS(e)];
+
+	switch ((enum opening_wire_type)e) {
+	case WIRE_OPENING_INIT: return "WIRE_OPENING_INIT";
+	case WIRE_OPENING_FUNDER: return "WIRE_OPENING_FUNDER";
+	case WIRE_OPENING_FUNDER_REPLY: return "WIRE_OPENING_FUNDER_REPLY";
+	case WIRE_OPENING_FUNDEE: return "WIRE_OPENING_FUNDEE";
+	case WIRE_OPENING_FUNDEE_REPLY: return "WIRE_OPENING_FUNDEE_REPLY";
+	case WIRE_OPENING_NEGOTIATION_FAILED: return "WIRE_OPENING_NEGOTIATION_FAILED";
+	}
+
+	sprintf(invalidbuf, "INVALID %i", e);
+	return invalidbuf;
+}
+
+bool fromwire_opening_init(const void *p, size_t *plen, u32 *network_index, struct channel_config *our_config, u32 *max_to_self_delay, u64 *min_effective_htlc_capacity_msat, struct crypto_state *crypto_state, u64 *gossip_index, struct privkey *seed)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_OPENING_INIT)
+		return false;
+	/* Which network are we configured for (as index into the chainparams)? */
+	//3th case network_index
+	*network_index = fromwire_u32(&cursor, plen);
+	/* Base configuration we'll offer (channel reserve will vary with amount) */
+	//4th case our_config
+	fromwire_channel_config(&cursor, plen, our_config);
+	/* Minimum/maximum configuration values we'll accept */
+	//3th case max_to_self_delay
+	*max_to_self_delay = fromwire_u32(&cursor, plen);
+	//3th case min_effective_htlc_capacity_msat
+	*min_effective_htlc_capacity_msat = fromwire_u64(&cursor, plen);
+	//4th case crypto_state
+	fromwire_crypto_state(&cursor, plen, crypto_state);
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	/* Seed to generate all the keys from */
+	//4th case seed
+	fromwire_privkey(&cursor, plen, seed);
+	return cursor != NULL;
+}
+
+bool fromwire_opening_funder(const tal_t *ctx, const void *p, size_t *plen, u64 *funding_satoshis, u64 *push_msat, u32 *feerate_per_kw, u32 *max_minimum_depth, u64 *change_satoshis, u32 *change_keyindex, u8 *channel_flags, struct utxo **inputs, struct ext_key *bip32)
+{
+	u16 num_inputs;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_OPENING_FUNDER)
+		return false;
+	//3th case funding_satoshis
+	*funding_satoshis = fromwire_u64(&cursor, plen);
+	//3th case push_msat
+	*push_msat = fromwire_u64(&cursor, plen);
+	//3th case feerate_per_kw
+	*feerate_per_kw = fromwire_u32(&cursor, plen);
+	//3th case max_minimum_depth
+	*max_minimum_depth = fromwire_u32(&cursor, plen);
+	//3th case change_satoshis
+	*change_satoshis = fromwire_u64(&cursor, plen);
+	//3th case change_keyindex
+	*change_keyindex = fromwire_u32(&cursor, plen);
+	//3th case channel_flags
+	*channel_flags = fromwire_u8(&cursor, plen);
+	//3th case num_inputs
+	num_inputs = fromwire_u16(&cursor, plen);
+	//2nd case inputs
+	*inputs = num_inputs ? tal_arr(ctx, struct utxo, num_inputs) : NULL;
+	for (size_t i = 0; i < num_inputs; i++)
+		fromwire_utxo(ctx, &cursor, plen, *inputs + i);
+	//4th case bip32
+	fromwire_ext_key(&cursor, plen, bip32);
+	return cursor != NULL;
+}
+
+bool fromwire_opening_funder_reply(const void *p, size_t *plen, struct channel_config *their_config, struct bitcoin_tx *first_commit, secp256k1_ecdsa_signature *first_commit_sig, struct crypto_state *crypto_state, u64 *gossip_index, struct pubkey *revocation_basepoint, struct pubkey *payment_basepoint, struct pubkey *htlc_basepoint, struct pubkey *delayed_payment_basepoint, struct pubkey *their_per_commit_point, u32 *minimum_depth, struct pubkey *remote_fundingkey, struct bitcoin_txid *funding_txid, u32 *feerate_per_kw)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_OPENING_FUNDER_REPLY)
+		return false;
+	//4th case their_config
+	fromwire_channel_config(&cursor, plen, their_config);
+	//4th case first_commit
+	fromwire_bitcoin_tx(&cursor, plen, first_commit);
+	//4th case first_commit_sig
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, first_commit_sig);
+	//4th case crypto_state
+	fromwire_crypto_state(&cursor, plen, crypto_state);
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	//4th case revocation_basepoint
+	fromwire_pubkey(&cursor, plen, revocation_basepoint);
+	//4th case payment_basepoint
+	fromwire_pubkey(&cursor, plen, payment_basepoint);
+	//4th case htlc_basepoint
+	fromwire_pubkey(&cursor, plen, htlc_basepoint);
+	//4th case delayed_payment_basepoint
+	fromwire_pubkey(&cursor, plen, delayed_payment_basepoint);
+	//4th case their_per_commit_point
+	fromwire_pubkey(&cursor, plen, their_per_commit_point);
+	//3th case minimum_depth
+	*minimum_depth = fromwire_u32(&cursor, plen);
+	//4th case remote_fundingkey
+	fromwire_pubkey(&cursor, plen, remote_fundingkey);
+	//4th case funding_txid
+	fromwire_bitcoin_txid(&cursor, plen, funding_txid);
+	//3th case feerate_per_kw
+	*feerate_per_kw = fromwire_u32(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_opening_fundee(const tal_t *ctx, const void *p, size_t *plen, u32 *minimum_depth, u32 *min_feerate, u32 *max_feerate, u8 **msg)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_OPENING_FUNDEE)
+		return false;
+	//3th case minimum_depth
+	*minimum_depth = fromwire_u32(&cursor, plen);
+	//3th case min_feerate
+	*min_feerate = fromwire_u32(&cursor, plen);
+	//3th case max_feerate
+	*max_feerate = fromwire_u32(&cursor, plen);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case msg
+	*msg = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *msg, len);
+	return cursor != NULL;
+}
+
+bool fromwire_opening_fundee_reply(const tal_t *ctx, const void *p, size_t *plen, struct channel_config *their_config, struct bitcoin_tx *first_commit, secp256k1_ecdsa_signature *first_commit_sig, struct crypto_state *crypto_state, u64 *gossip_index, struct pubkey *revocation_basepoint, struct pubkey *payment_basepoint, struct pubkey *htlc_basepoint, struct pubkey *delayed_payment_basepoint, struct pubkey *their_per_commit_point, struct pubkey *remote_fundingkey, struct bitcoin_txid *funding_txid, u16 *funding_txout, u64 *funding_satoshis, u64 *push_msat, u8 *channel_flags, u32 *feerate_per_kw, u8 **funding_signed_msg)
+{
+	u16 msglen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_OPENING_FUNDEE_REPLY)
+		return false;
+	//4th case their_config
+	fromwire_channel_config(&cursor, plen, their_config);
+	//4th case first_commit
+	fromwire_bitcoin_tx(&cursor, plen, first_commit);
+	//4th case first_commit_sig
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, first_commit_sig);
+	//4th case crypto_state
+	fromwire_crypto_state(&cursor, plen, crypto_state);
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	//4th case revocation_basepoint
+	fromwire_pubkey(&cursor, plen, revocation_basepoint);
+	//4th case payment_basepoint
+	fromwire_pubkey(&cursor, plen, payment_basepoint);
+	//4th case htlc_basepoint
+	fromwire_pubkey(&cursor, plen, htlc_basepoint);
+	//4th case delayed_payment_basepoint
+	fromwire_pubkey(&cursor, plen, delayed_payment_basepoint);
+	//4th case their_per_commit_point
+	fromwire_pubkey(&cursor, plen, their_per_commit_point);
+	//4th case remote_fundingkey
+	fromwire_pubkey(&cursor, plen, remote_fundingkey);
+	//4th case funding_txid
+	fromwire_bitcoin_txid(&cursor, plen, funding_txid);
+	//3th case funding_txout
+	*funding_txout = fromwire_u16(&cursor, plen);
+	//3th case funding_satoshis
+	*funding_satoshis = fromwire_u64(&cursor, plen);
+	//3th case push_msat
+	*push_msat = fromwire_u64(&cursor, plen);
+	//3th case channel_flags
+	*channel_flags = fromwire_u8(&cursor, plen);
+	//3th case feerate_per_kw
+	*feerate_per_kw = fromwire_u32(&cursor, plen);
+	/* The (encrypted) funding signed message: send this and we're committed. */
+	//3th case msglen
+	msglen = fromwire_u16(&cursor, plen);
+	//2nd case funding_signed_msg
+	*funding_signed_msg = msglen ? tal_arr(ctx, u8, msglen) : NULL;
+	fromwire_u8_array(&cursor, plen, *funding_signed_msg, msglen);
+	return cursor != NULL;
+}
+
+bool fromwire_opening_negotiation_failed(const tal_t *ctx, const void *p, size_t *plen, struct crypto_state *crypto_state, u64 *gossip_index, u8 **msg)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_OPENING_NEGOTIATION_FAILED)
+		return false;
+	//4th case crypto_state
+	fromwire_crypto_state(&cursor, plen, crypto_state);
+	//3th case gossip_index
+	*gossip_index = fromwire_u64(&cursor, plen);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	/* FIXME: string support! */
+	//2nd case msg
+	*msg = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *msg, len);
+	return cursor != NULL;
+}
+
+u8 *towire_opening_init(const tal_t *ctx, u32 network_index, const struct channel_config *our_config, u32 max_to_self_delay, u64 min_effective_htlc_capacity_msat, const struct crypto_state *crypto_state, u64 gossip_index, const struct privkey *seed)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_OPENING_INIT);
+	/* Which network are we configured for (as index into the chainparams)? */
+	towire_u32(&p, network_index);
+	/* Base configuration we'll offer (channel reserve will vary with amount) */
+	towire_channel_config(&p, our_config);
+	/* Minimum/maximum configuration values we'll accept */
+	towire_u32(&p, max_to_self_delay);
+	towire_u64(&p, min_effective_htlc_capacity_msat);
+	towire_crypto_state(&p, crypto_state);
+	towire_u64(&p, gossip_index);
+	/* Seed to generate all the keys from */
+	towire_privkey(&p, seed);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_opening_funder(const tal_t *ctx, u64 funding_satoshis, u64 push_msat, u32 feerate_per_kw, u32 max_minimum_depth, u64 change_satoshis, u32 change_keyindex, u8 channel_flags, const struct utxo *inputs, const struct ext_key *bip32)
+{
+	u16 num_inputs = tal_count(inputs);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_OPENING_FUNDER);
+	towire_u64(&p, funding_satoshis);
+	towire_u64(&p, push_msat);
+	towire_u32(&p, feerate_per_kw);
+	towire_u32(&p, max_minimum_depth);
+	towire_u64(&p, change_satoshis);
+	towire_u32(&p, change_keyindex);
+	towire_u8(&p, channel_flags);
+	towire_u16(&p, num_inputs);
+	for (size_t i = 0; i < num_inputs; i++)
+
+		towire_utxo(&p, inputs + i);
+	towire_ext_key(&p, bip32);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_opening_funder_reply(const tal_t *ctx, const struct channel_config *their_config, const struct bitcoin_tx *first_commit, const secp256k1_ecdsa_signature *first_commit_sig, const struct crypto_state *crypto_state, u64 gossip_index, const struct pubkey *revocation_basepoint, const struct pubkey *payment_basepoint, const struct pubkey *htlc_basepoint, const struct pubkey *delayed_payment_basepoint, const struct pubkey *their_per_commit_point, u32 minimum_depth, const struct pubkey *remote_fundingkey, const struct bitcoin_txid *funding_txid, u32 feerate_per_kw)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_OPENING_FUNDER_REPLY);
+	towire_channel_config(&p, their_config);
+	towire_bitcoin_tx(&p, first_commit);
+	towire_secp256k1_ecdsa_signature(&p, first_commit_sig);
+	towire_crypto_state(&p, crypto_state);
+	towire_u64(&p, gossip_index);
+	towire_pubkey(&p, revocation_basepoint);
+	towire_pubkey(&p, payment_basepoint);
+	towire_pubkey(&p, htlc_basepoint);
+	towire_pubkey(&p, delayed_payment_basepoint);
+	towire_pubkey(&p, their_per_commit_point);
+	towire_u32(&p, minimum_depth);
+	towire_pubkey(&p, remote_fundingkey);
+	towire_bitcoin_txid(&p, funding_txid);
+	towire_u32(&p, feerate_per_kw);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_opening_fundee(const tal_t *ctx, u32 minimum_depth, u32 min_feerate, u32 max_feerate, const u8 *msg)
+{
+	u16 len = tal_count(msg);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_OPENING_FUNDEE);
+	towire_u32(&p, minimum_depth);
+	towire_u32(&p, min_feerate);
+	towire_u32(&p, max_feerate);
+	towire_u16(&p, len);
+	towire_u8_array(&p, msg, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_opening_fundee_reply(const tal_t *ctx, const struct channel_config *their_config, const struct bitcoin_tx *first_commit, const secp256k1_ecdsa_signature *first_commit_sig, const struct crypto_state *crypto_state, u64 gossip_index, const struct pubkey *revocation_basepoint, const struct pubkey *payment_basepoint, const struct pubkey *htlc_basepoint, const struct pubkey *delayed_payment_basepoint, const struct pubkey *their_per_commit_point, const struct pubkey *remote_fundingkey, const struct bitcoin_txid *funding_txid, u16 funding_txout, u64 funding_satoshis, u64 push_msat, u8 channel_flags, u32 feerate_per_kw, const u8 *funding_signed_msg)
+{
+	u16 msglen = tal_count(funding_signed_msg);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_OPENING_FUNDEE_REPLY);
+	towire_channel_config(&p, their_config);
+	towire_bitcoin_tx(&p, first_commit);
+	towire_secp256k1_ecdsa_signature(&p, first_commit_sig);
+	towire_crypto_state(&p, crypto_state);
+	towire_u64(&p, gossip_index);
+	towire_pubkey(&p, revocation_basepoint);
+	towire_pubkey(&p, payment_basepoint);
+	towire_pubkey(&p, htlc_basepoint);
+	towire_pubkey(&p, delayed_payment_basepoint);
+	towire_pubkey(&p, their_per_commit_point);
+	towire_pubkey(&p, remote_fundingkey);
+	towire_bitcoin_txid(&p, funding_txid);
+	towire_u16(&p, funding_txout);
+	towire_u64(&p, funding_satoshis);
+	towire_u64(&p, push_msat);
+	towire_u8(&p, channel_flags);
+	towire_u32(&p, feerate_per_kw);
+	/* The (encrypted) funding signed message: send this and we're committed. */
+	towire_u16(&p, msglen);
+	towire_u8_array(&p, funding_signed_msg, msglen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_opening_negotiation_failed(const tal_t *ctx, const struct crypto_state *crypto_state, u64 gossip_index, const u8 *msg)
+{
+	u16 len = tal_count(msg);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_OPENING_NEGOTIATION_FAILED);
+	towire_crypto_state(&p, crypto_state);
+	towire_u64(&p, gossip_index);
+	towire_u16(&p, len);
+	/* FIXME: string support! */
+	towire_u8_array(&p, msg, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+
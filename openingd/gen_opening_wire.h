@@ -0,0 +1,57 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#ifndef LIGHTNING_OPENINGD_GEN_OPENING_WIRE_H
+#define LIGHTNING_OPENINGD_GEN_OPENING_WIRE_H
+#include <ccan/tal/tal.h>
+#include <wire/wire.h>
+#include <common/cryptomsg.h>
+
+#include <common/channel_config.h>
+
+#include <common/bip32.h>
+
+#include <common/htlc_wire.h>
+
+#include <common/utxo.h>
+
+enum opening_wire_type {
+	WIRE_OPENING_INIT = 6000,
+	/* This means we offer the open. */
+	WIRE_OPENING_FUNDER = 6001,
+	/* This gives their sig, means we can broadcast tx: we're done. */
+	WIRE_OPENING_FUNDER_REPLY = 6101,
+	/* This means they offer the open (contains their offer packet) */
+	WIRE_OPENING_FUNDEE = 6003,
+	/* This gives their txid and info, means we can send funding_signed: we're done. */
+	WIRE_OPENING_FUNDEE_REPLY = 6103,
+	/* We disagreed with opening parameters, but peer is ok for gossip (+ peerfd) */
+	WIRE_OPENING_NEGOTIATION_FAILED = 6010,
+};
+const char *opening_wire_type_name(int e);
+
+bool fromwire_opening_init(const void *p, size_t *plen, u32 *network_index, struct channel_config *our_config, u32 *max_to_self_delay, u64 *min_effective_htlc_capacity_msat, struct crypto_state *crypto_state, u64 *gossip_index, struct privkey *seed);
+
+bool fromwire_opening_funder(const tal_t *ctx, const void *p, size_t *plen, u64 *funding_satoshis, u64 *push_msat, u32 *feerate_per_kw, u32 *max_minimum_depth, u64 *change_satoshis, u32 *change_keyindex, u8 *channel_flags, struct utxo **inputs, struct ext_key *bip32);
+
+bool fromwire_opening_funder_reply(const void *p, size_t *plen, struct channel_config *their_config, struct bitcoin_tx *first_commit, secp256k1_ecdsa_signature *first_commit_sig, struct crypto_state *crypto_state, u64 *gossip_index, struct pubkey *revocation_basepoint, struct pubkey *payment_basepoint, struct pubkey *htlc_basepoint, struct pubkey *delayed_payment_basepoint, struct pubkey *their_per_commit_point, u32 *minimum_depth, struct pubkey *remote_fundingkey, struct bitcoin_txid *funding_txid, u32 *feerate_per_kw);
+
+bool fromwire_opening_fundee(const tal_t *ctx, const void *p, size_t *plen, u32 *minimum_depth, u32 *min_feerate, u32 *max_feerate, u8 **msg);
+
+bool fromwire_opening_fundee_reply(const tal_t *ctx, const void *p, size_t *plen, struct channel_config *their_config, struct bitcoin_tx *first_commit, secp256k1_ecdsa_signature *first_commit_sig, struct crypto_state *crypto_state, u64 *gossip_index, struct pubkey *revocation_basepoint, struct pubkey *payment_basepoint, struct pubkey *htlc_basepoint, struct pubkey *delayed_payment_basepoint, struct pubkey *their_per_commit_point, struct pubkey *remote_fundingkey, struct bitcoin_txid *funding_txid, u16 *funding_txout, u64 *funding_satoshis, u64 *push_msat, u8 *channel_flags, u32 *feerate_per_kw, u8 **funding_signed_msg);
+
+bool fromwire_opening_negotiation_failed(const tal_t *ctx, const void *p, size_t *plen, struct crypto_state *crypto_state, u64 *gossip_index, u8 **msg);
+
+u8 *towire_opening_init(const tal_t *ctx, u32 network_index, const struct channel_config *our_config, u32 max_to_self_delay, u64 min_effective_htlc_capacity_msat, const struct crypto_state *crypto_state, u64 gossip_index, const struct privkey *seed);
+
+u8 *towire_opening_funder(const tal_t *ctx, u64 funding_satoshis, u64 push_msat, u32 feerate_per_kw, u32 max_minimum_depth, u64 change_satoshis, u32 change_keyindex, u8 channel_flags, const struct utxo *inputs, const struct ext_key *bip32);
+
+u8 *towire_opening_funder_reply(const tal_t *ctx, const struct channel_config *their_config, const struct bitcoin_tx *first_commit, const secp256k1_ecdsa_signature *first_commit_sig, const struct crypto_state *crypto_state, u64 gossip_index, const struct pubkey *revocation_basepoint, const struct pubkey *payment_basepoint, const struct pubkey *htlc_basepoint, const struct pubkey *delayed_payment_basepoint, const struct pubkey *their_per_commit_point, u32 minimum_depth, const struct pubkey *remote_fundingkey, const struct bitcoin_txid *funding_txid, u32 feerate_per_kw);
+
+u8 *towire_opening_fundee(const tal_t *ctx, u32 minimum_depth, u32 min_feerate, u32 max_feerate, const u8 *msg);
+
+u8 *towire_opening_fundee_reply(const tal_t *ctx, const struct channel_config *their_config, const struct bitcoin_tx *first_commit, const secp256k1_ecdsa_signature *first_commit_sig, const struct crypto_state *crypto_state, u64 gossip_index, const struct pubkey *revocation_basepoint, const struct pubkey *payment_basepoint, const struct pubkey *htlc_basepoint, const struct pubkey *delayed_payment_basepoint, const struct pubkey *their_per_commit_point, const struct pubkey *remote_fundingkey, const struct bitcoin_txid *funding_txid, u16 funding_txout, u64 funding_satoshis, u64 push_msat, u8 channel_flags, u32 feerate_per_kw, const u8 *funding_signed_msg);
+
+u8 *towire_opening_negotiation_failed(const tal_t *ctx, const struct crypto_state *crypto_state, u64 gossip_index, const u8 *msg);
+
+#endif /* LIGHTNING_OPENINGD_GEN_OPENING_WIRE_H */
+
@@ -366,6 +366,21 @@ class LightningDTests(BaseLightningDTests):
         assert l2.rpc.listinvoice('test_pay')[0]['complete'] == False
         assert l2.rpc.listinvoice('test_pay')[0]['expiry_time'] < time.time()
 
+        # Expiry times have to fit in 32 bits.
+        self.assertRaises(ValueError, l2.rpc.invoice, 123000, 'test_pay2', 'description', 2**32)
+
+    def test_autocleaninvoice(self):
+        l1 = self.node_factory.get_node(options=['--autocleaninvoice-cycle=1',
+                                                 '--autocleaninvoice-expired-by=1'])
+
+        l1.rpc.invoice(1000, 'short', 'desc', 1)
+        l1.rpc.invoice(1000, 'long', 'desc', 3600)
+
+        # Once expired for long enough, it goes away; the other stays.
+        wait_for(lambda: l1.rpc.listinvoice('short') == [])
+        assert len(l1.rpc.listinvoice('long')) == 1
+        l1.daemon.wait_for_log('autocleaninvoice: deleted 1 expired invoices')
+
     def test_connect(self):
         l1,l2 = self.connect()
 
@@ -1502,6 +1517,49 @@ class LightningDTests(BaseLightningDTests):
         # channeld pinging
         self.ping_tests(l1, l2)
 
+    def test_gossip_listing_pages(self):
+        l1 = self.node_factory.get_node()
+        l2 = self.node_factory.get_node()
+        l3 = self.node_factory.get_node()
+
+        l1.rpc.connect(l2.info['id'], 'localhost', l2.info['port'])
+        l2.rpc.connect(l3.info['id'], 'localhost', l3.info['port'])
+
+        scid1 = self.fund_channel(l1, l2, 10**6)
+        scid2 = self.fund_channel(l2, l3, 10**6)
+
+        l1.bitcoin.rpc.generate(6)
+        wait_for(lambda: len(l1.rpc.getchannels()['channels']) == 4)
+        wait_for(lambda: len(l1.rpc.getnodes()['nodes']) == 3)
+
+        # limit counts channels: we get both directions of one.
+        page = l1.rpc.getchannels(limit=1)
+        assert len(page['channels']) == 2
+        first = page['channels'][0]['short_channel_id']
+        assert page['channels'][1]['short_channel_id'] == first
+        assert page['next'] != first
+        rest = l1.rpc.getchannels(first=page['next'])
+        assert 'next' not in rest
+        assert len(rest['channels']) == 2
+        assert set([first, page['next']]) == set([scid1, scid2])
+
+        # Filters.
+        chans = l1.rpc.getchannels(source=l2.info['id'])['channels']
+        assert set([c['destination'] for c in chans]) == set([l1.info['id'], l3.info['id']])
+        chans = l1.rpc.getchannels(first=scid2, last=scid2)['channels']
+        assert [c['short_channel_id'] for c in chans] == [scid2, scid2]
+
+        # Nodes come in id order, and next is where the following page starts.
+        page = l1.rpc.getnodes(limit=2)
+        assert len(page['nodes']) == 2
+        nodes = [n['nodeid'] for n in page['nodes']]
+        rest = l1.rpc.getnodes(first=page['next'])
+        assert 'next' not in rest
+        assert [n['nodeid'] for n in rest['nodes']] == [page['next']]
+        nodes += [page['next']]
+        assert nodes == sorted([l1.info['id'], l2.info['id'], l3.info['id']])
+        assert [n['nodeid'] for n in l1.rpc.getnodes(id=l3.info['id'])['nodes']] == [l3.info['id']]
+
     @unittest.skipIf(not DEVELOPER, "needs DEVELOPER=1")
     def test_routing_gossip_reconnect(self):
         # Connect two peers, reconnect and then see if we resume the
@@ -2819,6 +2877,74 @@ class LightningDTests(BaseLightningDTests):
         l1.daemon.wait_for_log('onchaind complete, forgetting peer')
         l2.daemon.wait_for_log('onchaind complete, forgetting peer')
 
+    def test_blockchain_catchup(self):
+        l1 = self.node_factory.get_node()
+
+        # Catch up many blocks at once, so the prefetch window opens up.
+        l1.stop()
+        l1.bitcoin.generate_block(40)
+        l1.daemon.start()
+        sync_blockheight([l1])
+
+        # Replace the last 5 blocks with a longer fork: the prefetched
+        # blocks don't connect, so we must back up and refetch.
+        height = l1.bitcoin.rpc.getblockcount()
+        l1.bitcoin.rpc.invalidateblock(l1.bitcoin.rpc.getblockhash(height - 4))
+        l1.bitcoin.generate_block(10)
+        sync_blockheight([l1])
+        assert l1.rpc.getinfo()['blockheight'] == height + 5
+
+    def test_block_retention(self):
+        l1 = self.node_factory.get_node(options=['--block-retention=5'])
+
+        # We forget old block ids as we go, but can still follow a
+        # reorg shallower than that.
+        l1.bitcoin.generate_block(30)
+        sync_blockheight([l1])
+        height = l1.bitcoin.rpc.getblockcount()
+        l1.bitcoin.rpc.invalidateblock(l1.bitcoin.rpc.getblockhash(height - 3))
+        l1.bitcoin.generate_block(6)
+        sync_blockheight([l1])
+        assert l1.rpc.getinfo()['blockheight'] == height + 2
+
+    def test_db_durability(self):
+        l1 = self.node_factory.get_node(options=['--db-durability=wal'])
+        l2 = self.node_factory.get_node(options=['--db-durability=wal-full'])
+        l3 = self.node_factory.get_node()
+
+        for n in [l1, l2]:
+            assert os.path.exists(os.path.join(n.daemon.lightning_dir,
+                                               'lightningd.sqlite3-wal'))
+        assert not os.path.exists(os.path.join(l3.daemon.lightning_dir,
+                                               'lightningd.sqlite3-wal'))
+
+        # Writes still land, others can read them, and they survive.
+        for n in [l1, l2, l3]:
+            n.rpc.invoice(1000, 'durable', 'desc')
+            assert len(n.db_query("SELECT * FROM invoices WHERE label='durable';")) == 1
+            n.restart()
+            assert n.rpc.listinvoices('durable')['invoices'][0]['label'] == 'durable'
+
+    def test_bitcoind_rpc_backend(self):
+        # l1 talks JSON-RPC to bitcoind directly, l2 uses bitcoin-cli.
+        l1 = self.node_factory.get_node(options=[
+            '--bitcoin-rpcconnect=127.0.0.1',
+            '--bitcoin-rpcport={}'.format(self.node_factory.bitcoind.rpcport),
+            '--bitcoin-rpcuser={}'.format(utils.BITCOIND_CONFIG['rpcuser']),
+            '--bitcoin-rpcpassword={}'.format(utils.BITCOIND_CONFIG['rpcpassword']),
+            '--bitcoin-rpcconnections=2'])
+        l2 = self.node_factory.get_node()
+
+        l1.bitcoin.generate_block(10)
+        sync_blockheight([l1, l2])
+
+        # Funding needs sendrawtransaction, gossip needs gettxout.
+        l1.rpc.connect(l2.info['id'], 'localhost', l2.info['port'])
+        self.fund_channel(l1, l2, 10**6)
+        l1.bitcoin.generate_block(6)
+        wait_for(lambda: len(l1.rpc.getchannels()['channels']) == 2)
+        assert not l1.daemon.is_in_log('exited with status')
+
     @unittest.skipIf(not DEVELOPER, "needs DEVELOPER=1")
     def test_fee_limits(self):
         # FIXME: Test case where opening denied.
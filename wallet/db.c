@@ -1,7 +1,12 @@
 #include "db.h"
 
+#include <ccan/array_size/array_size.h>
+#include <ccan/crypto/siphash24/siphash24.h>
+#include <ccan/htable/htable_type.h>
 #include <ccan/tal/str/str.h>
 #include <ccan/tal/tal.h>
+#include <common/memleak.h>
+#include <common/pseudorand.h>
 #include <inttypes.h>
 #include <lightningd/lightningd.h>
 #include <lightningd/log.h>
@@ -177,24 +182,86 @@ char *dbmigrations[] = {
     "ALTER TABLE payments ADD COLUMN payment_preimage BLOB;",
     /* We need to keep the shared secrets to decode error returns. */
     "ALTER TABLE payments ADD COLUMN path_secrets BLOB;",
+    /* We load unpaid invoices at startup, and delete expired ones. */
+    "CREATE INDEX invoices_state_expiry ON invoices(state, expiry_time);",
     NULL,
 };
 
+/* A statement db_prepare compiled, which we keep to hand out again. */
+struct db_stmt {
+	const char *query;
+	sqlite3_stmt *stmt;
+	/* Handed out, and not yet given back to db_stmt_done? */
+	bool in_use;
+};
+
+static const char *db_stmt_keyof(const struct db_stmt *s)
+{
+	return s->query;
+}
+
+static size_t db_stmt_hash(const char *query)
+{
+	return siphash24(siphash_seed(), query, strlen(query));
+}
+
+static bool db_stmt_eq(const struct db_stmt *s, const char *query)
+{
+	return streq(s->query, query);
+}
+HTABLE_DEFINE_TYPE(struct db_stmt, db_stmt_keyof, db_stmt_hash, db_stmt_eq,
+		   db_stmt_map);
+
 sqlite3_stmt *db_prepare_(const char *caller, struct db *db, const char *query)
 {
 	int err;
 	sqlite3_stmt *stmt;
+	struct db_stmt *s;
 
 	assert(db->in_transaction);
 
+	s = db_stmt_map_get(db->stmts, query);
+	if (s && !s->in_use) {
+		db->stmt_hits++;
+		s->in_use = true;
+		return s->stmt;
+	}
+
+	db->stmt_misses++;
 	err = sqlite3_prepare_v2(db->sql, query, -1, &stmt, NULL);
 
 	if (err != SQLITE_OK)
 		fatal("%s: %s: %s", caller, query, sqlite3_errmsg(db->sql));
 
+	/* db_stmt_done finds it again by its SQL, so that must match.  If
+	 * it's already in use (same query nested), this one is a one-off. */
+	if (!s && streq(sqlite3_sql(stmt), query)) {
+		/* Only the hash table points to it. */
+		s = notleak_with_children(tal(db->stmts, struct db_stmt));
+		s->query = tal_strdup(s, query);
+		s->stmt = stmt;
+		s->in_use = true;
+		db_stmt_map_add(db->stmts, s);
+	}
 	return stmt;
 }
 
+void db_stmt_done(struct db *db, sqlite3_stmt *stmt)
+{
+	struct db_stmt *s;
+
+	if (!stmt)
+		return;
+
+	s = db_stmt_map_get(db->stmts, sqlite3_sql(stmt));
+	if (s && s->stmt == stmt) {
+		sqlite3_reset(stmt);
+		sqlite3_clear_bindings(stmt);
+		s->in_use = false;
+	} else
+		sqlite3_finalize(stmt);
+}
+
 void db_exec_prepared_(const char *caller, struct db *db, sqlite3_stmt *stmt)
 {
 	assert(db->in_transaction);
@@ -202,7 +269,7 @@ void db_exec_prepared_(const char *caller, struct db *db, sqlite3_stmt *stmt)
 	if (sqlite3_step(stmt) !=  SQLITE_DONE)
 		fatal("%s: %s", caller, sqlite3_errmsg(db->sql));
 
-	sqlite3_finalize(stmt);
+	db_stmt_done(db, stmt);
 }
 
 /* This one doesn't check if we're in a transaction. */
@@ -243,10 +310,10 @@ bool db_exec_prepared_mayfail_(const char *caller, struct db *db, sqlite3_stmt *
 		goto fail;
 	}
 
-	sqlite3_finalize(stmt);
+	db_stmt_done(db, stmt);
 	return true;
 fail:
-	sqlite3_finalize(stmt);
+	db_stmt_done(db, stmt);
 	return false;
 }
 
@@ -269,24 +336,129 @@ sqlite3_stmt *PRINTF_FMT(3, 4)
 	return stmt;
 }
 
-static void close_db(struct db *db) { sqlite3_close(db->sql); }
+static void close_db(struct db *db)
+{
+	struct db_stmt_map_iter it;
+	struct db_stmt *s;
+
+	/* Don't lose a group commit we were still holding open. */
+	if (db->commit_pending)
+		db_flush(db);
+
+	/* sqlite3_close refuses while any statement is still around. */
+	for (s = db_stmt_map_first(db->stmts, &it);
+	     s;
+	     s = db_stmt_map_next(db->stmts, &it))
+		sqlite3_finalize(s->stmt);
+	db_stmt_map_clear(db->stmts);
+	sqlite3_close(db->sql);
+}
 
 void db_begin_transaction_(struct db *db, const char *location)
 {
 	if (db->in_transaction)
 		fatal("Already in transaction from %s", db->in_transaction);
 
-	db_do_exec(location, db, "BEGIN TRANSACTION;");
+	/* Joining the group db_flush will commit? */
+	if (!db->commit_pending)
+		db_do_exec(location, db, "BEGIN TRANSACTION;");
 	db->in_transaction = location;
 }
 
 void db_commit_transaction(struct db *db)
 {
 	assert(db->in_transaction);
-	db_exec(__func__, db, "COMMIT;");
+	if (db->group_commit)
+		db->commit_pending = true;
+	else
+		db_exec(__func__, db, "COMMIT;");
 	db->in_transaction = NULL;
 }
 
+void db_flush(struct db *db)
+{
+	assert(!db->in_transaction);
+	if (!db->commit_pending)
+		return;
+
+	db_do_exec(__func__, db, "COMMIT;");
+	db->commit_pending = false;
+}
+
+static const char *durability_names[] = {
+	[DB_DURABILITY_LEGACY] = "legacy",
+	[DB_DURABILITY_WAL] = "wal",
+	[DB_DURABILITY_WAL_FULL] = "wal-full",
+};
+
+const char *db_durability_name(enum db_durability durability)
+{
+	return durability_names[durability];
+}
+
+bool db_durability_from_name(const char *name, enum db_durability *durability)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(durability_names); i++) {
+		if (streq(name, durability_names[i])) {
+			*durability = i;
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Called after each commit in WAL mode; replaces sqlite's own
+ * autocheckpoint, which would do it right there in the commit. */
+static int db_wal_hook(void *arg, sqlite3 *sql, const char *dbname, int pages)
+{
+	struct db *db = arg;
+
+	db->wal_pages = pages;
+	return SQLITE_OK;
+}
+
+void db_set_durability(struct db *db, enum db_durability durability)
+{
+	bool wal = (durability != DB_DURABILITY_LEGACY);
+	sqlite3_stmt *stmt;
+	const char *mode;
+
+	assert(!db->in_transaction);
+
+	/* This one answers with the mode it ended up in. */
+	if (sqlite3_prepare_v2(db->sql,
+			       wal ? "PRAGMA journal_mode=WAL;"
+			       : "PRAGMA journal_mode=DELETE;",
+			       -1, &stmt, NULL) != SQLITE_OK
+	    || sqlite3_step(stmt) != SQLITE_ROW)
+		fatal("%s: %s", __func__, sqlite3_errmsg(db->sql));
+	mode = (const char *)sqlite3_column_text(stmt, 0);
+	if (!streq(mode, wal ? "wal" : "delete"))
+		fatal("Could not set %s journal mode: still %s",
+		      wal ? "wal" : "delete", mode);
+	sqlite3_finalize(stmt);
+
+	if (durability == DB_DURABILITY_WAL)
+		db_do_exec(__func__, db, "PRAGMA synchronous=NORMAL;");
+	else
+		db_do_exec(__func__, db, "PRAGMA synchronous=FULL;");
+
+	db->wal_pages = 0;
+	if (wal)
+		sqlite3_wal_hook(db->sql, db_wal_hook, db);
+	else
+		sqlite3_wal_hook(db->sql, NULL, NULL);
+}
+
+void db_checkpoint(struct db *db)
+{
+	assert(!db->in_transaction);
+
+	if (sqlite3_wal_checkpoint_v2(db->sql, NULL, SQLITE_CHECKPOINT_PASSIVE,
+				      NULL, NULL) == SQLITE_OK)
+		db->wal_pages = 0;
+}
+
 /**
  * db_open - Open or create a sqlite3 database
  */
@@ -311,8 +483,13 @@ static struct db *db_open(const tal_t *ctx, char *filename)
 	db = tal(ctx, struct db);
 	db->filename = tal_dup_arr(db, char, filename, strlen(filename), 0);
 	db->sql = sql;
+	db->stmts = tal(db, struct db_stmt_map);
+	db_stmt_map_init(db->stmts);
+	db->stmt_hits = db->stmt_misses = 0;
 	tal_add_destructor(db, close_db);
 	db->in_transaction = NULL;
+	db->group_commit = db->commit_pending = false;
+	db->wal_pages = 0;
 	db_do_exec(__func__, db, "PRAGMA foreign_keys = ON;");
 
 	return db;
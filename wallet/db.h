@@ -14,11 +14,35 @@
 #include <stdbool.h>
 
 struct log;
+struct db_stmt_map;
+
+/* How hard we try to get commits to disk: see db_set_durability. */
+enum db_durability {
+	/* Rollback journal, synchronous=FULL: what sqlite does by default. */
+	DB_DURABILITY_LEGACY,
+	/* WAL, synchronous=NORMAL: a power loss can lose the last commits. */
+	DB_DURABILITY_WAL,
+	/* WAL, synchronous=FULL: as safe as legacy, with fewer fsyncs. */
+	DB_DURABILITY_WAL_FULL,
+};
 
 struct db {
 	char *filename;
 	const char *in_transaction;
 	sqlite3 *sql;
+
+	/* Leave committed transactions open for db_flush to commit together */
+	bool group_commit;
+	/* Is there an SQL transaction open which db_flush must commit? */
+	bool commit_pending;
+
+	/* Statements db_prepare compiled, kept to hand out again. */
+	struct db_stmt_map *stmts;
+	/* How often db_prepare found its statement already compiled, or not */
+	u64 stmt_hits, stmt_misses;
+
+	/* In WAL mode, pages in the log which db_checkpoint hasn't done. */
+	size_t wal_pages;
 };
 
 /**
@@ -53,10 +77,41 @@ void db_begin_transaction_(struct db *db, const char *location);
  * db_commit_transaction - Commit a running transaction
  *
  * Requires that we are currently in a transaction.  fatal() if we
- * fail to commit.
+ * fail to commit.  If @db->group_commit is set, the commit is only
+ * done on the next `db_flush`, together with any transactions after
+ * this one.
  */
 void db_commit_transaction(struct db *db);
 
+/**
+ * db_flush - Commit any transactions group_commit left open
+ *
+ * Requires that we are not in a transaction.  fatal() if we fail to
+ * commit.
+ */
+void db_flush(struct db *db);
+
+/**
+ * db_set_durability - Set the journal mode and sync level
+ *
+ * Requires that we are not in a transaction.  In the WAL modes sqlite
+ * doesn't checkpoint by itself: the caller should call `db_checkpoint`
+ * when it's idle or `wal_pages` grows.  fatal() on database error.
+ */
+void db_set_durability(struct db *db, enum db_durability durability);
+
+/* Name for --db-durability, and back; returns false if unknown. */
+const char *db_durability_name(enum db_durability durability);
+bool db_durability_from_name(const char *name, enum db_durability *durability);
+
+/**
+ * db_checkpoint - Copy the WAL back into the database, if we can
+ *
+ * Requires that we are not in a transaction.  Doesn't wait for anything:
+ * if it can't finish, `wal_pages` stays set and we can try again later.
+ */
+void db_checkpoint(struct db *db);
+
 /**
  * db_set_intvar - Set an integer variable in the database
  *
@@ -82,6 +137,10 @@ s64 db_get_intvar(struct db *db, char *varname, s64 defval);
  * statement, `NULL` otherwise. On failure `db->err` will be set with
  * the human readable error.
  *
+ * Statements are remembered by their query, so the next db_prepare of
+ * the same query reuses the compiled statement: give it back with
+ * `db_stmt_done` (or `db_exec_prepared`), never `sqlite3_finalize`.
+ *
  * @db: Database to query/exec
  * @query: The SQL statement to compile
  */
@@ -95,8 +154,8 @@ sqlite3_stmt *db_prepare_(const char *caller, struct db *db, const char *query);
  * all non-null variables using the `sqlite3_bind_*` functions, it can
  * be executed with this function. It is a small, transaction-aware,
  * wrapper around `sqlite3_step`, that calls fatal() if the execution
- * fails. This will take ownership of `stmt` and will free
- * it before returning.
+ * fails. This will take ownership of `stmt` and will hand
+ * it to `db_stmt_done` before returning.
  *
  * @db: The database to execute on
  * @stmt: The prepared statement to execute
@@ -113,6 +172,17 @@ bool db_exec_prepared_mayfail_(const char *caller,
 			       struct db *db,
 			       sqlite3_stmt *stmt);
 
+/**
+ * db_stmt_done -- We're finished with a statement
+ *
+ * Resets and clears a statement from `db_prepare` so it can be handed
+ * out again, or finalizes it if it's a one-off (eg. from `db_query`).
+ *
+ * @db: The database the statement was prepared on
+ * @stmt: The statement (may be NULL)
+ */
+void db_stmt_done(struct db *db, sqlite3_stmt *stmt);
+
 bool sqlite3_bind_short_channel_id(sqlite3_stmt *stmt, int col,
 				   const struct short_channel_id *id);
 bool sqlite3_column_short_channel_id(sqlite3_stmt *stmt, int col,
@@ -2,6 +2,9 @@
 #include "invoices.h"
 #include "wallet.h"
 #include <assert.h>
+#include <ccan/crypto/siphash24/siphash24.h>
+#include <ccan/htable/htable_type.h>
+#include <ccan/intmap/intmap.h>
 #include <ccan/list/list.h>
 #include <ccan/structeq/structeq.h>
 #include <ccan/tal/str/str.h>
@@ -10,6 +13,7 @@
 #include <lightningd/log.h>
 #include <sodium/randombytes.h>
 #include <sqlite3.h>
+#include <common/pseudorand.h>
 #include <common/utils.h>
 
 struct invoice_waiter {
@@ -19,22 +23,78 @@ struct invoice_waiter {
 	void *cbarg;
 };
 
+static const char *invoice_label(const struct invoice *i)
+{
+	return i->label;
+}
+
+static size_t label_hash(const char *label)
+{
+	return siphash24(siphash_seed(), label, strlen(label));
+}
+
+static bool invoice_label_eq(const struct invoice *i, const char *label)
+{
+	return streq(i->label, label);
+}
+HTABLE_DEFINE_TYPE(struct invoice, invoice_label, label_hash, invoice_label_eq,
+		   invoice_label_map);
+
+static const struct sha256 *invoice_rhash(const struct invoice *i)
+{
+	return &i->rhash;
+}
+
+static size_t rhash_hash(const struct sha256 *rhash)
+{
+	return siphash24(siphash_seed(), rhash, sizeof(*rhash));
+}
+
+static bool invoice_rhash_eq(const struct invoice *i, const struct sha256 *rhash)
+{
+	return structeq(&i->rhash, rhash);
+}
+HTABLE_DEFINE_TYPE(struct invoice, invoice_rhash, rhash_hash, invoice_rhash_eq,
+		   invoice_rhash_map);
+
+/* How many paid or expired invoices we keep in memory once looked up. */
+#define INVOICE_CACHE_MAX 128
+
+/* What wallet_stmt2invoice wants, in order. */
+#define INVOICE_COLUMNS \
+	"id, state, payment_key, payment_hash, label, msatoshi, expiry_time" \
+	", pay_index, msatoshi_received"
+
 struct invoices {
 	/* The database connection to use. */
 	struct db *db;
 	/* The log to report to. */
 	struct log *log;
-	/* The invoice list. */
-	struct list_head invlist;
+	/* Unpaid invoices, which we always keep in memory. */
+	struct list_head resident;
+	/* Others we've looked up lately, most recent first. */
+	struct list_head cache;
+	size_t cache_count;
+	/* All the above, by label and by payment_hash. */
+	struct invoice_label_map by_label;
+	struct invoice_rhash_map by_rhash;
+	/* The resident invoices, by expiry_key() */
+	UINTMAP(struct invoice *) unpaid_by_expiry;
 	/* Waiters waiting for any new invoice to be paid. */
 	struct list_head waitany_waiters;
 };
 
-static void trigger_invoice_waiter(struct invoice_waiter *w,
-				   struct invoice *invoice)
+/* Orders by expiry_time; the low bits of the (unique) id tell apart
+ * invoices which expire in the same second.  We don't create invoices
+ * expiring after 2106, but an older db might have them: they just sort
+ * last, rather than wrapping around. */
+static u64 expiry_key(const struct invoice *i)
 {
-	w->triggered = true;
-	w->cb(invoice, w->cbarg);
+	u64 expiry_time = i->expiry_time;
+
+	if (expiry_time > UINT32_MAX)
+		expiry_time = UINT32_MAX;
+	return (expiry_time << 32) | (u32)i->id;
 }
 
 static bool wallet_stmt2invoice(sqlite3_stmt *stmt, struct invoice *inv)
@@ -68,6 +128,98 @@ static bool wallet_stmt2invoice(sqlite3_stmt *stmt, struct invoice *inv)
 	return true;
 }
 
+static bool invoice_expired(const struct invoice *i, u64 now)
+{
+	return now > i->expiry_time;
+}
+
+static void make_resident(struct invoices *invoices, struct invoice *i)
+{
+	i->cached = false;
+	list_add_tail(&invoices->resident, &i->list);
+	if (!uintmap_add(&invoices->unpaid_by_expiry, expiry_key(i), i))
+		abort();
+}
+
+/* Drop it from memory (but not the database). */
+static void forget_invoice(struct invoices *invoices, struct invoice *i)
+{
+	/* Nobody's told about it going, so nobody can be waiting. */
+	assert(list_empty(&i->waitone_waiters));
+
+	invoice_label_map_del(&invoices->by_label, i);
+	invoice_rhash_map_del(&invoices->by_rhash, i);
+	if (i->cached) {
+		list_del_from(&invoices->cache, &i->list);
+		invoices->cache_count--;
+	} else {
+		list_del_from(&invoices->resident, &i->list);
+		uintmap_del(&invoices->unpaid_by_expiry, expiry_key(i));
+	}
+	tal_free(i);
+}
+
+static void add_cached(struct invoices *invoices, struct invoice *i)
+{
+	i->cached = true;
+	list_add(&invoices->cache, &i->list);
+	invoices->cache_count++;
+
+	while (invoices->cache_count > INVOICE_CACHE_MAX)
+		forget_invoice(invoices, list_tail(&invoices->cache,
+						   struct invoice, list));
+}
+
+/* Move it to the front of the cache, if it's there. */
+static struct invoice *use_invoice(struct invoices *invoices,
+				   struct invoice *i)
+{
+	if (i && i->cached) {
+		list_del_from(&invoices->cache, &i->list);
+		list_add(&invoices->cache, &i->list);
+	}
+	return i;
+}
+
+/* Get the invoice for this row: from memory if we have it, otherwise
+ * loaded into the cache (or made resident, if it's still payable). */
+static struct invoice *invoice_from_row(struct invoices *invoices,
+					sqlite3_stmt *stmt)
+{
+	struct invoice *i;
+
+	assert(sqlite3_column_bytes(stmt, 3) == sizeof(struct sha256));
+	i = invoice_rhash_map_get(&invoices->by_rhash,
+				  sqlite3_column_blob(stmt, 3));
+	if (i)
+		return use_invoice(invoices, i);
+
+	i = tal(invoices, struct invoice);
+	wallet_stmt2invoice(stmt, i);
+	invoice_label_map_add(&invoices->by_label, i);
+	invoice_rhash_map_add(&invoices->by_rhash, i);
+	if (i->state == UNPAID
+	    && !invoice_expired(i, time_now().ts.tv_sec))
+		make_resident(invoices, i);
+	else
+		add_cached(invoices, i);
+	return i;
+}
+
+static void destroy_invoices(struct invoices *invoices)
+{
+	invoice_label_map_clear(&invoices->by_label);
+	invoice_rhash_map_clear(&invoices->by_rhash);
+	uintmap_clear(&invoices->unpaid_by_expiry);
+}
+
+static void trigger_invoice_waiter(struct invoice_waiter *w,
+				   struct invoice *invoice)
+{
+	w->triggered = true;
+	w->cb(invoice, w->cbarg);
+}
+
 struct invoices *invoices_new(const tal_t *ctx,
 			      struct db *db,
 			      struct log *log)
@@ -77,8 +229,14 @@ struct invoices *invoices_new(const tal_t *ctx,
 	invs->db = db;
 	invs->log = log;
 
-	list_head_init(&invs->invlist);
+	list_head_init(&invs->resident);
+	list_head_init(&invs->cache);
+	invs->cache_count = 0;
+	invoice_label_map_init(&invs->by_label);
+	invoice_rhash_map_init(&invs->by_rhash);
+	uintmap_init(&invs->unpaid_by_expiry);
 	list_head_init(&invs->waitany_waiters);
+	tal_add_destructor(invs, destroy_invoices);
 
 	return invs;
 }
@@ -90,33 +248,45 @@ bool invoices_load(struct invoices *invoices)
 	struct invoice *i;
 	sqlite3_stmt *stmt;
 
-	/* Load invoices from db. */
-	stmt = db_query(__func__, invoices->db,
-			"SELECT id, state, payment_key, payment_hash"
-			"     , label, msatoshi, expiry_time, pay_index"
-			"     , msatoshi_received"
-			"  FROM invoices;");
-	if (!stmt) {
-		log_broken(invoices->log, "Could not load invoices");
-		return false;
-	}
+	/* Only those which can still be paid: the rest we look up later. */
+	stmt = db_prepare(invoices->db,
+			  "SELECT " INVOICE_COLUMNS
+			  "  FROM invoices"
+			  " WHERE state=? AND expiry_time>=?;");
+	sqlite3_bind_int(stmt, 1, UNPAID);
+	sqlite3_bind_int64(stmt, 2, time_now().ts.tv_sec);
 
 	while (sqlite3_step(stmt) == SQLITE_ROW) {
 		i = tal(invoices, struct invoice);
 		if (!wallet_stmt2invoice(stmt, i)) {
 			log_broken(invoices->log, "Error deserializing invoice");
-			sqlite3_finalize(stmt);
+			db_stmt_done(invoices->db, stmt);
 			return false;
 		}
-		list_add_tail(&invoices->invlist, &i->list);
+		invoice_label_map_add(&invoices->by_label, i);
+		invoice_rhash_map_add(&invoices->by_rhash, i);
+		make_resident(invoices, i);
 		count++;
 	}
-	log_debug(invoices->log, "Loaded %d invoices from DB", count);
+	log_debug(invoices->log, "Loaded %d unpaid invoices from DB", count);
 
-	sqlite3_finalize(stmt);
+	db_stmt_done(invoices->db, stmt);
 	return true;
 }
 
+/* Expired invoices can't be paid, so needn't stay in memory, unless
+ * someone's waiting on one. */
+static void forget_expired(struct invoices *invoices, u64 now)
+{
+	const struct invoice *i, *next;
+
+	for (i = invoices_next_expired(invoices, now, NULL); i; i = next) {
+		next = invoices_next_expired(invoices, now, i);
+		if (list_empty(&i->waitone_waiters))
+			forget_invoice(invoices, (struct invoice *)i);
+	}
+}
+
 const struct invoice *invoices_create(struct invoices *invoices,
 				      u64 *msatoshi TAKES,
 				      const char *label TAKES,
@@ -126,7 +296,7 @@ const struct invoice *invoices_create(struct invoices *invoices,
 	struct invoice *invoice;
 	struct preimage r;
 	struct sha256 rhash;
-	u64 expiry_time;
+	u64 now, expiry_time;
 
 	if (invoices_find_by_label(invoices, label)) {
 		if (taken(msatoshi))
@@ -137,7 +307,12 @@ const struct invoice *invoices_create(struct invoices *invoices,
 	}
 
 	/* Compute expiration. */
-	expiry_time = time_now().ts.tv_sec + expiry;
+	now = time_now().ts.tv_sec;
+	expiry_time = now + expiry;
+
+	/* We're adding one, so make room. */
+	forget_expired(invoices, now);
+
 	/* Generate random secret preimage and hash. */
 	randombytes_buf(r.r, sizeof(r.r));
 	sha256(&rhash, r.r, sizeof(r.r));
@@ -177,7 +352,9 @@ const struct invoice *invoices_create(struct invoices *invoices,
 	list_head_init(&invoice->waitone_waiters);
 
 	/* Add to invoices object. */
-	list_add_tail(&invoices->invlist, &invoice->list);
+	invoice_label_map_add(&invoices->by_label, invoice);
+	invoice_rhash_map_add(&invoices->by_rhash, invoice);
+	make_resident(invoices, invoice);
 
 	return invoice;
 }
@@ -187,13 +364,21 @@ const struct invoice *invoices_find_by_label(struct invoices *invoices,
 					     const char *label)
 {
 	struct invoice *i;
+	sqlite3_stmt *stmt;
 
-	/* FIXME: Use something better than a linear scan. */
-	list_for_each(&invoices->invlist, i, list) {
-		if (streq(i->label, label))
-			return i;
-	}
-	return NULL;
+	i = invoice_label_map_get(&invoices->by_label, label);
+	if (i)
+		return use_invoice(invoices, i);
+
+	stmt = db_prepare(invoices->db,
+			  "SELECT " INVOICE_COLUMNS
+			  "  FROM invoices"
+			  " WHERE label=?;");
+	sqlite3_bind_text(stmt, 1, label, strlen(label), SQLITE_TRANSIENT);
+	if (sqlite3_step(stmt) == SQLITE_ROW)
+		i = invoice_from_row(invoices, stmt);
+	db_stmt_done(invoices->db, stmt);
+	return i;
 }
 
 const struct invoice *invoices_find_unpaid(struct invoices *invoices,
@@ -201,14 +386,31 @@ const struct invoice *invoices_find_unpaid(struct invoices *invoices,
 {
 	struct invoice *i;
 
-	list_for_each(&invoices->invlist, i, list) {
-		if (structeq(rhash, &i->rhash) && i->state == UNPAID) {
-			if (time_now().ts.tv_sec > i->expiry_time)
-				break;
-			return i;
-		}
-	}
-	return NULL;
+	/* Every unpaid invoice is in memory. */
+	i = invoice_rhash_map_get(&invoices->by_rhash, rhash);
+	if (!i || i->state != UNPAID)
+		return NULL;
+	if (invoice_expired(i, time_now().ts.tv_sec))
+		return NULL;
+	return i;
+}
+
+const struct invoice *invoices_next_expired(struct invoices *invoices,
+					    u64 now,
+					    const struct invoice *invoice)
+{
+	struct invoice *i;
+	u64 key;
+
+	if (invoice) {
+		key = expiry_key(invoice);
+		i = uintmap_after(&invoices->unpaid_by_expiry, &key);
+	} else
+		i = uintmap_first(&invoices->unpaid_by_expiry, &key);
+
+	if (!i || i->expiry_time >= now)
+		return NULL;
+	return i;
 }
 
 bool invoices_delete(struct invoices *invoices,
@@ -227,9 +429,6 @@ bool invoices_delete(struct invoices *invoices,
 	if (sqlite3_changes(invoices->db->sql) != 1)
 		return false;
 
-	/* Delete from invoices object. */
-	list_del_from(&invoices->invlist, &invoice->list);
-
 	/* Tell all the waiters about the fact that it was deleted. */
 	while ((w = list_pop(&invoice->waitone_waiters,
 			     struct invoice_waiter,
@@ -241,17 +440,67 @@ bool invoices_delete(struct invoices *invoices,
 
 	/* Free all watchers and the invoice. */
 	tal_free(tmpctx);
-	tal_free(invoice);
+	forget_invoice(invoices, invoice);
 	return true;
 }
 
+size_t invoices_delete_expired(struct invoices *invoices, u64 expired_before)
+{
+	sqlite3_stmt *stmt;
+	struct invoice_waiter *w;
+	const struct invoice *i, *next;
+	struct invoice *c, *cnext;
+	const tal_t *tmpctx = tal_tmpctx(NULL);
+
+	/* Tell anyone waiting on one that it's gone. */
+	for (i = invoices_next_expired(invoices, expired_before, NULL);
+	     i;
+	     i = next) {
+		struct invoice *invoice = (struct invoice *)i;
+
+		next = invoices_next_expired(invoices, expired_before, i);
+		while ((w = list_pop(&invoice->waitone_waiters,
+				     struct invoice_waiter,
+				     list)) != NULL) {
+			tal_steal(tmpctx, w);
+			trigger_invoice_waiter(w, NULL);
+		}
+		forget_invoice(invoices, invoice);
+	}
+	tal_free(tmpctx);
+
+	list_for_each_safe(&invoices->cache, c, cnext, list) {
+		if (c->state == UNPAID && c->expiry_time < expired_before)
+			forget_invoice(invoices, c);
+	}
+
+	stmt = db_prepare(invoices->db,
+			  "DELETE FROM invoices"
+			  " WHERE state=? AND expiry_time<?;");
+	sqlite3_bind_int(stmt, 1, UNPAID);
+	sqlite3_bind_int64(stmt, 2, expired_before);
+	db_exec_prepared(invoices->db, stmt);
+
+	return sqlite3_changes(invoices->db->sql);
+}
+
 const struct invoice *invoices_iterate(struct invoices *invoices,
 				       const struct invoice *invoice)
 {
-	if (invoice)
-		return list_next(&invoices->invlist, invoice, list);
-	else
-		return list_top(&invoices->invlist, struct invoice, list);
+	struct invoice *i = NULL;
+	sqlite3_stmt *stmt;
+
+	/* Straight from the db, so we don't need them all in memory. */
+	stmt = db_prepare(invoices->db,
+			  "SELECT " INVOICE_COLUMNS
+			  "  FROM invoices"
+			  " WHERE id>?"
+			  " ORDER BY id LIMIT 1;");
+	sqlite3_bind_int64(stmt, 1, invoice ? invoice->id : 0);
+	if (sqlite3_step(stmt) == SQLITE_ROW)
+		i = invoice_from_row(invoices, stmt);
+	db_stmt_done(invoices->db, stmt);
+	return i;
 }
 
 static s64 get_next_pay_index(struct db *db)
@@ -293,7 +542,10 @@ void invoices_resolve(struct invoices *invoices,
 	sqlite3_bind_int64(stmt, 4, invoice->id);
 	db_exec_prepared(invoices->db, stmt);
 
-	/* Update in-memory structure. */
+	/* Update in-memory structure: it needn't stay resident now. */
+	assert(!invoice->cached);
+	list_del_from(&invoices->resident, &invoice->list);
+	uintmap_del(&invoices->unpaid_by_expiry, expiry_key(invoice));
 	invoice->state = PAID;
 	invoice->pay_index = pay_index;
 	invoice->msatoshi_received = msatoshi_received;
@@ -316,6 +568,8 @@ void invoices_resolve(struct invoices *invoices,
 
 	/* Free all watchers. */
 	tal_free(tmpctx);
+
+	add_cached(invoices, invoice);
 }
 
 /* Called when an invoice waiter is destructed. */
@@ -366,9 +620,9 @@ void invoices_waitany(const tal_t *ctx,
 	if (res == SQLITE_ROW) {
 		/* Invoice found. Look up the invoice object. */
 		label = tal_strndup(ctx, sqlite3_column_blob(stmt, 0), sqlite3_column_bytes(stmt, 0));
-		sqlite3_finalize(stmt);
+		db_stmt_done(invoices->db, stmt);
 
-		/* The invoice should definitely exist in-memory. */
+		/* The invoice should definitely exist. */
 		invoice = invoices_find_by_label(invoices, label);
 		assert(invoice);
 		tal_free(label);
@@ -377,7 +631,7 @@ void invoices_waitany(const tal_t *ctx,
 		return;
 	}
 
-	sqlite3_finalize(stmt);
+	db_stmt_done(invoices->db, stmt);
 
 	/* None found. */
 	add_invoice_waiter(ctx, &invoices->waitany_waiters, cb, cbarg);
@@ -397,6 +651,11 @@ void invoices_waitone(const tal_t *ctx,
 		return;
 	}
 
-	/* Not yet paid. */
+	/* Not yet paid: keep it in memory while they wait. */
+	if (invoice->cached) {
+		list_del_from(&invoices->cache, &invoice->list);
+		invoices->cache_count--;
+		make_resident(invoices, invoice);
+	}
 	add_invoice_waiter(ctx, &invoice->waitone_waiters, cb, cbarg);
 }
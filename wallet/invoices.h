@@ -27,6 +27,11 @@ struct invoices *invoices_new(const tal_t *ctx,
  * Must be called before the other functions are called
  *
  * @invoices - the invoice handler.
+ *
+ * Only unpaid, unexpired invoices stay in memory: others are read from
+ * the database when asked for, and kept in a small cache.  So a paid or
+ * expired invoice returned by these functions may be freed by the next
+ * call which looks up another.
  */
 bool invoices_load(struct invoices *invoices);
 
@@ -72,6 +77,31 @@ const struct invoice *invoices_find_by_label(struct invoices *invoices,
 const struct invoice *invoices_find_unpaid(struct invoices *invoices,
 					   const struct sha256 *rhash);
 
+/**
+ * invoices_delete_expired - Delete unpaid invoices which expired
+ *
+ * @invoices - the invoice handler.
+ * @expired_before - delete those with expiry_time before this.
+ *
+ * Anyone waiting on one is told it was deleted.  Returns the number
+ * deleted.
+ */
+size_t invoices_delete_expired(struct invoices *invoices, u64 expired_before);
+
+/**
+ * invoices_next_expired - Iterate over unpaid invoices which have expired
+ *
+ * @invoices - the invoice handler.
+ * @now - the time to compare expiry_time against.
+ * @invoice - the previous invoice, or NULL to start.
+ *
+ * Returns unpaid invoices which expired before @now, soonest first,
+ * and NULL when there are no more.
+ */
+const struct invoice *invoices_next_expired(struct invoices *invoices,
+					    u64 now,
+					    const struct invoice *invoice);
+
 /**
  * invoices_delete - Delete an invoice
  *
@@ -89,7 +119,8 @@ bool invoices_delete(struct invoices *invoices,
  * @invoices - the invoice handler.
  * @invoice - the previous invoice you iterated over.
  *
- * Return NULL at end-of-sequence. Usage:
+ * Return NULL at end-of-sequence.  Each call reads the next from the
+ * database.  Usage:
  *
  *   const struct invoice *i;
  *   i = NULL;
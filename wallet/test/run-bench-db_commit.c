@@ -0,0 +1,89 @@
+#include <lightningd/log.h>
+
+static void db_fatal(const char *fmt, ...);
+#define fatal db_fatal
+
+static void db_log_(struct log *log, enum log_level level, const char *fmt, ...)
+{
+}
+#define log_ db_log_
+
+#include "wallet/db.c"
+
+#include <ccan/err/err.h>
+#include <ccan/time/time.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <unistd.h>
+
+/* AUTOGENERATED MOCKS START */
+/* AUTOGENERATED MOCKS END */
+
+static void db_fatal(const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	verrx(1, fmt, ap);
+	va_end(ap);
+}
+
+/* Like an HTLC update from channeld: one small write, one commit. */
+static u64 time_commits(enum db_durability durability, size_t num_commits)
+{
+	char filename[] = "/tmp/ldb-bench-XXXXXX";
+	struct timemono start, end;
+	const tal_t *tmp = tal_tmpctx(NULL);
+	struct db *db;
+	u64 usec;
+	int fd;
+
+	fd = mkstemp(filename);
+	if (fd == -1)
+		err(1, "mkstemp");
+	close(fd);
+
+	db = db_open(NULL, filename);
+	db_migrate(db, NULL);
+	db_set_durability(db, durability);
+
+	start = time_mono();
+	for (size_t i = 0; i < num_commits; i++) {
+		db_begin_transaction(db);
+		db_set_intvar(db, "bench", i);
+		db_commit_transaction(db);
+		if (db->wal_pages >= 1000)
+			db_checkpoint(db);
+	}
+	end = time_mono();
+	usec = time_to_usec(timemono_between(end, start));
+
+	tal_free(db);
+	unlink(filename);
+	/* WAL leaves these behind until the last close. */
+	unlink(tal_fmt(tmp, "%s-wal", filename));
+	unlink(tal_fmt(tmp, "%s-shm", filename));
+	tal_free(tmp);
+
+	return usec;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t num_commits = 100;
+	enum db_durability d;
+
+	if (argc > 1)
+		num_commits = atoi(argv[1]);
+	if (argc > 2 || num_commits == 0)
+		errx(1, "Usage: %s [num_commits]", argv[0]);
+
+	for (d = DB_DURABILITY_LEGACY; d <= DB_DURABILITY_WAL_FULL; d++) {
+		u64 usec = time_commits(d, num_commits);
+
+		printf("%s: %zu commits in %"PRIu64" usec (%"PRIu64" commits/sec)\n",
+		       db_durability_name(d), num_commits, usec,
+		       usec ? (u64)num_commits * 1000000 / usec : 0);
+	}
+	return 0;
+}
@@ -110,6 +110,87 @@ static bool test_vars(void)
 	return true;
 }
 
+static bool test_stmt_cache(void)
+{
+	struct db *db = create_test_db(__func__);
+	sqlite3_stmt *stmt, *nested;
+	const char *query = "SELECT val FROM vars WHERE name=?";
+	CHECK(db);
+	db_migrate(db, NULL);
+
+	db_begin_transaction(db);
+	db_set_intvar(db, "testvar", 7);
+	db->stmt_hits = db->stmt_misses = 0;
+
+	stmt = db_prepare(db, query);
+	CHECK(db->stmt_misses == 1);
+	sqlite3_bind_text(stmt, 1, "testvar", -1, SQLITE_TRANSIENT);
+	CHECK(sqlite3_step(stmt) == SQLITE_ROW);
+
+	/* Still in use, so nesting the same query gets a one-off. */
+	nested = db_prepare(db, query);
+	CHECK(nested != stmt);
+	CHECK(db->stmt_misses == 2);
+	db_stmt_done(db, nested);
+	db_stmt_done(db, stmt);
+	db_commit_transaction(db);
+
+	/* Given back, it's handed out again, even in a new transaction,
+	 * and without the old bindings. */
+	db_begin_transaction(db);
+	nested = db_prepare(db, query);
+	CHECK(nested == stmt);
+	CHECK(db->stmt_hits == 1);
+	CHECK(sqlite3_step(stmt) == SQLITE_DONE);
+	db_stmt_done(db, stmt);
+
+	/* The same query via db_query is a one-off: freed, not kept. */
+	stmt = db_query(__func__, db, "%s", query);
+	CHECK(stmt);
+	db_stmt_done(db, stmt);
+	CHECK(db_prepare(db, query) == nested);
+	CHECK(db->stmt_hits == 2);
+	db_commit_transaction(db);
+
+	/* Closing must not be refused because we still hold it. */
+	tal_free(db);
+	return true;
+}
+
+static bool test_group_commit(void)
+{
+	struct db *db = create_test_db(__func__);
+	CHECK(db);
+	db_migrate(db, NULL);
+
+	db->group_commit = true;
+	db_begin_transaction(db);
+	db_set_intvar(db, "testvar", 1);
+	db_commit_transaction(db);
+	/* Not committed yet: the next one joins it. */
+	CHECK(!sqlite3_get_autocommit(db->sql));
+	db_begin_transaction(db);
+	db_set_intvar(db, "testvar", 2);
+	db_commit_transaction(db);
+	CHECK(!sqlite3_get_autocommit(db->sql));
+
+	db_flush(db);
+	CHECK(sqlite3_get_autocommit(db->sql));
+	CHECK(!db->commit_pending);
+
+	/* Nothing to do. */
+	db_flush(db);
+
+	db_begin_transaction(db);
+	CHECK(!sqlite3_get_autocommit(db->sql));
+	CHECK(db_get_intvar(db, "testvar", 0) == 2);
+	db_commit_transaction(db);
+
+	/* Closing commits what's left. */
+	tal_free(db);
+	return true;
+}
+
 int main(void)
 {
 	bool ok = true;
@@ -117,6 +198,8 @@ int main(void)
 	ok &= test_empty_db_migrate();
 	ok &= test_vars();
 	ok &= test_primitives();
+	ok &= test_stmt_cache();
+	ok &= test_group_commit();
 
 	return !ok;
 }
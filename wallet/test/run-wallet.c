@@ -13,6 +13,7 @@ static void db_log_(struct log *log, enum log_level level, const char *fmt, ...)
 
 #include "wallet/db.c"
 
+#include <ccan/array_size/array_size.h>
 #include <ccan/mem/mem.h>
 #include <ccan/tal/str/str.h>
 #include <ccan/structeq/structeq.h>
@@ -165,6 +166,74 @@ static bool test_wallet_outputs(void)
 	return true;
 }
 
+static bool test_wallet_select(void)
+{
+	char filename[] = "/tmp/ldb-XXXXXX";
+	const u64 amounts[] = { 20000, 100000, 7000, 50000, 30000 };
+	struct utxo u;
+	int fd = mkstemp(filename);
+	CHECK_MSG(fd != -1, "Unable to generate temp filename");
+	close(fd);
+
+	struct wallet *w = tal(NULL, struct wallet);
+	u64 fee_estimate, change_satoshis;
+	const struct utxo **utxos, **more;
+
+	w->db = db_open(w, filename);
+	CHECK_MSG(w->db, "Failed opening the db");
+	db_migrate(w->db, NULL);
+	CHECK_MSG(!wallet_err, "DB migration failed");
+
+	db_begin_transaction(w->db);
+	memset(&u, 0, sizeof(u));
+	for (size_t i = 0; i < ARRAY_SIZE(amounts); i++) {
+		memset(&u.txid, i, sizeof(u.txid));
+		u.amount = amounts[i];
+		CHECK(wallet_add_utxo(w, &u, our_change));
+	}
+
+	/* 50000 + 7000 is exact: no change needed. */
+	utxos = wallet_select_coins(w, w, 57000, 0, 22,
+				    &fee_estimate, &change_satoshis);
+	CHECK(utxos && tal_count(utxos) == 2);
+	CHECK(utxos[0]->amount == 7000 && utxos[1]->amount == 50000);
+	CHECK(change_satoshis == 0);
+
+	/* Those are reserved now: 20000 + 30000 is the next best. */
+	more = wallet_select_coins(w, w, 50000, 0, 22,
+				   &fee_estimate, &change_satoshis);
+	CHECK(more && tal_count(more) == 2);
+	CHECK(more[0]->amount == 20000 && more[1]->amount == 30000);
+	tal_free(more);
+	tal_free(utxos);
+
+	/* No exact match, so we take the biggest. */
+	utxos = wallet_select_coins(w, w, 95000, 0, 22,
+				    &fee_estimate, &change_satoshis);
+	CHECK(utxos && tal_count(utxos) == 1);
+	CHECK(utxos[0]->amount == 100000 && change_satoshis == 5000);
+	tal_free(utxos);
+
+	/* Fees count: each input costs us some of its value. */
+	utxos = wallet_select_coins(w, w, 150000, 1000, 22,
+				    &fee_estimate, &change_satoshis);
+	CHECK(utxos && tal_count(utxos) == 3);
+	CHECK(fee_estimate == 1107 && change_satoshis == 28893);
+	tal_free(utxos);
+
+	/* Can't afford it? */
+	CHECK(!wallet_select_coins(w, w, 207001, 0, 22,
+				   &fee_estimate, &change_satoshis));
+
+	/* All of them were handed back. */
+	CHECK(tal_count(wallet_get_utxos(w, w, output_state_available))
+	      == ARRAY_SIZE(amounts));
+	db_commit_transaction(w->db);
+
+	tal_free(w);
+	return true;
+}
+
 static bool test_shachain_crud(void)
 {
 	struct wallet_shachain a, b;
@@ -588,17 +657,99 @@ static bool test_payment_crud(const tal_t *ctx)
 	return true;
 }
 
+static bool test_invoice_crud(const tal_t *ctx)
+{
+	struct wallet *w = create_test_wallet(ctx);
+	const struct invoice *a, *b, *c, *i;
+	struct sha256 b_rhash;
+	u64 msatoshi = 1000, now = time_now().ts.tv_sec;
+	size_t count;
+
+	w->invoices = invoices_new(w, w->db, w->log);
+	db_begin_transaction(w->db);
+	a = invoices_create(w->invoices, &msatoshi, "a", 100);
+	b = invoices_create(w->invoices, &msatoshi, "b", 0);
+	c = invoices_create(w->invoices, &msatoshi, "c", 10);
+	CHECK(a && b && c);
+	CHECK(!invoices_create(w->invoices, &msatoshi, "b", 100));
+	b_rhash = b->rhash;
+
+	CHECK(invoices_find_by_label(w->invoices, "b") == b);
+	CHECK(!invoices_find_by_label(w->invoices, "x"));
+	CHECK(invoices_find_unpaid(w->invoices, &a->rhash) == a);
+
+	/* Soonest first, and only those already expired. */
+	CHECK(invoices_next_expired(w->invoices, now + 50, NULL) == b);
+	CHECK(invoices_next_expired(w->invoices, now + 50, b) == c);
+	CHECK(!invoices_next_expired(w->invoices, now + 50, c));
+	CHECK(!invoices_next_expired(w->invoices, now, NULL));
+
+	/* One expiring after 2106 still sorts last. */
+	i = invoices_create(w->invoices, &msatoshi, "d", 1ULL << 33);
+	CHECK(i && i->expiry_time > UINT32_MAX);
+	CHECK(invoices_next_expired(w->invoices, now + 50, NULL) == b);
+	CHECK(!invoices_next_expired(w->invoices, now + 50, c));
+	CHECK(invoices_next_expired(w->invoices, UINT64_MAX, a) == i);
+	CHECK(invoices_delete(w->invoices, i));
+
+	/* Paid invoices aren't found as unpaid, nor expire. */
+	invoices_resolve(w->invoices, c, 1000);
+	CHECK(!invoices_find_unpaid(w->invoices, &c->rhash));
+	CHECK(invoices_find_by_label(w->invoices, "c") == c);
+	CHECK(invoices_next_expired(w->invoices, now + 50, NULL) == b);
+	CHECK(!invoices_next_expired(w->invoices, now + 50, b));
+
+	CHECK(invoices_delete(w->invoices, b));
+	CHECK(!invoices_find_by_label(w->invoices, "b"));
+	CHECK(!invoices_find_unpaid(w->invoices, &b_rhash));
+	CHECK(!invoices_next_expired(w->invoices, now + 50, NULL));
+
+	/* Loading them again indexes them the same way, but only the
+	 * unpaid one is loaded up front. */
+	w->invoices = invoices_new(w, w->db, w->log);
+	CHECK(invoices_load(w->invoices));
+	a = invoices_find_by_label(w->invoices, "a");
+	c = invoices_find_by_label(w->invoices, "c");
+	CHECK(a && !a->cached && c && c->cached);
+	CHECK(!invoices_find_by_label(w->invoices, "b"));
+	CHECK(invoices_find_by_label(w->invoices, "c") == c);
+	CHECK(invoices_find_unpaid(w->invoices, &a->rhash) == a);
+	CHECK(!invoices_find_unpaid(w->invoices, &c->rhash));
+	CHECK(c->state == PAID && c->msatoshi_received == 1000);
+	CHECK(!invoices_next_expired(w->invoices, now + 50, NULL));
+	CHECK(invoices_next_expired(w->invoices, now + 200, NULL) == a);
+
+	count = 0;
+	for (i = invoices_iterate(w->invoices, NULL);
+	     i;
+	     i = invoices_iterate(w->invoices, i))
+		count++;
+	CHECK(count == 2);
+
+	/* Only unpaid ones are cleaned, once expired long enough. */
+	CHECK(invoices_delete_expired(w->invoices, now + 50) == 0);
+	CHECK(invoices_delete_expired(w->invoices, now + 200) == 1);
+	CHECK(!invoices_find_by_label(w->invoices, "a"));
+	i = invoices_iterate(w->invoices, NULL);
+	CHECK(i && streq(i->label, "c"));
+	CHECK(!invoices_iterate(w->invoices, i));
+	db_commit_transaction(w->db);
+	return true;
+}
+
 int main(void)
 {
 	bool ok = true;
 	tal_t *tmpctx = tal_tmpctx(NULL);
 
 	ok &= test_wallet_outputs();
+	ok &= test_wallet_select();
 	ok &= test_shachain_crud();
 	ok &= test_channel_crud(tmpctx);
 	ok &= test_channel_config_crud(tmpctx);
 	ok &= test_htlc_crud(tmpctx);
 	ok &= test_payment_crud(tmpctx);
+	ok &= test_invoice_crud(tmpctx);
 
 	tal_free(tmpctx);
 	return !ok;
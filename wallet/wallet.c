@@ -2,6 +2,7 @@
 #include "wallet.h"
 
 #include <bitcoin/script.h>
+#include <ccan/asort/asort.h>
 #include <ccan/structeq/structeq.h>
 #include <ccan/tal/str/str.h>
 #include <inttypes.h>
@@ -118,42 +119,160 @@ struct utxo **wallet_get_utxos(const tal_t *ctx, struct wallet *w, const enum ou
 		results[i] = tal(results, struct utxo);
 		wallet_stmt2output(stmt, results[i]);
 	}
-	sqlite3_finalize(stmt);
+	db_stmt_done(w->db, stmt);
 
 	return results;
 }
 
 /**
- * unreserve_utxo - Mark a reserved UTXO as available again
+ * update_utxos_status - Move a set of UTXOs from oldstatus to newstatus
+ *
+ * One statement, reused for each: returns false if any wasn't in oldstatus.
  */
-static void unreserve_utxo(struct wallet *w, const struct utxo *unres)
+static bool update_utxos_status(struct wallet *w, const struct utxo **utxos,
+				enum output_status oldstatus,
+				enum output_status newstatus)
 {
-	if (!wallet_update_output_status(w, &unres->txid, unres->outnum,
-					 output_state_reserved,
-					 output_state_available)) {
-		fatal("Unable to unreserve output");
+	bool ok = true;
+	sqlite3_stmt *stmt = db_prepare(
+		w->db, "UPDATE outputs SET status=? WHERE status=? AND prev_out_tx=? AND prev_out_index=?");
+
+	for (size_t i = 0; i < tal_count(utxos); i++) {
+		sqlite3_bind_int(stmt, 1, newstatus);
+		sqlite3_bind_int(stmt, 2, oldstatus);
+		sqlite3_bind_blob(stmt, 3, &utxos[i]->txid,
+				  sizeof(utxos[i]->txid), SQLITE_TRANSIENT);
+		sqlite3_bind_int(stmt, 4, utxos[i]->outnum);
+		if (sqlite3_step(stmt) != SQLITE_DONE)
+			fatal("%s: %s", __func__, sqlite3_errmsg(w->db->sql));
+		if (sqlite3_changes(w->db->sql) == 0)
+			ok = false;
+		sqlite3_reset(stmt);
 	}
+	db_stmt_done(w->db, stmt);
+	return ok;
 }
 
 /**
  * destroy_utxos - Destructor for an array of pointers to utxo
+ *
+ * Marks the reserved UTXOs as available again.
  */
 static void destroy_utxos(const struct utxo **utxos, struct wallet *w)
 {
-	for (size_t i = 0; i < tal_count(utxos); i++)
-		unreserve_utxo(w, utxos[i]);
+	if (!update_utxos_status(w, utxos, output_state_reserved,
+				 output_state_available))
+		fatal("Unable to unreserve output");
 }
 
 void wallet_confirm_utxos(struct wallet *w, const struct utxo **utxos)
 {
 	tal_del_destructor2(utxos, destroy_utxos, w);
-	for (size_t i = 0; i < tal_count(utxos); i++) {
-		if (!wallet_update_output_status(
-			w, &utxos[i]->txid, utxos[i]->outnum,
-			output_state_reserved, output_state_spent)) {
-			fatal("Unable to mark output as spent");
+	if (!update_utxos_status(w, utxos, output_state_reserved,
+				 output_state_spent))
+		fatal("Unable to mark output as spent");
+}
+
+/* Weight it adds to a tx to spend this UTXO. */
+static size_t utxo_spend_weight(const struct utxo *utxo)
+{
+	/* Input weight: txid + index + sequence */
+	size_t input_weight = (32 + 4 + 4) * 4;
+
+	/* We always encode the length of the script, even if empty */
+	input_weight += 1 * 4;
+
+	/* P2SH variants include push of <0 <20-byte-key-hash>> */
+	if (utxo->is_p2sh)
+		input_weight += 23 * 4;
+
+	/* Account for witness (1 byte count + sig + key) */
+	input_weight += 1 + (1 + 73 + 1 + 33);
+
+	return input_weight;
+}
+
+/* Most combinations select_exact() will try. */
+#define SELECT_MAX_TRIES 100000
+
+/* Leftover we're happy to lose to fees rather than make change. */
+#define SELECT_MAX_WASTE 546
+
+/* Fee for this weight, rounded up: so these sum to at least the real fee. */
+static u64 weight_fee_ceil(u64 weight, u32 feerate_per_kw)
+{
+	return (weight * feerate_per_kw + 999) / 1000;
+}
+
+/* What a UTXO is worth once we've paid to spend it. */
+static s64 utxo_effective_value(const struct utxo *utxo, u32 feerate_per_kw)
+{
+	return (s64)utxo->amount
+		- (s64)weight_fee_ceil(utxo_spend_weight(utxo), feerate_per_kw);
+}
+
+static int cmp_effective_value(const size_t *a, const size_t *b,
+			       s64 *effective)
+{
+	/* Largest first; ties in db order. */
+	if (effective[*a] != effective[*b])
+		return effective[*a] > effective[*b] ? -1 : 1;
+	return *a < *b ? -1 : *a > *b;
+}
+
+/**
+ * select_exact - Branch and bound search for UTXOs which need no change
+ *
+ * Searches (largest first) for a set of @order whose effective values sum to
+ * between @target and @target + SELECT_MAX_WASTE.  Gives up after
+ * SELECT_MAX_TRIES steps, so huge wallets don't make this slow.
+ */
+static bool select_exact(const size_t *order, const s64 *effective,
+			 s64 target, bool *use)
+{
+	size_t n = tal_count(order), i = 0, tries;
+	s64 *remaining = tal_arr(order, s64, n + 1), sum = 0;
+	bool found = false;
+
+	/* remaining[i] is the most we can still add from order[i] on. */
+	remaining[n] = 0;
+	for (i = n; i > 0; i--)
+		remaining[i-1] = remaining[i]
+			+ (effective[order[i-1]] > 0 ? effective[order[i-1]] : 0);
+
+	i = 0;
+	for (tries = 0; tries < SELECT_MAX_TRIES; tries++) {
+		if (sum >= target && sum <= target + SELECT_MAX_WASTE) {
+			found = true;
+			break;
 		}
+
+		/* Overshot, or can't get there from here?  Drop the last
+		 * one we took, and try without it. */
+		if (sum > target + SELECT_MAX_WASTE
+		    || i == n
+		    || sum + remaining[i] < target
+		    || effective[order[i]] <= 0) {
+			while (i > 0 && !use[order[i-1]])
+				i--;
+			if (i == 0)
+				break;
+			i--;
+			use[order[i]] = false;
+			sum -= effective[order[i]];
+			i++;
+			continue;
+		}
+
+		use[order[i]] = true;
+		sum += effective[order[i]];
+		i++;
 	}
+
+	if (!found)
+		memset(use, 0, sizeof(*use) * n);
+	tal_free(remaining);
+	return found;
 }
 
 static const struct utxo **wallet_select(const tal_t *ctx, struct wallet *w,
@@ -164,11 +283,12 @@ static const struct utxo **wallet_select(const tal_t *ctx, struct wallet *w,
 					 u64 *satoshi_in,
 					 u64 *fee_estimate)
 {
-	size_t i = 0;
 	struct utxo **available;
 	u64 weight;
+	size_t *order;
+	s64 *effective;
+	bool *use;
 	const struct utxo **utxos = tal_arr(ctx, const struct utxo *, 0);
-	tal_add_destructor2(utxos, destroy_utxos, w);
 
 	/* version, input count, output count, locktime */
 	weight = (4 + 1 + 1 + 4) * 4;
@@ -184,40 +304,52 @@ static const struct utxo **wallet_select(const tal_t *ctx, struct wallet *w,
 	*satoshi_in = 0;
 
 	available = wallet_get_utxos(ctx, w, output_state_available);
+	order = tal_arr(available, size_t, tal_count(available));
+	effective = tal_arr(available, s64, tal_count(available));
+	use = tal_arrz(available, bool, tal_count(available));
+	for (size_t i = 0; i < tal_count(available); i++) {
+		order[i] = i;
+		effective[i] = utxo_effective_value(available[i],
+						    feerate_per_kw);
+	}
+	asort(order, tal_count(order), cmp_effective_value, effective);
+
+	/* Best is a set which needs no change at all; otherwise take the
+	 * largest first, so we pay for as few inputs as we can. */
+	if (!select_exact(order, effective,
+			  value + weight_fee_ceil(weight, feerate_per_kw), use)) {
+		u64 sum = 0, fee, select_weight = weight;
+
+		for (size_t i = 0; i < tal_count(order); i++) {
+			use[order[i]] = true;
+			sum += available[order[i]]->amount;
+			select_weight += utxo_spend_weight(available[order[i]]);
+			fee = select_weight * feerate_per_kw / 1000;
+			if (sum >= fee + value)
+				break;
+		}
+	}
 
-	for (i = 0; i < tal_count(available); i++) {
-		size_t input_weight;
-
-		tal_resize(&utxos, i + 1);
-		utxos[i] = tal_steal(utxos, available[i]);
-
-		if (!wallet_update_output_status(
-			w, &available[i]->txid, available[i]->outnum,
-			output_state_available, output_state_reserved))
-			fatal("Unable to reserve output");
-
-		/* Input weight: txid + index + sequence */
-		input_weight = (32 + 4 + 4) * 4;
-
-		/* We always encode the length of the script, even if empty */
-		input_weight += 1 * 4;
-
-		/* P2SH variants include push of <0 <20-byte-key-hash>> */
-		if (utxos[i]->is_p2sh)
-			input_weight += 23 * 4;
-
-		/* Account for witness (1 byte count + sig + key) */
-		input_weight += 1 + (1 + 73 + 1 + 33);
+	/* Hand them back in db order. */
+	for (size_t i = 0; i < tal_count(available); i++) {
+		size_t n = tal_count(utxos);
 
-		weight += input_weight;
+		if (!use[i])
+			continue;
 
-		*fee_estimate = weight * feerate_per_kw / 1000;
-		*satoshi_in += utxos[i]->amount;
-		if (*satoshi_in >= *fee_estimate + value)
-			break;
+		tal_resize(&utxos, n + 1);
+		utxos[n] = tal_steal(utxos, available[i]);
+		weight += utxo_spend_weight(utxos[n]);
+		*satoshi_in += utxos[n]->amount;
 	}
+	*fee_estimate = weight * feerate_per_kw / 1000;
 	tal_free(available);
 
+	if (!update_utxos_status(w, utxos, output_state_available,
+				 output_state_reserved))
+		fatal("Unable to reserve output");
+	tal_add_destructor2(utxos, destroy_utxos, w);
+
 	return utxos;
 }
 
@@ -386,13 +518,13 @@ bool wallet_shachain_load(struct wallet *wallet, u64 id,
 
 	err = sqlite3_step(stmt);
 	if (err != SQLITE_ROW) {
-		sqlite3_finalize(stmt);
+		db_stmt_done(wallet->db, stmt);
 		return false;
 	}
 
 	chain->chain.min_index = sqlite3_column_int64(stmt, 0);
 	chain->chain.num_valid = sqlite3_column_int64(stmt, 1);
-	sqlite3_finalize(stmt);
+	db_stmt_done(wallet->db, stmt);
 
 	/* Load shachain known entries */
 	stmt = db_prepare(wallet->db, "SELECT idx, hash, pos FROM shachain_known WHERE shachain_id=?");
@@ -404,7 +536,7 @@ bool wallet_shachain_load(struct wallet *wallet, u64 id,
 		memcpy(&chain->chain.known[pos].hash, sqlite3_column_blob(stmt, 1), sqlite3_column_bytes(stmt, 1));
 	}
 
-	sqlite3_finalize(stmt);
+	db_stmt_done(wallet->db, stmt);
 	return true;
 }
 
@@ -454,7 +586,7 @@ bool wallet_peer_by_nodeid(struct wallet *w, const struct pubkey *nodeid,
 		/* Make sure we mark this as a new peer */
 		peer->dbid = 0;
 	}
-	sqlite3_finalize(stmt);
+	db_stmt_done(w->db, stmt);
 	tal_free(tmpctx);
 	return ok;
 }
@@ -1183,6 +1315,11 @@ bool wallet_invoice_delete(struct wallet *wallet,
 {
 	return invoices_delete(wallet->invoices, invoice);
 }
+size_t wallet_invoice_delete_expired(struct wallet *wallet,
+				     u64 expired_before)
+{
+	return invoices_delete_expired(wallet->invoices, expired_before);
+}
 const struct invoice *wallet_invoice_iterate(struct wallet *wallet,
 					     const struct invoice *invoice)
 {
@@ -1239,7 +1376,7 @@ struct htlc_stub *wallet_htlc_stubs(const tal_t *ctx, struct wallet *wallet,
 		sqlite3_column_sha256(stmt, 3, &payment_hash);
 		ripemd160(&stubs[n].ripemd, payment_hash.u.u8, sizeof(payment_hash.u));
 	}
-	sqlite3_finalize(stmt);
+	db_stmt_done(wallet->db, stmt);
 	return stubs;
 }
 
@@ -1368,7 +1505,7 @@ wallet_payment_by_hash(const tal_t *ctx, struct wallet *wallet,
 	if (sqlite3_step(stmt) == SQLITE_ROW) {
 		payment = wallet_stmt2payment(ctx, stmt);
 	}
-	sqlite3_finalize(stmt);
+	db_stmt_done(wallet->db, stmt);
 	return payment;
 }
 
@@ -1388,7 +1525,7 @@ struct secret *wallet_payment_get_secrets(const tal_t *ctx,
 	if (sqlite3_step(stmt) == SQLITE_ROW) {
 		path_secrets = sqlite3_column_secrets(ctx, stmt, 0);
 	}
-	sqlite3_finalize(stmt);
+	db_stmt_done(wallet->db, stmt);
 	return path_secrets;
 }
 
@@ -1448,7 +1585,7 @@ const struct wallet_payment **wallet_payment_list(const tal_t *ctx,
 		payments[i] = wallet_stmt2payment(payments, stmt);
 	}
 
-	sqlite3_finalize(stmt);
+	db_stmt_done(wallet->db, stmt);
 
 	/* Now attach payments not yet in db. */
 	list_for_each(&wallet->unstored_payments, p, list) {
@@ -355,8 +355,10 @@ enum invoice_status {
 };
 
 struct invoice {
-	/* List off ld->wallet->invoices */
+	/* List off ld->wallet->invoices: resident, or cached */
 	struct list_node list;
+	/* Only in memory until we need room (ie. paid or expired)? */
+	bool cached;
 	/* Database ID */
 	u64 id;
 	enum invoice_status state;
@@ -443,6 +445,19 @@ const struct invoice *wallet_invoice_find_unpaid(struct wallet *wallet,
 bool wallet_invoice_delete(struct wallet *wallet,
 			   const struct invoice *invoice);
 
+/**
+ * wallet_invoice_delete_expired - Delete unpaid invoices which expired
+ *
+ * @wallet - the wallet to delete the invoices from.
+ * @expired_before - delete those with expiry_time before this, which
+ * must not be after now.
+ *
+ * Anyone waiting on one is told it was deleted.  Returns the number
+ * deleted.
+ */
+size_t wallet_invoice_delete_expired(struct wallet *wallet,
+				     u64 expired_before);
+
 /**
  * wallet_invoice_iterate - Iterate over all existing invoices
  *
@@ -0,0 +1,657 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#include <wire/gen_onion_wire.h>
+#include <ccan/mem/mem.h>
+#include <ccan/tal/str/str.h>
+#include <stdio.h>
+
+const char *onion_type_name(int e)
+{
+	static char invalidbuf[sizeof("INVALID ") + STR_MAX_CHARS(e)];
+
+	switch ((enum onion_type)e) {
+	case WIRE_INVALID_REALM: return "WIRE_INVALID_REALM";
+	case WIRE_TEMPORARY_NODE_FAILURE: return "WIRE_TEMPORARY_NODE_FAILURE";
+	case WIRE_PERMANENT_NODE_FAILURE: return "WIRE_PERMANENT_NODE_FAILURE";
+	case WIRE_REQUIRED_NODE_FEATURE_MISSING: return "WIRE_REQUIRED_NODE_FEATURE_MISSING";
+	case WIRE_INVALID_ONION_VERSION: return "WIRE_INVALID_ONION_VERSION";
+	case WIRE_INVALID_ONION_HMAC: return "WIRE_INVALID_ONION_HMAC";
+	case WIRE_INVALID_ONION_KEY: return "WIRE_INVALID_ONION_KEY";
+	case WIRE_TEMPORARY_CHANNEL_FAILURE: return "WIRE_TEMPORARY_CHANNEL_FAILURE";
+	case WIRE_PERMANENT_CHANNEL_FAILURE: return "WIRE_PERMANENT_CHANNEL_FAILURE";
+	case WIRE_REQUIRED_CHANNEL_FEATURE_MISSING: return "WIRE_REQUIRED_CHANNEL_FEATURE_MISSING";
+	case WIRE_UNKNOWN_NEXT_PEER: return "WIRE_UNKNOWN_NEXT_PEER";
+	case WIRE_AMOUNT_BELOW_MINIMUM: return "WIRE_AMOUNT_BELOW_MINIMUM";
+	case WIRE_FEE_INSUFFICIENT: return "WIRE_FEE_INSUFFICIENT";
+	case WIRE_INCORRECT_CLTV_EXPIRY: return "WIRE_INCORRECT_CLTV_EXPIRY";
+	case WIRE_EXPIRY_TOO_SOON: return "WIRE_EXPIRY_TOO_SOON";
+	case WIRE_UNKNOWN_PAYMENT_HASH: return "WIRE_UNKNOWN_PAYMENT_HASH";
+	case WIRE_INCORRECT_PAYMENT_AMOUNT: return "WIRE_INCORRECT_PAYMENT_AMOUNT";
+	case WIRE_FINAL_EXPIRY_TOO_SOON: return "WIRE_FINAL_EXPIRY_TOO_SOON";
+	case WIRE_FINAL_INCORRECT_CLTV_EXPIRY: return "WIRE_FINAL_INCORRECT_CLTV_EXPIRY";
+	case WIRE_FINAL_INCORRECT_HTLC_AMOUNT: return "WIRE_FINAL_INCORRECT_HTLC_AMOUNT";
+	case WIRE_CHANNEL_DISABLED: return "WIRE_CHANNEL_DISABLED";
+	case WIRE_EXPIRY_TOO_FAR: return "WIRE_EXPIRY_TOO_FAR";
+	}
+
+	sprintf(invalidbuf, "INVALID %i", e);
+	return invalidbuf;
+}
+
+bool fromwire_invalid_realm(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_INVALID_REALM)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_temporary_node_failure(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_TEMPORARY_NODE_FAILURE)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_permanent_node_failure(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_PERMANENT_NODE_FAILURE)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_required_node_feature_missing(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_REQUIRED_NODE_FEATURE_MISSING)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_invalid_onion_version(const void *p, size_t *plen, struct sha256 *sha256_of_onion)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_INVALID_ONION_VERSION)
+		return false;
+	//4th case sha256_of_onion
+	fromwire_sha256(&cursor, plen, sha256_of_onion);
+	return cursor != NULL;
+}
+
+bool fromwire_invalid_onion_hmac(const void *p, size_t *plen, struct sha256 *sha256_of_onion)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_INVALID_ONION_HMAC)
+		return false;
+	//4th case sha256_of_onion
+	fromwire_sha256(&cursor, plen, sha256_of_onion);
+	return cursor != NULL;
+}
+
+bool fromwire_invalid_onion_key(const void *p, size_t *plen, struct sha256 *sha256_of_onion)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_INVALID_ONION_KEY)
+		return false;
+	//4th case sha256_of_onion
+	fromwire_sha256(&cursor, plen, sha256_of_onion);
+	return cursor != NULL;
+}
+
+bool fromwire_temporary_channel_failure(const tal_t *ctx, const void *p, size_t *plen, u8 **channel_update)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_TEMPORARY_CHANNEL_FAILURE)
+		return false;
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case channel_update
+	*channel_update = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *channel_update, len);
+	return cursor != NULL;
+}
+
+bool fromwire_permanent_channel_failure(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_PERMANENT_CHANNEL_FAILURE)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_required_channel_feature_missing(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_REQUIRED_CHANNEL_FEATURE_MISSING)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_unknown_next_peer(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_UNKNOWN_NEXT_PEER)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_amount_below_minimum(const tal_t *ctx, const void *p, size_t *plen, u64 *htlc_msat, u8 **channel_update)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_AMOUNT_BELOW_MINIMUM)
+		return false;
+	//3th case htlc_msat
+	*htlc_msat = fromwire_u64(&cursor, plen);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case channel_update
+	*channel_update = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *channel_update, len);
+	return cursor != NULL;
+}
+
+bool fromwire_fee_insufficient(const tal_t *ctx, const void *p, size_t *plen, u64 *htlc_msat, u8 **channel_update)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_FEE_INSUFFICIENT)
+		return false;
+	//3th case htlc_msat
+	*htlc_msat = fromwire_u64(&cursor, plen);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case channel_update
+	*channel_update = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *channel_update, len);
+	return cursor != NULL;
+}
+
+bool fromwire_incorrect_cltv_expiry(const tal_t *ctx, const void *p, size_t *plen, u32 *cltv_expiry, u8 **channel_update)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_INCORRECT_CLTV_EXPIRY)
+		return false;
+	//3th case cltv_expiry
+	*cltv_expiry = fromwire_u32(&cursor, plen);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case channel_update
+	*channel_update = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *channel_update, len);
+	return cursor != NULL;
+}
+
+bool fromwire_expiry_too_soon(const tal_t *ctx, const void *p, size_t *plen, u8 **channel_update)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_EXPIRY_TOO_SOON)
+		return false;
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case channel_update
+	*channel_update = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *channel_update, len);
+	return cursor != NULL;
+}
+
+bool fromwire_unknown_payment_hash(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_UNKNOWN_PAYMENT_HASH)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_incorrect_payment_amount(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_INCORRECT_PAYMENT_AMOUNT)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_final_expiry_too_soon(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_FINAL_EXPIRY_TOO_SOON)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_final_incorrect_cltv_expiry(const void *p, size_t *plen, u32 *cltv_expiry)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_FINAL_INCORRECT_CLTV_EXPIRY)
+		return false;
+	//3th case cltv_expiry
+	*cltv_expiry = fromwire_u32(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_final_incorrect_htlc_amount(const void *p, size_t *plen, u32 *incoming_htlc_amt)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_FINAL_INCORRECT_HTLC_AMOUNT)
+		return false;
+	//3th case incoming_htlc_amt
+	*incoming_htlc_amt = fromwire_u32(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_disabled(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_DISABLED)
+		return false;
+
+	return cursor != NULL;
+}
+
+bool fromwire_expiry_too_far(const void *p, size_t *plen)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_EXPIRY_TOO_FAR)
+		return false;
+
+	return cursor != NULL;
+}
+
+u8 *towire_invalid_realm(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_INVALID_REALM);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_temporary_node_failure(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_TEMPORARY_NODE_FAILURE);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_permanent_node_failure(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_PERMANENT_NODE_FAILURE);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_required_node_feature_missing(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_REQUIRED_NODE_FEATURE_MISSING);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_invalid_onion_version(const tal_t *ctx, const struct sha256 *sha256_of_onion)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_INVALID_ONION_VERSION);
+	towire_sha256(&p, sha256_of_onion);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_invalid_onion_hmac(const tal_t *ctx, const struct sha256 *sha256_of_onion)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_INVALID_ONION_HMAC);
+	towire_sha256(&p, sha256_of_onion);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_invalid_onion_key(const tal_t *ctx, const struct sha256 *sha256_of_onion)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_INVALID_ONION_KEY);
+	towire_sha256(&p, sha256_of_onion);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_temporary_channel_failure(const tal_t *ctx, const u8 *channel_update)
+{
+	u16 len = tal_count(channel_update);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_TEMPORARY_CHANNEL_FAILURE);
+	towire_u16(&p, len);
+	towire_u8_array(&p, channel_update, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_permanent_channel_failure(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_PERMANENT_CHANNEL_FAILURE);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_required_channel_feature_missing(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_REQUIRED_CHANNEL_FEATURE_MISSING);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_unknown_next_peer(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_UNKNOWN_NEXT_PEER);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_amount_below_minimum(const tal_t *ctx, u64 htlc_msat, const u8 *channel_update)
+{
+	u16 len = tal_count(channel_update);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_AMOUNT_BELOW_MINIMUM);
+	towire_u64(&p, htlc_msat);
+	towire_u16(&p, len);
+	towire_u8_array(&p, channel_update, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_fee_insufficient(const tal_t *ctx, u64 htlc_msat, const u8 *channel_update)
+{
+	u16 len = tal_count(channel_update);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_FEE_INSUFFICIENT);
+	towire_u64(&p, htlc_msat);
+	towire_u16(&p, len);
+	towire_u8_array(&p, channel_update, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_incorrect_cltv_expiry(const tal_t *ctx, u32 cltv_expiry, const u8 *channel_update)
+{
+	u16 len = tal_count(channel_update);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_INCORRECT_CLTV_EXPIRY);
+	towire_u32(&p, cltv_expiry);
+	towire_u16(&p, len);
+	towire_u8_array(&p, channel_update, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_expiry_too_soon(const tal_t *ctx, const u8 *channel_update)
+{
+	u16 len = tal_count(channel_update);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_EXPIRY_TOO_SOON);
+	towire_u16(&p, len);
+	towire_u8_array(&p, channel_update, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_unknown_payment_hash(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_UNKNOWN_PAYMENT_HASH);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_incorrect_payment_amount(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_INCORRECT_PAYMENT_AMOUNT);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_final_expiry_too_soon(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_FINAL_EXPIRY_TOO_SOON);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_final_incorrect_cltv_expiry(const tal_t *ctx, u32 cltv_expiry)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_FINAL_INCORRECT_CLTV_EXPIRY);
+	towire_u32(&p, cltv_expiry);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_final_incorrect_htlc_amount(const tal_t *ctx, u32 incoming_htlc_amt)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_FINAL_INCORRECT_HTLC_AMOUNT);
+	towire_u32(&p, incoming_htlc_amt);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_disabled(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_DISABLED);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_expiry_too_far(const tal_t *ctx)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_EXPIRY_TOO_FAR);
+
+
+	return memcheck(p, tal_count(p));
+}
+
+
@@ -0,0 +1,124 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#ifndef LIGHTNING_WIRE_GEN_ONION_WIRE_H
+#define LIGHTNING_WIRE_GEN_ONION_WIRE_H
+#include <ccan/tal/tal.h>
+#include <wire/wire.h>
+#include <wire/onion_defs.h>
+
+enum onion_type {
+	WIRE_INVALID_REALM = PERM|1,
+	WIRE_TEMPORARY_NODE_FAILURE = NODE|2,
+	WIRE_PERMANENT_NODE_FAILURE = PERM|NODE|2,
+	WIRE_REQUIRED_NODE_FEATURE_MISSING = PERM|NODE|3,
+	WIRE_INVALID_ONION_VERSION = BADONION|PERM|4,
+	WIRE_INVALID_ONION_HMAC = BADONION|PERM|5,
+	WIRE_INVALID_ONION_KEY = BADONION|PERM|6,
+	WIRE_TEMPORARY_CHANNEL_FAILURE = UPDATE|7,
+	WIRE_PERMANENT_CHANNEL_FAILURE = PERM|8,
+	WIRE_REQUIRED_CHANNEL_FEATURE_MISSING = PERM|9,
+	WIRE_UNKNOWN_NEXT_PEER = PERM|10,
+	WIRE_AMOUNT_BELOW_MINIMUM = UPDATE|11,
+	WIRE_FEE_INSUFFICIENT = UPDATE|12,
+	WIRE_INCORRECT_CLTV_EXPIRY = UPDATE|13,
+	WIRE_EXPIRY_TOO_SOON = UPDATE|14,
+	WIRE_UNKNOWN_PAYMENT_HASH = PERM|15,
+	WIRE_INCORRECT_PAYMENT_AMOUNT = PERM|16,
+	WIRE_FINAL_EXPIRY_TOO_SOON = 17,
+	WIRE_FINAL_INCORRECT_CLTV_EXPIRY = 18,
+	WIRE_FINAL_INCORRECT_HTLC_AMOUNT = 19,
+	WIRE_CHANNEL_DISABLED = UPDATE|20,
+	WIRE_EXPIRY_TOO_FAR = 21,
+};
+const char *onion_type_name(int e);
+
+bool fromwire_invalid_realm(const void *p, size_t *plen);
+
+bool fromwire_temporary_node_failure(const void *p, size_t *plen);
+
+bool fromwire_permanent_node_failure(const void *p, size_t *plen);
+
+bool fromwire_required_node_feature_missing(const void *p, size_t *plen);
+
+bool fromwire_invalid_onion_version(const void *p, size_t *plen, struct sha256 *sha256_of_onion);
+
+bool fromwire_invalid_onion_hmac(const void *p, size_t *plen, struct sha256 *sha256_of_onion);
+
+bool fromwire_invalid_onion_key(const void *p, size_t *plen, struct sha256 *sha256_of_onion);
+
+bool fromwire_temporary_channel_failure(const tal_t *ctx, const void *p, size_t *plen, u8 **channel_update);
+
+bool fromwire_permanent_channel_failure(const void *p, size_t *plen);
+
+bool fromwire_required_channel_feature_missing(const void *p, size_t *plen);
+
+bool fromwire_unknown_next_peer(const void *p, size_t *plen);
+
+bool fromwire_amount_below_minimum(const tal_t *ctx, const void *p, size_t *plen, u64 *htlc_msat, u8 **channel_update);
+
+bool fromwire_fee_insufficient(const tal_t *ctx, const void *p, size_t *plen, u64 *htlc_msat, u8 **channel_update);
+
+bool fromwire_incorrect_cltv_expiry(const tal_t *ctx, const void *p, size_t *plen, u32 *cltv_expiry, u8 **channel_update);
+
+bool fromwire_expiry_too_soon(const tal_t *ctx, const void *p, size_t *plen, u8 **channel_update);
+
+bool fromwire_unknown_payment_hash(const void *p, size_t *plen);
+
+bool fromwire_incorrect_payment_amount(const void *p, size_t *plen);
+
+bool fromwire_final_expiry_too_soon(const void *p, size_t *plen);
+
+bool fromwire_final_incorrect_cltv_expiry(const void *p, size_t *plen, u32 *cltv_expiry);
+
+bool fromwire_final_incorrect_htlc_amount(const void *p, size_t *plen, u32 *incoming_htlc_amt);
+
+bool fromwire_channel_disabled(const void *p, size_t *plen);
+
+bool fromwire_expiry_too_far(const void *p, size_t *plen);
+
+u8 *towire_invalid_realm(const tal_t *ctx);
+
+u8 *towire_temporary_node_failure(const tal_t *ctx);
+
+u8 *towire_permanent_node_failure(const tal_t *ctx);
+
+u8 *towire_required_node_feature_missing(const tal_t *ctx);
+
+u8 *towire_invalid_onion_version(const tal_t *ctx, const struct sha256 *sha256_of_onion);
+
+u8 *towire_invalid_onion_hmac(const tal_t *ctx, const struct sha256 *sha256_of_onion);
+
+u8 *towire_invalid_onion_key(const tal_t *ctx, const struct sha256 *sha256_of_onion);
+
+u8 *towire_temporary_channel_failure(const tal_t *ctx, const u8 *channel_update);
+
+u8 *towire_permanent_channel_failure(const tal_t *ctx);
+
+u8 *towire_required_channel_feature_missing(const tal_t *ctx);
+
+u8 *towire_unknown_next_peer(const tal_t *ctx);
+
+u8 *towire_amount_below_minimum(const tal_t *ctx, u64 htlc_msat, const u8 *channel_update);
+
+u8 *towire_fee_insufficient(const tal_t *ctx, u64 htlc_msat, const u8 *channel_update);
+
+u8 *towire_incorrect_cltv_expiry(const tal_t *ctx, u32 cltv_expiry, const u8 *channel_update);
+
+u8 *towire_expiry_too_soon(const tal_t *ctx, const u8 *channel_update);
+
+u8 *towire_unknown_payment_hash(const tal_t *ctx);
+
+u8 *towire_incorrect_payment_amount(const tal_t *ctx);
+
+u8 *towire_final_expiry_too_soon(const tal_t *ctx);
+
+u8 *towire_final_incorrect_cltv_expiry(const tal_t *ctx, u32 cltv_expiry);
+
+u8 *towire_final_incorrect_htlc_amount(const tal_t *ctx, u32 incoming_htlc_amt);
+
+u8 *towire_channel_disabled(const tal_t *ctx);
+
+u8 *towire_expiry_too_far(const tal_t *ctx);
+
+#endif /* LIGHTNING_WIRE_GEN_ONION_WIRE_H */
+
@@ -0,0 +1,1170 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#include <wire/gen_peer_wire.h>
+#include <ccan/mem/mem.h>
+#include <ccan/tal/str/str.h>
+#include <stdio.h>
+
+const char *wire_type_name(int e)
+{
+	static char invalidbuf[sizeof("INVALID ") + STR_MAX_CHARS(e)];
+
+	switch ((enum wire_type)e) {
+	case WIRE_INIT: return "WIRE_INIT";
+	case WIRE_ERROR: return "WIRE_ERROR";
+	case WIRE_PING: return "WIRE_PING";
+	case WIRE_PONG: return "WIRE_PONG";
+	case WIRE_OPEN_CHANNEL: return "WIRE_OPEN_CHANNEL";
+	case WIRE_ACCEPT_CHANNEL: return "WIRE_ACCEPT_CHANNEL";
+	case WIRE_FUNDING_CREATED: return "WIRE_FUNDING_CREATED";
+	case WIRE_FUNDING_SIGNED: return "WIRE_FUNDING_SIGNED";
+	case WIRE_FUNDING_LOCKED: return "WIRE_FUNDING_LOCKED";
+	case WIRE_SHUTDOWN: return "WIRE_SHUTDOWN";
+	case WIRE_CLOSING_SIGNED: return "WIRE_CLOSING_SIGNED";
+	case WIRE_UPDATE_ADD_HTLC: return "WIRE_UPDATE_ADD_HTLC";
+	case WIRE_UPDATE_FULFILL_HTLC: return "WIRE_UPDATE_FULFILL_HTLC";
+	case WIRE_UPDATE_FAIL_HTLC: return "WIRE_UPDATE_FAIL_HTLC";
+	case WIRE_UPDATE_FAIL_MALFORMED_HTLC: return "WIRE_UPDATE_FAIL_MALFORMED_HTLC";
+	case WIRE_COMMITMENT_SIGNED: return "WIRE_COMMITMENT_SIGNED";
+	case WIRE_REVOKE_AND_ACK: return "WIRE_REVOKE_AND_ACK";
+	case WIRE_UPDATE_FEE: return "WIRE_UPDATE_FEE";
+	case WIRE_CHANNEL_REESTABLISH: return "WIRE_CHANNEL_REESTABLISH";
+	case WIRE_ANNOUNCEMENT_SIGNATURES: return "WIRE_ANNOUNCEMENT_SIGNATURES";
+	case WIRE_CHANNEL_ANNOUNCEMENT: return "WIRE_CHANNEL_ANNOUNCEMENT";
+	case WIRE_NODE_ANNOUNCEMENT: return "WIRE_NODE_ANNOUNCEMENT";
+	case WIRE_CHANNEL_UPDATE: return "WIRE_CHANNEL_UPDATE";
+	}
+
+	sprintf(invalidbuf, "INVALID %i", e);
+	return invalidbuf;
+}
+
+bool fromwire_init(const tal_t *ctx, const void *p, size_t *plen, u8 **globalfeatures, u8 **localfeatures)
+{
+	u16 gflen;
+	u16 lflen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_INIT)
+		return false;
+	//3th case gflen
+	gflen = fromwire_u16(&cursor, plen);
+	//2nd case globalfeatures
+	*globalfeatures = gflen ? tal_arr(ctx, u8, gflen) : NULL;
+	fromwire_u8_array(&cursor, plen, *globalfeatures, gflen);
+	//3th case lflen
+	lflen = fromwire_u16(&cursor, plen);
+	//2nd case localfeatures
+	*localfeatures = lflen ? tal_arr(ctx, u8, lflen) : NULL;
+	fromwire_u8_array(&cursor, plen, *localfeatures, lflen);
+	return cursor != NULL;
+}
+
+bool fromwire_error(const tal_t *ctx, const void *p, size_t *plen, struct channel_id *channel_id, u8 **data)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ERROR)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case data
+	*data = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *data, len);
+	return cursor != NULL;
+}
+
+bool fromwire_ping(const tal_t *ctx, const void *p, size_t *plen, u16 *num_pong_bytes, u8 **ignored)
+{
+	u16 byteslen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_PING)
+		return false;
+	//3th case num_pong_bytes
+	*num_pong_bytes = fromwire_u16(&cursor, plen);
+	//3th case byteslen
+	byteslen = fromwire_u16(&cursor, plen);
+	//2nd case ignored
+	*ignored = byteslen ? tal_arr(ctx, u8, byteslen) : NULL;
+	fromwire_u8_array(&cursor, plen, *ignored, byteslen);
+	return cursor != NULL;
+}
+
+bool fromwire_pong(const tal_t *ctx, const void *p, size_t *plen, u8 **ignored)
+{
+	u16 byteslen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_PONG)
+		return false;
+	//3th case byteslen
+	byteslen = fromwire_u16(&cursor, plen);
+	//2nd case ignored
+	*ignored = byteslen ? tal_arr(ctx, u8, byteslen) : NULL;
+	fromwire_u8_array(&cursor, plen, *ignored, byteslen);
+	return cursor != NULL;
+}
+
+bool fromwire_open_channel(const void *p, size_t *plen, struct bitcoin_blkid *chain_hash, struct channel_id *temporary_channel_id, u64 *funding_satoshis, u64 *push_msat, u64 *dust_limit_satoshis, u64 *max_htlc_value_in_flight_msat, u64 *channel_reserve_satoshis, u64 *htlc_minimum_msat, u32 *feerate_per_kw, u16 *to_self_delay, u16 *max_accepted_htlcs, struct pubkey *funding_pubkey, struct pubkey *revocation_basepoint, struct pubkey *payment_basepoint, struct pubkey *delayed_payment_basepoint, struct pubkey *htlc_basepoint, struct pubkey *first_per_commitment_point, u8 *channel_flags)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_OPEN_CHANNEL)
+		return false;
+	//4th case chain_hash
+	fromwire_bitcoin_blkid(&cursor, plen, chain_hash);
+	//4th case temporary_channel_id
+	fromwire_channel_id(&cursor, plen, temporary_channel_id);
+	//3th case funding_satoshis
+	*funding_satoshis = fromwire_u64(&cursor, plen);
+	//3th case push_msat
+	*push_msat = fromwire_u64(&cursor, plen);
+	//3th case dust_limit_satoshis
+	*dust_limit_satoshis = fromwire_u64(&cursor, plen);
+	//3th case max_htlc_value_in_flight_msat
+	*max_htlc_value_in_flight_msat = fromwire_u64(&cursor, plen);
+	//3th case channel_reserve_satoshis
+	*channel_reserve_satoshis = fromwire_u64(&cursor, plen);
+	//3th case htlc_minimum_msat
+	*htlc_minimum_msat = fromwire_u64(&cursor, plen);
+	//3th case feerate_per_kw
+	*feerate_per_kw = fromwire_u32(&cursor, plen);
+	//3th case to_self_delay
+	*to_self_delay = fromwire_u16(&cursor, plen);
+	//3th case max_accepted_htlcs
+	*max_accepted_htlcs = fromwire_u16(&cursor, plen);
+	//4th case funding_pubkey
+	fromwire_pubkey(&cursor, plen, funding_pubkey);
+	//4th case revocation_basepoint
+	fromwire_pubkey(&cursor, plen, revocation_basepoint);
+	//4th case payment_basepoint
+	fromwire_pubkey(&cursor, plen, payment_basepoint);
+	//4th case delayed_payment_basepoint
+	fromwire_pubkey(&cursor, plen, delayed_payment_basepoint);
+	//4th case htlc_basepoint
+	fromwire_pubkey(&cursor, plen, htlc_basepoint);
+	//4th case first_per_commitment_point
+	fromwire_pubkey(&cursor, plen, first_per_commitment_point);
+	//3th case channel_flags
+	*channel_flags = fromwire_u8(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_accept_channel(const void *p, size_t *plen, struct channel_id *temporary_channel_id, u64 *dust_limit_satoshis, u64 *max_htlc_value_in_flight_msat, u64 *channel_reserve_satoshis, u64 *htlc_minimum_msat, u32 *minimum_depth, u16 *to_self_delay, u16 *max_accepted_htlcs, struct pubkey *funding_pubkey, struct pubkey *revocation_basepoint, struct pubkey *payment_basepoint, struct pubkey *delayed_payment_basepoint, struct pubkey *htlc_basepoint, struct pubkey *first_per_commitment_point)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ACCEPT_CHANNEL)
+		return false;
+	//4th case temporary_channel_id
+	fromwire_channel_id(&cursor, plen, temporary_channel_id);
+	//3th case dust_limit_satoshis
+	*dust_limit_satoshis = fromwire_u64(&cursor, plen);
+	//3th case max_htlc_value_in_flight_msat
+	*max_htlc_value_in_flight_msat = fromwire_u64(&cursor, plen);
+	//3th case channel_reserve_satoshis
+	*channel_reserve_satoshis = fromwire_u64(&cursor, plen);
+	//3th case htlc_minimum_msat
+	*htlc_minimum_msat = fromwire_u64(&cursor, plen);
+	//3th case minimum_depth
+	*minimum_depth = fromwire_u32(&cursor, plen);
+	//3th case to_self_delay
+	*to_self_delay = fromwire_u16(&cursor, plen);
+	//3th case max_accepted_htlcs
+	*max_accepted_htlcs = fromwire_u16(&cursor, plen);
+	//4th case funding_pubkey
+	fromwire_pubkey(&cursor, plen, funding_pubkey);
+	//4th case revocation_basepoint
+	fromwire_pubkey(&cursor, plen, revocation_basepoint);
+	//4th case payment_basepoint
+	fromwire_pubkey(&cursor, plen, payment_basepoint);
+	//4th case delayed_payment_basepoint
+	fromwire_pubkey(&cursor, plen, delayed_payment_basepoint);
+	//4th case htlc_basepoint
+	fromwire_pubkey(&cursor, plen, htlc_basepoint);
+	//4th case first_per_commitment_point
+	fromwire_pubkey(&cursor, plen, first_per_commitment_point);
+	return cursor != NULL;
+}
+
+bool fromwire_funding_created(const void *p, size_t *plen, struct channel_id *temporary_channel_id, struct bitcoin_txid *funding_txid, u16 *funding_output_index, secp256k1_ecdsa_signature *signature)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_FUNDING_CREATED)
+		return false;
+	//4th case temporary_channel_id
+	fromwire_channel_id(&cursor, plen, temporary_channel_id);
+	//4th case funding_txid
+	fromwire_bitcoin_txid(&cursor, plen, funding_txid);
+	//3th case funding_output_index
+	*funding_output_index = fromwire_u16(&cursor, plen);
+	//4th case signature
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, signature);
+	return cursor != NULL;
+}
+
+bool fromwire_funding_signed(const void *p, size_t *plen, struct channel_id *channel_id, secp256k1_ecdsa_signature *signature)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_FUNDING_SIGNED)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//4th case signature
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, signature);
+	return cursor != NULL;
+}
+
+bool fromwire_funding_locked(const void *p, size_t *plen, struct channel_id *channel_id, struct pubkey *next_per_commitment_point)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_FUNDING_LOCKED)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//4th case next_per_commitment_point
+	fromwire_pubkey(&cursor, plen, next_per_commitment_point);
+	return cursor != NULL;
+}
+
+bool fromwire_shutdown(const tal_t *ctx, const void *p, size_t *plen, struct channel_id *channel_id, u8 **scriptpubkey)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_SHUTDOWN)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case scriptpubkey
+	*scriptpubkey = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *scriptpubkey, len);
+	return cursor != NULL;
+}
+
+bool fromwire_closing_signed(const void *p, size_t *plen, struct channel_id *channel_id, u64 *fee_satoshis, secp256k1_ecdsa_signature *signature)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CLOSING_SIGNED)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//3th case fee_satoshis
+	*fee_satoshis = fromwire_u64(&cursor, plen);
+	//4th case signature
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, signature);
+	return cursor != NULL;
+}
+
+bool fromwire_update_add_htlc(const void *p, size_t *plen, struct channel_id *channel_id, u64 *id, u64 *amount_msat, struct sha256 *payment_hash, u32 *cltv_expiry, u8 onion_routing_packet[1366])
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_UPDATE_ADD_HTLC)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//3th case id
+	*id = fromwire_u64(&cursor, plen);
+	//3th case amount_msat
+	*amount_msat = fromwire_u64(&cursor, plen);
+	//4th case payment_hash
+	fromwire_sha256(&cursor, plen, payment_hash);
+	//3th case cltv_expiry
+	*cltv_expiry = fromwire_u32(&cursor, plen);
+	fromwire_u8_array(&cursor, plen, onion_routing_packet, 1366);
+	return cursor != NULL;
+}
+
+bool fromwire_update_fulfill_htlc(const void *p, size_t *plen, struct channel_id *channel_id, u64 *id, struct preimage *payment_preimage)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_UPDATE_FULFILL_HTLC)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//3th case id
+	*id = fromwire_u64(&cursor, plen);
+	//4th case payment_preimage
+	fromwire_preimage(&cursor, plen, payment_preimage);
+	return cursor != NULL;
+}
+
+bool fromwire_update_fail_htlc(const tal_t *ctx, const void *p, size_t *plen, struct channel_id *channel_id, u64 *id, u8 **reason)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_UPDATE_FAIL_HTLC)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//3th case id
+	*id = fromwire_u64(&cursor, plen);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case reason
+	*reason = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *reason, len);
+	return cursor != NULL;
+}
+
+bool fromwire_update_fail_malformed_htlc(const void *p, size_t *plen, struct channel_id *channel_id, u64 *id, struct sha256 *sha256_of_onion, u16 *failure_code)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_UPDATE_FAIL_MALFORMED_HTLC)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//3th case id
+	*id = fromwire_u64(&cursor, plen);
+	//4th case sha256_of_onion
+	fromwire_sha256(&cursor, plen, sha256_of_onion);
+	//3th case failure_code
+	*failure_code = fromwire_u16(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_commitment_signed(const tal_t *ctx, const void *p, size_t *plen, struct channel_id *channel_id, secp256k1_ecdsa_signature *signature, secp256k1_ecdsa_signature **htlc_signature)
+{
+	u16 num_htlcs;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_COMMITMENT_SIGNED)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//4th case signature
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, signature);
+	//3th case num_htlcs
+	num_htlcs = fromwire_u16(&cursor, plen);
+	//2nd case htlc_signature
+	*htlc_signature = num_htlcs ? tal_arr(ctx, secp256k1_ecdsa_signature, num_htlcs) : NULL;
+	for (size_t i = 0; i < num_htlcs; i++)
+		fromwire_secp256k1_ecdsa_signature(&cursor, plen, *htlc_signature + i);
+	return cursor != NULL;
+}
+
+bool fromwire_revoke_and_ack(const void *p, size_t *plen, struct channel_id *channel_id, struct sha256 *per_commitment_secret, struct pubkey *next_per_commitment_point)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_REVOKE_AND_ACK)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//4th case per_commitment_secret
+	fromwire_sha256(&cursor, plen, per_commitment_secret);
+	//4th case next_per_commitment_point
+	fromwire_pubkey(&cursor, plen, next_per_commitment_point);
+	return cursor != NULL;
+}
+
+bool fromwire_update_fee(const void *p, size_t *plen, struct channel_id *channel_id, u32 *feerate_per_kw)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_UPDATE_FEE)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//3th case feerate_per_kw
+	*feerate_per_kw = fromwire_u32(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_reestablish(const void *p, size_t *plen, struct channel_id *channel_id, u64 *next_local_commitment_number, u64 *next_remote_revocation_number)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_REESTABLISH)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//3th case next_local_commitment_number
+	*next_local_commitment_number = fromwire_u64(&cursor, plen);
+	//3th case next_remote_revocation_number
+	*next_remote_revocation_number = fromwire_u64(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_announcement_signatures(const void *p, size_t *plen, struct channel_id *channel_id, struct short_channel_id *short_channel_id, secp256k1_ecdsa_signature *node_signature, secp256k1_ecdsa_signature *bitcoin_signature)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ANNOUNCEMENT_SIGNATURES)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//4th case short_channel_id
+	fromwire_short_channel_id(&cursor, plen, short_channel_id);
+	//4th case node_signature
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, node_signature);
+	//4th case bitcoin_signature
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, bitcoin_signature);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_announcement(const tal_t *ctx, const void *p, size_t *plen, secp256k1_ecdsa_signature *node_signature_1, secp256k1_ecdsa_signature *node_signature_2, secp256k1_ecdsa_signature *bitcoin_signature_1, secp256k1_ecdsa_signature *bitcoin_signature_2, u8 **features, struct bitcoin_blkid *chain_hash, struct short_channel_id *short_channel_id, struct pubkey *node_id_1, struct pubkey *node_id_2, struct pubkey *bitcoin_key_1, struct pubkey *bitcoin_key_2)
+{
+	u16 len;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_ANNOUNCEMENT)
+		return false;
+	//4th case node_signature_1
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, node_signature_1);
+	//4th case node_signature_2
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, node_signature_2);
+	//4th case bitcoin_signature_1
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, bitcoin_signature_1);
+	//4th case bitcoin_signature_2
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, bitcoin_signature_2);
+	//3th case len
+	len = fromwire_u16(&cursor, plen);
+	//2nd case features
+	*features = len ? tal_arr(ctx, u8, len) : NULL;
+	fromwire_u8_array(&cursor, plen, *features, len);
+	//4th case chain_hash
+	fromwire_bitcoin_blkid(&cursor, plen, chain_hash);
+	//4th case short_channel_id
+	fromwire_short_channel_id(&cursor, plen, short_channel_id);
+	//4th case node_id_1
+	fromwire_pubkey(&cursor, plen, node_id_1);
+	//4th case node_id_2
+	fromwire_pubkey(&cursor, plen, node_id_2);
+	//4th case bitcoin_key_1
+	fromwire_pubkey(&cursor, plen, bitcoin_key_1);
+	//4th case bitcoin_key_2
+	fromwire_pubkey(&cursor, plen, bitcoin_key_2);
+	return cursor != NULL;
+}
+
+bool fromwire_node_announcement(const tal_t *ctx, const void *p, size_t *plen, secp256k1_ecdsa_signature *signature, u8 **features, u32 *timestamp, struct pubkey *node_id, u8 rgb_color[3], u8 alias[32], u8 **addresses)
+{
+	u16 flen;
+	u16 addrlen;
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_NODE_ANNOUNCEMENT)
+		return false;
+	//4th case signature
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, signature);
+	//3th case flen
+	flen = fromwire_u16(&cursor, plen);
+	//2nd case features
+	*features = flen ? tal_arr(ctx, u8, flen) : NULL;
+	fromwire_u8_array(&cursor, plen, *features, flen);
+	//3th case timestamp
+	*timestamp = fromwire_u32(&cursor, plen);
+	//4th case node_id
+	fromwire_pubkey(&cursor, plen, node_id);
+	fromwire_u8_array(&cursor, plen, rgb_color, 3);
+	fromwire_u8_array(&cursor, plen, alias, 32);
+	//3th case addrlen
+	addrlen = fromwire_u16(&cursor, plen);
+	//2nd case addresses
+	*addresses = addrlen ? tal_arr(ctx, u8, addrlen) : NULL;
+	fromwire_u8_array(&cursor, plen, *addresses, addrlen);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_update(const void *p, size_t *plen, secp256k1_ecdsa_signature *signature, struct bitcoin_blkid *chain_hash, struct short_channel_id *short_channel_id, u32 *timestamp, u16 *flags, u16 *cltv_expiry_delta, u64 *htlc_minimum_msat, u32 *fee_base_msat, u32 *fee_proportional_millionths)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_UPDATE)
+		return false;
+	//4th case signature
+	fromwire_secp256k1_ecdsa_signature(&cursor, plen, signature);
+	//4th case chain_hash
+	fromwire_bitcoin_blkid(&cursor, plen, chain_hash);
+	//4th case short_channel_id
+	fromwire_short_channel_id(&cursor, plen, short_channel_id);
+	//3th case timestamp
+	*timestamp = fromwire_u32(&cursor, plen);
+	//3th case flags
+	*flags = fromwire_u16(&cursor, plen);
+	//3th case cltv_expiry_delta
+	*cltv_expiry_delta = fromwire_u16(&cursor, plen);
+	//3th case htlc_minimum_msat
+	*htlc_minimum_msat = fromwire_u64(&cursor, plen);
+	//3th case fee_base_msat
+	*fee_base_msat = fromwire_u32(&cursor, plen);
+	//3th case fee_proportional_millionths
+	*fee_proportional_millionths = fromwire_u32(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_open_channel_option_upfront_shutdown_script(const void *p, size_t *plen, struct bitcoin_blkid *chain_hash, struct channel_id *temporary_channel_id, u64 *funding_satoshis, u64 *push_msat, u64 *dust_limit_satoshis, u64 *max_htlc_value_in_flight_msat, u64 *channel_reserve_satoshis, u64 *htlc_minimum_msat, u32 *feerate_per_kw, u16 *to_self_delay, u16 *max_accepted_htlcs, struct pubkey *funding_pubkey, struct pubkey *revocation_basepoint, struct pubkey *payment_basepoint, struct pubkey *delayed_payment_basepoint, struct pubkey *htlc_basepoint, struct pubkey *first_per_commitment_point, u8 *channel_flags, u16 *shutdown_len)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_OPEN_CHANNEL)
+		return false;
+	//4th case chain_hash
+	fromwire_bitcoin_blkid(&cursor, plen, chain_hash);
+	//4th case temporary_channel_id
+	fromwire_channel_id(&cursor, plen, temporary_channel_id);
+	//3th case funding_satoshis
+	*funding_satoshis = fromwire_u64(&cursor, plen);
+	//3th case push_msat
+	*push_msat = fromwire_u64(&cursor, plen);
+	//3th case dust_limit_satoshis
+	*dust_limit_satoshis = fromwire_u64(&cursor, plen);
+	//3th case max_htlc_value_in_flight_msat
+	*max_htlc_value_in_flight_msat = fromwire_u64(&cursor, plen);
+	//3th case channel_reserve_satoshis
+	*channel_reserve_satoshis = fromwire_u64(&cursor, plen);
+	//3th case htlc_minimum_msat
+	*htlc_minimum_msat = fromwire_u64(&cursor, plen);
+	//3th case feerate_per_kw
+	*feerate_per_kw = fromwire_u32(&cursor, plen);
+	//3th case to_self_delay
+	*to_self_delay = fromwire_u16(&cursor, plen);
+	//3th case max_accepted_htlcs
+	*max_accepted_htlcs = fromwire_u16(&cursor, plen);
+	//4th case funding_pubkey
+	fromwire_pubkey(&cursor, plen, funding_pubkey);
+	//4th case revocation_basepoint
+	fromwire_pubkey(&cursor, plen, revocation_basepoint);
+	//4th case payment_basepoint
+	fromwire_pubkey(&cursor, plen, payment_basepoint);
+	//4th case delayed_payment_basepoint
+	fromwire_pubkey(&cursor, plen, delayed_payment_basepoint);
+	//4th case htlc_basepoint
+	fromwire_pubkey(&cursor, plen, htlc_basepoint);
+	//4th case first_per_commitment_point
+	fromwire_pubkey(&cursor, plen, first_per_commitment_point);
+	//3th case channel_flags
+	*channel_flags = fromwire_u8(&cursor, plen);
+	//3th case shutdown_len
+	*shutdown_len = fromwire_u16(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_accept_channel_option_upfront_shutdown_script(const void *p, size_t *plen, struct channel_id *temporary_channel_id, u64 *dust_limit_satoshis, u64 *max_htlc_value_in_flight_msat, u64 *channel_reserve_satoshis, u64 *htlc_minimum_msat, u32 *minimum_depth, u16 *to_self_delay, u16 *max_accepted_htlcs, struct pubkey *funding_pubkey, struct pubkey *revocation_basepoint, struct pubkey *payment_basepoint, struct pubkey *delayed_payment_basepoint, struct pubkey *htlc_basepoint, struct pubkey *first_per_commitment_point, u16 *shutdown_len)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_ACCEPT_CHANNEL)
+		return false;
+	//4th case temporary_channel_id
+	fromwire_channel_id(&cursor, plen, temporary_channel_id);
+	//3th case dust_limit_satoshis
+	*dust_limit_satoshis = fromwire_u64(&cursor, plen);
+	//3th case max_htlc_value_in_flight_msat
+	*max_htlc_value_in_flight_msat = fromwire_u64(&cursor, plen);
+	//3th case channel_reserve_satoshis
+	*channel_reserve_satoshis = fromwire_u64(&cursor, plen);
+	//3th case htlc_minimum_msat
+	*htlc_minimum_msat = fromwire_u64(&cursor, plen);
+	//3th case minimum_depth
+	*minimum_depth = fromwire_u32(&cursor, plen);
+	//3th case to_self_delay
+	*to_self_delay = fromwire_u16(&cursor, plen);
+	//3th case max_accepted_htlcs
+	*max_accepted_htlcs = fromwire_u16(&cursor, plen);
+	//4th case funding_pubkey
+	fromwire_pubkey(&cursor, plen, funding_pubkey);
+	//4th case revocation_basepoint
+	fromwire_pubkey(&cursor, plen, revocation_basepoint);
+	//4th case payment_basepoint
+	fromwire_pubkey(&cursor, plen, payment_basepoint);
+	//4th case delayed_payment_basepoint
+	fromwire_pubkey(&cursor, plen, delayed_payment_basepoint);
+	//4th case htlc_basepoint
+	fromwire_pubkey(&cursor, plen, htlc_basepoint);
+	//4th case first_per_commitment_point
+	fromwire_pubkey(&cursor, plen, first_per_commitment_point);
+	//3th case shutdown_len
+	*shutdown_len = fromwire_u16(&cursor, plen);
+	return cursor != NULL;
+}
+
+bool fromwire_channel_reestablish_option_data_loss_protect(const void *p, size_t *plen, struct channel_id *channel_id, u64 *next_local_commitment_number, u64 *next_remote_revocation_number, struct sha256 *your_last_per_commitment_secret, struct pubkey *my_current_per_commitment_point)
+{
+
+	const u8 *cursor = p;
+	size_t tmp_len;
+
+	if (!plen) {
+		tmp_len = tal_count(p);
+		plen = &tmp_len;
+	}
+	if (fromwire_u16(&cursor, plen) != WIRE_CHANNEL_REESTABLISH)
+		return false;
+	//4th case channel_id
+	fromwire_channel_id(&cursor, plen, channel_id);
+	//3th case next_local_commitment_number
+	*next_local_commitment_number = fromwire_u64(&cursor, plen);
+	//3th case next_remote_revocation_number
+	*next_remote_revocation_number = fromwire_u64(&cursor, plen);
+	//4th case your_last_per_commitment_secret
+	fromwire_sha256(&cursor, plen, your_last_per_commitment_secret);
+	//4th case my_current_per_commitment_point
+	fromwire_pubkey(&cursor, plen, my_current_per_commitment_point);
+	return cursor != NULL;
+}
+
+u8 *towire_init(const tal_t *ctx, const u8 *globalfeatures, const u8 *localfeatures)
+{
+	u16 gflen = tal_count(globalfeatures);
+	u16 lflen = tal_count(localfeatures);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_INIT);
+	towire_u16(&p, gflen);
+	towire_u8_array(&p, globalfeatures, gflen);
+	towire_u16(&p, lflen);
+	towire_u8_array(&p, localfeatures, lflen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_error(const tal_t *ctx, const struct channel_id *channel_id, const u8 *data)
+{
+	u16 len = tal_count(data);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ERROR);
+	towire_channel_id(&p, channel_id);
+	towire_u16(&p, len);
+	towire_u8_array(&p, data, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_ping(const tal_t *ctx, u16 num_pong_bytes, const u8 *ignored)
+{
+	u16 byteslen = tal_count(ignored);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_PING);
+	towire_u16(&p, num_pong_bytes);
+	towire_u16(&p, byteslen);
+	towire_u8_array(&p, ignored, byteslen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_pong(const tal_t *ctx, const u8 *ignored)
+{
+	u16 byteslen = tal_count(ignored);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_PONG);
+	towire_u16(&p, byteslen);
+	towire_u8_array(&p, ignored, byteslen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_open_channel(const tal_t *ctx, const struct bitcoin_blkid *chain_hash, const struct channel_id *temporary_channel_id, u64 funding_satoshis, u64 push_msat, u64 dust_limit_satoshis, u64 max_htlc_value_in_flight_msat, u64 channel_reserve_satoshis, u64 htlc_minimum_msat, u32 feerate_per_kw, u16 to_self_delay, u16 max_accepted_htlcs, const struct pubkey *funding_pubkey, const struct pubkey *revocation_basepoint, const struct pubkey *payment_basepoint, const struct pubkey *delayed_payment_basepoint, const struct pubkey *htlc_basepoint, const struct pubkey *first_per_commitment_point, u8 channel_flags)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_OPEN_CHANNEL);
+	towire_bitcoin_blkid(&p, chain_hash);
+	towire_channel_id(&p, temporary_channel_id);
+	towire_u64(&p, funding_satoshis);
+	towire_u64(&p, push_msat);
+	towire_u64(&p, dust_limit_satoshis);
+	towire_u64(&p, max_htlc_value_in_flight_msat);
+	towire_u64(&p, channel_reserve_satoshis);
+	towire_u64(&p, htlc_minimum_msat);
+	towire_u32(&p, feerate_per_kw);
+	towire_u16(&p, to_self_delay);
+	towire_u16(&p, max_accepted_htlcs);
+	towire_pubkey(&p, funding_pubkey);
+	towire_pubkey(&p, revocation_basepoint);
+	towire_pubkey(&p, payment_basepoint);
+	towire_pubkey(&p, delayed_payment_basepoint);
+	towire_pubkey(&p, htlc_basepoint);
+	towire_pubkey(&p, first_per_commitment_point);
+	towire_u8(&p, channel_flags);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_accept_channel(const tal_t *ctx, const struct channel_id *temporary_channel_id, u64 dust_limit_satoshis, u64 max_htlc_value_in_flight_msat, u64 channel_reserve_satoshis, u64 htlc_minimum_msat, u32 minimum_depth, u16 to_self_delay, u16 max_accepted_htlcs, const struct pubkey *funding_pubkey, const struct pubkey *revocation_basepoint, const struct pubkey *payment_basepoint, const struct pubkey *delayed_payment_basepoint, const struct pubkey *htlc_basepoint, const struct pubkey *first_per_commitment_point)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ACCEPT_CHANNEL);
+	towire_channel_id(&p, temporary_channel_id);
+	towire_u64(&p, dust_limit_satoshis);
+	towire_u64(&p, max_htlc_value_in_flight_msat);
+	towire_u64(&p, channel_reserve_satoshis);
+	towire_u64(&p, htlc_minimum_msat);
+	towire_u32(&p, minimum_depth);
+	towire_u16(&p, to_self_delay);
+	towire_u16(&p, max_accepted_htlcs);
+	towire_pubkey(&p, funding_pubkey);
+	towire_pubkey(&p, revocation_basepoint);
+	towire_pubkey(&p, payment_basepoint);
+	towire_pubkey(&p, delayed_payment_basepoint);
+	towire_pubkey(&p, htlc_basepoint);
+	towire_pubkey(&p, first_per_commitment_point);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_funding_created(const tal_t *ctx, const struct channel_id *temporary_channel_id, const struct bitcoin_txid *funding_txid, u16 funding_output_index, const secp256k1_ecdsa_signature *signature)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_FUNDING_CREATED);
+	towire_channel_id(&p, temporary_channel_id);
+	towire_bitcoin_txid(&p, funding_txid);
+	towire_u16(&p, funding_output_index);
+	towire_secp256k1_ecdsa_signature(&p, signature);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_funding_signed(const tal_t *ctx, const struct channel_id *channel_id, const secp256k1_ecdsa_signature *signature)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_FUNDING_SIGNED);
+	towire_channel_id(&p, channel_id);
+	towire_secp256k1_ecdsa_signature(&p, signature);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_funding_locked(const tal_t *ctx, const struct channel_id *channel_id, const struct pubkey *next_per_commitment_point)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_FUNDING_LOCKED);
+	towire_channel_id(&p, channel_id);
+	towire_pubkey(&p, next_per_commitment_point);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_shutdown(const tal_t *ctx, const struct channel_id *channel_id, const u8 *scriptpubkey)
+{
+	u16 len = tal_count(scriptpubkey);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_SHUTDOWN);
+	towire_channel_id(&p, channel_id);
+	towire_u16(&p, len);
+	towire_u8_array(&p, scriptpubkey, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_closing_signed(const tal_t *ctx, const struct channel_id *channel_id, u64 fee_satoshis, const secp256k1_ecdsa_signature *signature)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CLOSING_SIGNED);
+	towire_channel_id(&p, channel_id);
+	towire_u64(&p, fee_satoshis);
+	towire_secp256k1_ecdsa_signature(&p, signature);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_update_add_htlc(const tal_t *ctx, const struct channel_id *channel_id, u64 id, u64 amount_msat, const struct sha256 *payment_hash, u32 cltv_expiry, const u8 onion_routing_packet[1366])
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_UPDATE_ADD_HTLC);
+	towire_channel_id(&p, channel_id);
+	towire_u64(&p, id);
+	towire_u64(&p, amount_msat);
+	towire_sha256(&p, payment_hash);
+	towire_u32(&p, cltv_expiry);
+	towire_u8_array(&p, onion_routing_packet, 1366);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_update_fulfill_htlc(const tal_t *ctx, const struct channel_id *channel_id, u64 id, const struct preimage *payment_preimage)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_UPDATE_FULFILL_HTLC);
+	towire_channel_id(&p, channel_id);
+	towire_u64(&p, id);
+	towire_preimage(&p, payment_preimage);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_update_fail_htlc(const tal_t *ctx, const struct channel_id *channel_id, u64 id, const u8 *reason)
+{
+	u16 len = tal_count(reason);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_UPDATE_FAIL_HTLC);
+	towire_channel_id(&p, channel_id);
+	towire_u64(&p, id);
+	towire_u16(&p, len);
+	towire_u8_array(&p, reason, len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_update_fail_malformed_htlc(const tal_t *ctx, const struct channel_id *channel_id, u64 id, const struct sha256 *sha256_of_onion, u16 failure_code)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_UPDATE_FAIL_MALFORMED_HTLC);
+	towire_channel_id(&p, channel_id);
+	towire_u64(&p, id);
+	towire_sha256(&p, sha256_of_onion);
+	towire_u16(&p, failure_code);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_commitment_signed(const tal_t *ctx, const struct channel_id *channel_id, const secp256k1_ecdsa_signature *signature, const secp256k1_ecdsa_signature *htlc_signature)
+{
+	u16 num_htlcs = tal_count(htlc_signature);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_COMMITMENT_SIGNED);
+	towire_channel_id(&p, channel_id);
+	towire_secp256k1_ecdsa_signature(&p, signature);
+	towire_u16(&p, num_htlcs);
+	for (size_t i = 0; i < num_htlcs; i++)
+
+		towire_secp256k1_ecdsa_signature(&p, htlc_signature + i);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_revoke_and_ack(const tal_t *ctx, const struct channel_id *channel_id, const struct sha256 *per_commitment_secret, const struct pubkey *next_per_commitment_point)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_REVOKE_AND_ACK);
+	towire_channel_id(&p, channel_id);
+	towire_sha256(&p, per_commitment_secret);
+	towire_pubkey(&p, next_per_commitment_point);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_update_fee(const tal_t *ctx, const struct channel_id *channel_id, u32 feerate_per_kw)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_UPDATE_FEE);
+	towire_channel_id(&p, channel_id);
+	towire_u32(&p, feerate_per_kw);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_reestablish(const tal_t *ctx, const struct channel_id *channel_id, u64 next_local_commitment_number, u64 next_remote_revocation_number)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_REESTABLISH);
+	towire_channel_id(&p, channel_id);
+	towire_u64(&p, next_local_commitment_number);
+	towire_u64(&p, next_remote_revocation_number);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_announcement_signatures(const tal_t *ctx, const struct channel_id *channel_id, const struct short_channel_id *short_channel_id, const secp256k1_ecdsa_signature *node_signature, const secp256k1_ecdsa_signature *bitcoin_signature)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ANNOUNCEMENT_SIGNATURES);
+	towire_channel_id(&p, channel_id);
+	towire_short_channel_id(&p, short_channel_id);
+	towire_secp256k1_ecdsa_signature(&p, node_signature);
+	towire_secp256k1_ecdsa_signature(&p, bitcoin_signature);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_announcement(const tal_t *ctx, const secp256k1_ecdsa_signature *node_signature_1, const secp256k1_ecdsa_signature *node_signature_2, const secp256k1_ecdsa_signature *bitcoin_signature_1, const secp256k1_ecdsa_signature *bitcoin_signature_2, const u8 *features, const struct bitcoin_blkid *chain_hash, const struct short_channel_id *short_channel_id, const struct pubkey *node_id_1, const struct pubkey *node_id_2, const struct pubkey *bitcoin_key_1, const struct pubkey *bitcoin_key_2)
+{
+	u16 len = tal_count(features);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_ANNOUNCEMENT);
+	towire_secp256k1_ecdsa_signature(&p, node_signature_1);
+	towire_secp256k1_ecdsa_signature(&p, node_signature_2);
+	towire_secp256k1_ecdsa_signature(&p, bitcoin_signature_1);
+	towire_secp256k1_ecdsa_signature(&p, bitcoin_signature_2);
+	towire_u16(&p, len);
+	towire_u8_array(&p, features, len);
+	towire_bitcoin_blkid(&p, chain_hash);
+	towire_short_channel_id(&p, short_channel_id);
+	towire_pubkey(&p, node_id_1);
+	towire_pubkey(&p, node_id_2);
+	towire_pubkey(&p, bitcoin_key_1);
+	towire_pubkey(&p, bitcoin_key_2);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_node_announcement(const tal_t *ctx, const secp256k1_ecdsa_signature *signature, const u8 *features, u32 timestamp, const struct pubkey *node_id, const u8 rgb_color[3], const u8 alias[32], const u8 *addresses)
+{
+	u16 flen = tal_count(features);
+	u16 addrlen = tal_count(addresses);
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_NODE_ANNOUNCEMENT);
+	towire_secp256k1_ecdsa_signature(&p, signature);
+	towire_u16(&p, flen);
+	towire_u8_array(&p, features, flen);
+	towire_u32(&p, timestamp);
+	towire_pubkey(&p, node_id);
+	towire_u8_array(&p, rgb_color, 3);
+	towire_u8_array(&p, alias, 32);
+	towire_u16(&p, addrlen);
+	towire_u8_array(&p, addresses, addrlen);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_update(const tal_t *ctx, const secp256k1_ecdsa_signature *signature, const struct bitcoin_blkid *chain_hash, const struct short_channel_id *short_channel_id, u32 timestamp, u16 flags, u16 cltv_expiry_delta, u64 htlc_minimum_msat, u32 fee_base_msat, u32 fee_proportional_millionths)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_UPDATE);
+	towire_secp256k1_ecdsa_signature(&p, signature);
+	towire_bitcoin_blkid(&p, chain_hash);
+	towire_short_channel_id(&p, short_channel_id);
+	towire_u32(&p, timestamp);
+	towire_u16(&p, flags);
+	towire_u16(&p, cltv_expiry_delta);
+	towire_u64(&p, htlc_minimum_msat);
+	towire_u32(&p, fee_base_msat);
+	towire_u32(&p, fee_proportional_millionths);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_open_channel_option_upfront_shutdown_script(const tal_t *ctx, const struct bitcoin_blkid *chain_hash, const struct channel_id *temporary_channel_id, u64 funding_satoshis, u64 push_msat, u64 dust_limit_satoshis, u64 max_htlc_value_in_flight_msat, u64 channel_reserve_satoshis, u64 htlc_minimum_msat, u32 feerate_per_kw, u16 to_self_delay, u16 max_accepted_htlcs, const struct pubkey *funding_pubkey, const struct pubkey *revocation_basepoint, const struct pubkey *payment_basepoint, const struct pubkey *delayed_payment_basepoint, const struct pubkey *htlc_basepoint, const struct pubkey *first_per_commitment_point, u8 channel_flags, u16 shutdown_len)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_OPEN_CHANNEL);
+	towire_bitcoin_blkid(&p, chain_hash);
+	towire_channel_id(&p, temporary_channel_id);
+	towire_u64(&p, funding_satoshis);
+	towire_u64(&p, push_msat);
+	towire_u64(&p, dust_limit_satoshis);
+	towire_u64(&p, max_htlc_value_in_flight_msat);
+	towire_u64(&p, channel_reserve_satoshis);
+	towire_u64(&p, htlc_minimum_msat);
+	towire_u32(&p, feerate_per_kw);
+	towire_u16(&p, to_self_delay);
+	towire_u16(&p, max_accepted_htlcs);
+	towire_pubkey(&p, funding_pubkey);
+	towire_pubkey(&p, revocation_basepoint);
+	towire_pubkey(&p, payment_basepoint);
+	towire_pubkey(&p, delayed_payment_basepoint);
+	towire_pubkey(&p, htlc_basepoint);
+	towire_pubkey(&p, first_per_commitment_point);
+	towire_u8(&p, channel_flags);
+	towire_u16(&p, shutdown_len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_accept_channel_option_upfront_shutdown_script(const tal_t *ctx, const struct channel_id *temporary_channel_id, u64 dust_limit_satoshis, u64 max_htlc_value_in_flight_msat, u64 channel_reserve_satoshis, u64 htlc_minimum_msat, u32 minimum_depth, u16 to_self_delay, u16 max_accepted_htlcs, const struct pubkey *funding_pubkey, const struct pubkey *revocation_basepoint, const struct pubkey *payment_basepoint, const struct pubkey *delayed_payment_basepoint, const struct pubkey *htlc_basepoint, const struct pubkey *first_per_commitment_point, u16 shutdown_len)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_ACCEPT_CHANNEL);
+	towire_channel_id(&p, temporary_channel_id);
+	towire_u64(&p, dust_limit_satoshis);
+	towire_u64(&p, max_htlc_value_in_flight_msat);
+	towire_u64(&p, channel_reserve_satoshis);
+	towire_u64(&p, htlc_minimum_msat);
+	towire_u32(&p, minimum_depth);
+	towire_u16(&p, to_self_delay);
+	towire_u16(&p, max_accepted_htlcs);
+	towire_pubkey(&p, funding_pubkey);
+	towire_pubkey(&p, revocation_basepoint);
+	towire_pubkey(&p, payment_basepoint);
+	towire_pubkey(&p, delayed_payment_basepoint);
+	towire_pubkey(&p, htlc_basepoint);
+	towire_pubkey(&p, first_per_commitment_point);
+	towire_u16(&p, shutdown_len);
+
+	return memcheck(p, tal_count(p));
+}
+
+u8 *towire_channel_reestablish_option_data_loss_protect(const tal_t *ctx, const struct channel_id *channel_id, u64 next_local_commitment_number, u64 next_remote_revocation_number, const struct sha256 *your_last_per_commitment_secret, const struct pubkey *my_current_per_commitment_point)
+{
+
+	u8 *p = tal_arr(ctx, u8, 0);
+	towire_u16(&p, WIRE_CHANNEL_REESTABLISH);
+	towire_channel_id(&p, channel_id);
+	towire_u64(&p, next_local_commitment_number);
+	towire_u64(&p, next_remote_revocation_number);
+	towire_sha256(&p, your_last_per_commitment_secret);
+	towire_pubkey(&p, my_current_per_commitment_point);
+
+	return memcheck(p, tal_count(p));
+}
+
+
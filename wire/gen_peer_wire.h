@@ -0,0 +1,140 @@
+/* This file was generated by generate-wire.py */
+/* Do not modify this file! Modify the _csv file it was generated from. */
+#ifndef LIGHTNING_WIRE_GEN_PEER_WIRE_H
+#define LIGHTNING_WIRE_GEN_PEER_WIRE_H
+#include <ccan/tal/tal.h>
+#include <wire/wire.h>
+
+enum wire_type {
+	WIRE_INIT = 16,
+	WIRE_ERROR = 17,
+	WIRE_PING = 18,
+	WIRE_PONG = 19,
+	WIRE_OPEN_CHANNEL = 32,
+	WIRE_ACCEPT_CHANNEL = 33,
+	WIRE_FUNDING_CREATED = 34,
+	WIRE_FUNDING_SIGNED = 35,
+	WIRE_FUNDING_LOCKED = 36,
+	WIRE_SHUTDOWN = 38,
+	WIRE_CLOSING_SIGNED = 39,
+	WIRE_UPDATE_ADD_HTLC = 128,
+	WIRE_UPDATE_FULFILL_HTLC = 130,
+	WIRE_UPDATE_FAIL_HTLC = 131,
+	WIRE_UPDATE_FAIL_MALFORMED_HTLC = 135,
+	WIRE_COMMITMENT_SIGNED = 132,
+	WIRE_REVOKE_AND_ACK = 133,
+	WIRE_UPDATE_FEE = 134,
+	WIRE_CHANNEL_REESTABLISH = 136,
+	WIRE_ANNOUNCEMENT_SIGNATURES = 259,
+	WIRE_CHANNEL_ANNOUNCEMENT = 256,
+	WIRE_NODE_ANNOUNCEMENT = 257,
+	WIRE_CHANNEL_UPDATE = 258,
+};
+const char *wire_type_name(int e);
+
+bool fromwire_init(const tal_t *ctx, const void *p, size_t *plen, u8 **globalfeatures, u8 **localfeatures);
+
+bool fromwire_error(const tal_t *ctx, const void *p, size_t *plen, struct channel_id *channel_id, u8 **data);
+
+bool fromwire_ping(const tal_t *ctx, const void *p, size_t *plen, u16 *num_pong_bytes, u8 **ignored);
+
+bool fromwire_pong(const tal_t *ctx, const void *p, size_t *plen, u8 **ignored);
+
+bool fromwire_open_channel(const void *p, size_t *plen, struct bitcoin_blkid *chain_hash, struct channel_id *temporary_channel_id, u64 *funding_satoshis, u64 *push_msat, u64 *dust_limit_satoshis, u64 *max_htlc_value_in_flight_msat, u64 *channel_reserve_satoshis, u64 *htlc_minimum_msat, u32 *feerate_per_kw, u16 *to_self_delay, u16 *max_accepted_htlcs, struct pubkey *funding_pubkey, struct pubkey *revocation_basepoint, struct pubkey *payment_basepoint, struct pubkey *delayed_payment_basepoint, struct pubkey *htlc_basepoint, struct pubkey *first_per_commitment_point, u8 *channel_flags);
+
+bool fromwire_accept_channel(const void *p, size_t *plen, struct channel_id *temporary_channel_id, u64 *dust_limit_satoshis, u64 *max_htlc_value_in_flight_msat, u64 *channel_reserve_satoshis, u64 *htlc_minimum_msat, u32 *minimum_depth, u16 *to_self_delay, u16 *max_accepted_htlcs, struct pubkey *funding_pubkey, struct pubkey *revocation_basepoint, struct pubkey *payment_basepoint, struct pubkey *delayed_payment_basepoint, struct pubkey *htlc_basepoint, struct pubkey *first_per_commitment_point);
+
+bool fromwire_funding_created(const void *p, size_t *plen, struct channel_id *temporary_channel_id, struct bitcoin_txid *funding_txid, u16 *funding_output_index, secp256k1_ecdsa_signature *signature);
+
+bool fromwire_funding_signed(const void *p, size_t *plen, struct channel_id *channel_id, secp256k1_ecdsa_signature *signature);
+
+bool fromwire_funding_locked(const void *p, size_t *plen, struct channel_id *channel_id, struct pubkey *next_per_commitment_point);
+
+bool fromwire_shutdown(const tal_t *ctx, const void *p, size_t *plen, struct channel_id *channel_id, u8 **scriptpubkey);
+
+bool fromwire_closing_signed(const void *p, size_t *plen, struct channel_id *channel_id, u64 *fee_satoshis, secp256k1_ecdsa_signature *signature);
+
+bool fromwire_update_add_htlc(const void *p, size_t *plen, struct channel_id *channel_id, u64 *id, u64 *amount_msat, struct sha256 *payment_hash, u32 *cltv_expiry, u8 onion_routing_packet[1366]);
+
+bool fromwire_update_fulfill_htlc(const void *p, size_t *plen, struct channel_id *channel_id, u64 *id, struct preimage *payment_preimage);
+
+bool fromwire_update_fail_htlc(const tal_t *ctx, const void *p, size_t *plen, struct channel_id *channel_id, u64 *id, u8 **reason);
+
+bool fromwire_update_fail_malformed_htlc(const void *p, size_t *plen, struct channel_id *channel_id, u64 *id, struct sha256 *sha256_of_onion, u16 *failure_code);
+
+bool fromwire_commitment_signed(const tal_t *ctx, const void *p, size_t *plen, struct channel_id *channel_id, secp256k1_ecdsa_signature *signature, secp256k1_ecdsa_signature **htlc_signature);
+
+bool fromwire_revoke_and_ack(const void *p, size_t *plen, struct channel_id *channel_id, struct sha256 *per_commitment_secret, struct pubkey *next_per_commitment_point);
+
+bool fromwire_update_fee(const void *p, size_t *plen, struct channel_id *channel_id, u32 *feerate_per_kw);
+
+bool fromwire_channel_reestablish(const void *p, size_t *plen, struct channel_id *channel_id, u64 *next_local_commitment_number, u64 *next_remote_revocation_number);
+
+bool fromwire_announcement_signatures(const void *p, size_t *plen, struct channel_id *channel_id, struct short_channel_id *short_channel_id, secp256k1_ecdsa_signature *node_signature, secp256k1_ecdsa_signature *bitcoin_signature);
+
+bool fromwire_channel_announcement(const tal_t *ctx, const void *p, size_t *plen, secp256k1_ecdsa_signature *node_signature_1, secp256k1_ecdsa_signature *node_signature_2, secp256k1_ecdsa_signature *bitcoin_signature_1, secp256k1_ecdsa_signature *bitcoin_signature_2, u8 **features, struct bitcoin_blkid *chain_hash, struct short_channel_id *short_channel_id, struct pubkey *node_id_1, struct pubkey *node_id_2, struct pubkey *bitcoin_key_1, struct pubkey *bitcoin_key_2);
+
+bool fromwire_node_announcement(const tal_t *ctx, const void *p, size_t *plen, secp256k1_ecdsa_signature *signature, u8 **features, u32 *timestamp, struct pubkey *node_id, u8 rgb_color[3], u8 alias[32], u8 **addresses);
+
+bool fromwire_channel_update(const void *p, size_t *plen, secp256k1_ecdsa_signature *signature, struct bitcoin_blkid *chain_hash, struct short_channel_id *short_channel_id, u32 *timestamp, u16 *flags, u16 *cltv_expiry_delta, u64 *htlc_minimum_msat, u32 *fee_base_msat, u32 *fee_proportional_millionths);
+
+bool fromwire_open_channel_option_upfront_shutdown_script(const void *p, size_t *plen, struct bitcoin_blkid *chain_hash, struct channel_id *temporary_channel_id, u64 *funding_satoshis, u64 *push_msat, u64 *dust_limit_satoshis, u64 *max_htlc_value_in_flight_msat, u64 *channel_reserve_satoshis, u64 *htlc_minimum_msat, u32 *feerate_per_kw, u16 *to_self_delay, u16 *max_accepted_htlcs, struct pubkey *funding_pubkey, struct pubkey *revocation_basepoint, struct pubkey *payment_basepoint, struct pubkey *delayed_payment_basepoint, struct pubkey *htlc_basepoint, struct pubkey *first_per_commitment_point, u8 *channel_flags, u16 *shutdown_len);
+
+bool fromwire_accept_channel_option_upfront_shutdown_script(const void *p, size_t *plen, struct channel_id *temporary_channel_id, u64 *dust_limit_satoshis, u64 *max_htlc_value_in_flight_msat, u64 *channel_reserve_satoshis, u64 *htlc_minimum_msat, u32 *minimum_depth, u16 *to_self_delay, u16 *max_accepted_htlcs, struct pubkey *funding_pubkey, struct pubkey *revocation_basepoint, struct pubkey *payment_basepoint, struct pubkey *delayed_payment_basepoint, struct pubkey *htlc_basepoint, struct pubkey *first_per_commitment_point, u16 *shutdown_len);
+
+bool fromwire_channel_reestablish_option_data_loss_protect(const void *p, size_t *plen, struct channel_id *channel_id, u64 *next_local_commitment_number, u64 *next_remote_revocation_number, struct sha256 *your_last_per_commitment_secret, struct pubkey *my_current_per_commitment_point);
+
+u8 *towire_init(const tal_t *ctx, const u8 *globalfeatures, const u8 *localfeatures);
+
+u8 *towire_error(const tal_t *ctx, const struct channel_id *channel_id, const u8 *data);
+
+u8 *towire_ping(const tal_t *ctx, u16 num_pong_bytes, const u8 *ignored);
+
+u8 *towire_pong(const tal_t *ctx, const u8 *ignored);
+
+u8 *towire_open_channel(const tal_t *ctx, const struct bitcoin_blkid *chain_hash, const struct channel_id *temporary_channel_id, u64 funding_satoshis, u64 push_msat, u64 dust_limit_satoshis, u64 max_htlc_value_in_flight_msat, u64 channel_reserve_satoshis, u64 htlc_minimum_msat, u32 feerate_per_kw, u16 to_self_delay, u16 max_accepted_htlcs, const struct pubkey *funding_pubkey, const struct pubkey *revocation_basepoint, const struct pubkey *payment_basepoint, const struct pubkey *delayed_payment_basepoint, const struct pubkey *htlc_basepoint, const struct pubkey *first_per_commitment_point, u8 channel_flags);
+
+u8 *towire_accept_channel(const tal_t *ctx, const struct channel_id *temporary_channel_id, u64 dust_limit_satoshis, u64 max_htlc_value_in_flight_msat, u64 channel_reserve_satoshis, u64 htlc_minimum_msat, u32 minimum_depth, u16 to_self_delay, u16 max_accepted_htlcs, const struct pubkey *funding_pubkey, const struct pubkey *revocation_basepoint, const struct pubkey *payment_basepoint, const struct pubkey *delayed_payment_basepoint, const struct pubkey *htlc_basepoint, const struct pubkey *first_per_commitment_point);
+
+u8 *towire_funding_created(const tal_t *ctx, const struct channel_id *temporary_channel_id, const struct bitcoin_txid *funding_txid, u16 funding_output_index, const secp256k1_ecdsa_signature *signature);
+
+u8 *towire_funding_signed(const tal_t *ctx, const struct channel_id *channel_id, const secp256k1_ecdsa_signature *signature);
+
+u8 *towire_funding_locked(const tal_t *ctx, const struct channel_id *channel_id, const struct pubkey *next_per_commitment_point);
+
+u8 *towire_shutdown(const tal_t *ctx, const struct channel_id *channel_id, const u8 *scriptpubkey);
+
+u8 *towire_closing_signed(const tal_t *ctx, const struct channel_id *channel_id, u64 fee_satoshis, const secp256k1_ecdsa_signature *signature);
+
+u8 *towire_update_add_htlc(const tal_t *ctx, const struct channel_id *channel_id, u64 id, u64 amount_msat, const struct sha256 *payment_hash, u32 cltv_expiry, const u8 onion_routing_packet[1366]);
+
+u8 *towire_update_fulfill_htlc(const tal_t *ctx, const struct channel_id *channel_id, u64 id, const struct preimage *payment_preimage);
+
+u8 *towire_update_fail_htlc(const tal_t *ctx, const struct channel_id *channel_id, u64 id, const u8 *reason);
+
+u8 *towire_update_fail_malformed_htlc(const tal_t *ctx, const struct channel_id *channel_id, u64 id, const struct sha256 *sha256_of_onion, u16 failure_code);
+
+u8 *towire_commitment_signed(const tal_t *ctx, const struct channel_id *channel_id, const secp256k1_ecdsa_signature *signature, const secp256k1_ecdsa_signature *htlc_signature);
+
+u8 *towire_revoke_and_ack(const tal_t *ctx, const struct channel_id *channel_id, const struct sha256 *per_commitment_secret, const struct pubkey *next_per_commitment_point);
+
+u8 *towire_update_fee(const tal_t *ctx, const struct channel_id *channel_id, u32 feerate_per_kw);
+
+u8 *towire_channel_reestablish(const tal_t *ctx, const struct channel_id *channel_id, u64 next_local_commitment_number, u64 next_remote_revocation_number);
+
+u8 *towire_announcement_signatures(const tal_t *ctx, const struct channel_id *channel_id, const struct short_channel_id *short_channel_id, const secp256k1_ecdsa_signature *node_signature, const secp256k1_ecdsa_signature *bitcoin_signature);
+
+u8 *towire_channel_announcement(const tal_t *ctx, const secp256k1_ecdsa_signature *node_signature_1, const secp256k1_ecdsa_signature *node_signature_2, const secp256k1_ecdsa_signature *bitcoin_signature_1, const secp256k1_ecdsa_signature *bitcoin_signature_2, const u8 *features, const struct bitcoin_blkid *chain_hash, const struct short_channel_id *short_channel_id, const struct pubkey *node_id_1, const struct pubkey *node_id_2, const struct pubkey *bitcoin_key_1, const struct pubkey *bitcoin_key_2);
+
+u8 *towire_node_announcement(const tal_t *ctx, const secp256k1_ecdsa_signature *signature, const u8 *features, u32 timestamp, const struct pubkey *node_id, const u8 rgb_color[3], const u8 alias[32], const u8 *addresses);
+
+u8 *towire_channel_update(const tal_t *ctx, const secp256k1_ecdsa_signature *signature, const struct bitcoin_blkid *chain_hash, const struct short_channel_id *short_channel_id, u32 timestamp, u16 flags, u16 cltv_expiry_delta, u64 htlc_minimum_msat, u32 fee_base_msat, u32 fee_proportional_millionths);
+
+u8 *towire_open_channel_option_upfront_shutdown_script(const tal_t *ctx, const struct bitcoin_blkid *chain_hash, const struct channel_id *temporary_channel_id, u64 funding_satoshis, u64 push_msat, u64 dust_limit_satoshis, u64 max_htlc_value_in_flight_msat, u64 channel_reserve_satoshis, u64 htlc_minimum_msat, u32 feerate_per_kw, u16 to_self_delay, u16 max_accepted_htlcs, const struct pubkey *funding_pubkey, const struct pubkey *revocation_basepoint, const struct pubkey *payment_basepoint, const struct pubkey *delayed_payment_basepoint, const struct pubkey *htlc_basepoint, const struct pubkey *first_per_commitment_point, u8 channel_flags, u16 shutdown_len);
+
+u8 *towire_accept_channel_option_upfront_shutdown_script(const tal_t *ctx, const struct channel_id *temporary_channel_id, u64 dust_limit_satoshis, u64 max_htlc_value_in_flight_msat, u64 channel_reserve_satoshis, u64 htlc_minimum_msat, u32 minimum_depth, u16 to_self_delay, u16 max_accepted_htlcs, const struct pubkey *funding_pubkey, const struct pubkey *revocation_basepoint, const struct pubkey *payment_basepoint, const struct pubkey *delayed_payment_basepoint, const struct pubkey *htlc_basepoint, const struct pubkey *first_per_commitment_point, u16 shutdown_len);
+
+u8 *towire_channel_reestablish_option_data_loss_protect(const tal_t *ctx, const struct channel_id *channel_id, u64 next_local_commitment_number, u64 next_remote_revocation_number, const struct sha256 *your_last_per_commitment_secret, const struct pubkey *my_current_per_commitment_point);
+
+#endif /* LIGHTNING_WIRE_GEN_PEER_WIRE_H */
+